@@ -40,5 +40,81 @@ BinaryData AudioData::GetData() const
     return data_;
 }
 
+bool AudioData::IsStreaming() const
+{
+    return false;
+}
+
+void AudioData::SetArchive(RefPtr<FileArchive> archive)
+{
+    archive_ = archive;
+}
+
+StreamAudioData::StreamAudioData()
+    : eos_(false)
+    , next_chunk_(0)
+{
+}
+
+StreamAudioData::~StreamAudioData() {}
+
+bool StreamAudioData::IsStreaming() const
+{
+    return true;
+}
+
+BinaryData StreamAudioData::ReadChunk()
+{
+    if (eos_)
+        return BinaryData();
+
+    if (ring_.empty())
+        ring_.resize(CHUNK_COUNT * CHUNK_SIZE);
+
+    char* chunk = ring_.data() + next_chunk_ * CHUNK_SIZE;
+
+    // Fill the whole chunk, the decoder may return less than requested
+    uint32_t pos = 0;
+    while (pos < CHUNK_SIZE)
+    {
+        int bytes_read = DecodePCM(chunk + pos, CHUNK_SIZE - pos);
+        if (bytes_read <= 0)
+        {
+            eos_ = true;
+            break;
+        }
+        pos += uint32_t(bytes_read);
+    }
+
+    // Keep the chunk aligned to whole sample frames
+    if (meta_.block_align)
+        pos -= pos % meta_.block_align;
+
+    if (pos == 0)
+        return BinaryData();
+
+    next_chunk_ = (next_chunk_ + 1) % CHUNK_COUNT;
+    return BinaryData(chunk, pos);
+}
+
+bool StreamAudioData::Seek(Duration pos)
+{
+    if (!SeekPCM(pos))
+        return false;
+
+    eos_ = false;
+    return true;
+}
+
+bool StreamAudioData::IsEndOfStream() const
+{
+    return eos_;
+}
+
+Duration StreamAudioData::GetDuration() const
+{
+    return duration_;
+}
+
 }  // namespace audio
 }  // namespace kiwano
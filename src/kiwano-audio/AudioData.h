@@ -20,8 +20,10 @@
 
 #pragma once
 #include <kiwano/core/BinaryData.h>
+#include <kiwano/core/Duration.h>
 #include <kiwano/base/ObjectBase.h>
 #include <kiwano/platform/NativeObject.hpp>
+#include <kiwano/platform/FileArchive.h>
 
 namespace kiwano
 {
@@ -81,12 +83,88 @@ public:
     /// @brief ȡ
     BinaryData GetData() const;
 
+    /// \~chinese
+    /// @brief ǷʽƵ
+    virtual bool IsStreaming() const;
+
+    /// \~chinese
+    /// @brief ڵĴļ
+    /// @details ֱӶȡļڴƵݳиôļжغԿɲ
+    void SetArchive(RefPtr<FileArchive> archive);
+
 protected:
     AudioData() = default;
 
 protected:
-    BinaryData data_;
-    AudioMeta  meta_;
+    BinaryData          data_;
+    AudioMeta           meta_;
+    RefPtr<FileArchive> archive_;
+};
+
+/**
+ * \~chinese
+ * @brief ʽƵ
+ * @details 轫Ƶ뵽̶СĻλУڽϳƵжȡλã
+ * ˲ܱƵͬʱʹãƵʽʱͨ Clone ԼĽ
+ */
+class KGE_API StreamAudioData : public AudioData
+{
+public:
+    /// \~chinese
+    /// @brief λ
+    static const uint32_t CHUNK_COUNT = 3;
+
+    /// \~chinese
+    /// @brief λС
+    static const uint32_t CHUNK_SIZE = 64 * 1024;
+
+    StreamAudioData();
+
+    virtual ~StreamAudioData();
+
+    /// \~chinese
+    /// @brief ǷʽƵ
+    bool IsStreaming() const override;
+
+    /// \~chinese
+    /// @brief һ
+    /// @details д뻷λһУͬʱ CHUNK_COUNT 
+    /// @return õݣʧʱؿ
+    BinaryData ReadChunk();
+
+    /// \~chinese
+    /// @brief תָλ
+    /// @param pos Ƶʼʱ
+    bool Seek(Duration pos);
+
+    /// \~chinese
+    /// @brief Ƿѽ
+    bool IsEndOfStream() const;
+
+    /// \~chinese
+    /// @brief ȡƵʱ
+    Duration GetDuration() const;
+
+    /// \~chinese
+    /// @brief ȡͬһԴĶ
+    /// @return ½Ƶʼȡʧʱؿָ
+    virtual RefPtr<StreamAudioData> Clone() const = 0;
+
+protected:
+    /// \~chinese
+    /// @brief  PCM 
+    /// @return õֽʱ 0ʧʱظ
+    virtual int DecodePCM(char* buffer, uint32_t size) = 0;
+
+    /// \~chinese
+    /// @brief תָλ
+    virtual bool SeekPCM(Duration pos) = 0;
+
+protected:
+    bool         eos_;
+    uint32_t     next_chunk_;
+    Duration     duration_;
+    Vector<char> ring_;
 };
 
 /** @} */
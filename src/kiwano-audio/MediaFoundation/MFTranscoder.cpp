@@ -65,6 +65,11 @@ RefPtr<AudioData> MFTranscoder::Decode(StringView file_path)
 }
 
 RefPtr<AudioData> MFTranscoder::Decode(const Resource& res)
+{
+    return Decode(res.GetData());
+}
+
+RefPtr<AudioData> MFTranscoder::Decode(const BinaryData& data)
 {
     HRESULT hr = S_OK;
 
@@ -72,7 +77,6 @@ RefPtr<AudioData> MFTranscoder::Decode(const Resource& res)
     ComPtr<IMFByteStream>   byte_stream;
     ComPtr<IMFSourceReader> reader;
 
-    BinaryData data = res.GetData();
     if (!data.IsValid())
     {
         KGE_ERROR("invalid audio data");
@@ -46,6 +46,8 @@ public:
     RefPtr<AudioData> Decode(StringView file_path) override;
 
     RefPtr<AudioData> Decode(const Resource& res) override;
+
+    RefPtr<AudioData> Decode(const BinaryData& data) override;
 };
 
 /** @} */
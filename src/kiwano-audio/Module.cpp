@@ -20,6 +20,7 @@
 #include <kiwano/core/Exception.h>
 #include <kiwano/utils/Logger.h>
 #include <kiwano/platform/FileSystem.h>
+#include <kiwano/utils/ResourceLoader.h>
 #include <kiwano-audio/Module.h>
 #include <kiwano-audio/libraries.h>
 #include <kiwano-audio/MediaFoundation/MFTranscoder.h>
@@ -33,18 +34,25 @@ namespace audio
 class VoiceCallback : public IXAudio2VoiceCallback
 {
 public:
-    SoundCallback* cb = nullptr;
+    SoundCallback* cb    = nullptr;
+    Sound*         sound = nullptr;
 
-    VoiceCallback(SoundCallback* cb)
+    VoiceCallback(SoundCallback* cb, Sound* sound)
         : cb(cb)
+        , sound(sound)
     {
     }
 
     ~VoiceCallback() {}
 
+    // Buffers of streaming audio carry a playback token as their context
+
     STDMETHOD_(void, OnBufferStart(void* pBufferContext))
     {
-        cb->OnStart(nullptr);
+        if (pBufferContext)
+            sound->OnStreamChunkStart(pBufferContext);
+        else
+            cb->OnStart(nullptr);
     }
 
     STDMETHOD_(void, OnLoopEnd(void* pBufferContext))
@@ -54,7 +62,10 @@ public:
 
     STDMETHOD_(void, OnBufferEnd(void* pBufferContext))
     {
-        cb->OnEnd(nullptr);
+        if (pBufferContext)
+            sound->OnStreamChunkEnd(pBufferContext);
+        else
+            cb->OnEnd(nullptr);
     }
 
     STDMETHOD_(void, OnStreamEnd()) {}
@@ -69,6 +80,37 @@ public:
     }
 };
 
+// Decodes audio listed in resource manifests, called on the resource loading threads
+RefPtr<ObjectBase> DecodeAudioResource(StringView file_path, const BinaryData& data)
+{
+    auto transcoder = Module::GetInstance().GetTranscoder(FileSystem::GetInstance().GetFileExt(file_path));
+    if (!transcoder)
+        return nullptr;
+
+    // Media Foundation needs COM on the calling thread, the main thread has initialized it already
+    HRESULT hr = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    RefPtr<AudioData> output;
+    if (data.IsValid())
+    {
+        // Streams keep reading the archive mapping; lookups of mounted archives are safe on other threads
+        RefPtr<FileArchive> archive;
+        FileSystem::GetInstance().GetArchivedFileData(file_path, archive);
+
+        output = transcoder->Decode(data);
+        if (output)
+            output->SetArchive(archive);
+    }
+    else
+    {
+        output = transcoder->Decode(file_path);
+    }
+
+    if (SUCCEEDED(hr))
+        ::CoUninitialize();
+    return output;
+}
+
 WORD ConvertWaveFormat(AudioFormat format)
 {
     switch (format)
@@ -102,6 +144,13 @@ void Module::SetupModule()
     {
         RegisterTranscoder("*", MakePtr<MFTranscoder>());
         RegisterTranscoder("ogg", MakePtr<OggTranscoder>());
+
+        // audio listed under "audios" in resource manifests is decoded on the loading threads
+        ResourceLoader::RegisterDecoder("audios", DecodeAudioResource);
+
+        // one thread decodes streaming chunks in the order they are requested
+        std::lock_guard<std::mutex> lock(stream_pool_mutex_);
+        stream_pool_.reset(new ThreadPool(1));
     }
 
     KGE_THROW_IF_FAILED(hr, "Create audio resources failed");
@@ -111,6 +160,16 @@ void Module::DestroyModule()
 {
     KGE_DEBUG_LOGF("Destroying audio resources");
 
+    ResourceLoader::RegisterDecoder("audios", nullptr);
+
+    // wait for the decoding jobs outside the lock, they may submit buffers to voices
+    std::unique_ptr<ThreadPool> stream_pool;
+    {
+        std::lock_guard<std::mutex> lock(stream_pool_mutex_);
+        stream_pool.swap(stream_pool_);
+    }
+    stream_pool.reset();
+
     if (mastering_voice_)
     {
         mastering_voice_->DestroyVoice();
@@ -124,6 +183,16 @@ void Module::DestroyModule()
     }
 }
 
+bool Module::PerformStreamDecoding(Function<void()> job)
+{
+    std::lock_guard<std::mutex> lock(stream_pool_mutex_);
+    if (!stream_pool_)
+        return false;
+
+    stream_pool_->Submit(std::move(job));
+    return true;
+}
+
 bool Module::CreateSound(Sound& sound, RefPtr<AudioData> data)
 {
     KGE_ASSERT(x_audio2_ && "Audio module hasn't been initialized!");
@@ -149,7 +218,7 @@ bool Module::CreateSound(Sound& sound, RefPtr<AudioData> data)
     if (SUCCEEDED(hr))
     {
         auto chain = sound.GetCallbackChain();
-        chain->SetNative(VoiceCallback{ chain.Get() });
+        chain->SetNative(VoiceCallback{ chain.Get(), &sound });
         auto callback = const_cast<VoiceCallback*>(chain->GetNative().CastPtr<VoiceCallback>());
 
         IXAudio2SourceVoice* voice = nullptr;
@@ -201,6 +270,24 @@ RefPtr<Transcoder> Module::GetTranscoder(StringView ext)
 
 RefPtr<AudioData> Module::Decode(StringView file_path)
 {
+    RefPtr<FileArchive> archive;
+    BinaryData          archived = FileSystem::GetInstance().GetArchivedFileData(file_path, archive);
+    if (archived.IsValid())
+    {
+        auto transcoder = GetTranscoder(FileSystem::GetInstance().GetFileExt(file_path));
+        if (!transcoder)
+        {
+            return nullptr;
+        }
+
+        RefPtr<AudioData> output = transcoder->Decode(archived);
+        if (output)
+        {
+            output->SetArchive(archive);
+        }
+        return output;
+    }
+
     if (!FileSystem::GetInstance().IsFileExists(file_path))
     {
         KGE_WARNF("Media file '%s' not found", file_path.data());
@@ -22,6 +22,7 @@
 #include <kiwano-audio/Sound.h>
 #include <kiwano-audio/Transcoder.h>
 #include <kiwano/core/Common.h>
+#include <kiwano/core/ThreadPool.h>
 #include <kiwano/base/Module.h>
 #include <xaudio2.h>
 
@@ -84,6 +85,12 @@ public:
     /// @brief Ƶ
     bool CreateSound(Sound& sound, RefPtr<AudioData> data);
 
+    /// \~chinese
+    /// @brief ʽִ߳
+    /// @details ʽƵݿ鲥Žڸ߳̽һݣXAudio2 Ļص߳вн
+    /// @return Ƶģʱִ񲢷 false
+    bool PerformStreamDecoding(Function<void()> job);
+
 public:
     void SetupModule() override;
 
@@ -98,6 +105,9 @@ private:
     IXAudio2*               x_audio2_;
     IXAudio2MasteringVoice* mastering_voice_;
 
+    std::mutex                  stream_pool_mutex_;
+    std::unique_ptr<ThreadPool> stream_pool_;
+
     UnorderedMap<String, RefPtr<Transcoder>> registered_transcoders_;
 };
 
@@ -27,6 +27,65 @@ namespace kiwano
 namespace audio
 {
 
+namespace
+{
+
+struct OggMemorySource
+{
+    const char* data;
+    size_t      size;
+    size_t      pos;
+};
+
+size_t OggMemoryRead(void* ptr, size_t size, size_t nmemb, void* datasource)
+{
+    auto source = reinterpret_cast<OggMemorySource*>(datasource);
+    if (size == 0 || source->pos >= source->size)
+        return 0;
+
+    const size_t count = std::min(nmemb, (source->size - source->pos) / size);
+    std::memcpy(ptr, source->data + source->pos, count * size);
+    source->pos += count * size;
+    return count;
+}
+
+int OggMemorySeek(void* datasource, ogg_int64_t offset, int whence)
+{
+    auto source = reinterpret_cast<OggMemorySource*>(datasource);
+
+    ogg_int64_t pos = 0;
+    switch (whence)
+    {
+    case SEEK_SET:
+        pos = offset;
+        break;
+    case SEEK_CUR:
+        pos = ogg_int64_t(source->pos) + offset;
+        break;
+    case SEEK_END:
+        pos = ogg_int64_t(source->size) + offset;
+        break;
+    default:
+        return -1;
+    }
+
+    if (pos < 0 || pos > ogg_int64_t(source->size))
+        return -1;
+
+    source->pos = size_t(pos);
+    return 0;
+}
+
+long OggMemoryTell(void* datasource)
+{
+    auto source = reinterpret_cast<OggMemorySource*>(datasource);
+    return long(source->pos);
+}
+
+const ov_callbacks OggMemoryCallbacks = { OggMemoryRead, OggMemorySeek, nullptr, OggMemoryTell };
+
+}  // namespace
+
 class OggAudioData : public AudioData
 {
 public:
@@ -40,67 +99,189 @@ public:
     std::vector<char> raw_;
 };
 
-RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
+class OggStreamAudioData : public StreamAudioData
 {
-    OggVorbis_File vf;
+public:
+    OggStreamAudioData()
+        : opened_(false)
+        , source_{}
+        , vf_{}
+    {
+    }
 
-    int err = ov_fopen(file_path.data(), &vf);
-    if (err != 0)
+    virtual ~OggStreamAudioData()
     {
-        KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
-        return nullptr;
+        if (opened_)
+        {
+            ov_clear(&vf_);
+        }
     }
 
-    // read metadata
-    vorbis_info* vi = ov_info(&vf, -1);
+    bool Open(StringView file_path)
+    {
+        file_path_ = file_path;
+        return Init(ov_fopen(file_path_.c_str(), &vf_));
+    }
+
+    bool Open(const BinaryData& data)
+    {
+        source_.data = reinterpret_cast<const char*>(data.buffer);
+        source_.size = data.size;
+        source_.pos  = 0;
+        return Init(ov_open_callbacks(&source_, &vf_, nullptr, 0, OggMemoryCallbacks));
+    }
+
+    RefPtr<StreamAudioData> Clone() const override
+    {
+        RefPtr<OggStreamAudioData> clone = MakePtr<OggStreamAudioData>();
+
+        bool succeeded = false;
+        if (!file_path_.empty())
+            succeeded = clone->Open(file_path_);
+        else
+            succeeded = clone->Open(BinaryData(const_cast<char*>(source_.data), uint32_t(source_.size)));
+
+        if (!succeeded)
+            return nullptr;
+
+        clone->archive_ = archive_;
+        return clone;
+    }
+
+    RefPtr<AudioData> DecodeAll()
+    {
+        // allocate buffer
+        std::vector<char> data;
+
+        const size_t expected_size = size_t(duration_.GetMilliseconds() * meta_.avg_bytes_per_sec() / 1000) + 1;
+        data.resize(expected_size);
 
-    AudioMeta meta;
-    meta.samples_per_sec = uint32_t(vi->rate);
-    meta.channels        = uint16_t(vi->channels);
-    meta.bits_per_sample = uint16_t(16);  // the 'word' param of ov_read sets to 2, which means 16-bits samples.
-    meta.block_align     = uint16_t(meta.channels * meta.bits_per_sample / 8);
+        // read ogg audio
+        size_t pos  = 0;
+        size_t step = 4096;
+        while (true)
+        {
+            if (data.size() <= pos)
+            {
+                data.resize(pos + step);
+            }
+            const size_t buffer_size = std::min(step, data.size() - pos);
 
-    // Get the audio total duration (in microseconds)
-    auto duration = static_cast<std::uintmax_t>(math::Ceil(ov_time_total(&vf, -1) * 1e6));
+            int bytes_read = DecodePCM(data.data() + pos, uint32_t(buffer_size));
+            if (bytes_read == 0)
+                break;
+            if (bytes_read < 0)
+                return nullptr;
+            pos += bytes_read;
+        }
 
-    // allocate buffer
-    std::vector<char> data;
+        RefPtr<AudioData> output = new OggAudioData(std::move(data), uint32_t(pos), meta_);
+        return output;
+    }
 
-    const size_t expected_size = size_t(((duration * meta.avg_bytes_per_sec())) / 1000000) + 1;
-    data.resize(expected_size);
+protected:
+    bool Init(int err)
+    {
+        if (err != 0)
+        {
+            KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+            return false;
+        }
+        opened_ = true;
+
+        // read metadata
+        vorbis_info* vi = ov_info(&vf_, -1);
+
+        meta_.samples_per_sec = uint32_t(vi->rate);
+        meta_.channels        = uint16_t(vi->channels);
+        meta_.bits_per_sample = uint16_t(16);  // the 'word' param of ov_read sets to 2, which means 16-bits samples.
+        meta_.block_align     = uint16_t(meta_.channels * meta_.bits_per_sample / 8);
+
+        // Get the audio total duration (in milliseconds)
+        duration_ = Duration(static_cast<int64_t>(std::ceil(ov_time_total(&vf_, -1) * 1e3)));
+        return true;
+    }
 
-    // read ogg audio
-    size_t pos  = 0;
-    size_t step = 4096;
-    int    bitstream;
-    while (true)
+    int DecodePCM(char* buffer, uint32_t size) override
     {
-        if (data.size() <= pos)
+        int bitstream  = 0;
+        int bytes_read = OV_HOLE;
+        while (bytes_read == OV_HOLE)
         {
-            data.resize(pos + step);
+            // OV_HOLE only reports an interruption in the data, just go on reading
+            bytes_read = ov_read(&vf_, buffer, int(size), 0, 2, 1, &bitstream);
         }
-        const size_t buffer_size = std::min(step, data.size() - pos);
 
-        int bytes_read = ov_read(&vf, data.data() + pos, int(buffer_size), 0, 2, 1, &bitstream);
-        if (bytes_read == 0)
-            break;
         if (bytes_read < 0)
         {
             KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, bytes_read, "Decode ogg audio failed"));
-            return nullptr;
         }
-        pos += bytes_read;
+        return bytes_read;
+    }
+
+    bool SeekPCM(Duration pos) override
+    {
+        int err = ov_time_seek(&vf_, double(pos.GetMilliseconds()) / 1e3);
+        if (err != 0)
+        {
+            KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Seek ogg audio failed"));
+            return false;
+        }
+        return true;
     }
-    ov_clear(&vf);
 
-    RefPtr<AudioData> output = new OggAudioData(std::move(data), uint32_t(pos), meta);
-    return output;
+private:
+    bool            opened_;
+    String          file_path_;
+    OggMemorySource source_;
+    OggVorbis_File  vf_;
+};
+
+OggTranscoder::OggTranscoder()
+    : streaming_threshold_(time::Second * 10)
+{
+}
+
+RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
+{
+    RefPtr<OggStreamAudioData> stream = MakePtr<OggStreamAudioData>();
+    if (!stream->Open(file_path))
+    {
+        return nullptr;
+    }
+
+    if (stream->GetDuration() > streaming_threshold_)
+    {
+        return stream;
+    }
+    return stream->DecodeAll();
 }
 
 RefPtr<AudioData> OggTranscoder::Decode(const Resource& res)
 {
-    KGE_ERROR("Loading audio from memory resource is not supported for OggTranscoder");
-    return nullptr;
+    BinaryData data = res.GetData();
+    if (!data.IsValid())
+    {
+        KGE_ERROR("Load ogg audio from resource failed");
+        return nullptr;
+    }
+    return Decode(data);
+}
+
+RefPtr<AudioData> OggTranscoder::Decode(const BinaryData& data)
+{
+
+    RefPtr<OggStreamAudioData> stream = MakePtr<OggStreamAudioData>();
+    if (!stream->Open(data))
+    {
+        return nullptr;
+    }
+
+    if (stream->GetDuration() > streaming_threshold_)
+    {
+        return stream;
+    }
+    return stream->DecodeAll();
 }
 
 }  // namespace audio
@@ -38,11 +38,37 @@ namespace audio
 class KGE_API OggTranscoder : public Transcoder
 {
 public:
+    OggTranscoder();
+
     RefPtr<AudioData> Decode(StringView file_path) override;
 
     RefPtr<AudioData> Decode(const Resource& res) override;
+
+    RefPtr<AudioData> Decode(const BinaryData& data) override;
+
+    /// \~chinese
+    /// @brief ʽʱֵ
+    /// @details ʱֵƵʽƵ StreamAudioDataʱ
+    void SetStreamingThreshold(Duration threshold);
+
+    /// \~chinese
+    /// @brief ȡʽʱֵ
+    Duration GetStreamingThreshold() const;
+
+private:
+    Duration streaming_threshold_;
 };
 
+inline void OggTranscoder::SetStreamingThreshold(Duration threshold)
+{
+    streaming_threshold_ = threshold;
+}
+
+inline Duration OggTranscoder::GetStreamingThreshold() const
+{
+    return streaming_threshold_;
+}
+
 /** @} */
 
 }  // namespace audio
@@ -28,6 +28,18 @@ namespace kiwano
 namespace audio
 {
 
+namespace
+{
+
+enum StreamChunkFlag : uint8_t
+{
+    StreamChunkFirst     = 1 << 0,  // first chunk after Play
+    StreamChunkLoopStart = 1 << 1,  // first chunk of a new loop
+    StreamChunkLast      = 1 << 2,  // last chunk of the stream
+};
+
+}  // namespace
+
 Sound::Sound(StringView file_path)
     : Sound()
 {
@@ -50,6 +62,13 @@ Sound::Sound()
     : opened_(false)
     , playing_(false)
     , volume_(1.f)
+    , stream_active_(false)
+    , stream_loop_count_(0)
+    , stream_token_(0)
+    , stream_submitted_(0)
+    , stream_finished_(0)
+    , stream_pending_jobs_(0)
+    , stream_chunk_flags_{}
 {
 }
 
@@ -69,6 +88,17 @@ bool Sound::Load(RefPtr<AudioData> data)
     {
         Close();
     }
+
+    if (data->IsStreaming())
+    {
+        // the decoder keeps a read position, so sounds sharing the data need decoders of their own
+        data = static_cast<StreamAudioData*>(data.Get())->Clone();
+        if (!data)
+        {
+            return false;
+        }
+    }
+
     if (!Module::GetInstance().CreateSound(*this, data))
     {
         return false;
@@ -102,15 +132,52 @@ void Sound::Play(int loop_count)
     // clamp loop count
     loop_count = (loop_count < 0) ? XAUDIO2_LOOP_INFINITE : std::min(loop_count, XAUDIO2_LOOP_INFINITE - 1);
 
-    auto data = data_->GetData();
+    HRESULT hr = S_OK;
+    if (data_->IsStreaming())
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
 
-    XAUDIO2_BUFFER xaudio2_buffer = { 0 };
-    xaudio2_buffer.pAudioData     = reinterpret_cast<BYTE*>(data.buffer);
-    xaudio2_buffer.Flags          = XAUDIO2_END_OF_STREAM;
-    xaudio2_buffer.AudioBytes     = UINT32(data.size);
-    xaudio2_buffer.LoopCount      = static_cast<uint32_t>(loop_count);
+        auto stream = static_cast<StreamAudioData*>(data_.Get());
+        if (!stream->Seek(0))
+        {
+            hr = E_FAIL;
+        }
+
+        // A new token makes callbacks of flushed buffers from the last playback be ignored
+        if (++stream_token_ == 0)
+            ++stream_token_;
+
+        stream_active_     = SUCCEEDED(hr);
+        stream_loop_count_ = loop_count;
+        stream_submitted_  = 0;
+        stream_finished_   = 0;
+
+        // Queue the whole ring, later chunks are decoded when a queued chunk ends
+        for (uint32_t i = 0; i < StreamAudioData::CHUNK_COUNT; ++i)
+        {
+            if (!SubmitStreamChunk())
+                break;
+        }
+
+        if (stream_submitted_ == 0)
+        {
+            stream_active_ = false;
+            hr             = E_FAIL;
+        }
+    }
+    else
+    {
+        auto data = data_->GetData();
+
+        XAUDIO2_BUFFER xaudio2_buffer = { 0 };
+        xaudio2_buffer.pAudioData     = reinterpret_cast<BYTE*>(data.buffer);
+        xaudio2_buffer.Flags          = XAUDIO2_END_OF_STREAM;
+        xaudio2_buffer.AudioBytes     = UINT32(data.size);
+        xaudio2_buffer.LoopCount      = static_cast<uint32_t>(loop_count);
+
+        hr = voice->SubmitSourceBuffer(&xaudio2_buffer);
+    }
 
-    HRESULT hr = voice->SubmitSourceBuffer(&xaudio2_buffer);
     if (SUCCEEDED(hr))
     {
         hr = voice->Start();
@@ -159,6 +226,11 @@ void Sound::Stop()
     auto voice = GetNative<IXAudio2SourceVoice*>();
     KGE_ASSERT(voice != nullptr && "IXAudio2SourceVoice* is NULL");
 
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        stream_active_ = false;
+    }
+
     HRESULT hr = voice->Stop();
 
     if (SUCCEEDED(hr))
@@ -178,6 +250,11 @@ void Sound::Stop()
 
 void Sound::Close()
 {
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        stream_active_ = false;
+    }
+
     auto voice = GetNative<IXAudio2SourceVoice*>();
     if (voice)
     {
@@ -186,6 +263,12 @@ void Sound::Close()
         voice->DestroyVoice();
     }
 
+    {
+        // no more jobs are queued after the voice is destroyed, wait for the queued ones to see the sound stopped
+        std::unique_lock<std::mutex> lock(stream_mutex_);
+        stream_cond_.wait(lock, [this]() { return stream_pending_jobs_ == 0; });
+    }
+
     data_    = nullptr;
     opened_  = false;
     playing_ = false;
@@ -239,6 +322,130 @@ void Sound::ResetVolume()
     SetVolume(old_volume);
 }
 
+bool Sound::SubmitStreamChunk()
+{
+    if (!stream_active_ || stream_submitted_ - stream_finished_ >= StreamAudioData::CHUNK_COUNT)
+        return false;
+
+    auto voice  = GetNative<IXAudio2SourceVoice*>();
+    auto stream = static_cast<StreamAudioData*>(data_.Get());
+
+    uint8_t flags = (stream_submitted_ == 0) ? StreamChunkFirst : 0;
+
+    BinaryData chunk = stream->ReadChunk();
+    if (!chunk.IsValid() && stream->IsEndOfStream() && stream_loop_count_ != 0)
+    {
+        // Rewind for the next loop
+        if (stream_loop_count_ != XAUDIO2_LOOP_INFINITE)
+            --stream_loop_count_;
+
+        if (stream->Seek(0))
+        {
+            flags |= StreamChunkLoopStart;
+            chunk = stream->ReadChunk();
+        }
+    }
+
+    if (!chunk.IsValid())
+    {
+        // The stream ended right after the last submitted chunk
+        if (stream_submitted_ != stream_finished_)
+        {
+            stream_chunk_flags_[(stream_submitted_ - 1) % StreamAudioData::CHUNK_COUNT] |= StreamChunkLast;
+            voice->Discontinuity();
+        }
+        else
+        {
+            stream_active_ = false;
+        }
+        return false;
+    }
+
+    const bool last = stream->IsEndOfStream() && stream_loop_count_ == 0;
+    if (last)
+        flags |= StreamChunkLast;
+
+    XAUDIO2_BUFFER xaudio2_buffer = { 0 };
+    xaudio2_buffer.pAudioData     = reinterpret_cast<BYTE*>(chunk.buffer);
+    xaudio2_buffer.Flags          = last ? XAUDIO2_END_OF_STREAM : 0;
+    xaudio2_buffer.AudioBytes     = UINT32(chunk.size);
+    xaudio2_buffer.pContext       = reinterpret_cast<void*>(stream_token_);
+
+    stream_chunk_flags_[stream_submitted_ % StreamAudioData::CHUNK_COUNT] = flags;
+
+    HRESULT hr = voice->SubmitSourceBuffer(&xaudio2_buffer);
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Submitting source buffer failed with HRESULT of %08X", hr);
+        return false;
+    }
+
+    ++stream_submitted_;
+    return !last;
+}
+
+void Sound::OnStreamChunkStart(void* token)
+{
+    uint8_t flags = 0;
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        if (!stream_active_ || token != reinterpret_cast<void*>(stream_token_))
+            return;
+
+        flags = stream_chunk_flags_[stream_finished_ % StreamAudioData::CHUNK_COUNT];
+    }
+
+    if (flags & StreamChunkFirst)
+        GetCallbackChain()->OnStart(this);
+
+    if (flags & StreamChunkLoopStart)
+        GetCallbackChain()->OnLoopEnd(this);
+}
+
+void Sound::OnStreamChunkEnd(void* token)
+{
+    uint8_t flags = 0;
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        if (!stream_active_ || token != reinterpret_cast<void*>(stream_token_))
+            return;
+
+        flags = stream_chunk_flags_[stream_finished_ % StreamAudioData::CHUNK_COUNT];
+        ++stream_finished_;
+
+        if (flags & StreamChunkLast)
+        {
+            stream_active_ = false;
+        }
+        else
+        {
+            // decoding takes a while and XAudio2 callbacks should return quickly, so decode on another thread.
+            // Close() waits for the pending jobs, so the job does not need to hold the sound
+            ++stream_pending_jobs_;
+
+            Sound*    self  = this;
+            uintptr_t token = stream_token_;
+            if (!Module::GetInstance().PerformStreamDecoding([self, token]() { self->DecodeStreamChunk(token); }))
+                --stream_pending_jobs_;
+        }
+    }
+
+    if (flags & StreamChunkLast)
+        GetCallbackChain()->OnEnd(this);
+}
+
+void Sound::DecodeStreamChunk(uintptr_t token)
+{
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+
+    // the sound may be stopped or played again since the job was queued
+    if (stream_active_ && token == stream_token_)
+        SubmitStreamChunk();
+
+    if (--stream_pending_jobs_ == 0)
+        stream_cond_.notify_all();
+}
+
 RefPtr<SoundCallback> Sound::GetCallbackChain()
 {
     class SoundCallbackChain : public SoundCallback
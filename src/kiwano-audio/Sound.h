@@ -21,6 +21,8 @@
 #pragma once
 #include <kiwano/core/Resource.h>
 #include <kiwano-audio/AudioData.h>
+#include <condition_variable>
+#include <mutex>
 
 namespace kiwano
 {
@@ -86,6 +88,7 @@ class KGE_API Sound : public NativeObject
 {
     friend class Module;
     friend class SoundPlayer;
+    friend class VoiceCallback;
 
 public:
     /// \~chinese
@@ -101,7 +104,7 @@ public:
 
     /// \~chinese
     /// @brief Ƶ
-    /// @param data Ƶ
+    /// @param data ƵݣʽƵݻᱻƳĽ˿ԱƵ
     Sound(RefPtr<AudioData> data);
 
     Sound();
@@ -161,12 +164,38 @@ protected:
 
     void ResetVolume();
 
+    /// \~chinese
+    /// @brief 벢ύһʽƵݣǰ stream_mutex_
+    bool SubmitStreamChunk();
+
+    /// \~chinese
+    /// @brief ʽƵݿ鿪ʼ
+    void OnStreamChunkStart(void* token);
+
+    /// \~chinese
+    /// @brief ʽƵݿ鲥Ž
+    void OnStreamChunkEnd(void* token);
+
+    /// \~chinese
+    /// @brief ʽ߳н벢ύһ
+    void DecodeStreamChunk(uintptr_t token);
+
 private:
     bool              opened_;
     bool              playing_;
     float             volume_;
     RefPtr<AudioData> data_;
 
+    std::mutex              stream_mutex_;
+    std::condition_variable stream_cond_;
+    bool                    stream_active_;
+    int                     stream_loop_count_;
+    uintptr_t               stream_token_;
+    uint32_t                stream_submitted_;
+    uint32_t                stream_finished_;
+    uint32_t                stream_pending_jobs_;
+    uint8_t                 stream_chunk_flags_[StreamAudioData::CHUNK_COUNT];
+
     RefPtr<SoundCallback>       callback_chain_;
     List<RefPtr<SoundCallback>> callbacks_;
 };
@@ -46,6 +46,11 @@ public:
     virtual RefPtr<AudioData> Decode(StringView file_path) = 0;
 
     virtual RefPtr<AudioData> Decode(const Resource& res) = 0;
+
+    /// \~chinese
+    /// @brief ڴнƵ
+    /// @details ʽƵݻ data豣֤ƵǰЧ
+    virtual RefPtr<AudioData> Decode(const BinaryData& data) = 0;
 };
 
 /** @} */
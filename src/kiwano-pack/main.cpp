@@ -0,0 +1,134 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <kiwano/platform/ArchiveFormat.h>
+
+using namespace kiwano;
+
+namespace
+{
+void PrintUsage()
+{
+    std::printf("usage: kiwano-pack <output-file> <input-directory> [--store]\n");
+    std::printf("  Packs every file under <input-directory> into <output-file>.\n");
+    std::printf("  Files are named by their path relative to <input-directory>.\n");
+    std::printf("  --store  save files without compression\n");
+}
+
+bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data)
+{
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs)
+        return false;
+
+    const auto size = ifs.tellg();
+    if (size < 0)
+        return false;
+
+    data.resize(size_t(size));
+    ifs.seekg(0);
+    return size == 0 || bool(ifs.read(reinterpret_cast<char*>(data.data()), size));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const char* output   = argv[1];
+    const char* input    = argv[2];
+    bool        compress = true;
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--store") == 0)
+        {
+            compress = false;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::error_code       ec;
+    std::filesystem::path root(input);
+    if (!std::filesystem::is_directory(root, ec))
+    {
+        std::fprintf(stderr, "kiwano-pack: '%s' is not a directory\n", input);
+        return 1;
+    }
+
+    std::vector<archive::PackedFile> files;
+    uint64_t                         total_size = 0;
+
+    for (auto iter = std::filesystem::recursive_directory_iterator(root, ec);
+         iter != std::filesystem::recursive_directory_iterator(); iter.increment(ec))
+    {
+        if (ec)
+            break;
+        if (!iter->is_regular_file(ec))
+            continue;
+
+        std::vector<uint8_t> data;
+        if (!ReadFile(iter->path(), data))
+        {
+            std::fprintf(stderr, "kiwano-pack: failed to read '%s'\n", iter->path().string().c_str());
+            return 1;
+        }
+
+        if (data.size() > UINT32_MAX)
+        {
+            std::fprintf(stderr, "kiwano-pack: '%s' is too large\n", iter->path().string().c_str());
+            return 1;
+        }
+
+        std::string name = std::filesystem::relative(iter->path(), root, ec).generic_string();
+        files.push_back(archive::PackFile(name, data.data(), data.size(), compress));
+        total_size += data.size();
+    }
+
+    if (ec)
+    {
+        std::fprintf(stderr, "kiwano-pack: failed to scan '%s': %s\n", input, ec.message().c_str());
+        return 1;
+    }
+
+    std::vector<uint8_t> output_data = archive::Build(files);
+
+    std::ofstream ofs(output, std::ios::binary);
+    if (!ofs || !ofs.write(reinterpret_cast<const char*>(output_data.data()), std::streamsize(output_data.size())))
+    {
+        std::fprintf(stderr, "kiwano-pack: failed to write '%s'\n", output);
+        return 1;
+    }
+
+    std::printf("packed %u files, %llu bytes -> %u bytes\n", unsigned(files.size()),
+                (unsigned long long)total_size, unsigned(output_data.size()));
+    return 0;
+}
@@ -29,18 +29,44 @@ namespace physics
 Body::Body(b2Body* body, b2World* world)
     : b2body_(body)
     , b2world_(world)
+    , world_(nullptr)
+    , angle_cached_(0.f)
+    , rotation_cached_(0.f)
+    , parent_cached_(nullptr)
+    , parent_rotation_cached_(0.f)
 {
     SetName(KGE_COMP_PHYSIC_BODY);
 
     body->SetUserData(this);
 }
 
-Body::~Body() {}
+Body::~Body()
+{
+    if (world_)
+    {
+        world_->DetachBody(this);
+    }
+
+    // the world looks for unregistered bodies through the user data
+    if (b2body_)
+    {
+        b2body_->SetUserData(nullptr);
+    }
+}
 
 void Body::InitComponent(Actor* actor)
 {
     Component::InitComponent(actor);
 
+    if (!world_)
+    {
+        World* world = FindWorld(actor);
+        if (world)
+        {
+            world->AttachBody(this);
+        }
+    }
+
     UpdateFromActor(actor);
 }
 
@@ -49,16 +75,43 @@ void Body::DestroyComponent()
     // Detach from actor first
     Component::DestroyComponent();
 
+    if (world_)
+    {
+        world_->DetachBody(this);
+    }
+
     if (b2body_ && b2world_)
     {
         b2world_->DestroyBody(b2body_);
+        b2body_ = nullptr;
     }
 }
 
-void Body::BeforeSimulation(Actor* actor, const Matrix3x2& parent_to_world, const Matrix3x2& actor_to_world,
-                                  float parent_rotation)
+void Body::BeforeSimulation(Actor* world_actor)
 {
-    UpdateFromActor(actor, actor_to_world, parent_rotation + actor->GetRotation());
+    Actor* actor = GetBoundActor();
+
+    Matrix3x2 parent_to_world;
+    float     parent_rotation = 0.0f;
+    if (!actor || !GetParentTransform(world_actor, parent_to_world, parent_rotation))
+    {
+        // the actor left the world subtree, register it again after it comes back
+        if (world_)
+            world_->DetachBody(this);
+        return;
+    }
+
+    Matrix3x2 actor_to_world = actor->GetTransformMatrixToParent() * parent_to_world;
+    float     rotation       = parent_rotation + actor->GetRotation();
+
+    // Static and sleeping bodies do not move, skip them until the actor is moved
+    if (b2body_->GetType() == b2_staticBody || !b2body_->IsAwake())
+    {
+        if (transform_cached_ == actor_to_world && rotation_cached_ == rotation)
+            return;
+    }
+
+    UpdateFromActor(actor, actor_to_world, rotation);
 
     /*if (actor->GetAnchor() != Vec2(0.5f, 0.5f))
     {
@@ -68,9 +121,21 @@ void Body::BeforeSimulation(Actor* actor, const Matrix3x2& parent_to_world, cons
     }*/
 }
 
-void Body::AfterSimulation(Actor* actor, const Matrix3x2& parent_to_world, float parent_rotation)
+void Body::AfterSimulation(Actor* world_actor)
 {
+    Actor* actor = GetBoundActor();
+    if (!actor || b2body_->GetType() == b2_staticBody)
+        return;
+
     Point position_in_parent = WorldToLocal(b2body_->GetPosition());
+    if (!b2body_->IsAwake() && position_cached_ == position_in_parent && angle_cached_ == b2body_->GetAngle())
+        return;
+
+    Matrix3x2 parent_to_world;
+    float     parent_rotation = 0.0f;
+    if (!GetParentTransform(world_actor, parent_to_world, parent_rotation))
+        return;
+
     if (position_cached_ != position_in_parent)
     {
         /*position_in_parent = parent_to_world.Invert().Transform(position_in_parent);
@@ -92,7 +157,7 @@ void Body::UpdateFromActor(Actor* actor)
     Actor* ptr = actor;
     while (ptr)
     {
-        auto world = dynamic_cast<World*>(ptr->GetComponent(KGE_COMP_PHYSIC_WORLD));
+        auto world = ptr->GetComponent<World>();
         if (world && world->GetB2World() == b2body_->GetWorld())
         {
             break;
@@ -106,6 +171,67 @@ void Body::UpdateFromActor(Actor* actor)
     UpdateFromActor(actor, transform_to_world, rotation);
 }
 
+bool Body::GetParentTransform(Actor* world_actor, Matrix3x2& parent_to_world, float& parent_rotation)
+{
+    Actor* actor = GetBoundActor();
+    if (!actor || actor == world_actor)
+        return false;
+
+    Actor* parent = actor->GetParent();
+    if (!parent)
+        return false;
+
+    // Both world matrices are recomputed only when the actors or their ancestors are dirty.
+    // The walk below is needed only after one of them is moved or the actor is re-parented.
+    const Matrix3x2& parent_matrix = parent->GetTransformMatrix();
+    const Matrix3x2& world_matrix  = world_actor->GetTransformMatrix();
+    if (parent == parent_cached_ && parent_matrix == parent_matrix_cached_ && world_matrix == world_matrix_cached_)
+    {
+        parent_to_world = parent_to_world_cached_;
+        parent_rotation = parent_rotation_cached_;
+        return true;
+    }
+
+    parent_cached_ = nullptr;
+
+    Actor* ptr = parent;
+    while (ptr != world_actor)
+    {
+        if (!ptr)
+        {
+            // The actor is not in the world
+            return false;
+        }
+
+        parent_rotation += ptr->GetRotation();
+        parent_to_world *= ptr->GetTransformMatrixToParent();
+
+        ptr = ptr->GetParent();
+    }
+
+    parent_cached_          = parent;
+    parent_rotation_cached_ = parent_rotation;
+    parent_matrix_cached_   = parent_matrix;
+    world_matrix_cached_    = world_matrix;
+    parent_to_world_cached_ = parent_to_world;
+    return true;
+}
+
+World* Body::FindWorld(Actor* actor) const
+{
+    Actor* ptr = actor;
+    while (ptr)
+    {
+        auto world = ptr->GetComponent<World>();
+        if (world && world->GetB2World() == b2body_->GetWorld())
+        {
+            return world;
+        }
+        ptr = ptr->GetParent();
+    }
+    return nullptr;
+}
+
 void Body::UpdateFromActor(Actor* actor, const Matrix3x2& actor_to_world, float rotation)
 {
     /*Point center   = actor->GetSize() / 2;
@@ -115,7 +241,10 @@ void Body::UpdateFromActor(Actor* actor, const Matrix3x2& actor_to_world, float
     Point position = actor_to_world.Transform(Point(anchor.x * size.x, anchor.y * size.y));
     b2body_->SetTransform(LocalToWorld(position), math::Degree2Radian(rotation));
 
-    position_cached_ = WorldToLocal(b2body_->GetPosition());
+    position_cached_  = WorldToLocal(b2body_->GetPosition());
+    angle_cached_     = b2body_->GetAngle();
+    rotation_cached_  = rotation;
+    transform_cached_ = actor_to_world;
 }
 
 Point Body::GetLocalPoint(const Point& world) const
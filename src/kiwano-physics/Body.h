@@ -37,9 +37,14 @@ class World;
 
 /// \~chinese
 /// @brief 
-class KGE_API Body : public Component
+class KGE_API Body
+    : public Component
+    , protected IntrusiveListValue<Body*>
 {
+    KGE_COMPONENT_TYPE(Body, Component)
+
     friend class World;
+    friend IntrusiveList<Body*>;
 
 public:
     /// \~chinese
@@ -89,19 +94,44 @@ protected:
 
     /// \~chinese
     /// @brief ǰ
-    void BeforeSimulation(Actor* actor, const Matrix3x2& parent_to_world, const Matrix3x2& actor_to_world,
-                          float parent_rotation);
+    /// @details ̬ߵڽɫ任δıʱͬ
+    /// @param world_actor ڵĽɫ
+    void BeforeSimulation(Actor* world_actor);
 
     /// \~chinese
     /// @brief 
-    void AfterSimulation(Actor* actorconst, const Matrix3x2& parent_to_world, float parent_rotation);
+    /// @param world_actor ڵĽɫ
+    void AfterSimulation(Actor* world_actor);
+
+    /// \~chinese
+    /// @brief ȡɫı任
+    /// @details ڸɫڽɫ任ıǰֻ棬ߵ任ɽɫά
+    /// @param world_actor ڵĽɫ
+    /// @param[out] parent_to_world ɫı任
+    /// @param[out] parent_rotation ɫеתǶ
+    /// @return ɫʱ false
+    bool GetParentTransform(Actor* world_actor, Matrix3x2& parent_to_world, float& parent_rotation);
+
+    /// \~chinese
+    /// @brief ҽɫڵ
+    World* FindWorld(Actor* actor) const;
 
 private:
     b2World* b2world_;
     b2Body*  b2body_;
+    World*   world_;
 
     // Point offset_;
-    Point position_cached_;
+    Point     position_cached_;
+    float     angle_cached_;
+    float     rotation_cached_;
+    Matrix3x2 transform_cached_;
+
+    Actor*    parent_cached_;
+    float     parent_rotation_cached_;
+    Matrix3x2 parent_matrix_cached_;
+    Matrix3x2 world_matrix_cached_;
+    Matrix3x2 parent_to_world_cached_;
 };
 
 /** @} */
@@ -19,6 +19,8 @@
 // THE SOFTWARE.
 
 #include <kiwano-physics/World.h>
+#include <kiwano/event/EventPool.h>
+#include <kiwano/utils/Profiler.h>
 
 namespace kiwano
 {
@@ -150,7 +152,7 @@ public:
 
     void BeginContact(b2Contact* b2contact) override
     {
-        RefPtr<ContactBeginEvent> evt = new ContactBeginEvent(b2contact);
+        RefPtr<ContactBeginEvent> evt = EventPool<ContactBeginEvent>::Acquire(b2contact);
         dispatcher_(evt.Get());
     }
 
@@ -164,7 +166,7 @@ public:
             return;
         }
 
-        RefPtr<ContactEndEvent> evt = new ContactEndEvent(b2contact);
+        RefPtr<ContactEndEvent> evt = EventPool<ContactEndEvent>::Acquire(b2contact);
         dispatcher_(evt.Get());
     }
 
@@ -186,6 +188,7 @@ World::World(const b2Vec2& gravity)
     , vel_iter_(6)
     , pos_iter_(2)
     , fixed_acc_(0.f)
+    , body_count_(0)
 {
     SetName(KGE_COMP_PHYSIC_WORLD);
 
@@ -196,12 +199,22 @@ World::World(const b2Vec2& gravity)
 World::~World()
 {
     world_.SetContactListener(nullptr);
+
+    for (Body* body = bodies_.GetFirst(); body; body = body->GetNext())
+    {
+        body->world_ = nullptr;
+    }
+    bodies_.Clear();
+    body_count_ = 0;
 }
 
 RefPtr<Body> World::AddBody(b2BodyDef* def)
 {
     b2Body* body = world_.CreateBody(def);
-    return MakePtr<Body>(body, &world_);
+
+    // the body is registered when it is bound to an actor in this world
+    RefPtr<Body> ptr = MakePtr<Body>(body, &world_);
+    return ptr;
 }
 
 b2Joint* World::AddJoint(b2JointDef* def)
@@ -229,15 +242,14 @@ void World::InitComponent(Actor* actor)
     Component::InitComponent(actor);
 
     // Update body status
-    Actor* world_actor = GetBoundActor();
-    BeforeSimulation(world_actor, Matrix3x2(), 0.0f);
+    BeforeSimulation();
 }
 
 void World::OnUpdate(Duration dt)
 {
-    Actor* world_actor = GetBoundActor();
+    KGE_PROFILE_ZONE("physics::World::OnUpdate");
 
-    BeforeSimulation(world_actor, Matrix3x2(), 0.0f);
+    BeforeSimulation();
 
     // Update physic world
     // The implementation referenced this article. https://www.unagames.com/blog/daniele/2010/06/fixed-time-step-implementation-box2d
@@ -256,7 +268,7 @@ void World::OnUpdate(Duration dt)
         world_.Step(FIXED_TIMESTEP, vel_iter_, pos_iter_);
     }
 
-    AfterSimulation(world_actor, Matrix3x2(), 0.0f);
+    AfterSimulation();
 }
 
 void World::OnRender(RenderContext& ctx)
@@ -280,37 +292,86 @@ void World::DispatchEvent(Event* evt)
     }
 }
 
-void World::BeforeSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation)
+void World::BeforeSimulation()
 {
-    for (auto child : parent->GetAllChildren())
+    Actor* world_actor = GetBoundActor();
+    if (!world_actor)
+        return;
+
+    // some bodies are not registered, their actors may have entered the world subtree
+    if (world_.GetBodyCount() != body_count_)
+        AttachPendingBodies(world_actor);
+
+    Body* next = nullptr;
+    for (Body* body = bodies_.GetFirst(); body; body = next)
     {
-        Matrix3x2 child_to_world = child->GetTransformMatrixToParent() * parent_to_world;
+        next = body->GetNext();
+        body->BeforeSimulation(world_actor);
+    }
+}
 
-        auto body = dynamic_cast<Body*>(child->GetComponent(KGE_COMP_PHYSIC_BODY));
-        if (body)
-        {
-            body->BeforeSimulation(child.Get(), parent_to_world, child_to_world, parent_rotation);
-        }
+void World::AfterSimulation()
+{
+    Actor* world_actor = GetBoundActor();
+    if (!world_actor)
+        return;
 
-        float rotation = parent_rotation + child->GetRotation();
-        BeforeSimulation(child.Get(), child_to_world, rotation);
+    Body* next = nullptr;
+    for (Body* body = bodies_.GetFirst(); body; body = next)
+    {
+        next = body->GetNext();
+        body->AfterSimulation(world_actor);
     }
 }
 
-void World::AfterSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation)
+void World::AttachPendingBodies(Actor* world_actor)
 {
-    for (auto child : parent->GetAllChildren())
+    for (b2Body* b2body = world_.GetBodyList(); b2body; b2body = b2body->GetNext())
     {
-        auto body = dynamic_cast<Body*>(child->GetComponent(KGE_COMP_PHYSIC_BODY));
-        if (body)
+        Body* body = static_cast<Body*>(b2body->GetUserData());
+        if (!body || body->world_ == this)
+            continue;
+
+        // bodies bound to the world actor itself are not synced
+        Actor* actor = body->GetBoundActor();
+        for (Actor* ptr = actor ? actor->GetParent() : nullptr; ptr; ptr = ptr->GetParent())
         {
-            body->AfterSimulation(child.Get(), parent_to_world, parent_rotation);
+            if (ptr == world_actor)
+            {
+                AttachBody(body);
+                break;
+            }
         }
+    }
+}
+
+void World::AttachBody(Body* body)
+{
+    KGE_ASSERT(body);
+
+    if (body->world_ == this)
+        return;
 
-        Matrix3x2 child_to_world = child->GetTransformMatrixToParent() * parent_to_world;
-        float     rotation       = parent_rotation + child->GetRotation();
-        AfterSimulation(child.Get(), child_to_world, rotation);
+    if (body->world_)
+    {
+        body->world_->DetachBody(body);
     }
+
+    body->world_ = this;
+    bodies_.PushBack(body);
+    ++body_count_;
+}
+
+void World::DetachBody(Body* body)
+{
+    KGE_ASSERT(body);
+
+    if (body->world_ != this)
+        return;
+
+    bodies_.Remove(body);
+    body->world_ = nullptr;
+    --body_count_;
 }
 
 void World::ShowDebugInfo(bool show)
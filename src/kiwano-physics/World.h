@@ -45,6 +45,8 @@ namespace physics
  */
 class KGE_API World : public Component
 {
+    KGE_COMPONENT_TYPE(World, Component)
+
     friend class Body;
     friend class Joint;
 
@@ -58,6 +60,7 @@ public:
 
     /// \~chinese
     /// @brief 
+    /// @details ڰ󶨵Ľɫڽɫͬ
     RefPtr<Body> AddBody(b2BodyDef* def);
 
     /// \~chinese
@@ -107,11 +110,24 @@ protected:
 
     /// \~chinese
     /// @brief ǰ
-    void BeforeSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation);
+    void BeforeSimulation();
+
+    /// \~chinese
+    /// @brief Ǽǰ󶨵Ľɫѽ
+    /// @param world_actor ڵĽɫ
+    void AttachPendingBodies(Actor* world_actor);
 
     /// \~chinese
     /// @brief 
-    void AfterSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation);
+    void AfterSimulation();
+
+    /// \~chinese
+    /// @brief Ǽ
+    void AttachBody(Body* body);
+
+    /// \~chinese
+    /// @brief ƳǼ
+    void DetachBody(Body* body);
 
 private:
     int     vel_iter_;
@@ -119,6 +135,9 @@ private:
     float   fixed_acc_;
     b2World world_;
 
+    IntrusiveList<Body*> bodies_;
+    int                  body_count_;
+
     class DebugDrawer;
     std::unique_ptr<DebugDrawer> drawer_;
 
@@ -19,7 +19,9 @@
 // THE SOFTWARE.
 
 #include <kiwano/2d/Actor.h>
+#include <kiwano/2d/ParallelUpdater.h>
 #include <kiwano/2d/Stage.h>
+#include <kiwano/2d/TransformStore.h>
 #include <kiwano/base/Director.h>
 #include <kiwano/utils/Logger.h>
 #include <kiwano/render/Renderer.h>
@@ -32,8 +34,86 @@ namespace
 float default_anchor_x = 0.f;
 float default_anchor_y = 0.f;
 
+// Actors removed from their parent while any ChildWalker is alive are kept here,
+// so that an actor removing itself or its siblings in OnUpdate won't be destroyed
+// in the middle of the walk. Independent subtrees are walked on worker threads, so
+// the bookkeeping is per thread
+thread_local int                   walking_depth = 0;
+thread_local Vector<RefPtr<Actor>> removed_while_walking;
+
 }  // namespace
 
+struct Actor::TransformBatch
+{
+    TransformStore store;
+    Vector<Actor*> nodes;
+};
+
+struct Actor::BitmapCache
+{
+    RefPtr<Texture>       texture;
+    RefPtr<RenderContext> ctx;
+    PixelSize             capacity;
+    Rect                  bounds;
+    float                 opacity = 1.f;
+};
+
+class Actor::ChildWalker
+{
+public:
+    ChildWalker(const Actor* parent)
+        : parent_(parent)
+        , current_(nullptr)
+        , next_(parent->children_.GetFirst().Get())
+        , version_(parent->children_version_)
+        , stamp_(++parent->walk_serial_)
+    {
+        ++walking_depth;
+    }
+
+    ~ChildWalker()
+    {
+        --walking_depth;
+        if (walking_depth == 0 && !removed_while_walking.empty())
+        {
+            // release actors after the list is cleared, as their destructors may remove other actors
+            Vector<RefPtr<Actor>> removed;
+            removed.swap(removed_while_walking);
+        }
+    }
+
+    Actor* Next()
+    {
+        if (parent_->children_version_ != version_)
+        {
+            // the child list was changed by a callback, the saved sibling may have been removed or moved,
+            // so restart from the first child and skip the children already visited by this walk
+            version_ = parent_->children_version_;
+            next_    = parent_->children_.GetFirst().Get();
+        }
+
+        while (next_ && next_->walk_stamp_ == stamp_)
+        {
+            next_ = next_->GetNext().Get();
+        }
+
+        current_ = next_;
+        if (current_)
+        {
+            current_->walk_stamp_ = stamp_;
+            next_                 = current_->GetNext().Get();
+        }
+        return current_;
+    }
+
+private:
+    const Actor* parent_;
+    Actor*       current_;
+    Actor*       next_;
+    uint32_t     version_;
+    uint32_t     stamp_;
+};
+
 void Actor::SetDefaultAnchor(float anchor_x, float anchor_y)
 {
     default_anchor_x = anchor_x;
@@ -47,14 +127,22 @@ Actor::Actor()
     , update_pausing_(false)
     , cascade_opacity_(true)
     , show_border_(false)
-    , dirty_flag_(DirtyFlag::DirtyVisibility)
+    , mouse_clipping_(false)
+    , subtree_culling_(false)
+    , update_independent_(false)
+    , subtree_empty_(true)
+    , dirty_flag_(DirtyFlag::DirtyVisibility | DirtyFlag::DirtyWorldBounds | DirtyFlag::DirtySubtreeBounds)
     , parent_(nullptr)
     , stage_(nullptr)
     , hash_name_(0)
     , z_order_(0)
+    , children_version_(0)
     , opacity_(1.f)
     , displayed_opacity_(1.f)
     , anchor_(default_anchor_x, default_anchor_y)
+    , subtree_size_(1)
+    , walk_serial_(0)
+    , walk_stamp_(0)
 {
 }
 
@@ -72,24 +160,46 @@ void Actor::Update(Duration dt)
         return;
     }
 
-    // update children those are less than 0 in Z-Order
-    RefPtr<Actor> child = children_.GetFirst();
-    while (child)
-    {
-        if (child->GetZOrder() >= 0)
-            break;
+    // consecutive independent subtrees are updated in parallel, in place of their sequential turn
+    bool           parallel = !ParallelUpdater::IsDeferring() && ParallelUpdater::GetInstance().IsEnabled();
+    Vector<Actor*> roots;
 
-        child->Update(dt);
-        child = child->GetNext();
-    }
+    auto update_roots = [&]() {
+        if (roots.empty())
+            return;
 
-    UpdateSelf(dt);
+        // make sure workers only read the shared ancestors
+        UpdateTransformUpwards();
+        ParallelUpdater::GetInstance().Update(roots, dt);
+        roots.clear();
+    };
 
-    while (child)
+    // update children those are less than 0 in Z-Order first
+    bool        self_updated = false;
+    ChildWalker walker(this);
+    while (Actor* child = walker.Next())
     {
+        if (!self_updated && child->GetZOrder() >= 0)
+        {
+            update_roots();
+            UpdateSelf(dt);
+            self_updated = true;
+        }
+
+        if (parallel && child->update_independent_)
+        {
+            roots.push_back(child);
+            continue;
+        }
+
+        update_roots();
         child->Update(dt);
-        child = child->GetNext();
     }
+
+    update_roots();
+
+    if (!self_updated)
+        UpdateSelf(dt);
 }
 
 void Actor::UpdateSelf(Duration dt)
@@ -117,44 +227,222 @@ void Actor::Render(RenderContext& ctx)
     if (!visible_)
         return;
 
+    if (transform_batch_)
+    {
+        UpdateTransform();
+        UpdateTransformBatch();
+    }
+
+    if (subtree_culling_)
+    {
+        // reject the whole branch with one test
+        UpdateSubtreeBounds();
+        if (subtree_empty_ || !ctx.CheckWorldVisibility(subtree_bounds_))
+        {
+            if (stage_)
+                stage_->culled_actor_count_ += subtree_size_;
+            return;
+        }
+    }
+
     UpdateTransform();
     UpdateOpacity();
 
-    if (children_.IsEmpty())
+    if (bitmap_cache_)
+    {
+        RenderBitmapCache(ctx);
+    }
+    else if (children_.IsEmpty())
     {
-        if (CheckVisibility(ctx))
+        RenderSelf(ctx);
+    }
+    else
+    {
+        RenderChildren(ctx);
+    }
+}
+
+void Actor::RenderChildren(RenderContext& ctx)
+{
+    // render children those are less than 0 in Z-Order first
+    bool        self_rendered = false;
+    ChildWalker walker(this);
+    while (Actor* child = walker.Next())
+    {
+        if (!self_rendered && child->GetZOrder() >= 0)
         {
-            PrepareToRender(ctx);
-            ComponentManager::Render(ctx);
-            OnRender(ctx);
+            RenderSelf(ctx);
+            self_rendered = true;
         }
+        RenderChild(ctx, child);
     }
-    else
+
+    if (!self_rendered)
+        RenderSelf(ctx);
+}
+
+void Actor::RenderChild(RenderContext& ctx, Actor* child)
+{
+    child->Render(ctx);
+}
+
+void Actor::RenderSelf(RenderContext& ctx)
+{
+    if (CheckVisibility(ctx))
+    {
+        PrepareToRender(ctx);
+        ComponentManager::Render(ctx);
+        OnRender(ctx);
+
+        if (stage_)
+            ++stage_->rendered_actor_count_;
+    }
+    else if (stage_)
+    {
+        ++stage_->culled_actor_count_;
+    }
+}
+
+void Actor::RenderBitmapCache(RenderContext& ctx)
+{
+    BitmapCache& cache = *bitmap_cache_;
+
+    // the texture is rendered at full opacity, the displayed opacity is applied when compositing
+    const bool      dirty          = dirty_flag_.Has(DirtyFlag::DirtyContent);
+    const Matrix3x2 world_to_local = transform_matrix_.Invert();
+    if (dirty)
     {
-        // render children those are less than 0 in Z-Order
-        RefPtr<Actor> child = children_.GetFirst();
-        while (child)
+        // bounds of the visible subtree in local space
+        Rect bounds;
+        bool empty = true;
+
+        Vector<const Actor*> stack = { this };
+        while (!stack.empty())
         {
-            if (child->GetZOrder() >= 0)
-                break;
+            const Actor* node = stack.back();
+            stack.pop_back();
 
-            child->Render(ctx);
-            child = child->GetNext();
+            // parents are popped before their children
+            node->UpdateTransform();
+            if (!node->size_.IsOrigin())
+            {
+                Rect local = Matrix3x2(node->transform_matrix_ * world_to_local).Transform(node->GetBounds());
+                bounds     = empty ? local : bounds.Merge(local);
+                empty      = false;
+            }
+
+            for (const auto& child : node->children_)
+            {
+                if (child->visible_)
+                    stack.push_back(child.Get());
+            }
         }
 
-        if (CheckVisibility(ctx))
+        // align to whole pixels
+        cache.bounds = empty ? Rect() : Rect(math::Floor(bounds.GetLeft()), math::Floor(bounds.GetTop()),
+                                             math::Ceil(bounds.GetRight()), math::Ceil(bounds.GetBottom()));
+    }
+
+    if (cache.bounds.IsEmpty() || !ctx.CheckVisibility(cache.bounds, transform_matrix_))
+    {
+        if (stage_)
+            ++stage_->culled_actor_count_;
+        return;
+    }
+
+    if (dirty)
+    {
+        // the texture only grows, the content is drawn into its top-left corner
+        const Size size = cache.bounds.GetSize();
+        if (!cache.ctx || uint32_t(size.x) > cache.capacity.x || uint32_t(size.y) > cache.capacity.y)
+        {
+            cache.capacity = PixelSize(std::max(uint32_t(size.x), cache.capacity.x),
+                                       std::max(uint32_t(size.y), cache.capacity.y));
+            cache.texture  = MakePtr<Texture>();
+            cache.ctx      = RenderContext::Create(cache.texture, cache.capacity);
+        }
+
+        if (!cache.ctx)
+        {
+            Fail("Actor::RenderBitmapCache failed");
+            return;
+        }
+
+        // visibility was evaluated against the other context, and the content flags are cleared before
+        // rendering so that changes made while rendering still invalidate the cache. Nested caches keep
+        // their own flags
+        dirty_flag_.Unset(DirtyFlag::DirtyContent);
+        dirty_flag_.Set(DirtyFlag::DirtyVisibility);
+
+        Vector<Actor*> stack = { this };
+        while (!stack.empty())
+        {
+            Actor* node = stack.back();
+            stack.pop_back();
+
+            for (const auto& child : node->children_)
+            {
+                child->dirty_flag_.Set(DirtyFlag::DirtyVisibility);
+                if (!child->bitmap_cache_)
+                {
+                    child->dirty_flag_.Unset(DirtyFlag::DirtyContent);
+                    stack.push_back(child.Get());
+                }
+            }
+        }
+
+        // the subtree is rendered relative to this actor, see the opacity update below
+        displayed_opacity_ = 1.f;
+        for (const auto& child : children_)
+            child->dirty_flag_.Set(DirtyFlag::DirtyOpacity);
+
+        // actors keep drawing with their world transforms
+        RenderContext& cache_ctx = *cache.ctx;
+        cache_ctx.SetGlobalTransform(world_to_local * Matrix3x2::Translation(-cache.bounds.GetLeftTop()));
+        cache_ctx.BeginDraw();
+        cache_ctx.Clear();
+
+        if (children_.IsEmpty())
+        {
+            RenderSelf(cache_ctx);
+        }
+        else
         {
-            PrepareToRender(ctx);
-            ComponentManager::Render(ctx);
-            OnRender(ctx);
+            RenderChildren(cache_ctx);
         }
 
-        while (child)
+        cache_ctx.EndDraw();
+
+        dirty_flag_.Set(DirtyFlag::DirtyOpacity);
+        UpdateOpacity();
+    }
+
+    // the subtree is not visited again until the content changes, so its displayed opacity is updated here
+    if (dirty || cache.opacity != displayed_opacity_)
+    {
+        cache.opacity = displayed_opacity_;
+
+        Vector<Actor*> stack = { this };
+        while (!stack.empty())
         {
-            child->Render(ctx);
-            child = child->GetNext();
+            Actor* node = stack.back();
+            stack.pop_back();
+
+            node->UpdateOpacity();
+            for (const auto& child : node->children_)
+                stack.push_back(child.Get());
         }
     }
+
+    ctx.IncreaseBitmapCacheCount(!dirty);
+    ctx.SetTransform(transform_matrix_);
+    ctx.SetBrushOpacity(displayed_opacity_);
+
+    const Rect src_rect(Point(), cache.bounds.GetSize());
+    ctx.DrawTexture(*cache.texture, &src_rect, &cache.bounds);
+
+    if (stage_)
+        ++stage_->rendered_actor_count_;
 }
 
 void Actor::PrepareToRender(RenderContext& ctx)
@@ -181,7 +469,8 @@ void Actor::RenderBorder(RenderContext& ctx)
         ctx.DrawRectangle(bounds);
     }
 
-    for (auto& child : children_)
+    ChildWalker walker(this);
+    while (Actor* child = walker.Next())
     {
         child->RenderBorder(ctx);
     }
@@ -199,7 +488,7 @@ bool Actor::CheckVisibility(RenderContext& ctx) const
         }
         else
         {
-            visible_in_rt_ = ctx.CheckVisibility(GetBounds(), transform_matrix_ /* GetTransformMatrix() */);
+            visible_in_rt_ = ctx.CheckWorldVisibility(UpdateWorldBounds());
         }
     }
     return visible_in_rt_;
@@ -256,7 +545,26 @@ void Actor::UpdateTransform() const
     dirty_flag_.Unset(DirtyFlag::DirtyTransform);
     dirty_flag_.Set(DirtyFlag::DirtyTransformInverse);
     dirty_flag_.Set(DirtyFlag::DirtyVisibility);
+    dirty_flag_.Set(DirtyFlag::DirtyWorldBounds);
+
+    UpdateTransformToParent();
 
+    transform_matrix_ = transform_matrix_to_parent_;
+    if (parent_)
+    {
+        transform_matrix_ *= parent_->transform_matrix_;
+    }
+
+    // update children's transform
+    for (const auto& child : children_)
+    {
+        child->dirty_flag_.Set(DirtyFlag::DirtyTransform);
+        child->dirty_flag_.Set(DirtyFlag::DirtySubtreeBounds);
+    }
+}
+
+void Actor::UpdateTransformToParent() const
+{
     if (transform_.IsFast())
     {
         transform_matrix_to_parent_ = Matrix3x2::Translation(transform_.position);
@@ -269,16 +577,191 @@ void Actor::UpdateTransform() const
 
     Point anchor_offset(-size_.x * anchor_.x, -size_.y * anchor_.y);
     transform_matrix_to_parent_.Translate(anchor_offset);
+}
 
-    transform_matrix_ = transform_matrix_to_parent_;
-    if (parent_)
+void Actor::UpdateTransformBatch()
+{
+    TransformStore& store = transform_batch_->store;
+    Vector<Actor*>& nodes = transform_batch_->nodes;
+
+    const bool rebuild = dirty_flag_.Has(DirtyFlag::DirtyStructure);
+    if (rebuild)
     {
-        transform_matrix_ *= parent_->transform_matrix_;
+        dirty_flag_.Unset(DirtyFlag::DirtyStructure);
+
+        // breadth-first, so the nodes of a level are contiguous and do not depend on each other
+        store.Clear();
+        nodes.clear();
+        for (const auto& child : children_)
+        {
+            store.AddNode(TransformStore::NoParent);
+            nodes.push_back(child.Get());
+        }
+
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            Actor* node = nodes[i];
+
+            // nested batches keep their own subtree
+            if (node->transform_batch_)
+                continue;
+
+            node->dirty_flag_.Unset(DirtyFlag::DirtyStructure);
+            for (const auto& child : node->children_)
+            {
+                store.AddNode(uint32_t(i));
+                nodes.push_back(child.Get());
+            }
+        }
     }
 
-    // update children's transform
-    for (const auto& child : children_)
-        child->dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    // gather, the recursive path may have already cleared DirtyTransform of a moved node,
+    // so the local transform is refreshed by its own flag
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        Actor* node = nodes[i];
+        if (rebuild || node->dirty_flag_.Has(DirtyFlag::DirtyLocalTransform))
+        {
+            node->dirty_flag_.Unset(DirtyFlag::DirtyLocalTransform);
+            node->UpdateTransformToParent();
+            store.SetLocal(uint32_t(i), node->transform_matrix_to_parent_);
+        }
+        else if (node->dirty_flag_.Has(DirtyFlag::DirtyTransform))
+        {
+            store.MarkDirty(uint32_t(i));
+        }
+        else if (!node->transform_batch_ && !node->children_.IsEmpty())
+        {
+            // the recursive path may have recomputed the node since the last compose,
+            // so its children are composed from the up-to-date matrix
+            store.SetWorld(uint32_t(i), node->transform_matrix_);
+        }
+    }
+
+    if (store.Compose(transform_matrix_) == 0)
+        return;
+
+    // scatter
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (!store.IsComposed(uint32_t(i)))
+            continue;
+
+        Actor* node             = nodes[i];
+        node->transform_matrix_ = store.GetWorld(uint32_t(i));
+        node->dirty_flag_.Unset(DirtyFlag::DirtyTransform);
+        node->dirty_flag_.Set(DirtyFlag::DirtyTransformInverse);
+        node->dirty_flag_.Set(DirtyFlag::DirtyVisibility);
+        node->dirty_flag_.Set(DirtyFlag::DirtyWorldBounds);
+        node->dirty_flag_.Set(DirtyFlag::DirtySubtreeBounds);
+
+        if (node->transform_batch_)
+        {
+            for (const auto& child : node->children_)
+                child->dirty_flag_.Set(DirtyFlag::DirtyTransform);
+        }
+    }
+}
+
+void Actor::SetTransformBatchingEnabled(bool enabled)
+{
+    if (enabled && !transform_batch_)
+    {
+        transform_batch_.reset(new TransformBatch);
+        dirty_flag_.Set(DirtyFlag::DirtyStructure);
+    }
+    else if (!enabled)
+    {
+        transform_batch_.reset();
+    }
+}
+
+void Actor::SetCacheAsBitmapEnabled(bool enabled)
+{
+    if (enabled && !bitmap_cache_)
+    {
+        bitmap_cache_.reset(new BitmapCache);
+        MarkContentDirty();
+    }
+    else if (!enabled && bitmap_cache_)
+    {
+        bitmap_cache_.reset();
+
+        // visibility of the subtree was evaluated against the cache
+        Vector<Actor*> stack = { this };
+        while (!stack.empty())
+        {
+            Actor* node = stack.back();
+            stack.pop_back();
+
+            node->dirty_flag_.Set(DirtyFlag::DirtyVisibility);
+            for (const auto& child : node->children_)
+                stack.push_back(child.Get());
+        }
+    }
+}
+
+void Actor::MarkContentDirty()
+{
+    // ancestors already marked have marked their ancestors as well
+    Actor* node = this;
+    while (node && !node->dirty_flag_.Has(DirtyFlag::DirtyContent))
+    {
+        node->dirty_flag_.Set(DirtyFlag::DirtyContent);
+
+        if (node->update_independent_ && node->parent_ && ParallelUpdater::IsDeferring())
+        {
+            // ancestors of an independent subtree are shared by other workers
+            Actor*        parent = node->parent_;
+            RefPtr<Actor> holder = parent;
+            ParallelUpdater::Defer([holder, parent]() { parent->MarkContentDirty(); });
+            return;
+        }
+        node = node->parent_;
+    }
+}
+
+void Actor::MarkTransformDirty()
+{
+    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    dirty_flag_.Set(DirtyFlag::DirtyLocalTransform);
+    MarkSubtreeBoundsDirty();
+
+    // the own transform does not change the content of the own cache
+    MarkParentContentDirty();
+}
+
+void Actor::MarkParentContentDirty()
+{
+    if (!parent_)
+        return;
+
+    if (update_independent_ && ParallelUpdater::IsDeferring())
+    {
+        Actor*        parent = parent_;
+        RefPtr<Actor> holder = parent;
+        ParallelUpdater::Defer([holder, parent]() { parent->MarkContentDirty(); });
+        return;
+    }
+    parent_->MarkContentDirty();
+}
+
+void Actor::MarkStructureDirty()
+{
+    Actor* node = this;
+    while (node && !node->dirty_flag_.Has(DirtyFlag::DirtyStructure))
+    {
+        node->dirty_flag_.Set(DirtyFlag::DirtyStructure);
+
+        if (node->update_independent_ && node->parent_ && ParallelUpdater::IsDeferring())
+        {
+            Actor*        parent = node->parent_;
+            RefPtr<Actor> holder = parent;
+            ParallelUpdater::Defer([holder, parent]() { parent->MarkStructureDirty(); });
+            return;
+        }
+        node = node->parent_;
+    }
 }
 
 void Actor::UpdateTransformUpwards() const
@@ -296,6 +779,76 @@ void Actor::UpdateTransformUpwards() const
     UpdateTransform();
 }
 
+const Rect& Actor::UpdateWorldBounds() const
+{
+    if (dirty_flag_.Has(DirtyFlag::DirtyWorldBounds))
+    {
+        dirty_flag_.Unset(DirtyFlag::DirtyWorldBounds);
+        world_bounds_ = transform_matrix_.Transform(GetBounds());
+    }
+    return world_bounds_;
+}
+
+void Actor::UpdateSubtreeBounds() const
+{
+    if (!dirty_flag_.Has(DirtyFlag::DirtySubtreeBounds))
+        return;
+
+    dirty_flag_.Unset(DirtyFlag::DirtySubtreeBounds);
+
+    UpdateTransform();
+
+    subtree_size_  = 1;
+    subtree_empty_ = size_.IsOrigin();
+    if (!subtree_empty_)
+    {
+        subtree_bounds_ = UpdateWorldBounds();
+    }
+
+    for (const auto& child : children_)
+    {
+        if (!child->visible_)
+            continue;
+
+        child->UpdateSubtreeBounds();
+        subtree_size_ += child->subtree_size_;
+
+        if (child->subtree_empty_)
+            continue;
+
+        subtree_bounds_ = subtree_empty_ ? child->subtree_bounds_ : subtree_bounds_.Merge(child->subtree_bounds_);
+        subtree_empty_  = false;
+    }
+
+    if (subtree_empty_)
+    {
+        subtree_bounds_ = Rect();
+    }
+}
+
+void Actor::MarkSubtreeBoundsDirty() const
+{
+    dirty_flag_.Set(DirtyFlag::DirtySubtreeBounds);
+
+    // ancestors already marked have marked their ancestors as well
+    const Actor* node = this;
+    while (node->parent_)
+    {
+        if (node->update_independent_ && ParallelUpdater::IsDeferring())
+        {
+            Actor*        parent = node->parent_;
+            RefPtr<Actor> holder = parent;
+            ParallelUpdater::Defer([holder, parent]() { parent->MarkSubtreeBoundsDirty(); });
+            return;
+        }
+
+        node = node->parent_;
+        if (node->dirty_flag_.Has(DirtyFlag::DirtySubtreeBounds))
+            break;
+        node->dirty_flag_.Set(DirtyFlag::DirtySubtreeBounds);
+    }
+}
+
 void Actor::UpdateOpacity()
 {
     if (!dirty_flag_.Has(DirtyFlag::DirtyOpacity))
@@ -334,6 +887,13 @@ void Actor::Reorder()
     {
         RefPtr<Actor> me = this;
 
+        // the siblings are shared with other workers unless the parent is in the same subtree
+        if (ParallelUpdater::IsDeferring() && !ParallelUpdater::IsInCurrentSubtree(parent_))
+        {
+            ParallelUpdater::Defer([me, this]() { this->Reorder(); });
+            return;
+        }
+
         parent_->children_.Remove(me);
 
         RefPtr<Actor> sibling = parent_->children_.GetLast();
@@ -357,6 +917,9 @@ void Actor::Reorder()
         {
             parent_->children_.PushFront(me);
         }
+        ++parent_->children_version_;
+
+        parent_->MarkContentDirty();
     }
 }
 
@@ -376,6 +939,9 @@ void Actor::SetOpacity(float opacity)
 
     displayed_opacity_ = opacity_ = std::min(std::max(opacity, 0.f), 1.f);
     dirty_flag_.Set(DirtyFlag::DirtyOpacity);
+
+    // the own opacity is applied when compositing the own cache
+    MarkParentContentDirty();
 }
 
 void Actor::SetCascadeOpacityEnabled(bool enabled)
@@ -385,6 +951,7 @@ void Actor::SetCascadeOpacityEnabled(bool enabled)
 
     cascade_opacity_ = enabled;
     dirty_flag_.Set(DirtyFlag::DirtyOpacity);
+    MarkContentDirty();
 }
 
 void Actor::SetAnchor(const Vec2& anchor)
@@ -393,7 +960,7 @@ void Actor::SetAnchor(const Vec2& anchor)
         return;
 
     anchor_ = anchor;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetSize(const Size& size)
@@ -402,18 +969,24 @@ void Actor::SetSize(const Size& size)
         return;
 
     size_ = size;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
+    MarkContentDirty();
 }
 
 void Actor::SetTransform(const Transform& transform)
 {
     transform_ = transform;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetVisible(bool val)
 {
+    if (visible_ == val)
+        return;
+
     visible_ = val;
+    MarkSubtreeBoundsDirty();
+    MarkParentContentDirty();
 }
 
 void Actor::SetName(StringView name)
@@ -428,7 +1001,7 @@ void Actor::SetPosition(const Point& pos)
         return;
 
     transform_.position = pos;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetScale(const Vec2& scale)
@@ -437,7 +1010,7 @@ void Actor::SetScale(const Vec2& scale)
         return;
 
     transform_.scale = scale;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetSkew(const Vec2& skew)
@@ -446,7 +1019,7 @@ void Actor::SetSkew(const Vec2& skew)
         return;
 
     transform_.skew = skew;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::SetRotation(float angle)
@@ -455,13 +1028,20 @@ void Actor::SetRotation(float angle)
         return;
 
     transform_.rotation = angle;
-    dirty_flag_.Set(DirtyFlag::DirtyTransform);
+    MarkTransformDirty();
 }
 
 void Actor::AddChild(RefPtr<Actor> child)
 {
     if (child)
     {
+        if (ParallelUpdater::IsDeferring() && !ParallelUpdater::IsInCurrentSubtree(this))
+        {
+            RefPtr<Actor> me = this;
+            ParallelUpdater::Defer([me, this, child]() { this->AddChild(child); });
+            return;
+        }
+
         KGE_ASSERT(!child->parent_ && "Actor::AddChild failed, the actor to be added already has a parent");
 
 #ifdef KGE_DEBUG
@@ -478,12 +1058,19 @@ void Actor::AddChild(RefPtr<Actor> child)
 #endif  // KGE_DEBUG
 
         children_.PushBack(child);
-        child->parent_ = this;
+        ++children_version_;
+        child->parent_     = this;
+        child->walk_stamp_ = 0;
         child->SetStage(this->stage_);
 
         child->dirty_flag_.Set(DirtyFlag::DirtyTransform);
+        child->dirty_flag_.Set(DirtyFlag::DirtyLocalTransform);
         child->dirty_flag_.Set(DirtyFlag::DirtyOpacity);
+        child->MarkSubtreeBoundsDirty();
         child->Reorder();
+
+        MarkStructureDirty();
+        MarkContentDirty();
     }
     else
     {
@@ -512,7 +1099,20 @@ Rect Actor::GetBounds() const
 
 Rect Actor::GetBoundingBox() const
 {
-    return GetTransformMatrix().Transform(GetBounds());
+    return GetWorldBounds();
+}
+
+const Rect& Actor::GetWorldBounds() const
+{
+    UpdateTransformUpwards();
+    return UpdateWorldBounds();
+}
+
+const Rect& Actor::GetSubtreeBounds() const
+{
+    UpdateTransformUpwards();
+    UpdateSubtreeBounds();
+    return subtree_bounds_;
 }
 
 Vector<RefPtr<Actor>> Actor::GetChildren(StringView name) const
@@ -569,10 +1169,28 @@ void Actor::RemoveChild(RefPtr<Actor> child)
 
     if (child)
     {
+        // this may be called in the destructor, so only hold this when deferring
+        if (ParallelUpdater::IsDeferring() && !ParallelUpdater::IsInCurrentSubtree(this))
+        {
+            RefPtr<Actor> me = this;
+            ParallelUpdater::Defer([me, this, child]() { this->RemoveChild(child); });
+            return;
+        }
+
+        if (walking_depth > 0)
+        {
+            removed_while_walking.push_back(child);
+        }
+
         child->parent_ = nullptr;
         if (child->stage_)
             child->SetStage(nullptr);
         children_.Remove(child);
+        ++children_version_;
+
+        MarkSubtreeBoundsDirty();
+        MarkStructureDirty();
+        MarkContentDirty();
     }
     else
     {
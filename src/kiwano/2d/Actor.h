@@ -63,6 +63,8 @@ class KGE_API Actor
 {
     friend class Director;
     friend class Transition;
+    friend class SpriteBatchActor;
+    friend class ParallelUpdater;
     friend IntrusiveList<RefPtr<Actor>>;
 
 public:
@@ -210,6 +212,68 @@ public:
     /// @brief ȡаΧ
     virtual Rect GetBoundingBox() const;
 
+    /// \~chinese
+    /// @brief ȡϵµаΧ
+    /// @details ᱻ棬ڶά任С仯¼
+    const Rect& GetWorldBounds() const;
+
+    /// \~chinese
+    /// @brief ȡпɼӽɫϵµĺϲΧ
+    /// @details ûдСΪĿɼɫʱؿվΡᱻ棬нɫĶά任СɼԻӽɫб仯¼
+    const Rect& GetSubtreeBounds() const;
+
+    /// \~chinese
+    /// @brief Ƿü
+    bool IsSubtreeCullingEnabled() const;
+
+    /// \~chinese
+    /// @brief ûü
+    /// @details ú󣬵ϲΧȫλʱӽɫȾ
+    /// ӽɫΧڻƵ͵ͼͼ
+    /// @param enabled Ƿ
+    void SetSubtreeCullingEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿ任
+    bool IsTransformBatchingEnabled() const;
+
+    /// \~chinese
+    /// @brief û任
+    /// @details úɫĶά任㼶˳򱣴 TransformStore УȾǰһԱ㣬
+    /// ɫݹ㡣ڽڵҾƶӺʹλ
+    /// @param enabled Ƿ
+    void SetTransformBatchingEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿλͼ
+    bool IsCacheAsBitmapEnabled() const;
+
+    /// \~chinese
+    /// @brief ûλͼ
+    /// @details úӽɫȾһУ֮ÿֱֻ֡нɫĶά任
+    /// ͸ȡɼԡӽɫбȾݷ仯Ķά任͸ȱ仯ʹʧЧ
+    /// ȫ͸ķʽȾʱӦ͸ȣصӽɫΪһ͸ںٱ仯ĸ
+    ///  UI ;̬ĳװΡϵĳߴդɫ߽Ļݻᱻü
+    /// @param enabled Ƿ
+    void SetCacheAsBitmapEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ⱦݷ仯ʹλͼʧЧ
+    /// @details ýɫݱ仯ʱԶá OnRender ԶƵĽɫֱ޸˻ˢȹԴʱ
+    /// Ҫֶ
+    void MarkContentDirty();
+
+    /// \~chinese
+    /// @brief Ƿ
+    bool IsUpdateIndependent() const;
+
+    /// \~chinese
+    /// @brief Ƿ
+    /// @details  ParallelUpdater 󣬶µͰZ˳ڵи¡
+    /// ڸʱֻ޸ĽɫԽڵṹ޸ĻƳٵжϺִ
+    /// @param independent Ƿ
+    void SetUpdateIndependent(bool independent);
+
     /// \~chinese
     /// @brief ȡά任
     const Matrix3x2& GetTransformMatrix() const;
@@ -390,6 +454,18 @@ public:
     /// @brief жϵǷڽɫ
     virtual bool ContainsPoint(const Point& point) const;
 
+    /// \~chinese
+    /// @brief Ƿ¼ü
+    bool IsMouseEventClippingEnabled() const;
+
+    /// \~chinese
+    /// @brief û¼ü
+    /// @details ú󣬽ɫֻλ߽ʱ¼⻹յƳ߽ĵһ¼
+    /// Լڽɫڰֱ̧ǰ¼ĬϽãֻΧ¼Ľɫ簴ť
+    /// øùܣԼ¼ķַ
+    /// @param enabled Ƿ
+    void SetMouseEventClippingEnabled(bool enabled);
+
     /// \~chinese
     /// @brief ϵתΪֲϵ
     Point ConvertToLocal(const Point& point) const;
@@ -425,6 +501,22 @@ protected:
     /// @brief Ⱦӽɫ
     virtual void Render(RenderContext& ctx);
 
+    /// \~chinese
+    /// @brief Ⱦӽɫ
+    void RenderSelf(RenderContext& ctx);
+
+    /// \~chinese
+    /// @brief Z˳Ⱦӽɫӽɫʱ
+    virtual void RenderChildren(RenderContext& ctx);
+
+    /// \~chinese
+    /// @brief Ⱦһӽɫ RenderChildren Z˳
+    virtual void RenderChild(RenderContext& ctx, Actor* child);
+
+    /// \~chinese
+    /// @brief λͼ棬ʧЧʱȽӽɫȾ
+    void RenderBitmapCache(RenderContext& ctx);
+
     /// \~chinese
     /// @brief ӽɫı߽
     virtual void RenderBorder(RenderContext& ctx);
@@ -441,11 +533,27 @@ protected:
     /// @brief ԼĶά任֪ͨӽɫ
     void UpdateTransform() const;
 
+    /// \~chinese
+    /// @brief ı任ԼڸɫĶά任
+    void UpdateTransformToParent() const;
+
+    /// \~chinese
+    /// @brief ɫĶά任ǰ豣֤Ķά任Ѹ
+    void UpdateTransformBatch();
+
     /// \~chinese
     /// @brief ׷ݸ
     /// @details ڽڵ A->B(dirty)->C->D D ִ UpdateTransformUpwards ʱ BCD ϵθ
     void UpdateTransformUpwards() const;
 
+    /// \~chinese
+    /// @brief ϵµаΧУǰ豣֤ά任Ѹ
+    const Rect& UpdateWorldBounds() const;
+
+    /// \~chinese
+    /// @brief пɼӽɫĺϲΧУǰ豣֤ɫĶά任Ѹ
+    void UpdateSubtreeBounds() const;
+
     /// \~chinese
     /// @brief Լӽɫ͸
     void UpdateOpacity();
@@ -458,27 +566,70 @@ protected:
     /// @brief ýڵ̨
     void SetStage(Stage* stage);
 
-    enum DirtyFlag : uint8_t
+    /// \~chinese
+    /// @brief иɫĺϲΧҪ¼
+    void MarkSubtreeBoundsDirty() const;
+
+    /// \~chinese
+    /// @brief иɫṹ仯
+    void MarkStructureDirty();
+
+    /// \~chinese
+    /// @brief Ƕά任仯
+    void MarkTransformDirty();
+
+    /// \~chinese
+    /// @brief ǸɫȾݷ仯
+    /// @details ڲиµĶĸڵʱƳٵύ׶ִ
+    void MarkParentContentDirty();
+
+    enum DirtyFlag : uint16_t
     {
         Clean                 = 0,
         DirtyTransform        = 1,
         DirtyTransformInverse = 1 << 1,
         DirtyOpacity          = 1 << 2,
-        DirtyVisibility       = 1 << 3
+        DirtyVisibility       = 1 << 3,
+        DirtyWorldBounds      = 1 << 4,
+        DirtySubtreeBounds    = 1 << 5,
+        DirtyStructure        = 1 << 6,
+        DirtyLocalTransform   = 1 << 7,
+        DirtyContent          = 1 << 8
     };
 
-    Flag<uint8_t>& GetDirtyFlag() const;
+    Flag<uint16_t>& GetDirtyFlag() const;
+
+    /// \~chinese
+    /// @brief ӽɫ
+    /// @details ԭʼָӽɫıüбƳĽɫӳٵͷš
+    /// ӽɫб仯ӡƳZ˳ʱӵһӽɫ¿ʼ
+    /// αѷʹӽɫÿӽɫ౻һΣ¼ӽɫҲᱻʡ
+    /// ͬһɫǶױṲʱǣʱб仯ظӽɫ
+    class ChildWalker;
+
+    /// \~chinese
+    /// @brief 任Ľڵ
+    struct TransformBatch;
+
+    /// \~chinese
+    /// @brief λͼ
+    struct BitmapCache;
 
 private:
     bool         visible_;
     bool         update_pausing_;
     bool         cascade_opacity_;
     bool         show_border_;
+    bool         mouse_clipping_;
+    bool         subtree_culling_;
+    bool         update_independent_;
     mutable bool visible_in_rt_;
+    mutable bool subtree_empty_;
 
-    mutable Flag<uint8_t> dirty_flag_;
+    mutable Flag<uint16_t> dirty_flag_;
 
     int            z_order_;
+    uint32_t       children_version_;
     float          opacity_;
     float          displayed_opacity_;
     Actor*         parent_;
@@ -493,6 +644,14 @@ private:
     mutable Matrix3x2 transform_matrix_;
     mutable Matrix3x2 transform_matrix_inverse_;
     mutable Matrix3x2 transform_matrix_to_parent_;
+    mutable Rect      world_bounds_;
+    mutable Rect      subtree_bounds_;
+    mutable uint32_t  subtree_size_;
+    mutable uint32_t  walk_serial_;
+    mutable uint32_t  walk_stamp_;
+
+    std::unique_ptr<TransformBatch> transform_batch_;
+    std::unique_ptr<BitmapCache>    bitmap_cache_;
 };
 
 /** @} */
@@ -507,7 +666,7 @@ inline void Actor::OnRender(RenderContext& ctx)
     KGE_NOT_USED(ctx);
 }
 
-inline Flag<uint8_t>& Actor::GetDirtyFlag() const
+inline Flag<uint16_t>& Actor::GetDirtyFlag() const
 {
     return dirty_flag_;
 }
@@ -522,6 +681,46 @@ inline bool Actor::IsCascadeOpacityEnabled() const
     return cascade_opacity_;
 }
 
+inline bool Actor::IsSubtreeCullingEnabled() const
+{
+    return subtree_culling_;
+}
+
+inline void Actor::SetSubtreeCullingEnabled(bool enabled)
+{
+    subtree_culling_ = enabled;
+}
+
+inline bool Actor::IsTransformBatchingEnabled() const
+{
+    return transform_batch_ != nullptr;
+}
+
+inline bool Actor::IsCacheAsBitmapEnabled() const
+{
+    return bitmap_cache_ != nullptr;
+}
+
+inline bool Actor::IsUpdateIndependent() const
+{
+    return update_independent_;
+}
+
+inline void Actor::SetUpdateIndependent(bool independent)
+{
+    update_independent_ = independent;
+}
+
+inline bool Actor::IsMouseEventClippingEnabled() const
+{
+    return mouse_clipping_;
+}
+
+inline void Actor::SetMouseEventClippingEnabled(bool enabled)
+{
+    mouse_clipping_ = enabled;
+}
+
 inline size_t Actor::GetHashName() const
 {
     return hash_name_;
@@ -43,6 +43,7 @@ void Canvas::ResizeAndClear(const PixelSize& size)
     if (render_ctx_)
     {
         SetSize(render_ctx_->GetSize());
+        MarkContentDirty();
     }
     else
     {
@@ -53,6 +53,7 @@ public:
 
     /// \~chinese
     /// @brief ȡ2Dͼ
+    /// @details λλͼʱɺ MarkContentDirty
     RefPtr<CanvasRenderContext> GetContext2D() const;
 
     /// \~chinese
@@ -19,9 +19,13 @@
 // THE SOFTWARE.
 
 #include <kiwano/2d/DebugActor.h>
+#include <kiwano/2d/Stage.h>
+#include <kiwano/base/Director.h>
 #include <kiwano/utils/Logger.h>
 #include <kiwano/render/Renderer.h>
+#include <kiwano/utils/Profiler.h>
 #include <kiwano/base/component/MouseSensor.h>
+#include <iomanip>  // std::setprecision
 #include <psapi.h>
 
 #pragma comment(lib, "psapi.lib")
@@ -108,6 +112,17 @@ void DebugActor::OnUpdate(Duration dt)
 
     ss << "Primitives / sec: " << std::fixed << status.primitives * frame_buffer_.Size() << std::endl;
 
+    if (status.cache_hits || status.cache_misses)
+    {
+        ss << "Bitmap cache: " << status.cache_hits << " hits, " << status.cache_misses << " misses" << std::endl;
+    }
+
+    if (RefPtr<Stage> stage = Director::GetInstance().GetCurrentStage())
+    {
+        ss << "Actors: " << stage->GetRenderedActorCount() << " rendered, " << stage->GetCulledActorCount() << " culled"
+           << std::endl;
+    }
+
     ss << "Memory: ";
     {
         PROCESS_MEMORY_COUNTERS_EX pmc;
@@ -122,6 +137,25 @@ void DebugActor::OnUpdate(Duration dt)
         ss << pmc.PrivateUsage / 1024 << "Kb";
     }
 
+    Profiler& profiler = Profiler::GetInstance();
+    if (profiler.IsEnabled())
+    {
+        const size_t max_zones = 8;
+        const auto&  summaries = profiler.GetZoneSummaries();
+
+        ss << std::endl << std::setprecision(2);
+        ss << "Frame: " << profiler.GetAverageFrameTime().GetMicroseconds() / 1000.0 << "ms";
+        for (size_t i = 0; i < summaries.size() && i < max_zones; ++i)
+        {
+            const auto& summary = summaries[i];
+
+            ss << std::endl << summary.name;
+            if (summary.category[0])
+                ss << " (" << summary.category << ")";
+            ss << ": " << summary.average_exclusive.GetMicroseconds() / 1000.0 << "ms";
+        }
+    }
+
     debug_text_.Reset(ss.str(), debug_text_style_);
 
     Size layout_size = debug_text_.GetSize();
@@ -28,6 +28,7 @@ namespace kiwano
 
 GifSprite::GifSprite()
     : animating_(false)
+    , frame_cached_(false)
     , next_index_(0)
     , total_loop_count_(1)
     , loop_count_(0)
@@ -78,6 +79,19 @@ bool GifSprite::Load(RefPtr<GifImage> gif)
         frame_to_render_.Reset();
         frame_rt_.Reset();
 
+        // Frames are shared with other sprites, no render target is needed
+        frame_cached_ = gif_->IsFrameCacheEnabled();
+        if (frame_cached_)
+        {
+            if (gif_->GetFramesCount() > 0)
+            {
+                ComposeNextFrame();
+            }
+
+            SetSize(Size(float(gif_->GetWidthInPixels()), float(gif_->GetHeightInPixels())));
+            return true;
+        }
+
         frame_to_render_ = MakePtr<Texture>();
         frame_rt_        = RenderContext::Create(frame_to_render_, gif_->GetSizeInPixels());
 
@@ -142,9 +156,29 @@ void GifSprite::RestartAnimation()
 
 void GifSprite::ComposeNextFrame()
 {
-    KGE_ASSERT(frame_rt_);
     KGE_ASSERT(gif_);
 
+    // The frame cache was switched after loading, the frames must be composed from the first one again
+    if (frame_cached_ != gif_->IsFrameCacheEnabled())
+    {
+        Load(gif_);
+        return;
+    }
+
+    if (frame_cached_)
+    {
+        do
+        {
+            FetchNextCachedFrame();
+        } while (frame_.delay.IsZero() && !IsLastFrame());
+
+        animating_ = (!EndOfAnimation() && gif_->GetFramesCount() > 1);
+        MarkContentDirty();
+        return;
+    }
+
+    KGE_ASSERT(frame_rt_);
+
     if (frame_rt_)
     {
         do
@@ -154,6 +188,7 @@ void GifSprite::ComposeNextFrame()
         } while (frame_.delay.IsZero() && !IsLastFrame());
 
         animating_ = (!EndOfAnimation() && gif_->GetFramesCount() > 1);
+        MarkContentDirty();
     }
 }
 
@@ -219,6 +254,37 @@ void GifSprite::OverlayNextFrame()
     }
 }
 
+void GifSprite::FetchNextCachedFrame()
+{
+    KGE_ASSERT(gif_);
+
+    GifImage::ComposedFrame composed = gif_->GetComposedFrame(uint32_t(next_index_));
+
+    frame_       = GifImage::Frame();
+    frame_.delay = composed.delay;
+    if (composed.texture)
+    {
+        frame_to_render_ = composed.texture;
+    }
+
+    if (next_index_ == 0)
+    {
+        loop_count_++;
+    }
+    next_index_ = (next_index_ + 1) % gif_->GetFramesCount();
+
+    // Execute callback
+    if (IsLastFrame() && loop_cb_)
+    {
+        loop_cb_(loop_count_ - 1);
+    }
+
+    if (EndOfAnimation() && done_cb_)
+    {
+        done_cb_();
+    }
+}
+
 void GifSprite::SaveComposedFrame()
 {
     KGE_ASSERT(frame_rt_);
@@ -128,6 +128,10 @@ private:
     /// @brief ϳһ֡
     void ComposeNextFrame();
 
+    /// \~chinese
+    /// @brief GIFͼ֡ȡһ֡
+    void FetchNextCachedFrame();
+
     /// \~chinese
     /// @brief ǰؼ֡
     void DisposeCurrentFrame();
@@ -150,6 +154,7 @@ private:
 
 private:
     bool                  animating_;
+    bool                  frame_cached_;
     int                   total_loop_count_;
     int                   loop_count_;
     size_t                next_index_;
@@ -92,6 +92,7 @@ inline Layer& LayerActor::GetLayer()
 inline void LayerActor::SetLayer(const Layer& layer)
 {
     layer_ = layer;
+    MarkContentDirty();
 }
 
 }  // namespace kiwano
@@ -0,0 +1,125 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/ParallelUpdater.h>
+#include <kiwano/2d/Actor.h>
+#include <kiwano/utils/Profiler.h>
+
+namespace kiwano
+{
+
+namespace
+{
+
+// commands recorded by the independent subtree being updated on this thread
+thread_local Vector<Function<void()>>* deferred_commands = nullptr;
+thread_local const Actor*              deferring_root    = nullptr;
+
+}  // namespace
+
+ParallelUpdater::ParallelUpdater() {}
+
+ParallelUpdater::~ParallelUpdater() {}
+
+void ParallelUpdater::SetEnabled(bool enabled, uint32_t thread_count)
+{
+    KGE_ASSERT(!IsDeferring() && "ParallelUpdater::SetEnabled cannot be called in an independent subtree");
+
+    if (!enabled)
+    {
+        pool_.reset();
+    }
+    else if (!pool_ || (thread_count && pool_->GetThreadCount() != thread_count))
+    {
+        pool_.reset();
+        pool_.reset(new ThreadPool(thread_count));
+    }
+}
+
+bool ParallelUpdater::IsDeferring()
+{
+    return deferred_commands != nullptr;
+}
+
+bool ParallelUpdater::IsInCurrentSubtree(const Actor* actor)
+{
+    if (!deferring_root)
+        return false;
+
+    // ancestors outside the subtree are not modified during the parallel phase
+    for (; actor; actor = actor->GetParent())
+    {
+        if (actor == deferring_root)
+            return true;
+    }
+    return false;
+}
+
+bool ParallelUpdater::Defer(Function<void()> command)
+{
+    if (!deferred_commands)
+        return false;
+
+    deferred_commands->push_back(std::move(command));
+    return true;
+}
+
+void ParallelUpdater::Update(const Vector<Actor*>& roots, Duration dt)
+{
+    KGE_ASSERT(!IsDeferring() && "ParallelUpdater::Update cannot be nested");
+
+    if (roots.empty())
+        return;
+
+    if (deferred_.size() < roots.size())
+        deferred_.resize(roots.size());
+
+    auto update_subtree = [&](size_t index) {
+        KGE_PROFILE_ZONE_CATEGORY("ParallelUpdate", "Update");
+
+        deferred_commands = &deferred_[index];
+        deferring_root    = roots[index];
+        roots[index]->Update(dt);
+        deferring_root    = nullptr;
+        deferred_commands = nullptr;
+    };
+
+    if (pool_ && roots.size() > 1)
+    {
+        pool_->ParallelFor(roots.size(), update_subtree);
+    }
+    else
+    {
+        for (size_t i = 0; i < roots.size(); ++i)
+            update_subtree(i);
+    }
+
+    // commit phase, replay in the same order as a sequential update would record
+    for (size_t i = 0; i < roots.size(); ++i)
+    {
+        for (auto& command : deferred_[i])
+        {
+            command();
+        }
+        deferred_[i].clear();
+    }
+}
+
+}  // namespace kiwano
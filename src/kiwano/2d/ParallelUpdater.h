@@ -0,0 +1,99 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/core/Common.h>
+#include <kiwano/core/Time.h>
+#include <kiwano/core/Singleton.h>
+#include <kiwano/core/ThreadPool.h>
+
+namespace kiwano
+{
+
+class Actor;
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief и
+ * @details ú󣬱Ϊµӽɫ Actor::SetUpdateIndependent̳߳ви¡
+ * Z˳ڵĶӽɫֵʱһи£븸ɫӽɫ֮Ⱥ˳͵̸߳ͬ
+ * ڲĽڵ޸Ч漰ڵ޸ģ罫ĸڵƳڵ㡢
+ * Z˳Լ¼ַб޸Ļᱻ¼жɺ
+ * ߳аZ˳ִУÿ֡Ľȷġ
+ * Ƴٵ޸ύǰɼڵ GetParent()  GetStage() ύ׶֮ǰֲ䣬
+ * 뵥̸߳µм״̬ܲͬ
+ * ڲܷǶ׵ĶڵĹ߳θ¡
+ */
+class KGE_API ParallelUpdater : public Singleton<ParallelUpdater>
+{
+    friend Singleton<ParallelUpdater>;
+
+public:
+    /// \~chinese
+    /// @brief ûòи
+    /// @param enabled Ƿ
+    /// @param thread_count ߳Ϊ 0 ʱ CPU 
+    void SetEnabled(bool enabled, uint32_t thread_count = 0);
+
+    /// \~chinese
+    /// @brief Ƿ˲и
+    bool IsEnabled() const;
+
+    /// \~chinese
+    /// @brief ǰ߳Ƿڸ¶
+    static bool IsDeferring();
+
+    /// \~chinese
+    /// @brief ɫǷڵǰ߳ڸµĶ
+    /// @details ڲ޸Чֻ漰ڵ޸ҪƳ
+    static bool IsInCurrentSubtree(const Actor* actor);
+
+    /// \~chinese
+    /// @brief Ƴִ
+    /// @details ǰ߳ڸ¶ʱ¼ύ׶ִУ棻κ²ؼ
+    static bool Defer(Function<void()> command);
+
+    /// \~chinese
+    /// @brief иһڵǰ߳ύƳٵ
+    void Update(const Vector<Actor*>& roots, Duration dt);
+
+    ~ParallelUpdater();
+
+private:
+    ParallelUpdater();
+
+private:
+    std::unique_ptr<ThreadPool>      pool_;
+    Vector<Vector<Function<void()>>> deferred_;
+};
+
+/** @} */
+
+inline bool ParallelUpdater::IsEnabled() const
+{
+    return pool_ != nullptr;
+}
+
+}  // namespace kiwano
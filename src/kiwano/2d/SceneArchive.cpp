@@ -0,0 +1,1044 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/SceneArchive.h>
+#include <kiwano/2d/Sprite.h>
+#include <kiwano/2d/TextActor.h>
+#include <kiwano/2d/ShapeActor.h>
+#include <kiwano/2d/animation/TweenAnimation.h>
+#include <kiwano/platform/FileSystem.h>
+#include <kiwano/platform/MappedFile.h>
+#include <kiwano/utils/ResourceCache.h>
+#include <kiwano/utils/Logger.h>
+#include <fstream>  // std::ofstream
+#include <cstring>  // std::memcpy
+
+namespace kiwano
+{
+
+namespace
+{
+
+const uint32_t SceneMagic = 0x4E43534B;  // "KSCN"
+const uint32_t NoIndex    = uint32_t(-1);
+
+enum class NodeType : uint32_t
+{
+    Actor,
+    Sprite,
+    Text,
+    Line,
+    Rect,
+    RoundedRect,
+    Circle,
+    Ellipse,
+    Polygon,
+    Last = Polygon,
+};
+
+enum class AnimationType : uint32_t
+{
+    MoveBy,
+    MoveTo,
+    JumpBy,
+    JumpTo,
+    ScaleBy,
+    ScaleTo,
+    FadeTo,
+    RotateBy,
+    RotateTo,
+    Last = RotateTo,
+};
+
+enum NodeFlag : uint32_t
+{
+    Visible           = 1,
+    UpdatePausing     = 1 << 1,
+    CascadeOpacity    = 1 << 2,
+    MouseClipping     = 1 << 3,
+    SubtreeCulling    = 1 << 4,
+    TransformBatching = 1 << 5,
+    CacheAsBitmap     = 1 << 6,
+    UpdateIndependent = 1 << 7,
+};
+
+enum BrushFlag : uint32_t
+{
+    FillColor   = 1,
+    StrokeColor = 1 << 1,
+};
+
+enum TextFlag : uint32_t
+{
+    Underline     = 1,
+    Strikethrough = 1 << 1,
+};
+
+enum Section : uint32_t
+{
+    NodeSection,
+    SpriteSection,
+    TextSection,
+    ShapeSection,
+    AnimationSection,
+    StringSection,
+    FloatSection,
+    CharSection,
+    SectionCount
+};
+
+struct SectionEntry
+{
+    uint32_t offset;
+    uint32_t count;
+};
+
+struct FileHeader
+{
+    uint32_t     magic;
+    uint16_t     version;
+    uint16_t     header_size;
+    SectionEntry sections[SectionCount];
+};
+
+struct NodeRecord
+{
+    NodeType type;
+    uint32_t parent;
+    uint32_t name;
+    uint32_t flags;
+    int32_t  z_order;
+    float    opacity;
+    float    anchor[2];
+    float    size[2];
+    float    position[2];
+    float    scale[2];
+    float    skew[2];
+    float    rotation;
+    uint32_t payload;
+    uint32_t animation_begin;
+    uint32_t animation_count;
+};
+
+struct SpriteRecord
+{
+    uint32_t texture;
+    float    crop[4];
+};
+
+struct TextRecord
+{
+    uint32_t content;
+    uint32_t font_family;
+    float    font_size;
+    uint32_t font_weight;
+    uint32_t font_posture;
+    uint32_t font_stretch;
+    uint32_t alignment;
+    uint32_t word_wrapping;
+    uint32_t decoration;
+    float    line_spacing;
+    float    wrap_width;
+    uint32_t brush;
+    float    fill_color[4];
+    float    outline_color[4];
+    float    outline_width;
+};
+
+struct ShapeRecord
+{
+    float    geometry[4];
+    uint32_t vertex_begin;
+    uint32_t vertex_count;
+    uint32_t brush;
+    float    fill_color[4];
+    float    stroke_color[4];
+    float    stroke_width;
+};
+
+struct AnimationRecord
+{
+    AnimationType type;
+    uint32_t      name;
+    int32_t       loops;
+    int32_t       jump_count;
+    uint32_t      duration[2];  // int64 nanoseconds, split to keep the records 4-byte aligned
+    uint32_t      delay[2];
+    float         params[3];
+};
+
+struct StringRecord
+{
+    uint32_t offset;
+    uint32_t length;  // without the terminating NUL
+};
+
+static_assert(sizeof(FileHeader) % 4 == 0, "FileHeader must be 4-byte aligned");
+static_assert(std::is_trivially_copyable<NodeRecord>::value && std::is_trivially_copyable<SpriteRecord>::value
+                  && std::is_trivially_copyable<TextRecord>::value && std::is_trivially_copyable<ShapeRecord>::value
+                  && std::is_trivially_copyable<AnimationRecord>::value,
+              "Scene records must be trivially copyable");
+
+const size_t RecordSizes[SectionCount] = {
+    sizeof(NodeRecord),      sizeof(SpriteRecord), sizeof(TextRecord), sizeof(ShapeRecord),
+    sizeof(AnimationRecord), sizeof(StringRecord), sizeof(float),      sizeof(char),
+};
+
+inline void StoreColor(float* out, const Color& color)
+{
+    out[0] = color.r;
+    out[1] = color.g;
+    out[2] = color.b;
+    out[3] = color.a;
+}
+
+inline Color LoadColor(const float* in)
+{
+    return Color(in[0], in[1], in[2], in[3]);
+}
+
+inline bool IsSolidColor(const RefPtr<Brush>& brush)
+{
+    return brush && brush->GetType() == Brush::Type::SolidColor;
+}
+
+inline void StoreDuration(uint32_t* out, Duration dur)
+{
+    const int64_t ns = std::max<int64_t>(dur.GetNanoseconds(), 0);
+    std::memcpy(out, &ns, sizeof(ns));
+}
+
+inline Duration LoadDuration(const uint32_t* in)
+{
+    int64_t ns = 0;
+    std::memcpy(&ns, in, sizeof(ns));
+    return Duration::FromNanoseconds(ns);
+}
+
+class ArchiveWriter
+{
+public:
+    Vector<uint8_t> Write(const Actor* root)
+    {
+        struct Pending
+        {
+            const Actor* actor;
+            uint32_t     parent;
+        };
+
+        Vector<Pending>       stack   = { { root, NoIndex } };
+        Vector<const Actor*> children;
+        while (!stack.empty())
+        {
+            Pending pending = stack.back();
+            stack.pop_back();
+
+            const uint32_t index = uint32_t(nodes_.size());
+            WriteNode(pending.actor, pending.parent);
+
+            // ӽɫѹջ֤ǰҸڵʼӽڵ֮ǰ
+            children.clear();
+            for (const auto& child : pending.actor->GetAllChildren())
+                children.push_back(child.Get());
+            for (auto iter = children.rbegin(); iter != children.rend(); ++iter)
+                stack.push_back(Pending{ *iter, index });
+        }
+        return Finish();
+    }
+
+private:
+    uint32_t AddString(StringView str)
+    {
+        if (str.empty())
+            return NoIndex;
+
+        String key(str.data(), str.size());
+        auto   iter = string_index_.find(key);
+        if (iter != string_index_.end())
+            return iter->second;
+
+        const uint32_t index = uint32_t(strings_.size());
+        strings_.push_back(StringRecord{ uint32_t(chars_.size()), uint32_t(str.size()) });
+        chars_.insert(chars_.end(), str.data(), str.data() + str.size());
+
+        // strings are terminated, so they can be passed to APIs expecting C strings
+        chars_.push_back('\0');
+        string_index_.emplace(std::move(key), index);
+        return index;
+    }
+
+    void WriteNode(const Actor* actor, uint32_t parent)
+    {
+        NodeRecord record = {};
+        record.parent     = parent;
+        record.name       = AddString(actor->GetName());
+        record.z_order    = actor->GetZOrder();
+        record.opacity    = actor->GetOpacity();
+        record.payload    = NoIndex;
+
+        if (actor->IsVisible())
+            record.flags |= NodeFlag::Visible;
+        if (actor->IsUpdatePausing())
+            record.flags |= NodeFlag::UpdatePausing;
+        if (actor->IsCascadeOpacityEnabled())
+            record.flags |= NodeFlag::CascadeOpacity;
+        if (actor->IsMouseEventClippingEnabled())
+            record.flags |= NodeFlag::MouseClipping;
+        if (actor->IsSubtreeCullingEnabled())
+            record.flags |= NodeFlag::SubtreeCulling;
+        if (actor->IsTransformBatchingEnabled())
+            record.flags |= NodeFlag::TransformBatching;
+        if (actor->IsCacheAsBitmapEnabled())
+            record.flags |= NodeFlag::CacheAsBitmap;
+        if (actor->IsUpdateIndependent())
+            record.flags |= NodeFlag::UpdateIndependent;
+
+        const Transform transform = actor->GetTransform();
+        const Vec2      anchor    = actor->GetAnchor();
+        const Size      size      = actor->GetSize();
+
+        record.anchor[0]   = anchor.x;
+        record.anchor[1]   = anchor.y;
+        record.size[0]     = size.x;
+        record.size[1]     = size.y;
+        record.position[0] = transform.position.x;
+        record.position[1] = transform.position.y;
+        record.scale[0]    = transform.scale.x;
+        record.scale[1]    = transform.scale.y;
+        record.skew[0]     = transform.skew.x;
+        record.skew[1]     = transform.skew.y;
+        record.rotation    = transform.rotation;
+
+        if (auto sprite = dynamic_cast<const Sprite*>(actor))
+        {
+            record.type    = NodeType::Sprite;
+            record.payload = WriteSprite(sprite);
+        }
+        else if (auto text = dynamic_cast<const TextActor*>(actor))
+        {
+            record.type    = NodeType::Text;
+            record.payload = WriteText(text);
+        }
+        else if (auto shape = dynamic_cast<const ShapeActor*>(actor))
+        {
+            record.type    = NodeType::Actor;
+            record.payload = WriteShape(shape, record.type);
+        }
+        else
+        {
+            record.type = NodeType::Actor;
+        }
+
+        record.animation_begin = uint32_t(animations_.size());
+        for (const auto& animation : actor->GetAllAnimations())
+            WriteAnimation(animation.Get());
+        record.animation_count = uint32_t(animations_.size()) - record.animation_begin;
+
+        nodes_.push_back(record);
+    }
+
+    uint32_t WriteSprite(const Sprite* sprite)
+    {
+        SpriteRecord record = {};
+        record.texture      = NoIndex;
+
+        if (auto texture = sprite->GetTexture())
+        {
+            record.texture = AddString(texture->GetName());
+            if (record.texture == NoIndex)
+                KGE_WARNF("SceneArchive: texture of sprite '%s' has no name and will not be saved",
+                          String(sprite->GetName()).c_str());
+        }
+
+        const Rect crop = sprite->GetCropRect();
+        record.crop[0]  = crop.left_top.x;
+        record.crop[1]  = crop.left_top.y;
+        record.crop[2]  = crop.right_bottom.x;
+        record.crop[3]  = crop.right_bottom.y;
+
+        sprites_.push_back(record);
+        return uint32_t(sprites_.size() - 1);
+    }
+
+    uint32_t WriteText(const TextActor* text)
+    {
+        const TextStyle style = text->GetStyle();
+
+        TextRecord record    = {};
+        record.content       = AddString(text->GetText());
+        record.font_family   = AddString(style.font.family_name);
+        record.font_size     = style.font.size;
+        record.font_weight   = style.font.weight;
+        record.font_posture  = uint32_t(style.font.posture);
+        record.font_stretch  = uint32_t(style.font.stretch);
+        record.alignment     = uint32_t(style.alignment);
+        record.word_wrapping = uint32_t(style.word_wrapping);
+        record.line_spacing  = style.line_spacing;
+        record.wrap_width    = style.wrap_width;
+
+        if (style.show_underline)
+            record.decoration |= TextFlag::Underline;
+        if (style.show_strikethrough)
+            record.decoration |= TextFlag::Strikethrough;
+
+        if (IsSolidColor(text->GetFillBrush()))
+        {
+            record.brush |= BrushFlag::FillColor;
+            StoreColor(record.fill_color, text->GetFillBrush()->GetColor());
+        }
+        if (IsSolidColor(text->GetOutlineBrush()))
+        {
+            record.brush |= BrushFlag::StrokeColor;
+            StoreColor(record.outline_color, text->GetOutlineBrush()->GetColor());
+        }
+        if (auto stroke = text->GetOutlineStrokeStyle())
+        {
+            record.outline_width = stroke->GetWidth();
+        }
+
+        texts_.push_back(record);
+        return uint32_t(texts_.size() - 1);
+    }
+
+    uint32_t WriteShape(const ShapeActor* shape, NodeType& type)
+    {
+        ShapeRecord record  = {};
+        record.vertex_begin = NoIndex;
+
+        if (auto line = dynamic_cast<const LineActor*>(shape))
+        {
+            type               = NodeType::Line;
+            record.geometry[0] = line->GetBeginPoint().x;
+            record.geometry[1] = line->GetBeginPoint().y;
+            record.geometry[2] = line->GetEndPoint().x;
+            record.geometry[3] = line->GetEndPoint().y;
+        }
+        else if (auto rect = dynamic_cast<const RectActor*>(shape))
+        {
+            type               = NodeType::Rect;
+            record.geometry[0] = rect->GetRectSize().x;
+            record.geometry[1] = rect->GetRectSize().y;
+        }
+        else if (auto rounded_rect = dynamic_cast<const RoundedRectActor*>(shape))
+        {
+            type               = NodeType::RoundedRect;
+            record.geometry[0] = rounded_rect->GetRectSize().x;
+            record.geometry[1] = rounded_rect->GetRectSize().y;
+            record.geometry[2] = rounded_rect->GetRadius().x;
+            record.geometry[3] = rounded_rect->GetRadius().y;
+        }
+        else if (auto circle = dynamic_cast<const CircleActor*>(shape))
+        {
+            type               = NodeType::Circle;
+            record.geometry[0] = circle->GetRadius();
+        }
+        else if (auto ellipse = dynamic_cast<const EllipseActor*>(shape))
+        {
+            type               = NodeType::Ellipse;
+            record.geometry[0] = ellipse->GetRadius().x;
+            record.geometry[1] = ellipse->GetRadius().y;
+        }
+        else if (auto polygon = dynamic_cast<const PolygonActor*>(shape))
+        {
+            type                = NodeType::Polygon;
+            record.vertex_begin = uint32_t(floats_.size());
+            record.vertex_count = uint32_t(polygon->GetVertices().size());
+            for (const auto& vertex : polygon->GetVertices())
+            {
+                floats_.push_back(vertex.x);
+                floats_.push_back(vertex.y);
+            }
+        }
+        else
+        {
+            // ״ļ޷棬ͨɫ
+            return NoIndex;
+        }
+
+        if (IsSolidColor(shape->GetFillBrush()))
+        {
+            record.brush |= BrushFlag::FillColor;
+            StoreColor(record.fill_color, shape->GetFillBrush()->GetColor());
+        }
+        if (IsSolidColor(shape->GetStrokeBrush()))
+        {
+            record.brush |= BrushFlag::StrokeColor;
+            StoreColor(record.stroke_color, shape->GetStrokeBrush()->GetColor());
+        }
+        if (auto stroke = shape->GetStrokeStyle())
+        {
+            record.stroke_width = stroke->GetWidth();
+        }
+
+        shapes_.push_back(record);
+        return uint32_t(shapes_.size() - 1);
+    }
+
+    void WriteAnimation(const Animation* animation)
+    {
+        auto tween = dynamic_cast<const TweenAnimation*>(animation);
+        if (!tween)
+            return;
+
+        AnimationRecord record = {};
+        record.name            = AddString(animation->GetName());
+        record.loops           = animation->GetLoops();
+        StoreDuration(record.duration, tween->GetDuration());
+        StoreDuration(record.delay, animation->GetDelay());
+
+        //  To  By ж
+        if (auto move_to = dynamic_cast<const MoveToAnimation*>(tween))
+        {
+            record.type      = AnimationType::MoveTo;
+            record.params[0] = move_to->GetDistination().x;
+            record.params[1] = move_to->GetDistination().y;
+        }
+        else if (auto move_by = dynamic_cast<const MoveByAnimation*>(tween))
+        {
+            record.type      = AnimationType::MoveBy;
+            record.params[0] = move_by->GetDisplacement().x;
+            record.params[1] = move_by->GetDisplacement().y;
+        }
+        else if (auto jump_to = dynamic_cast<const JumpToAnimation*>(tween))
+        {
+            record.type       = AnimationType::JumpTo;
+            record.params[0]  = jump_to->GetDistination().x;
+            record.params[1]  = jump_to->GetDistination().y;
+            record.params[2]  = jump_to->GetJumpHeight();
+            record.jump_count = jump_to->GetJumpCount();
+        }
+        else if (auto jump_by = dynamic_cast<const JumpByAnimation*>(tween))
+        {
+            record.type       = AnimationType::JumpBy;
+            record.params[0]  = jump_by->GetDisplacement().x;
+            record.params[1]  = jump_by->GetDisplacement().y;
+            record.params[2]  = jump_by->GetJumpHeight();
+            record.jump_count = jump_by->GetJumpCount();
+        }
+        else if (auto scale_to = dynamic_cast<const ScaleToAnimation*>(tween))
+        {
+            record.type      = AnimationType::ScaleTo;
+            record.params[0] = scale_to->GetTargetScaleX();
+            record.params[1] = scale_to->GetTargetScaleY();
+        }
+        else if (auto scale_by = dynamic_cast<const ScaleByAnimation*>(tween))
+        {
+            record.type      = AnimationType::ScaleBy;
+            record.params[0] = scale_by->GetScaleX();
+            record.params[1] = scale_by->GetScaleY();
+        }
+        else if (auto fade_to = dynamic_cast<const FadeToAnimation*>(tween))
+        {
+            record.type      = AnimationType::FadeTo;
+            record.params[0] = fade_to->GetTargetOpacity();
+        }
+        else if (auto rotate_to = dynamic_cast<const RotateToAnimation*>(tween))
+        {
+            record.type      = AnimationType::RotateTo;
+            record.params[0] = rotate_to->GetTargetRotation();
+        }
+        else if (auto rotate_by = dynamic_cast<const RotateByAnimation*>(tween))
+        {
+            record.type      = AnimationType::RotateBy;
+            record.params[0] = rotate_by->GetRotation();
+        }
+        else
+        {
+            return;
+        }
+        animations_.push_back(record);
+    }
+
+    template <typename _Ty>
+    void CopySection(Vector<uint8_t>& buffer, FileHeader& header, Section section, const Vector<_Ty>& records,
+                     uint32_t& offset) const
+    {
+        header.sections[section].offset = offset;
+        header.sections[section].count  = uint32_t(records.size());
+        if (!records.empty())
+            std::memcpy(&buffer[offset], records.data(), records.size() * sizeof(_Ty));
+        offset += uint32_t((records.size() * sizeof(_Ty) + 3) & ~size_t(3));
+    }
+
+    Vector<uint8_t> Finish() const
+    {
+        size_t total = sizeof(FileHeader);
+        total += nodes_.size() * sizeof(NodeRecord) + sprites_.size() * sizeof(SpriteRecord);
+        total += texts_.size() * sizeof(TextRecord) + shapes_.size() * sizeof(ShapeRecord);
+        total += animations_.size() * sizeof(AnimationRecord) + strings_.size() * sizeof(StringRecord);
+        total += floats_.size() * sizeof(float) + ((chars_.size() + 3) & ~size_t(3));
+
+        Vector<uint8_t> buffer(total);
+        FileHeader      header  = {};
+        header.magic            = SceneMagic;
+        header.version          = SceneArchive::Version;
+        header.header_size      = uint16_t(sizeof(FileHeader));
+
+        uint32_t offset = uint32_t(sizeof(FileHeader));
+        CopySection(buffer, header, NodeSection, nodes_, offset);
+        CopySection(buffer, header, SpriteSection, sprites_, offset);
+        CopySection(buffer, header, TextSection, texts_, offset);
+        CopySection(buffer, header, ShapeSection, shapes_, offset);
+        CopySection(buffer, header, AnimationSection, animations_, offset);
+        CopySection(buffer, header, StringSection, strings_, offset);
+        CopySection(buffer, header, FloatSection, floats_, offset);
+        CopySection(buffer, header, CharSection, chars_, offset);
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        return buffer;
+    }
+
+private:
+    Vector<NodeRecord>             nodes_;
+    Vector<SpriteRecord>           sprites_;
+    Vector<TextRecord>             texts_;
+    Vector<ShapeRecord>            shapes_;
+    Vector<AnimationRecord>        animations_;
+    Vector<StringRecord>           strings_;
+    Vector<float>                  floats_;
+    Vector<char>                   chars_;
+    UnorderedMap<String, uint32_t> string_index_;
+};
+
+class ArchiveReader
+{
+public:
+    ArchiveReader(const uint8_t* data, size_t size, ResourceCache* cache)
+        : data_(data)
+        , size_(size)
+        , cache_(cache)
+        , header_(nullptr)
+    {
+    }
+
+    RefPtr<Actor> Read()
+    {
+        if (!ReadHeader())
+            return nullptr;
+
+        const auto* nodes = GetSection<NodeRecord>(NodeSection);
+        const auto  count = header_->sections[NodeSection].count;
+        if (count == 0)
+        {
+            KGE_ERRORF("SceneArchive: scene data has no root actor");
+            return nullptr;
+        }
+
+        Vector<RefPtr<Actor>> actors(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const NodeRecord& record = nodes[i];
+            if ((i == 0) != (record.parent == NoIndex) || (i > 0 && record.parent >= i))
+            {
+                KGE_ERRORF("SceneArchive: actor %u has an invalid parent", i);
+                return nullptr;
+            }
+
+            actors[i] = CreateActor(record);
+            if (!actors[i])
+            {
+                KGE_ERRORF("SceneArchive: actor %u is invalid", i);
+                return nullptr;
+            }
+
+            if (i > 0)
+                actors[record.parent]->AddChild(actors[i]);
+        }
+        return actors[0];
+    }
+
+private:
+    bool ReadHeader()
+    {
+        if (size_ < sizeof(FileHeader))
+        {
+            KGE_ERRORF("SceneArchive: scene data is too small");
+            return false;
+        }
+
+        // ¼Ҫ 4 ֽڶ룬δȸһ
+        if (reinterpret_cast<uintptr_t>(data_) % alignof(uint32_t) != 0)
+        {
+            aligned_copy_.resize((size_ + 3) / 4);
+            std::memcpy(aligned_copy_.data(), data_, size_);
+            data_ = reinterpret_cast<const uint8_t*>(aligned_copy_.data());
+        }
+
+        header_ = reinterpret_cast<const FileHeader*>(data_);
+        if (header_->magic != SceneMagic)
+        {
+            KGE_ERRORF("SceneArchive: scene data has an invalid magic number");
+            return false;
+        }
+        if (header_->version != SceneArchive::Version || header_->header_size != sizeof(FileHeader))
+        {
+            KGE_ERRORF("SceneArchive: unsupported scene version %u", uint32_t(header_->version));
+            return false;
+        }
+
+        for (uint32_t i = 0; i < SectionCount; ++i)
+        {
+            const SectionEntry& entry = header_->sections[i];
+            if (entry.offset % 4 != 0 || entry.offset < sizeof(FileHeader) || entry.offset > size_
+                || entry.count > (size_ - entry.offset) / RecordSizes[i])
+            {
+                KGE_ERRORF("SceneArchive: section %u is out of bounds", i);
+                return false;
+            }
+        }
+
+        const auto* strings = GetSection<StringRecord>(StringSection);
+        const auto* chars   = GetSection<char>(CharSection);
+        const auto  count   = header_->sections[CharSection].count;
+        for (uint32_t i = 0; i < header_->sections[StringSection].count; ++i)
+        {
+            if (strings[i].offset > count || strings[i].length >= count - strings[i].offset
+                || chars[strings[i].offset + strings[i].length] != '\0')
+            {
+                KGE_ERRORF("SceneArchive: string %u is out of bounds", i);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename _Ty>
+    const _Ty* GetSection(Section section) const
+    {
+        return reinterpret_cast<const _Ty*>(data_ + header_->sections[section].offset);
+    }
+
+    template <typename _Ty>
+    const _Ty* GetRecord(Section section, uint32_t index) const
+    {
+        if (index >= header_->sections[section].count)
+            return nullptr;
+        return GetSection<_Ty>(section) + index;
+    }
+
+    bool IsValidString(uint32_t index) const
+    {
+        return index == NoIndex || index < header_->sections[StringSection].count;
+    }
+
+    StringView GetString(uint32_t index) const
+    {
+        if (index == NoIndex)
+            return StringView();
+
+        const StringRecord& record = GetSection<StringRecord>(StringSection)[index];
+        return StringView(GetSection<char>(CharSection) + record.offset, record.length);
+    }
+
+    RefPtr<Actor> CreateActor(const NodeRecord& record)
+    {
+        if (uint32_t(record.type) > uint32_t(NodeType::Last) || !IsValidString(record.name)
+            || record.animation_begin > header_->sections[AnimationSection].count
+            || record.animation_count > header_->sections[AnimationSection].count - record.animation_begin)
+        {
+            return nullptr;
+        }
+
+        RefPtr<Actor> actor;
+        switch (record.type)
+        {
+        case NodeType::Actor:
+            actor = MakePtr<Actor>();
+            break;
+        case NodeType::Sprite:
+            actor = CreateSprite(record.payload);
+            break;
+        case NodeType::Text:
+            actor = CreateText(record.payload);
+            break;
+        default:
+            actor = CreateShape(record.type, record.payload);
+            break;
+        }
+
+        if (!actor)
+            return nullptr;
+
+        actor->SetName(GetString(record.name));
+        actor->SetVisible((record.flags & NodeFlag::Visible) != 0);
+        actor->SetCascadeOpacityEnabled((record.flags & NodeFlag::CascadeOpacity) != 0);
+        actor->SetMouseEventClippingEnabled((record.flags & NodeFlag::MouseClipping) != 0);
+        actor->SetSubtreeCullingEnabled((record.flags & NodeFlag::SubtreeCulling) != 0);
+        actor->SetTransformBatchingEnabled((record.flags & NodeFlag::TransformBatching) != 0);
+        actor->SetCacheAsBitmapEnabled((record.flags & NodeFlag::CacheAsBitmap) != 0);
+        actor->SetUpdateIndependent((record.flags & NodeFlag::UpdateIndependent) != 0);
+        if (record.flags & NodeFlag::UpdatePausing)
+            actor->PauseUpdating();
+
+        actor->SetZOrder(record.z_order);
+        actor->SetOpacity(record.opacity);
+        actor->SetAnchor(record.anchor[0], record.anchor[1]);
+        actor->SetPosition(record.position[0], record.position[1]);
+        actor->SetScale(record.scale[0], record.scale[1]);
+        actor->SetSkew(record.skew[0], record.skew[1]);
+        actor->SetRotation(record.rotation);
+
+        // ֽɫĴСֲ־
+        if (record.type != NodeType::Text)
+            actor->SetSize(record.size[0], record.size[1]);
+
+        for (uint32_t i = 0; i < record.animation_count; ++i)
+        {
+            auto animation = CreateAnimation(GetSection<AnimationRecord>(AnimationSection)[record.animation_begin + i]);
+            if (!animation)
+                return nullptr;
+            actor->AddAnimation(animation);
+        }
+        return actor;
+    }
+
+    RefPtr<Actor> CreateSprite(uint32_t index)
+    {
+        const auto* record = GetRecord<SpriteRecord>(SpriteSection, index);
+        if (!record || !IsValidString(record->texture))
+            return nullptr;
+
+        RefPtr<Sprite> sprite = MakePtr<Sprite>();
+        if (record->texture != NoIndex)
+        {
+            if (auto texture = GetTexture(record->texture))
+            {
+                const Rect crop(record->crop[0], record->crop[1], record->crop[2], record->crop[3]);
+                sprite->SetFrame(SpriteFrame(texture, crop));
+            }
+        }
+        return sprite;
+    }
+
+    RefPtr<Actor> CreateText(uint32_t index)
+    {
+        const auto* record = GetRecord<TextRecord>(TextSection, index);
+        if (!record || !IsValidString(record->content) || !IsValidString(record->font_family)
+            || record->font_posture > uint32_t(FontPosture::Italic)
+            || record->font_stretch > uint32_t(FontStretch::UltraExpanded)
+            || record->alignment > uint32_t(TextAlign::Justified)
+            || record->word_wrapping > uint32_t(TextWordWrapping::Character))
+        {
+            return nullptr;
+        }
+
+        TextStyle style;
+        style.font = Font(GetString(record->font_family), record->font_size, record->font_weight,
+                          FontPosture(record->font_posture), FontStretch(record->font_stretch));
+        style.alignment          = TextAlign(record->alignment);
+        style.word_wrapping      = TextWordWrapping(record->word_wrapping);
+        style.line_spacing       = record->line_spacing;
+        style.wrap_width         = record->wrap_width;
+        style.show_underline     = (record->decoration & TextFlag::Underline) != 0;
+        style.show_strikethrough = (record->decoration & TextFlag::Strikethrough) != 0;
+
+        RefPtr<TextActor> text = MakePtr<TextActor>(GetString(record->content), style);
+        if (record->brush & BrushFlag::FillColor)
+            text->SetFillColor(LoadColor(record->fill_color));
+        if (record->brush & BrushFlag::StrokeColor)
+            text->SetOutlineColor(LoadColor(record->outline_color));
+        if (record->outline_width > 0)
+            text->SetOutlineStrokeStyle(MakePtr<StrokeStyle>(record->outline_width));
+        return text;
+    }
+
+    RefPtr<Actor> CreateShape(NodeType type, uint32_t index)
+    {
+        const auto* record = GetRecord<ShapeRecord>(ShapeSection, index);
+        if (!record)
+            return nullptr;
+
+        const float*       geometry = record->geometry;
+        RefPtr<ShapeActor> shape;
+        switch (type)
+        {
+        case NodeType::Line:
+            shape = MakePtr<LineActor>(Point(geometry[0], geometry[1]), Point(geometry[2], geometry[3]));
+            break;
+        case NodeType::Rect:
+            shape = MakePtr<RectActor>(Size(geometry[0], geometry[1]));
+            break;
+        case NodeType::RoundedRect:
+            shape = MakePtr<RoundedRectActor>(Size(geometry[0], geometry[1]), Vec2(geometry[2], geometry[3]));
+            break;
+        case NodeType::Circle:
+            shape = MakePtr<CircleActor>(geometry[0]);
+            break;
+        case NodeType::Ellipse:
+            shape = MakePtr<EllipseActor>(Vec2(geometry[0], geometry[1]));
+            break;
+        case NodeType::Polygon:
+        {
+            const uint32_t floats = header_->sections[FloatSection].count;
+            if (record->vertex_begin > floats || record->vertex_count > (floats - record->vertex_begin) / 2)
+                return nullptr;
+
+            const float*  data = GetSection<float>(FloatSection) + record->vertex_begin;
+            Vector<Point> vertices(record->vertex_count);
+            for (uint32_t i = 0; i < record->vertex_count; ++i)
+                vertices[i] = Point(data[i * 2], data[i * 2 + 1]);
+            shape = MakePtr<PolygonActor>(vertices);
+            break;
+        }
+        default:
+            return nullptr;
+        }
+
+        if (record->brush & BrushFlag::FillColor)
+            shape->SetFillColor(LoadColor(record->fill_color));
+        if (record->brush & BrushFlag::StrokeColor)
+            shape->SetStrokeColor(LoadColor(record->stroke_color));
+        if (record->stroke_width > 0)
+            shape->SetStrokeStyle(MakePtr<StrokeStyle>(record->stroke_width));
+        return shape;
+    }
+
+    RefPtr<Animation> CreateAnimation(const AnimationRecord& record)
+    {
+        if (uint32_t(record.type) > uint32_t(AnimationType::Last) || !IsValidString(record.name))
+            return nullptr;
+
+        const Duration duration = LoadDuration(record.duration);
+        const float*   params   = record.params;
+
+        RefPtr<Animation> animation;
+        switch (record.type)
+        {
+        case AnimationType::MoveBy:
+            animation = MakePtr<MoveByAnimation>(duration, Vec2(params[0], params[1]));
+            break;
+        case AnimationType::MoveTo:
+            animation = MakePtr<MoveToAnimation>(duration, Point(params[0], params[1]));
+            break;
+        case AnimationType::JumpBy:
+            animation = MakePtr<JumpByAnimation>(duration, Vec2(params[0], params[1]), params[2], record.jump_count);
+            break;
+        case AnimationType::JumpTo:
+            animation = MakePtr<JumpToAnimation>(duration, Point(params[0], params[1]), params[2], record.jump_count);
+            break;
+        case AnimationType::ScaleBy:
+            animation = MakePtr<ScaleByAnimation>(duration, Vec2(params[0], params[1]));
+            break;
+        case AnimationType::ScaleTo:
+            animation = MakePtr<ScaleToAnimation>(duration, Vec2(params[0], params[1]));
+            break;
+        case AnimationType::FadeTo:
+            animation = MakePtr<FadeToAnimation>(duration, params[0]);
+            break;
+        case AnimationType::RotateBy:
+            animation = MakePtr<RotateByAnimation>(duration, params[0]);
+            break;
+        case AnimationType::RotateTo:
+            animation = MakePtr<RotateToAnimation>(duration, params[0]);
+            break;
+        }
+
+        animation->SetName(GetString(record.name));
+        animation->SetLoops(record.loops);
+        animation->SetDelay(LoadDuration(record.delay));
+        return animation;
+    }
+
+    RefPtr<Texture> GetTexture(uint32_t index)
+    {
+        auto iter = textures_.find(index);
+        if (iter != textures_.end())
+            return iter->second;
+
+        const StringView key = GetString(index);
+
+        RefPtr<Texture> texture;
+        if (cache_)
+            texture = cache_->Get<Texture>(key);
+
+        if (!texture)
+        {
+            texture = MakePtr<Texture>();
+            if (!texture->Load(key))
+            {
+                KGE_WARNF("SceneArchive: texture '%s' not found", String(key.data(), key.size()).c_str());
+                texture = nullptr;
+            }
+        }
+        textures_.emplace(index, texture);
+        return texture;
+    }
+
+private:
+    const uint8_t*                          data_;
+    size_t                                  size_;
+    ResourceCache*                          cache_;
+    const FileHeader*                       header_;
+    Vector<uint32_t>                        aligned_copy_;
+    UnorderedMap<uint32_t, RefPtr<Texture>> textures_;
+};
+
+}  // namespace
+
+Vector<uint8_t> SceneArchive::Save(const Actor* root)
+{
+    if (!root)
+        return Vector<uint8_t>();
+
+    ArchiveWriter writer;
+    return writer.Write(root);
+}
+
+bool SceneArchive::SaveToFile(const Actor* root, StringView file_path)
+{
+    if (!root)
+        return false;
+
+    Vector<uint8_t> data = SceneArchive::Save(root);
+
+    std::ofstream ofs(String(file_path.data(), file_path.size()), std::ios::binary);
+    if (!ofs.is_open())
+        return false;
+
+    ofs.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+    return ofs.good();
+}
+
+RefPtr<Actor> SceneArchive::Load(const uint8_t* data, size_t size, ResourceCache* cache)
+{
+    if (!data)
+        return nullptr;
+
+    ArchiveReader reader(data, size, cache);
+    return reader.Read();
+}
+
+RefPtr<Actor> SceneArchive::LoadFromFile(StringView file_path, ResourceCache* cache)
+{
+    BinaryData archived = FileSystem::GetInstance().GetArchivedFileData(file_path);
+    if (archived.IsValid())
+    {
+        return SceneArchive::Load(static_cast<const uint8_t*>(archived.buffer), archived.size, cache);
+    }
+
+    MappedFile file;
+    if (!file.Open(file_path))
+    {
+        KGE_ERRORF("SceneArchive: failed to open scene file '%s'", String(file_path.data(), file_path.size()).c_str());
+        return nullptr;
+    }
+    return SceneArchive::Load(file.GetData(), file.GetSize(), cache);
+}
+
+}  // namespace kiwano
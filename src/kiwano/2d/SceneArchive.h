@@ -0,0 +1,80 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/2d/Actor.h>
+
+namespace kiwano
+{
+
+class ResourceCache;
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief 浵
+ * @details ɫΪ汾ĶƸʽмؽɫ
+ * ļɹ̶Сļ¼ɣʱֱӳڴ϶ȡ¼ֶε麯á
+ * ֵ֧ݰɫ㼶ͻԡֱ֡֡//ԲǾ/Բ/Բ/νɫԼ䶯
+ * ͵Ľɫӽ֧ͱ棻ԼˢеĽᱻ档
+ * ԶƱ棬ResourceCache еԴIDļصļ·
+ * ɫͨ RefObject::operator new װ memory::PoolAllocator ڴз
+ */
+class KGE_API SceneArchive
+{
+public:
+    /// \~chinese
+    /// @brief ǰʽ汾
+    static const uint16_t Version = 3;
+
+    /// \~chinese
+    /// @brief ɫΪֽڴ
+    /// @param root ɫ
+    static Vector<uint8_t> Save(const Actor* root);
+
+    /// \~chinese
+    /// @brief ɫ浽ļ
+    /// @param root ɫ
+    /// @param file_path ļ·
+    static bool SaveToFile(const Actor* root, StringView file_path);
+
+    /// \~chinese
+    /// @brief ڴؽɫ
+    /// @param data 
+    /// @param size ݴС
+    /// @param cache ʹõԴ棬δҵΪʱΪļ·
+    /// @return ɫЧʱؿ
+    static RefPtr<Actor> Load(const uint8_t* data, size_t size, ResourceCache* cache = nullptr);
+
+    /// \~chinese
+    /// @brief ļؽɫļڴӳ䷽ʽȡ
+    /// @param file_path ļ·
+    /// @param cache ʹõԴ棬δҵΪʱΪļ·
+    /// @return ɫļЧʱؿ
+    static RefPtr<Actor> LoadFromFile(StringView file_path, ResourceCache* cache = nullptr);
+};
+
+/** @} */
+
+}  // namespace kiwano
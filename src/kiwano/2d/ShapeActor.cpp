@@ -82,6 +82,7 @@ void ShapeActor::SetShape(RefPtr<Shape> shape)
         bounds_ = Rect{};
         SetSize(0.f, 0.f);
     }
+    MarkContentDirty();
 }
 
 void ShapeActor::OnRender(RenderContext& ctx)
@@ -249,6 +250,7 @@ PolygonActor::~PolygonActor() {}
 
 void PolygonActor::SetVertices(const Vector<Point>& vertices)
 {
+    vertices_ = vertices;
     if (vertices.size() > 1)
     {
         ShapeMaker maker;
@@ -315,10 +315,17 @@ public:
 
     virtual ~PolygonActor();
 
+    /// \~chinese
+    /// @brief ȡζ˵
+    const Vector<Point>& GetVertices() const;
+
     /// \~chinese
     /// @brief öζ˵
     /// @param vertices ζ˵㼯
     void SetVertices(const Vector<Point>& vertices);
+
+private:
+    Vector<Point> vertices_;
 };
 
 /** @} */
@@ -330,6 +337,7 @@ inline void ShapeActor::SetStrokeColor(const Color& color)
         stroke_brush_ = MakePtr<Brush>();
     }
     stroke_brush_->SetColor(color);
+    MarkContentDirty();
 }
 
 inline void ShapeActor::SetFillColor(const Color& color)
@@ -339,16 +347,19 @@ inline void ShapeActor::SetFillColor(const Color& color)
         fill_brush_ = MakePtr<Brush>();
     }
     fill_brush_->SetColor(color);
+    MarkContentDirty();
 }
 
 inline void ShapeActor::SetFillBrush(RefPtr<Brush> brush)
 {
     fill_brush_ = brush;
+    MarkContentDirty();
 }
 
 inline void ShapeActor::SetStrokeBrush(RefPtr<Brush> brush)
 {
     stroke_brush_ = brush;
+    MarkContentDirty();
 }
 
 inline RefPtr<Brush> ShapeActor::GetFillBrush() const
@@ -374,6 +385,7 @@ inline RefPtr<Shape> ShapeActor::GetShape() const
 inline void ShapeActor::SetStrokeStyle(RefPtr<StrokeStyle> stroke_style)
 {
     stroke_style_ = stroke_style;
+    MarkContentDirty();
 }
 
 inline const Point& LineActor::GetBeginPoint() const
@@ -416,6 +428,11 @@ inline float CircleActor::GetRadius() const
     return radius_;
 }
 
+inline const Vector<Point>& PolygonActor::GetVertices() const
+{
+    return vertices_;
+}
+
 inline Vec2 EllipseActor::GetRadius() const
 {
     return radius_;
@@ -91,6 +91,7 @@ void Sprite::SetFrame(const SpriteFrame& frame)
 {
     frame_ = frame;
     SetSize(frame_.GetSize());
+    MarkContentDirty();
 
     if (!frame_.IsValid())
     {
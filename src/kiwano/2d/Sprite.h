@@ -36,6 +36,8 @@ namespace kiwano
  */
 class KGE_API Sprite : public Actor
 {
+    friend class SpriteBatchActor;
+
 public:
     Sprite();
 
@@ -140,6 +142,7 @@ inline SpriteFrame Sprite::GetFrame() const
 inline void Sprite::SetCropRect(const Rect& crop_rect)
 {
     frame_.SetCropRect(crop_rect);
+    MarkContentDirty();
 }
 
 }  // namespace kiwano
@@ -0,0 +1,96 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/SpriteBatchActor.h>
+#include <kiwano/2d/Sprite.h>
+#include <kiwano/2d/Stage.h>
+#include <typeinfo>
+
+namespace kiwano
+{
+
+SpriteBatchActor::SpriteBatchActor()
+    : batching_enabled_(true)
+{
+}
+
+SpriteBatchActor::~SpriteBatchActor() {}
+
+void SpriteBatchActor::RenderChildren(RenderContext& ctx)
+{
+    batch_.ResetStats();
+
+    Actor::RenderChildren(ctx);
+    batch_.Flush(ctx);
+}
+
+void SpriteBatchActor::RenderChild(RenderContext& ctx, Actor* child)
+{
+    if (!AddToBatch(ctx, child))
+    {
+        batch_.Flush(ctx);
+        child->Render(ctx);
+    }
+}
+
+void SpriteBatchActor::PrepareToRender(RenderContext& ctx)
+{
+    // the sprites collected so far are below the content of this actor
+    batch_.Flush(ctx);
+    Actor::PrepareToRender(ctx);
+}
+
+bool SpriteBatchActor::AddToBatch(RenderContext& ctx, Actor* child)
+{
+    if (!batching_enabled_)
+        return false;
+
+    // derived classes may draw something else in OnRender
+    if (typeid(*child) != typeid(Sprite) || !child->children_.IsEmpty() || !child->GetAllComponents().empty())
+        return false;
+
+    // these are handled by Actor::Render
+    if (child->bitmap_cache_ || child->transform_batch_ || child->subtree_culling_)
+        return false;
+
+    if (!child->IsVisible())
+        return true;
+
+    child->UpdateTransform();
+    child->UpdateOpacity();
+
+    Stage* stage = GetStage();
+    if (!child->CheckVisibility(ctx))
+    {
+        if (stage)
+            ++stage->culled_actor_count_;
+        return true;
+    }
+
+    const SpriteFrame& frame = static_cast<Sprite*>(child)->frame_;
+    batch_.Add(*frame.GetTexture(), frame.GetCropRect(), child->GetBounds(), child->transform_matrix_,
+               child->GetDisplayedOpacity());
+
+    if (stage)
+        ++stage->rendered_actor_count_;
+    return true;
+}
+
+}  // namespace kiwano
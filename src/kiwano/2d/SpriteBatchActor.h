@@ -0,0 +1,122 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/2d/Actor.h>
+#include <kiwano/render/SpriteBatch.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ɫ
+ * @details Ⱦӽɫʱûӽɫ Sprite ģʽ͸ȶͬ
+ * ֻύһλơӽɫύռľٰԭʽȾԱZ˳
+ * д OnRender  Sprite ࣬Լλͼ桢任üľ鲻ᱻϲ
+ * ǰԭʽȾɫλͼ桢任üͨɫͬ
+ */
+class KGE_API SpriteBatchActor : public Actor
+{
+public:
+    SpriteBatchActor();
+
+    virtual ~SpriteBatchActor();
+
+    /// \~chinese
+    /// @brief û
+    void SetBatchingEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿ
+    bool IsBatchingEnabled() const;
+
+    /// \~chinese
+    /// @brief ûð
+    /// @details ڵķǾӽɫ֮ľᰴʹòͬһصľ˳ܸı
+    void SetSortingEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿ˰
+    bool IsSortingEnabled() const;
+
+    /// \~chinese
+    /// @brief ȡһ֡ľύ
+    uint32_t GetSubmissionCount() const;
+
+    /// \~chinese
+    /// @brief ȡһ֡ͨλƵľ
+    uint32_t GetBatchedSpriteCount() const;
+
+protected:
+    void RenderChildren(RenderContext& ctx) override;
+
+    void RenderChild(RenderContext& ctx, Actor* child) override;
+
+    void PrepareToRender(RenderContext& ctx) override;
+
+private:
+    /// \~chinese
+    /// @brief ԽӽɫΣ޷ϲʱؼ
+    bool AddToBatch(RenderContext& ctx, Actor* child);
+
+private:
+    bool        batching_enabled_;
+    SpriteBatch batch_;
+};
+
+/** @} */
+
+inline void SpriteBatchActor::SetBatchingEnabled(bool enabled)
+{
+    batching_enabled_ = enabled;
+}
+
+inline bool SpriteBatchActor::IsBatchingEnabled() const
+{
+    return batching_enabled_;
+}
+
+inline void SpriteBatchActor::SetSortingEnabled(bool enabled)
+{
+    batch_.SetSortingEnabled(enabled);
+}
+
+inline bool SpriteBatchActor::IsSortingEnabled() const
+{
+    return batch_.IsSortingEnabled();
+}
+
+inline uint32_t SpriteBatchActor::GetSubmissionCount() const
+{
+    return batch_.GetSubmissionCount();
+}
+
+inline uint32_t SpriteBatchActor::GetBatchedSpriteCount() const
+{
+    return batch_.GetSubmittedSpriteCount();
+}
+
+}  // namespace kiwano
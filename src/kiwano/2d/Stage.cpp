@@ -26,11 +26,16 @@ namespace kiwano
 {
 
 Stage::Stage()
+    : rendered_actor_count_(0)
+    , culled_actor_count_(0)
 {
     SetStage(this);
 
     SetAnchor(Vec2{ 0, 0 });
     SetSize(Renderer::GetInstance().GetOutputSize());
+
+    // listeners on the stage usually expect every mouse event
+    SetMouseEventClippingEnabled(false);
 }
 
 Stage::~Stage() {}
@@ -45,6 +50,14 @@ void Stage::OnExit()
     KGE_DEBUG_LOGF("Stage exited");
 }
 
+void Stage::Render(RenderContext& ctx)
+{
+    rendered_actor_count_ = 0;
+    culled_actor_count_   = 0;
+
+    Actor::Render(ctx);
+}
+
 void Stage::RenderBorder(RenderContext& ctx)
 {
     ctx.SetBrushOpacity(GetDisplayedOpacity());
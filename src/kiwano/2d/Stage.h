@@ -38,6 +38,8 @@ namespace kiwano
  */
 class KGE_API Stage : public Actor
 {
+    friend class Actor;
+    friend class SpriteBatchActor;
     friend class Transition;
     friend class Director;
 
@@ -72,12 +74,27 @@ public:
     /// @brief ýɫ߽ˢ
     void SetBorderStrokeBrush(RefPtr<Brush> brush);
 
+    /// \~chinese
+    /// @brief ȡһ֡ȾĽɫ
+    uint32_t GetRenderedActorCount() const;
+
+    /// \~chinese
+    /// @brief ȡһ֡üĽɫ
+    /// @details ڵĽɫԼüнɫ
+    uint32_t GetCulledActorCount() const;
+
 protected:
+    /// \~chinese
+    /// @brief Ⱦӽɫ
+    void Render(RenderContext& ctx) override;
+
     /// \~chinese
     /// @brief ӽɫı߽
     void RenderBorder(RenderContext& ctx) override;
 
 private:
+    uint32_t      rendered_actor_count_;
+    uint32_t      culled_actor_count_;
     RefPtr<Brush> border_fill_brush_;
     RefPtr<Brush> border_stroke_brush_;
 };
@@ -103,4 +120,14 @@ inline void Stage::SetBorderStrokeBrush(RefPtr<Brush> brush)
 {
     border_stroke_brush_ = brush;
 }
+
+inline uint32_t Stage::GetRenderedActorCount() const
+{
+    return rendered_actor_count_;
+}
+
+inline uint32_t Stage::GetCulledActorCount() const
+{
+    return culled_actor_count_;
+}
 }  // namespace kiwano
@@ -246,10 +246,12 @@ void TextActor::UpdateDirtyLayout()
     if (layout_ && layout_->UpdateIfDirty())
     {
         ForceUpdateLayout();
+        MarkContentDirty();
     }
     else if (is_cache_dirty_)
     {
         UpdateCachedTexture();
+        MarkContentDirty();
     }
 }
 
@@ -275,6 +277,7 @@ void TextActor::UpdateCachedTexture()
 
     if (!texture_cached_)
     {
+        is_cache_dirty_ = false;
         return;
     }
 
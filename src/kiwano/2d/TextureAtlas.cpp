@@ -0,0 +1,197 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/TextureAtlas.h>
+#include <kiwano/render/RenderContext.h>
+#include <kiwano/utils/Logger.h>
+#include <algorithm>
+#include <cmath>
+
+namespace kiwano
+{
+
+TextureAtlasPacker::TextureAtlasPacker(const PixelSize& page_size, uint32_t padding)
+    : padding_(padding)
+    , page_count_(0)
+    , page_size_(page_size)
+{
+}
+
+Vector<TextureAtlasPacker::Placement> TextureAtlasPacker::Pack(const Vector<Size>& sizes)
+{
+    shelves_.clear();
+    page_count_ = 0;
+
+    Vector<Placement> placements(sizes.size());
+    Vector<size_t>    order(sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        placements[i].page = InvalidPage;
+        order[i]           = i;
+    }
+
+    // taller rectangles first keeps shelves tightly filled
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t lhs, size_t rhs) { return sizes[lhs].y > sizes[rhs].y; });
+
+    for (auto index : order)
+    {
+        const uint32_t width  = uint32_t(std::ceil(sizes[index].x));
+        const uint32_t height = uint32_t(std::ceil(sizes[index].y));
+
+        if (width == 0 || height == 0 || width + padding_ * 2 > page_size_.x || height + padding_ * 2 > page_size_.y)
+            continue;
+
+        Shelf* target = nullptr;
+        for (auto& shelf : shelves_)
+        {
+            if (height <= shelf.height && shelf.used_width + width + padding_ <= page_size_.x)
+            {
+                target = &shelf;
+                break;
+            }
+        }
+
+        if (!target)
+        {
+            Shelf shelf;
+            shelf.page       = page_count_ ? page_count_ - 1 : 0;
+            shelf.y          = padding_;
+            shelf.height     = height;
+            shelf.used_width = padding_;
+
+            if (page_count_ > 0)
+            {
+                // stack onto the last shelf of the current page
+                const Shelf& last = shelves_.back();
+                shelf.y           = last.y + last.height + padding_;
+            }
+
+            if (page_count_ == 0 || shelf.y + height + padding_ > page_size_.y)
+            {
+                shelf.page = page_count_++;
+                shelf.y    = padding_;
+            }
+
+            shelves_.push_back(shelf);
+            target = &shelves_.back();
+        }
+
+        placements[index].page = target->page;
+        placements[index].rect = Rect(float(target->used_width), float(target->y), float(target->used_width + width),
+                                      float(target->y + height));
+
+        target->used_width += width + padding_;
+    }
+    return placements;
+}
+
+TextureAtlas::TextureAtlas() {}
+
+TextureAtlas::~TextureAtlas() {}
+
+void TextureAtlas::AddFrame(const String& name, const SpriteFrame& frame)
+{
+    auto iter = indices_.find(name);
+    if (iter != indices_.end())
+    {
+        frames_[iter->second] = frame;
+    }
+    else
+    {
+        indices_.insert(std::make_pair(name, frames_.size()));
+        names_.push_back(name);
+        frames_.push_back(frame);
+    }
+}
+
+bool TextureAtlas::Build(const PixelSize& page_size, uint32_t padding)
+{
+    Vector<Size> sizes(frames_.size());
+    for (size_t i = 0; i < frames_.size(); ++i)
+    {
+        if (frames_[i].IsValid())
+            sizes[i] = frames_[i].GetSize();
+    }
+
+    TextureAtlasPacker packer(page_size, padding);
+    auto               placements = packer.Pack(sizes);
+
+    Vector<RefPtr<Texture>>       pages(packer.GetPageCount());
+    Vector<RefPtr<RenderContext>> contexts(packer.GetPageCount());
+    for (uint32_t i = 0; i < packer.GetPageCount(); ++i)
+    {
+        pages[i]    = MakePtr<Texture>();
+        contexts[i] = RenderContext::Create(pages[i], page_size);
+        if (!contexts[i])
+        {
+            KGE_ERRORF("Create texture atlas page failed (%u x %u)", page_size.x, page_size.y);
+            return false;
+        }
+
+        contexts[i]->BeginDraw();
+        contexts[i]->Clear();
+    }
+
+    for (size_t i = 0; i < frames_.size(); ++i)
+    {
+        const auto& placement = placements[i];
+        if (placement.page == TextureAtlasPacker::InvalidPage)
+        {
+            if (frames_[i].IsValid())
+                KGE_WARNF("Sprite frame '%s' does not fit in the texture atlas", names_[i].c_str());
+            continue;
+        }
+
+        auto& ctx = contexts[placement.page];
+        ctx->SetTransform(Matrix3x2());
+        ctx->DrawTexture(*frames_[i].GetTexture(), &frames_[i].GetCropRect(), &placement.rect);
+
+        frames_[i] = SpriteFrame(pages[placement.page], placement.rect);
+    }
+
+    for (auto& ctx : contexts)
+    {
+        ctx->EndDraw();
+    }
+
+    pages_ = std::move(pages);
+    return true;
+}
+
+SpriteFrame TextureAtlas::GetFrame(const String& name) const
+{
+    auto iter = indices_.find(name);
+    if (iter != indices_.end())
+    {
+        return frames_[iter->second];
+    }
+    return SpriteFrame();
+}
+
+void TextureAtlas::Clear()
+{
+    names_.clear();
+    indices_.clear();
+    frames_.clear();
+    pages_.clear();
+}
+
+}  // namespace kiwano
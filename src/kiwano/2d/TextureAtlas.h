@@ -0,0 +1,142 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/core/Common.h>
+#include <kiwano/2d/SpriteFrame.h>
+
+namespace kiwano
+{
+
+/**
+ * \~chinese
+ * @brief ͼװ
+ * @details ʹû㷨е̶СҳУֻм㣬漰
+ */
+class KGE_API TextureAtlasPacker
+{
+public:
+    /// \~chinese
+    /// @brief εİڷλ
+    struct Placement
+    {
+        uint32_t page;  ///< ҳ޷ڷʱΪ InvalidPage
+        Rect     rect;  ///< ҳе򣬲
+    };
+
+    /// \~chinese
+    /// @brief Чҳ
+    static const uint32_t InvalidPage = uint32_t(-1);
+
+    /// \~chinese
+    /// @brief װ
+    /// @param page_size ҳС
+    /// @param padding ֮ԼҳԵļ
+    TextureAtlasPacker(const PixelSize& page_size, uint32_t padding = 1);
+
+    /// \~chinese
+    /// @brief װ
+    /// @param sizes δС
+    /// @return ˳ӦİڷλãҳСľ޷ڷ
+    Vector<Placement> Pack(const Vector<Size>& sizes);
+
+    /// \~chinese
+    /// @brief ȡһװʹõҳ
+    uint32_t GetPageCount() const;
+
+private:
+    struct Shelf
+    {
+        uint32_t page;
+        uint32_t y;
+        uint32_t height;
+        uint32_t used_width;
+    };
+
+    uint32_t      padding_;
+    uint32_t      page_count_;
+    PixelSize     page_size_;
+    Vector<Shelf> shelves_;
+};
+
+/**
+ * \~chinese
+ * @brief ͼ
+ * @details ڼʱ֡ƵУʹԹ
+ */
+class KGE_API TextureAtlas : public ObjectBase
+{
+public:
+    TextureAtlas();
+
+    virtual ~TextureAtlas();
+
+    /// \~chinese
+    /// @brief Ӵϲľ֡
+    /// @param name ֡
+    /// @param frame ֡
+    void AddFrame(const String& name, const SpriteFrame& frame);
+
+    /// \~chinese
+    /// @brief ӵľ֡Ƶͼҳ
+    /// @param page_size ҳС
+    /// @param padding ֮֡ļ
+    /// @details ҳСľ֡ԭ
+    bool Build(const PixelSize& page_size = PixelSize(2048, 2048), uint32_t padding = 1);
+
+    /// \~chinese
+    /// @brief ȡ֡󷵻ͼеľ֡
+    SpriteFrame GetFrame(const String& name) const;
+
+    /// \~chinese
+    /// @brief ȡ֡
+    size_t GetFramesCount() const;
+
+    /// \~chinese
+    /// @brief ȡͼҳ
+    const Vector<RefPtr<Texture>>& GetPages() const;
+
+    /// \~chinese
+    /// @brief ͼ
+    void Clear();
+
+private:
+    Vector<String>               names_;
+    UnorderedMap<String, size_t> indices_;
+    Vector<SpriteFrame>          frames_;
+    Vector<RefPtr<Texture>>      pages_;
+};
+
+inline uint32_t TextureAtlasPacker::GetPageCount() const
+{
+    return page_count_;
+}
+
+inline size_t TextureAtlas::GetFramesCount() const
+{
+    return frames_.size();
+}
+
+inline const Vector<RefPtr<Texture>>& TextureAtlas::GetPages() const
+{
+    return pages_;
+}
+
+}  // namespace kiwano
@@ -0,0 +1,208 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/TransformStore.h>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define KGE_TRANSFORM_STORE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace kiwano
+{
+
+TransformStore::TransformStore() {}
+
+void TransformStore::Clear()
+{
+    parents_.clear();
+    dirty_.clear();
+    composed_.clear();
+    for (int i = 0; i < 6; ++i)
+    {
+        local_[i].clear();
+        world_[i].clear();
+    }
+}
+
+void TransformStore::Reserve(size_t count)
+{
+    parents_.reserve(count);
+    dirty_.reserve(count);
+    composed_.reserve(count);
+    for (int i = 0; i < 6; ++i)
+    {
+        local_[i].reserve(count);
+        world_[i].reserve(count);
+    }
+}
+
+uint32_t TransformStore::AddNode(uint32_t parent, const Matrix3x2& local)
+{
+    const uint32_t index = uint32_t(parents_.size());
+    KGE_ASSERT((parent == NoParent || parent < index) && "TransformStore::AddNode failed, parent must be added first");
+
+    parents_.push_back(parent);
+    dirty_.push_back(1);
+    composed_.push_back(0);
+    for (int i = 0; i < 6; ++i)
+    {
+        local_[i].push_back(local[i]);
+        world_[i].push_back(local[i]);
+    }
+    return index;
+}
+
+void TransformStore::SetLocal(uint32_t index, const Matrix3x2& local)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        local_[i][index] = local[i];
+    }
+    dirty_[index] = 1;
+}
+
+Matrix3x2 TransformStore::GetLocal(uint32_t index) const
+{
+    return Matrix3x2(local_[0][index], local_[1][index], local_[2][index], local_[3][index], local_[4][index],
+                     local_[5][index]);
+}
+
+Matrix3x2 TransformStore::GetWorld(uint32_t index) const
+{
+    return Matrix3x2(world_[0][index], world_[1][index], world_[2][index], world_[3][index], world_[4][index],
+                     world_[5][index]);
+}
+
+void TransformStore::SetWorld(uint32_t index, const Matrix3x2& world)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        world_[i][index] = world[i];
+    }
+}
+
+void TransformStore::ComposeNode(size_t index, const float* root)
+{
+    const uint32_t parent = parents_[index];
+
+    float p[6];
+    for (int i = 0; i < 6; ++i)
+    {
+        p[i] = (parent == NoParent) ? root[i] : world_[i][parent];
+    }
+
+    const float l11 = local_[0][index], l12 = local_[1][index];
+    const float l21 = local_[2][index], l22 = local_[3][index];
+    const float l31 = local_[4][index], l32 = local_[5][index];
+
+    world_[0][index] = l11 * p[0] + l12 * p[2];
+    world_[1][index] = l11 * p[1] + l12 * p[3];
+    world_[2][index] = l21 * p[0] + l22 * p[2];
+    world_[3][index] = l21 * p[1] + l22 * p[3];
+    world_[4][index] = l31 * p[0] + l32 * p[2] + p[4];
+    world_[5][index] = l31 * p[1] + l32 * p[3] + p[5];
+}
+
+size_t TransformStore::Compose(const Matrix3x2& root, bool root_dirty)
+{
+    const size_t count = parents_.size();
+    float        root_m[6];
+    for (int i = 0; i < 6; ++i)
+    {
+        root_m[i] = root[i];
+    }
+
+    // a node is recomposed when it or any of its ancestors changed
+    size_t composed_count = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t parent         = parents_[i];
+        const bool     parent_changed = (parent == NoParent) ? root_dirty : (composed_[parent] != 0);
+
+        composed_[i] = (dirty_[i] || parent_changed) ? 1 : 0;
+        dirty_[i]    = 0;
+        composed_count += composed_[i];
+    }
+
+    if (composed_count == 0)
+        return 0;
+
+    size_t i = 0;
+
+#ifdef KGE_TRANSFORM_STORE_SSE2
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint32_t* parents = &parents_[i];
+
+        // parents inside the block would be read before they are written
+        const bool independent = (parents[0] == NoParent || parents[0] < i) && (parents[1] == NoParent || parents[1] < i)
+                                 && (parents[2] == NoParent || parents[2] < i)
+                                 && (parents[3] == NoParent || parents[3] < i);
+        const bool all_composed = composed_[i] && composed_[i + 1] && composed_[i + 2] && composed_[i + 3];
+
+        if (!independent || !all_composed)
+        {
+            for (size_t j = i; j < i + 4; ++j)
+            {
+                if (composed_[j])
+                    ComposeNode(j, root_m);
+            }
+            continue;
+        }
+
+        __m128 p[6];
+        for (int k = 0; k < 6; ++k)
+        {
+            const float* world = world_[k].data();
+
+            p[k] = _mm_set_ps(parents[3] == NoParent ? root_m[k] : world[parents[3]],
+                              parents[2] == NoParent ? root_m[k] : world[parents[2]],
+                              parents[1] == NoParent ? root_m[k] : world[parents[1]],
+                              parents[0] == NoParent ? root_m[k] : world[parents[0]]);
+        }
+
+        const __m128 l11 = _mm_loadu_ps(&local_[0][i]);
+        const __m128 l12 = _mm_loadu_ps(&local_[1][i]);
+        const __m128 l21 = _mm_loadu_ps(&local_[2][i]);
+        const __m128 l22 = _mm_loadu_ps(&local_[3][i]);
+        const __m128 l31 = _mm_loadu_ps(&local_[4][i]);
+        const __m128 l32 = _mm_loadu_ps(&local_[5][i]);
+
+        _mm_storeu_ps(&world_[0][i], _mm_add_ps(_mm_mul_ps(l11, p[0]), _mm_mul_ps(l12, p[2])));
+        _mm_storeu_ps(&world_[1][i], _mm_add_ps(_mm_mul_ps(l11, p[1]), _mm_mul_ps(l12, p[3])));
+        _mm_storeu_ps(&world_[2][i], _mm_add_ps(_mm_mul_ps(l21, p[0]), _mm_mul_ps(l22, p[2])));
+        _mm_storeu_ps(&world_[3][i], _mm_add_ps(_mm_mul_ps(l21, p[1]), _mm_mul_ps(l22, p[3])));
+        _mm_storeu_ps(&world_[4][i],
+                      _mm_add_ps(_mm_add_ps(_mm_mul_ps(l31, p[0]), _mm_mul_ps(l32, p[2])), p[4]));
+        _mm_storeu_ps(&world_[5][i],
+                      _mm_add_ps(_mm_add_ps(_mm_mul_ps(l31, p[1]), _mm_mul_ps(l32, p[3])), p[5]));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (composed_[i])
+            ComposeNode(i, root_m);
+    }
+    return composed_count;
+}
+
+}  // namespace kiwano
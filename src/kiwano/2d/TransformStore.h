@@ -0,0 +1,137 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/core/Common.h>
+#include <kiwano/math/Math.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ά任洢
+ * @details Խṹʽڵĸڵֲ任任ڵСӽڵ㡣
+ * 任ʱֻһԱ֧ SSE2 ʱÿμĸڵ㡣
+ * 㼶˳򣨹ȣӽڵʱͬһ㼶Ľڵ㻥̶ȵ SIMD ָ
+ */
+class KGE_API TransformStore : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief ޸ڵ㣬任ڸ任
+    static const uint32_t NoParent = uint32_t(-1);
+
+    TransformStore();
+
+    /// \~chinese
+    /// @brief нڵ
+    void Clear();
+
+    /// \~chinese
+    /// @brief Ԥڵռ
+    void Reserve(size_t count);
+
+    /// \~chinese
+    /// @brief ӽڵ
+    /// @param parent ڵӵĽڵ NoParent
+    /// @param local ڸڵı任
+    /// @return ڵ
+    uint32_t AddNode(uint32_t parent, const Matrix3x2& local = Matrix3x2());
+
+    /// \~chinese
+    /// @brief ȡڵ
+    size_t GetNodeCount() const;
+
+    /// \~chinese
+    /// @brief ȡڵ
+    uint32_t GetParent(uint32_t index) const;
+
+    /// \~chinese
+    /// @brief ڸڵı任ڵ㼰ӽڵһμʱ
+    void SetLocal(uint32_t index, const Matrix3x2& local);
+
+    /// \~chinese
+    /// @brief ǽڵҪ£ڸ任ڴ洢֮ⷢ仯
+    void MarkDirty(uint32_t index);
+
+    /// \~chinese
+    /// @brief ȡڸڵı任
+    Matrix3x2 GetLocal(uint32_t index) const;
+
+    /// \~chinese
+    /// @brief ȡ任
+    Matrix3x2 GetWorld(uint32_t index) const;
+
+    /// \~chinese
+    /// @brief 任ڽڵڴ洢֮Ѿ任
+    /// @details ǽڵҪ£ڵ㲻ҪʱӽڵԴΪ任
+    void SetWorld(uint32_t index, const Matrix3x2& world);
+
+    /// \~chinese
+    /// @brief ڵ任Ƿһμи
+    bool IsComposed(uint32_t index) const;
+
+    /// \~chinese
+    /// @brief 仯Ľڵ㼰ӽڵ任
+    /// @param root 任Ϊ޸ڵĽڵĸ任
+    /// @param root_dirty 任Ƿ仯仯ʱнڵ㶼
+    /// @return µĽڵ
+    size_t Compose(const Matrix3x2& root, bool root_dirty = false);
+
+private:
+    void ComposeNode(size_t index, const float* root);
+
+private:
+    Vector<uint32_t> parents_;
+    Vector<uint8_t>  dirty_;
+    Vector<uint8_t>  composed_;
+    Vector<float>    local_[6];
+    Vector<float>    world_[6];
+};
+
+/** @} */
+
+inline size_t TransformStore::GetNodeCount() const
+{
+    return parents_.size();
+}
+
+inline uint32_t TransformStore::GetParent(uint32_t index) const
+{
+    return parents_[index];
+}
+
+inline void TransformStore::MarkDirty(uint32_t index)
+{
+    dirty_[index] = 1;
+}
+
+inline bool TransformStore::IsComposed(uint32_t index) const
+{
+    return composed_[index] != 0;
+}
+
+}  // namespace kiwano
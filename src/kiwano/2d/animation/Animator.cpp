@@ -21,6 +21,7 @@
 #include <kiwano/2d/Actor.h>
 #include <kiwano/2d/animation/Animator.h>
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 
 namespace kiwano
 {
@@ -30,6 +31,8 @@ void Animator::Update(Actor* target, Duration dt)
     if (animations_.IsEmpty() || !target)
         return;
 
+    KGE_PROFILE_ZONE("Animator::Update");
+
     RefPtr<Animation> next;
     for (auto animation = animations_.GetFirst(); animation; animation = next)
     {
@@ -20,6 +20,7 @@
 
 #include <kiwano/2d/transition/Transition.h>
 #include <kiwano/render/Renderer.h>
+#include <kiwano/render/RenderContext.h>
 
 namespace kiwano
 {
@@ -34,6 +35,7 @@ Transition::Transition()
     , in_stage_(nullptr)
     , out_layer_(nullptr)
     , in_layer_(nullptr)
+    , snapshot_enabled_(false)
 {
 }
 
@@ -62,6 +64,36 @@ void Transition::Init(Stage* prev, Stage* next)
     {
         out_layer_.bounds = Rect{ Point(), window_size_ };
     }
+
+    out_snapshot_ = nullptr;
+    if (snapshot_enabled_ && out_stage_)
+    {
+        // falls back to rendering the stage every frame
+        CaptureOutStage();
+    }
+}
+
+bool Transition::CaptureOutStage()
+{
+    const PixelSize size(uint32_t(math::Ceil(window_size_.x)), uint32_t(math::Ceil(window_size_.y)));
+    if (size.x == 0 || size.y == 0)
+        return false;
+
+    RefPtr<Texture>       texture = MakePtr<Texture>();
+    RefPtr<RenderContext> ctx     = RenderContext::Create(texture, size);
+    if (!ctx)
+        return false;
+
+    // The snapshot is taken in the local space of the stage, so that transitions
+    // can keep moving the stage by its transform
+    ctx->SetGlobalTransform(out_stage_->GetTransformInverseMatrix());
+    ctx->BeginDraw();
+    ctx->Clear();
+    out_stage_->Render(*ctx);
+    ctx->EndDraw();
+
+    out_snapshot_ = texture;
+    return true;
 }
 
 void Transition::Update(Duration dt)
@@ -84,7 +116,19 @@ void Transition::Update(Duration dt)
 
 void Transition::Render(RenderContext& ctx)
 {
-    if (out_stage_)
+    if (out_snapshot_)
+    {
+        // the opacity of the stage is already in the snapshot
+        ctx.SetTransform(out_stage_->GetTransformMatrix());
+        ctx.SetBrushOpacity(1.f);
+        ctx.PushLayer(out_layer_);
+
+        const Rect bounds(Point(), window_size_);
+        ctx.DrawTexture(*out_snapshot_, nullptr, &bounds);
+
+        ctx.PopLayer();
+    }
+    else if (out_stage_)
     {
         out_stage_->PrepareToRender(ctx);
         ctx.PushLayer(out_layer_);
@@ -109,6 +153,8 @@ void Transition::Stop()
 {
     done_ = true;
     Reset();
+
+    out_snapshot_ = nullptr;
 }
 
 }  // namespace kiwano
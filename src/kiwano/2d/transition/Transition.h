@@ -21,6 +21,7 @@
 #pragma once
 #include <kiwano/2d/Stage.h>
 #include <kiwano/render/Layer.h>
+#include <kiwano/render/Texture.h>
 
 namespace kiwano
 {
@@ -62,6 +63,20 @@ public:
      */
     bool IsDone();
 
+    /**
+     * \~chinese
+     * @brief ûÿģʽ
+     * @details úת̨ڶʼʱȾУڼ䲻ٸºȾֻ̨
+     * @note ڽ̨ǰ
+     */
+    void SetSnapshotEnabled(bool enabled);
+
+    /**
+     * \~chinese
+     * @brief Ƿ˿ģʽ
+     */
+    bool IsSnapshotEnabled() const;
+
 protected:
     /**
      * \~chinese
@@ -97,6 +112,15 @@ protected:
      */
     virtual void Reset() {}
 
+    /**
+     * \~chinese
+     * @brief ת̨Ƿѱմ
+     */
+    bool IsOutStageFrozen() const;
+
+private:
+    bool CaptureOutStage();
+
 protected:
     bool          done_;
     float         process_;
@@ -107,6 +131,10 @@ protected:
     RefPtr<Stage> in_stage_;
     Layer         out_layer_;
     Layer         in_layer_;
+
+private:
+    bool            snapshot_enabled_;
+    RefPtr<Texture> out_snapshot_;
 };
 
 /** @} */
@@ -116,4 +144,19 @@ inline void Transition::SetDuration(Duration dt)
     duration_ = dt;
 }
 
+inline void Transition::SetSnapshotEnabled(bool enabled)
+{
+    snapshot_enabled_ = enabled;
+}
+
+inline bool Transition::IsSnapshotEnabled() const
+{
+    return snapshot_enabled_;
+}
+
+inline bool Transition::IsOutStageFrozen() const
+{
+    return out_snapshot_ != nullptr;
+}
+
 }  // namespace kiwano
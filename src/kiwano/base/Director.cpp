@@ -20,8 +20,10 @@
 
 #include <kiwano/2d/Actor.h>
 #include <kiwano/2d/DebugActor.h>
+#include <kiwano/2d/ParallelUpdater.h>
 #include <kiwano/2d/Stage.h>
 #include <kiwano/base/Director.h>
+#include <algorithm>
 
 namespace kiwano
 {
@@ -36,6 +38,9 @@ Director::~Director() {}
 void Director::DestroyModule()
 {
     ClearStages();
+
+    // join the update workers before static destruction
+    ParallelUpdater::GetInstance().SetEnabled(false);
 }
 
 void Director::EnterStage(RefPtr<Stage> stage, RefPtr<Transition> transition)
@@ -115,6 +120,15 @@ void Director::ShowDebugInfo(bool show)
 void Director::ClearStages()
 {
     dispatcher_list_.Clear();
+    key_dispatchers_.clear();
+    window_dispatchers_.clear();
+    mouse_targets_.clear();
+    mouse_unclipped_.clear();
+    mouse_hovered_.clear();
+    mouse_captured_.clear();
+    last_hovered_.clear();
+    last_captured_.clear();
+    mouse_grid_.Clear();
     stages_ = Stack<RefPtr<Stage>>();
 
     current_stage_.Reset();
@@ -124,13 +138,88 @@ void Director::ClearStages()
 }
 
 void Director::PushEventDispatcher(EventDispatcher* dispatcher)
+{
+    if (ParallelUpdater::Defer([this, dispatcher]() { PushEventDispatcher(dispatcher); }))
+        return;
+
+    AddEventDispatcher(dispatcher, nullptr, Rect());
+}
+
+void Director::PushEventDispatcher(Actor* actor)
+{
+    if (ParallelUpdater::IsDeferring())
+    {
+        RefPtr<Actor> holder = actor;
+        ParallelUpdater::Defer([this, holder]() { PushEventDispatcher(holder.Get()); });
+        return;
+    }
+
+    // actors without size cannot be hit, they receive all mouse events
+    const bool clipped = actor->IsMouseEventClippingEnabled() && !actor->GetSize().IsOrigin();
+    if (clipped)
+        AddEventDispatcher(actor, actor, actor->GetBoundingBox());
+    else
+        AddEventDispatcher(actor, nullptr, Rect());
+}
+
+void Director::AddEventDispatcher(EventDispatcher* dispatcher, Actor* clipped_actor, const Rect& bounds)
 {
     dispatcher_list_.PushBack(dispatcher);
+
+    // walk the listeners only once for all categories
+    const uint32_t mask = dispatcher->GetListenerMask<KeyEvent, WindowEvent, MouseEvent>();
+
+    if (mask & 0x1)
+        key_dispatchers_.push_back(dispatcher);
+
+    if (mask & 0x2)
+        window_dispatchers_.push_back(dispatcher);
+
+    if (!(mask & 0x4))
+        return;
+
+    const bool clipped = clipped_actor != nullptr;
+    const auto id      = uint32_t(mouse_targets_.size());
+    mouse_targets_.push_back(MouseEventTarget{ dispatcher, clipped_actor, clipped, bounds });
+
+    if (!clipped)
+    {
+        mouse_unclipped_.push_back(id);
+        return;
+    }
+
+    mouse_grid_.Insert(id, bounds);
+
+    // actors tracked in the last frame keep receiving mouse events
+    auto is_actor = [=](const RefPtr<Actor>& actor) { return actor.Get() == clipped_actor; };
+
+    if (std::find_if(last_hovered_.begin(), last_hovered_.end(), is_actor) != last_hovered_.end())
+        mouse_hovered_.push_back(id);
+
+    if (std::find_if(last_captured_.begin(), last_captured_.end(), is_actor) != last_captured_.end())
+        mouse_captured_.push_back(id);
 }
 
 void Director::OnUpdate(UpdateModuleContext& ctx)
 {
+    // the target ids are only valid in one frame, so remember the actors instead, and hold them
+    // so that an actor created at the address of a released one does not inherit its state
+    last_hovered_.clear();
+    for (auto id : mouse_hovered_)
+        last_hovered_.push_back(mouse_targets_[id].actor);
+
+    last_captured_.clear();
+    for (auto id : mouse_captured_)
+        last_captured_.push_back(mouse_targets_[id].actor);
+
     dispatcher_list_.Clear();
+    key_dispatchers_.clear();
+    window_dispatchers_.clear();
+    mouse_targets_.clear();
+    mouse_unclipped_.clear();
+    mouse_hovered_.clear();
+    mouse_captured_.clear();
+    mouse_grid_.Clear();
 
     if (transition_)
     {
@@ -153,7 +242,8 @@ void Director::OnUpdate(UpdateModuleContext& ctx)
         next_stage_    = nullptr;
     }
 
-    if (current_stage_)
+    // a stage replaced by its snapshot is paused until the transition ends
+    if (current_stage_ && !(transition_ && transition_->IsOutStageFrozen()))
         current_stage_->Update(ctx.dt);
 
     if (next_stage_)
@@ -187,10 +277,71 @@ void Director::OnRender(RenderModuleContext& ctx)
 
 void Director::HandleEvent(EventModuleContext& ctx)
 {
-    for (auto dispatcher : dispatcher_list_)
+    Event* evt = ctx.evt;
+    if (auto mouse_evt = evt->Cast<MouseEvent>())
+    {
+        DispatchMouseEvent(evt, mouse_evt->pos);
+    }
+    else if (evt->IsType<KeyEvent>())
+    {
+        for (size_t i = 0; i < key_dispatchers_.size(); ++i)
+        {
+            key_dispatchers_[i]->DispatchEvent(evt);
+        }
+    }
+    else if (evt->IsType<WindowEvent>())
     {
-        dispatcher->DispatchEvent(ctx.evt);
+        for (size_t i = 0; i < window_dispatchers_.size(); ++i)
+        {
+            window_dispatchers_[i]->DispatchEvent(evt);
+        }
     }
+    else
+    {
+        for (auto dispatcher : dispatcher_list_)
+        {
+            dispatcher->DispatchEvent(evt);
+        }
+    }
+}
+
+void Director::DispatchMouseEvent(Event* evt, const Point& pos)
+{
+    // candidates are the dispatchers under the cursor, the unclipped ones, the ones hovered by the last
+    // mouse event (so that they can see the cursor leaving) and the ones captured by a mouse down
+    mouse_candidates_.clear();
+    mouse_grid_.Query(pos, mouse_candidates_);
+    mouse_candidates_.insert(mouse_candidates_.end(), mouse_unclipped_.begin(), mouse_unclipped_.end());
+    mouse_candidates_.insert(mouse_candidates_.end(), mouse_hovered_.begin(), mouse_hovered_.end());
+    mouse_candidates_.insert(mouse_candidates_.end(), mouse_captured_.begin(), mouse_captured_.end());
+
+    // dispatch in the same order as the dispatchers were pushed
+    std::sort(mouse_candidates_.begin(), mouse_candidates_.end());
+    mouse_candidates_.erase(std::unique(mouse_candidates_.begin(), mouse_candidates_.end()), mouse_candidates_.end());
+
+    const bool pressed  = evt->IsType<MouseDownEvent>();
+    const bool released = evt->IsType<MouseUpEvent>();
+
+    mouse_hovered_.clear();
+    for (auto id : mouse_candidates_)
+    {
+        // the stages may be cleared by a listener
+        if (id >= mouse_targets_.size())
+            break;
+
+        const auto& target = mouse_targets_[id];
+        if (target.clipped && target.bounds.ContainsPoint(pos))
+        {
+            mouse_hovered_.push_back(id);
+
+            if (pressed && std::find(mouse_captured_.begin(), mouse_captured_.end(), id) == mouse_captured_.end())
+                mouse_captured_.push_back(id);
+        }
+        target.dispatcher->DispatchEvent(evt);
+    }
+
+    if (released)
+        mouse_captured_.clear();
 }
 
 }  // namespace kiwano
@@ -23,6 +23,7 @@
 #include <kiwano/2d/Stage.h>
 #include <kiwano/2d/transition/Transition.h>
 #include <kiwano/base/Module.h>
+#include <kiwano/core/SpatialGrid.h>
 
 namespace kiwano
 {
@@ -96,6 +97,15 @@ public:
      */
     void PushEventDispatcher(EventDispatcher* dispatcher);
 
+    /**
+     * \~chinese
+     * @brief ӽɫ¼ַһ֡Զ
+     * @details ¼üĽɫֻλ߽ʱ¼
+     * @param actor ɫ
+     * @see Actor::SetMouseEventClippingEnabled
+     */
+    void PushEventDispatcher(Actor* actor);
+
 public:
     void OnUpdate(UpdateModuleContext& ctx) override;
 
@@ -110,7 +120,19 @@ public:
 private:
     Director();
 
+    void AddEventDispatcher(EventDispatcher* dispatcher, Actor* clipped_actor, const Rect& bounds);
+
+    void DispatchMouseEvent(Event* evt, const Point& pos);
+
 private:
+    struct MouseEventTarget
+    {
+        EventDispatcher* dispatcher;
+        Actor*           actor;  ///< òüʱĽɫ
+        bool             clipped;
+        Rect             bounds;
+    };
+
     bool                 render_border_enabled_;
     Stack<RefPtr<Stage>> stages_;
     RefPtr<Stage>        current_stage_;
@@ -119,6 +141,16 @@ private:
     RefPtr<Transition>   transition_;
 
     IntrusiveList<EventDispatcher*> dispatcher_list_;
+    Vector<EventDispatcher*>        key_dispatchers_;
+    Vector<EventDispatcher*>        window_dispatchers_;
+    Vector<MouseEventTarget>        mouse_targets_;
+    Vector<uint32_t>                mouse_unclipped_;
+    Vector<uint32_t>                mouse_hovered_;
+    Vector<uint32_t>                mouse_captured_;
+    Vector<uint32_t>                mouse_candidates_;
+    Vector<RefPtr<Actor>>           last_hovered_;
+    Vector<RefPtr<Actor>>           last_captured_;
+    SpatialGrid                     mouse_grid_;
 };
 
 
@@ -20,10 +20,22 @@
 
 #include <kiwano/base/Module.h>
 #include <kiwano/render/RenderContext.h>
+#include <kiwano/utils/Profiler.h>
 
 namespace kiwano
 {
 
+namespace
+{
+
+inline const char* GetProfileName(Module* m)
+{
+    // Resolve the type name only while profiling
+    return Profiler::GetInstance().IsEnabled() ? typeid(*m).name() : nullptr;
+}
+
+}  // namespace
+
 ModuleContext::ModuleContext(ModuleList& modules)
     : index_(-1)
     , modules_(modules)
@@ -69,6 +81,8 @@ RenderModuleContext::~RenderModuleContext()
 
 void RenderModuleContext::Handle(Module* m)
 {
+    KGE_PROFILE_ZONE_CATEGORY(GetProfileName(m), "Render");
+
     switch (step_)
     {
     case RenderModuleContext::Step::Before:
@@ -93,6 +107,8 @@ UpdateModuleContext::UpdateModuleContext(ModuleList& modules, Duration dt)
 
 void UpdateModuleContext::Handle(Module* m)
 {
+    KGE_PROFILE_ZONE_CATEGORY(GetProfileName(m), "Update");
+
     m->OnUpdate(*this);
 }
 
@@ -104,6 +120,8 @@ EventModuleContext::EventModuleContext(ModuleList& modules, Event* evt)
 
 void EventModuleContext::Handle(Module* m)
 {
+    KGE_PROFILE_ZONE_CATEGORY(GetProfileName(m), "Event");
+
     m->HandleEvent(*this);
 }
 
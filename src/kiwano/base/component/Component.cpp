@@ -20,12 +20,36 @@
 
 #include <kiwano/base/component/Component.h>
 #include <kiwano/2d/Actor.h>
+#include <mutex>
+#include <typeindex>
 
 namespace kiwano
 {
 
+namespace details
+{
+
+uint32_t GetComponentTypeId(const std::type_info& type)
+{
+    static std::mutex                               mutex;
+    static UnorderedMap<std::type_index, uint32_t> type_ids;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto iter = type_ids.find(type);
+    if (iter != type_ids.end())
+        return iter->second;
+
+    const auto type_id = uint32_t(type_ids.size() + 1);
+    type_ids.emplace(type, type_id);
+    return type_id;
+}
+
+}  // namespace details
+
 Component::Component()
     : enabled_(true)
+    , type_id_(0)
     , actor_(nullptr)
 {
 }
@@ -22,6 +22,7 @@
 #include <kiwano/core/Time.h>
 #include <kiwano/base/ObjectBase.h>
 #include <kiwano/render/RenderContext.h>
+#include <typeinfo>
 
 namespace kiwano
 {
@@ -65,6 +66,17 @@ public:
     /// @brief ӽɫƳ
     void RemoveFromActor();
 
+    /// \~chinese
+    /// @brief ȡID
+    /// @details ӵɫʱʵȷδӹ 0
+    uint32_t GetTypeId() const;
+
+    /// \~chinese
+    /// @brief ǷͨĳIDҵ
+    /// @details ӵɫʱȷʵͼͨ KGE_COMPONENT_TYPE Ļ
+    /// @param type_id ID
+    bool IsLookupType(uint32_t type_id) const;
+
 protected:
     Component();
 
@@ -86,11 +98,49 @@ protected:
     /// @brief Ⱦ
     virtual void OnRender(RenderContext& ctx);
 
+    /// \~chinese
+    /// @brief ȡԲҵĻID
+    /// @details ӵɫʱã KGE_COMPONENT_TYPE ʵ
+    virtual void GetLookupTypeIds(Vector<uint32_t>& type_ids) const;
+
 private:
-    bool   enabled_;
-    Actor* actor_;
+    bool             enabled_;
+    uint32_t         type_id_;
+    Vector<uint32_t> lookup_type_ids_;
+    Actor*           actor_;
 };
 
+namespace details
+{
+KGE_API uint32_t GetComponentTypeId(const std::type_info& type);
+}
+
+/// \~chinese
+/// @brief ȡID
+/// @details ÿ״ʹʱΨһķID˺ֱӶȡֵ
+/// @tparam _Ty 
+template <typename _Ty>
+inline uint32_t GetComponentTypeId()
+{
+    static_assert(std::is_base_of<Component, _Ty>::value, "_Ty is not a component type.");
+
+    static const uint32_t type_id = details::GetComponentTypeId(typeid(_Ty));
+    return type_id;
+}
+
+/// \~chinese
+/// @brief ɱ
+/// @details ඨĿͷʹã˺͵ࣨʹδҲͨ ComponentManager::GetComponent<CLASS> ҵ
+/// @param CLASS 
+/// @param BASE ֱӻ
+#define KGE_COMPONENT_TYPE(CLASS, BASE)                                                      \
+protected:                                                                                   \
+    void GetLookupTypeIds(::kiwano::Vector<uint32_t>& type_ids) const override               \
+    {                                                                                        \
+        type_ids.push_back(::kiwano::GetComponentTypeId<CLASS>());                           \
+        BASE::GetLookupTypeIds(type_ids);                                                    \
+    }
+
 /** @} */
 
 inline bool Component::IsEnable() const
@@ -108,6 +158,22 @@ inline Actor* Component::GetBoundActor() const
     return actor_;
 }
 
+inline uint32_t Component::GetTypeId() const
+{
+    return type_id_;
+}
+
+inline bool Component::IsLookupType(uint32_t type_id) const
+{
+    // usually one or two ids
+    for (auto id : lookup_type_ids_)
+    {
+        if (id == type_id)
+            return true;
+    }
+    return false;
+}
+
 inline void Component::OnUpdate(Duration dt)
 {
     KGE_NOT_USED(dt);
@@ -118,4 +184,9 @@ inline void Component::OnRender(RenderContext& ctx)
     KGE_NOT_USED(ctx);
 }
 
+inline void Component::GetLookupTypeIds(Vector<uint32_t>& type_ids) const
+{
+    KGE_NOT_USED(type_ids);
+}
+
 }  // namespace kiwano
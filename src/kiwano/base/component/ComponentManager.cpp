@@ -19,6 +19,8 @@
 // THE SOFTWARE.
 
 #include <kiwano/base/component/ComponentManager.h>
+#include <kiwano/utils/Profiler.h>
+#include <algorithm>
 #include <functional>
 
 namespace kiwano
@@ -26,6 +28,8 @@ namespace kiwano
 
 ComponentManager::ComponentManager(Actor* target)
     : target_(target)
+    , traversing_depth_(0)
+    , has_empty_slot_(false)
 {
 }
 
@@ -47,9 +51,26 @@ Component* ComponentManager::AddComponent(size_t index, RefPtr<Component> compon
 
     if (component)
     {
+        if (component->type_id_ == 0)
+        {
+            component->type_id_ = details::GetComponentTypeId(typeid(*component));
+
+            // the base types declared with KGE_COMPONENT_TYPE find the component as well
+            auto& ids = component->lookup_type_ids_;
+            ids.push_back(component->type_id_);
+            component->GetLookupTypeIds(ids);
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+
         component->InitComponent(target_);
 
-        components_[index] = component;
+        auto iter = std::find_if(components_.begin(), components_.end(),
+                                 [=](const ComponentList::value_type& pair) { return pair.first == index && pair.second; });
+        if (iter != components_.end())
+            iter->second = component;
+        else
+            components_.emplace_back(index, component);
     }
     return component.Get();
 }
@@ -62,23 +83,20 @@ Component* ComponentManager::GetComponent(StringView name)
 
 Component* ComponentManager::GetComponent(size_t name_hash)
 {
-    if (!components_.empty())
+    for (const auto& pair : components_)
     {
-        auto iter = components_.find(name_hash);
-        if (iter != components_.end())
-        {
-            return iter->second.Get();
-        }
+        if (pair.first == name_hash && pair.second)
+            return pair.second.Get();
     }
     return nullptr;
 }
 
-ComponentMap& ComponentManager::GetAllComponents()
+ComponentList& ComponentManager::GetAllComponents()
 {
     return components_;
 }
 
-const ComponentMap& ComponentManager::GetAllComponents() const
+const ComponentList& ComponentManager::GetAllComponents() const
 {
     return components_;
 }
@@ -96,56 +114,95 @@ void ComponentManager::RemoveComponent(StringView name)
 
 void ComponentManager::RemoveComponent(size_t name_hash)
 {
-    if (!components_.empty())
+    auto iter = std::find_if(components_.begin(), components_.end(),
+                             [=](const ComponentList::value_type& pair) { return pair.first == name_hash && pair.second; });
+    if (iter != components_.end())
     {
-        auto iter = components_.find(name_hash);
-        if (iter != components_.end())
-        {
-            iter->second->DestroyComponent();
-            components_.erase(iter);
-        }
+        RemoveComponent(iter);
+    }
+}
+
+void ComponentManager::RemoveComponent(ComponentList::iterator iter)
+{
+    RefPtr<Component> component = iter->second;
+
+    if (traversing_depth_ > 0)
+    {
+        // keep the slot while traversing, it will be erased after the traversal
+        iter->second.Reset();
+        has_empty_slot_ = true;
+    }
+    else
+    {
+        components_.erase(iter);
     }
+
+    component->DestroyComponent();
 }
 
 void ComponentManager::RemoveAllComponents()
 {
     // Destroy all components
-    if (!components_.empty())
+    ComponentList components;
+    components.swap(components_);
+
+    for (auto& pair : components)
     {
-        for (auto& p : components_)
-        {
-            p.second->DestroyComponent();
-        }
+        if (pair.second)
+            pair.second->DestroyComponent();
+    }
+
+    if (traversing_depth_ > 0 && !components.empty())
+    {
+        // the traversal is still reading slots
+        components_.resize(components.size());
+        has_empty_slot_ = true;
     }
-    components_.clear();
 }
 
-void ComponentManager::Update(Duration dt)
+void ComponentManager::UpdateComponents(Duration dt)
 {
-    if (!components_.empty())
+    KGE_PROFILE_ZONE("ComponentManager::Update");
+
+    ++traversing_depth_;
+
+    // components added while traversing are also updated
+    for (size_t i = 0; i < components_.size(); ++i)
     {
-        for (auto& p : components_)
+        RefPtr<Component> component = components_[i].second;
+        if (component && component->IsEnable())
         {
-            if (p.second->IsEnable())
-            {
-                p.second->OnUpdate(dt);
-            }
+            component->OnUpdate(dt);
         }
     }
+
+    if (--traversing_depth_ == 0 && has_empty_slot_)
+        RemoveEmptySlots();
 }
 
-void ComponentManager::Render(RenderContext& ctx)
+void ComponentManager::RenderComponents(RenderContext& ctx)
 {
-    if (!components_.empty())
+    ++traversing_depth_;
+
+    for (size_t i = 0; i < components_.size(); ++i)
     {
-        for (auto& p : components_)
+        RefPtr<Component> component = components_[i].second;
+        if (component && component->IsEnable())
         {
-            if (p.second->IsEnable())
-            {
-                p.second->OnRender(ctx);
-            }
+            component->OnRender(ctx);
         }
     }
+
+    if (--traversing_depth_ == 0 && has_empty_slot_)
+        RemoveEmptySlots();
+}
+
+void ComponentManager::RemoveEmptySlots()
+{
+    has_empty_slot_ = false;
+
+    auto is_empty = [](const ComponentList::value_type& pair) { return !pair.second; };
+    components_.erase(std::remove_if(components_.begin(), components_.end(), is_empty), components_.end());
 }
 
 }  // namespace kiwano
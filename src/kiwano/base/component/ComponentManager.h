@@ -30,9 +30,15 @@ namespace kiwano
  * @{
  */
 
+/// \~chinese
+/// @brief б
+/// @details ˳洢Ƶ Hash ֵ
+typedef Vector<Pair<size_t, RefPtr<Component>>> ComponentList;
+
 /// \~chinese
 /// @brief ӳ
-typedef UnorderedMap<size_t, RefPtr<Component>> ComponentMap;
+/// @deprecated ѸΪ˳洢ʹ ComponentList pair.firstpair.second Ĵ޸
+typedef ComponentList ComponentMap;
 
 /**
  * \~chinese
@@ -60,13 +66,29 @@ public:
     /// @brief ȡ
     Component* GetComponent(size_t name_hash);
 
+    /// \~chinese
+    /// @brief ȡ
+    /// @details IDʵΪ _Ty _Ty ͨ KGE_COMPONENT_TYPE ʱҲԲҵ
+    /// @tparam _Ty 
+    template <typename _Ty>
+    _Ty* GetComponent()
+    {
+        const uint32_t type_id = GetComponentTypeId<_Ty>();
+        for (const auto& pair : components_)
+        {
+            if (pair.second && pair.second->IsLookupType(type_id))
+                return static_cast<_Ty*>(pair.second.Get());
+        }
+        return nullptr;
+    }
+
     /// \~chinese
     /// @brief ȡ
-    ComponentMap& GetAllComponents();
+    ComponentList& GetAllComponents();
 
     /// \~chinese
     /// @brief ȡ
-    const ComponentMap& GetAllComponents() const;
+    const ComponentList& GetAllComponents() const;
 
     /// \~chinese
     /// @brief Ƴ
@@ -98,10 +120,33 @@ protected:
     ComponentManager(Actor* target);
 
 private:
-    Actor*       target_;
-    ComponentMap components_;
+    void UpdateComponents(Duration dt);
+
+    void RenderComponents(RenderContext& ctx);
+
+    void RemoveComponent(ComponentList::iterator iter);
+
+    void RemoveEmptySlots();
+
+private:
+    Actor*        target_;
+    int           traversing_depth_;
+    bool          has_empty_slot_;
+    ComponentList components_;
 };
 
 /** @} */
 
+inline void ComponentManager::Update(Duration dt)
+{
+    if (!components_.empty())
+        UpdateComponents(dt);
+}
+
+inline void ComponentManager::Render(RenderContext& ctx)
+{
+    if (!components_.empty())
+        RenderComponents(ctx);
+}
+
 }  // namespace kiwano
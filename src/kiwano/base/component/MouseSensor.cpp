@@ -20,6 +20,7 @@
 
 #include <kiwano/base/component/MouseSensor.h>
 #include <kiwano/2d/Actor.h>
+#include <kiwano/event/EventPool.h>
 
 namespace kiwano
 {
@@ -57,7 +58,7 @@ void MouseSensor::HandleEvent(Event* evt)
         {
             hover_ = true;
 
-            RefPtr<MouseHoverEvent> hover = new MouseHoverEvent;
+            RefPtr<MouseHoverEvent> hover = EventPool<MouseHoverEvent>::Acquire();
             hover->pos                    = mouse_evt->pos;
             GetBoundActor()->DispatchEvent(hover.Get());
         }
@@ -66,7 +67,7 @@ void MouseSensor::HandleEvent(Event* evt)
             hover_   = false;
             pressed_ = false;
 
-            RefPtr<MouseOutEvent> out = new MouseOutEvent;
+            RefPtr<MouseOutEvent> out = EventPool<MouseOutEvent>::Acquire();
             out->pos                  = mouse_evt->pos;
             GetBoundActor()->DispatchEvent(out.Get());
         }
@@ -83,7 +84,7 @@ void MouseSensor::HandleEvent(Event* evt)
 
         auto mouse_up_evt = dynamic_cast<MouseUpEvent*>(evt);
 
-        RefPtr<MouseClickEvent> click = new MouseClickEvent;
+        RefPtr<MouseClickEvent> click = EventPool<MouseClickEvent>::Acquire();
         click->pos                    = mouse_up_evt->pos;
         click->button                 = mouse_up_evt->button;
         GetBoundActor()->DispatchEvent(click.Get());
@@ -38,6 +38,8 @@ namespace kiwano
  */
 class KGE_API MouseSensor : public Component
 {
+    KGE_COMPONENT_TYPE(MouseSensor, Component)
+
 public:
     MouseSensor();
 
@@ -22,3 +22,6 @@
 
 //---- Define to enable DirectX debug layer
 // #define KGE_ENABLE_DX_DEBUG
+
+//---- Define to compile out all KGE_PROFILE_ZONE instrumentation
+// #define KGE_DISABLE_PROFILER
@@ -20,7 +20,7 @@
 
 #include <regex>          // std::regex
 #include <unordered_map>  // std::unordered_map
-#include <chrono>         // std::chrono::milliseconds
+#include <chrono>         // std::chrono::nanoseconds
 #include <thread>         // std::this_thread::sleep_for
 #include <kiwano/core/Duration.h>
 #include <kiwano/utils/Logger.h>  // KGE_THROW
@@ -28,50 +28,54 @@
 namespace kiwano
 {
 
-const Duration time::Millisecond = 1L;
+const Duration time::Nanosecond  = Duration::FromNanoseconds(1);
+const Duration time::Microsecond = Duration::FromNanoseconds(1000);
+const Duration time::Millisecond = Duration::FromNanoseconds(1000000);
 const Duration time::Second      = 1000 * time::Millisecond;
 const Duration time::Minute      = 60 * time::Second;
 const Duration time::Hour        = 60 * time::Minute;
 
 namespace
 {
-const auto duration_regex = std::regex(R"(^[-+]?([0-9]*(\.[0-9]*)?(h|m|s|ms)+)+$)");
+const auto duration_regex = std::regex(R"(^[-+]?([0-9]*(\.[0-9]*)?(h|m|s|ms|us|ns)+)+$)");
 
 typedef std::unordered_map<String, Duration> UnitMap;
 
 const auto unit_map =
-    UnitMap{ { "ms", time::Millisecond }, { "s", time::Second }, { "m", time::Minute }, { "h", time::Hour } };
+    UnitMap{ { "ns", time::Nanosecond }, { "us", time::Microsecond }, { "ms", time::Millisecond },
+             { "s", time::Second },      { "m", time::Minute },       { "h", time::Hour } };
 }  // namespace
 
 float Duration::GetSeconds() const
 {
-    auto sec = milliseconds_ / time::Second.milliseconds_;
-    auto ms  = milliseconds_ % time::Second.milliseconds_;
-    return static_cast<float>(sec + ms) / 1000.f;
+    // Split into whole units and remainder to keep the precision of long durations
+    auto sec = nanoseconds_ / time::Second.nanoseconds_;
+    auto ns  = nanoseconds_ % time::Second.nanoseconds_;
+    return static_cast<float>(static_cast<double>(sec) + static_cast<double>(ns) / time::Second.nanoseconds_);
 }
 
 float Duration::GetMinutes() const
 {
-    auto min = milliseconds_ / time::Minute.milliseconds_;
-    auto ms  = milliseconds_ % time::Minute.milliseconds_;
-    return static_cast<float>(min + ms) / (60 * 1000.f);
+    auto min = nanoseconds_ / time::Minute.nanoseconds_;
+    auto ns  = nanoseconds_ % time::Minute.nanoseconds_;
+    return static_cast<float>(static_cast<double>(min) + static_cast<double>(ns) / time::Minute.nanoseconds_);
 }
 
 float Duration::GetHours() const
 {
-    auto hour = milliseconds_ / time::Hour.milliseconds_;
-    auto ms   = milliseconds_ % time::Hour.milliseconds_;
-    return static_cast<float>(hour + ms) / (60 * 60 * 1000.f);
+    auto hour = nanoseconds_ / time::Hour.nanoseconds_;
+    auto ns   = nanoseconds_ % time::Hour.nanoseconds_;
+    return static_cast<float>(static_cast<double>(hour) + static_cast<double>(ns) / time::Hour.nanoseconds_);
 }
 
 void Duration::Sleep() const
 {
-    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
     using std::this_thread::sleep_for;
 
-    if (milliseconds_)
+    if (nanoseconds_ > 0)
     {
-        sleep_for(milliseconds(milliseconds_));
+        sleep_for(nanoseconds(nanoseconds_));
     }
 }
 
@@ -84,17 +88,17 @@ String Duration::ToString() const
 
     StringStream stream;
 
-    int64_t total_ms = milliseconds_;
-    if (total_ms < 0)
+    int64_t total_ns = nanoseconds_;
+    if (total_ns < 0)
     {
         stream << "-";
-        total_ms = -total_ms;
+        total_ns = -total_ns;
     }
 
-    int64_t hour = total_ms / time::Hour.milliseconds_;
-    int64_t min  = total_ms / time::Minute.milliseconds_ - hour * 60;
-    int64_t sec  = total_ms / time::Second.milliseconds_ - (hour * 60 * 60 + min * 60);
-    int64_t ms   = total_ms % time::Second.milliseconds_;
+    int64_t hour = total_ns / time::Hour.nanoseconds_;
+    int64_t min  = total_ns / time::Minute.nanoseconds_ - hour * 60;
+    int64_t sec  = total_ns / time::Second.nanoseconds_ - (hour * 60 * 60 + min * 60);
+    int64_t ns   = total_ns % time::Second.nanoseconds_;
 
     if (hour)
     {
@@ -105,9 +109,9 @@ String Duration::ToString() const
         stream << min << 'm';
     }
 
-    if (ms != 0)
+    if (ns != 0)
     {
-        stream << float(sec) + float(ms) / 1000.f << 's';
+        stream << double(sec) + double(ns) / time::Second.nanoseconds_ << 's';
     }
     else if (sec != 0)
     {
@@ -28,8 +28,11 @@ namespace kiwano
  * \~chinese
  * @brief ʱ
  * @par
+ *   ʱ뾫ȱ
+ * @par
  *   ʱαʾ:
  *   @code
+ *     time::Microsecond * 500  // 500 ΢
  *     time::Millisecond * 50  // 50 
  *     time::Second * 5  // 5 
  *     time::Hour * 1.5  // 1.5 Сʱ
@@ -55,6 +58,24 @@ struct KGE_API Duration
     /// @param milliseconds 
     Duration(int64_t milliseconds);
 
+    /// \~chinese
+    /// @brief ʱ
+    /// @param nanoseconds 
+    static Duration FromNanoseconds(int64_t nanoseconds);
+
+    /// \~chinese
+    /// @brief ʱ
+    /// @param microseconds ΢
+    static Duration FromMicroseconds(int64_t microseconds);
+
+    /// \~chinese
+    /// @brief ȡ
+    int64_t GetNanoseconds() const;
+
+    /// \~chinese
+    /// @brief ȡ΢
+    int64_t GetMicroseconds() const;
+
     /// \~chinese
     /// @brief ȡ
     int64_t GetMilliseconds() const;
@@ -76,6 +97,16 @@ struct KGE_API Duration
     /// @return ʱ㣬true
     bool IsZero() const;
 
+    /// \~chinese
+    /// @brief 
+    /// @param ns 
+    void SetNanoseconds(int64_t ns);
+
+    /// \~chinese
+    /// @brief ΢
+    /// @param us ΢
+    void SetMicroseconds(int64_t us);
+
     /// \~chinese
     /// @brief ú
     /// @param ms 
@@ -109,8 +140,8 @@ struct KGE_API Duration
     /// @param str ʱַ
     /// @details
     ///   ʱַзŵĸ, Ҵʱ䵥λ׺
-    ///   : "300ms", "-1.5h", "2h45m"
-    ///   ʱ䵥λ "ms", "s", "m", "h"
+    ///   : "300ms", "-1.5h", "2h45m", "16.67ms"
+    ///   ʱ䵥λ "ns", "us", "ms", "s", "m", "h"
     /// @return ʱ
     /// @throw kiwano::RuntimeError һϷĸʽʱ׳
     static Duration Parse(StringView str);
@@ -154,12 +185,14 @@ struct KGE_API Duration
     friend const Duration operator/(double, const Duration&);
 
 private:
-    int64_t milliseconds_;
+    int64_t nanoseconds_;
 };
 
 namespace time
 {
 
+extern const Duration Nanosecond;   ///< 
+extern const Duration Microsecond;  ///< ΢
 extern const Duration Millisecond;  ///< 
 extern const Duration Second;       ///< 
 extern const Duration Minute;       ///< 
@@ -168,180 +201,212 @@ extern const Duration Hour;         ///< Сʱ
 }  // namespace time
 
 inline Duration::Duration()
-    : milliseconds_(0)
+    : nanoseconds_(0)
 {
 }
 
 inline Duration::Duration(int64_t milliseconds)
-    : milliseconds_(milliseconds)
+    : nanoseconds_(milliseconds * 1000000LL)
+{
+}
+
+inline Duration Duration::FromNanoseconds(int64_t nanoseconds)
+{
+    Duration dur;
+    dur.nanoseconds_ = nanoseconds;
+    return dur;
+}
+
+inline Duration Duration::FromMicroseconds(int64_t microseconds)
 {
+    return FromNanoseconds(microseconds * 1000LL);
+}
+
+inline int64_t Duration::GetNanoseconds() const
+{
+    return nanoseconds_;
+}
+
+inline int64_t Duration::GetMicroseconds() const
+{
+    return nanoseconds_ / 1000LL;
 }
 
 inline int64_t Duration::GetMilliseconds() const
 {
-    return milliseconds_;
+    return nanoseconds_ / 1000000LL;
 }
 
 inline bool Duration::IsZero() const
 {
-    return milliseconds_ == 0LL;
+    return nanoseconds_ == 0LL;
+}
+
+inline void Duration::SetNanoseconds(int64_t ns)
+{
+    nanoseconds_ = ns;
+}
+
+inline void Duration::SetMicroseconds(int64_t us)
+{
+    nanoseconds_ = us * 1000LL;
 }
 
 inline void Duration::SetMilliseconds(int64_t ms)
 {
-    milliseconds_ = ms;
+    nanoseconds_ = ms * 1000000LL;
 }
 
 inline void Duration::SetSeconds(float seconds)
 {
-    milliseconds_ = static_cast<int64_t>(seconds * 1000.f);
+    nanoseconds_ = static_cast<int64_t>(double(seconds) * 1e9);
 }
 
 inline void Duration::SetMinutes(float minutes)
 {
-    milliseconds_ = static_cast<int64_t>(minutes * 60 * 1000.f);
+    nanoseconds_ = static_cast<int64_t>(double(minutes) * 60 * 1e9);
 }
 
 inline void Duration::SetHours(float hours)
 {
-    milliseconds_ = static_cast<int64_t>(hours * 60 * 60 * 1000.f);
+    nanoseconds_ = static_cast<int64_t>(double(hours) * 60 * 60 * 1e9);
 }
 
 inline bool Duration::operator==(const Duration& other) const
 {
-    return milliseconds_ == other.milliseconds_;
+    return nanoseconds_ == other.nanoseconds_;
 }
 
 inline bool Duration::operator!=(const Duration& other) const
 {
-    return milliseconds_ != other.milliseconds_;
+    return nanoseconds_ != other.nanoseconds_;
 }
 
 inline bool Duration::operator>(const Duration& other) const
 {
-    return milliseconds_ > other.milliseconds_;
+    return nanoseconds_ > other.nanoseconds_;
 }
 
 inline bool Duration::operator>=(const Duration& other) const
 {
-    return milliseconds_ >= other.milliseconds_;
+    return nanoseconds_ >= other.nanoseconds_;
 }
 
 inline bool Duration::operator<(const Duration& other) const
 {
-    return milliseconds_ < other.milliseconds_;
+    return nanoseconds_ < other.nanoseconds_;
 }
 
 inline bool Duration::operator<=(const Duration& other) const
 {
-    return milliseconds_ <= other.milliseconds_;
+    return nanoseconds_ <= other.nanoseconds_;
 }
 
 inline float Duration::operator/(const Duration& other) const
 {
-    return static_cast<float>(milliseconds_) / other.milliseconds_;
+    return static_cast<float>(static_cast<double>(nanoseconds_) / other.nanoseconds_);
 }
 
 inline const Duration Duration::operator+(const Duration& other) const
 {
-    return Duration(milliseconds_ + other.milliseconds_);
+    return Duration::FromNanoseconds(nanoseconds_ + other.nanoseconds_);
 }
 
 inline const Duration Duration::operator-(const Duration& other) const
 {
-    return Duration(milliseconds_ - other.milliseconds_);
+    return Duration::FromNanoseconds(nanoseconds_ - other.nanoseconds_);
 }
 
 inline const Duration Duration::operator-() const
 {
-    return Duration(-milliseconds_);
+    return Duration::FromNanoseconds(-nanoseconds_);
 }
 
 inline const Duration Duration::operator*(int val) const
 {
-    return Duration(milliseconds_ * val);
+    return Duration::FromNanoseconds(nanoseconds_ * val);
 }
 
 inline const Duration Duration::operator*(unsigned long long val) const
 {
-    return Duration(static_cast<int64_t>(milliseconds_ * val));
+    return Duration::FromNanoseconds(static_cast<int64_t>(nanoseconds_ * val));
 }
 
 inline const Duration Duration::operator*(float val) const
 {
-    return Duration(static_cast<int64_t>(milliseconds_ * val));
+    return Duration::FromNanoseconds(static_cast<int64_t>(nanoseconds_ * double(val)));
 }
 
 inline const Duration Duration::operator*(double val) const
 {
-    return Duration(static_cast<int64_t>(milliseconds_ * val));
+    return Duration::FromNanoseconds(static_cast<int64_t>(nanoseconds_ * double(val)));
 }
 
 inline const Duration Duration::operator*(long double val) const
 {
-    return Duration(static_cast<int64_t>(milliseconds_ * val));
+    return Duration::FromNanoseconds(static_cast<int64_t>(nanoseconds_ * double(val)));
 }
 
 inline const Duration Duration::operator/(int val) const
 {
-    return Duration(milliseconds_ / val);
+    return Duration::FromNanoseconds(nanoseconds_ / val);
 }
 
 inline const Duration Duration::operator/(float val) const
 {
-    return Duration(static_cast<int64_t>(milliseconds_ / val));
+    return Duration::FromNanoseconds(static_cast<int64_t>(nanoseconds_ / double(val)));
 }
 
 inline const Duration Duration::operator/(double val) const
 {
-    return Duration(static_cast<int64_t>(milliseconds_ / val));
+    return Duration::FromNanoseconds(static_cast<int64_t>(nanoseconds_ / double(val)));
 }
 
 inline Duration& Duration::operator+=(const Duration& other)
 {
-    milliseconds_ += other.milliseconds_;
+    nanoseconds_ += other.nanoseconds_;
     return (*this);
 }
 
 inline Duration& Duration::operator-=(const Duration& other)
 {
-    milliseconds_ -= other.milliseconds_;
+    nanoseconds_ -= other.nanoseconds_;
     return (*this);
 }
 
 inline Duration& Duration::operator*=(int val)
 {
-    milliseconds_ *= val;
+    nanoseconds_ *= val;
     return (*this);
 }
 
 inline Duration& Duration::operator/=(int val)
 {
-    milliseconds_ = static_cast<int64_t>(milliseconds_ / val);
+    nanoseconds_ = static_cast<int64_t>(nanoseconds_ / double(val));
     return (*this);
 }
 
 inline Duration& Duration::operator*=(float val)
 {
-    milliseconds_ = static_cast<int64_t>(milliseconds_ * val);
+    nanoseconds_ = static_cast<int64_t>(nanoseconds_ * double(val));
     return (*this);
 }
 
 inline Duration& Duration::operator/=(float val)
 {
-    milliseconds_ = static_cast<int64_t>(milliseconds_ / val);
+    nanoseconds_ = static_cast<int64_t>(nanoseconds_ / double(val));
     return (*this);
 }
 
 inline Duration& Duration::operator*=(double val)
 {
-    milliseconds_ = static_cast<int64_t>(milliseconds_ * val);
+    nanoseconds_ = static_cast<int64_t>(nanoseconds_ * double(val));
     return (*this);
 }
 
 inline Duration& Duration::operator/=(double val)
 {
-    milliseconds_ = static_cast<int64_t>(milliseconds_ / val);
+    nanoseconds_ = static_cast<int64_t>(nanoseconds_ / double(val));
     return (*this);
 }
 
@@ -388,6 +453,21 @@ namespace kiwano
 {
 inline namespace literals
 {
+inline const kiwano::Duration operator"" _nsec(unsigned long long val)
+{
+    return kiwano::time::Nanosecond * val;
+}
+
+inline const kiwano::Duration operator"" _usec(long double val)
+{
+    return kiwano::time::Microsecond * val;
+}
+
+inline const kiwano::Duration operator"" _usec(unsigned long long val)
+{
+    return kiwano::time::Microsecond * val;
+}
+
 inline const kiwano::Duration operator"" _msec(long double val)
 {
     return kiwano::time::Millisecond * val;
@@ -23,6 +23,10 @@
 #include <type_traits>
 #include <stdexcept>
 #include <functional>
+#include <utility>
+#include <cstddef>
+#include <new>
+#include <atomic>
 
 namespace kiwano
 {
@@ -71,44 +75,23 @@ class Callable
 public:
     virtual ~Callable() {}
 
-    virtual void Retain()                      = 0;
-    virtual void Release()                     = 0;
     virtual _Ret Invoke(_Args&&... args) const = 0;
 
     virtual const std::type_info& TargetType() const noexcept = 0;
 
     virtual const void* Target(const std::type_info& type) const noexcept = 0;
-};
 
-template <typename _Ret, typename... _Args>
-class RefCountCallable : public Callable<_Ret, _Args...>
-{
-public:
-    RefCountCallable()
-        : ref_count_(0)
-    {
-    }
+    // copy into the given storage, or share the heap object
+    virtual Callable* CopyTo(void* storage) = 0;
 
-    virtual void Retain() override
-    {
-        ++ref_count_;
-    }
+    // move into the given storage, only called on callables stored inline
+    virtual Callable* MoveTo(void* storage) noexcept = 0;
 
-    virtual void Release() override
-    {
-        --ref_count_;
-        if (ref_count_ <= 0)
-        {
-            delete this;
-        }
-    }
-
-private:
-    int ref_count_;
+    virtual void Destroy() noexcept = 0;
 };
 
 template <typename _Ty, typename _Ret, typename... _Args>
-class ProxyCallable : public RefCountCallable<_Ret, _Args...>
+class ProxyCallable : public Callable<_Ret, _Args...>
 {
 public:
     ProxyCallable(_Ty&& val)
@@ -133,17 +116,12 @@ public:
         return nullptr;
     }
 
-    static inline Callable<_Ret, _Args...>* Make(_Ty&& val)
-    {
-        return new (std::nothrow) ProxyCallable<_Ty, _Ret, _Args...>(std::move(val));
-    }
-
 private:
     _Ty callee_;
 };
 
 template <typename _Ty, typename _Ret, typename... _Args>
-class ProxyMemCallable : public RefCountCallable<_Ret, _Args...>
+class ProxyMemCallable : public Callable<_Ret, _Args...>
 {
 public:
     typedef _Ret (_Ty::*_FuncType)(_Args...);
@@ -165,11 +143,6 @@ public:
         return nullptr;
     }
 
-    static inline Callable<_Ret, _Args...>* Make(_Ty* ptr, _FuncType func)
-    {
-        return new (std::nothrow) ProxyMemCallable<_Ty, _Ret, _Args...>(ptr, func);
-    }
-
 protected:
     ProxyMemCallable(_Ty* ptr, _FuncType func)
         : ptr_(ptr)
@@ -183,7 +156,7 @@ protected:
 };
 
 template <typename _Ty, typename _Ret, typename... _Args>
-class ProxyConstMemCallable : public RefCountCallable<_Ret, _Args...>
+class ProxyConstMemCallable : public Callable<_Ret, _Args...>
 {
 public:
     typedef _Ret (_Ty::*_FuncType)(_Args...) const;
@@ -205,11 +178,6 @@ public:
         return nullptr;
     }
 
-    static inline Callable<_Ret, _Args...>* Make(_Ty* ptr, _FuncType func)
-    {
-        return new (std::nothrow) ProxyConstMemCallable<_Ty, _Ret, _Args...>(ptr, func);
-    }
-
 protected:
     ProxyConstMemCallable(_Ty* ptr, _FuncType func)
         : ptr_(ptr)
@@ -222,11 +190,93 @@ protected:
     _FuncType func_;
 };
 
+//
+// StoredCallable
+//
+
+template <typename _Proxy, bool _IsInline>
+class StoredCallable;
+
+// proxy constructed in the small buffer of Function, copied by value
+template <typename _Proxy>
+class StoredCallable<_Proxy, true> final : public _Proxy
+{
+public:
+    template <typename... _CtorArgs>
+    StoredCallable(std::in_place_t, _CtorArgs&&... args)
+        : _Proxy(std::forward<_CtorArgs>(args)...)
+    {
+    }
+
+    virtual StoredCallable* CopyTo(void* storage) override
+    {
+        return ::new (storage) StoredCallable(*this);
+    }
+
+    virtual StoredCallable* MoveTo(void* storage) noexcept override
+    {
+        return ::new (storage) StoredCallable(std::move(*this));
+    }
+
+    virtual void Destroy() noexcept override
+    {
+        this->~StoredCallable();
+    }
+};
+
+// proxy allocated on heap, shared by reference counting, copies may live on different threads
+template <typename _Proxy>
+class StoredCallable<_Proxy, false> final : public _Proxy
+{
+public:
+    template <typename... _CtorArgs>
+    StoredCallable(std::in_place_t, _CtorArgs&&... args)
+        : _Proxy(std::forward<_CtorArgs>(args)...)
+        , ref_count_(1)
+    {
+    }
+
+    virtual StoredCallable* CopyTo(void*) override
+    {
+        ref_count_.fetch_add(1, std::memory_order_relaxed);
+        return this;
+    }
+
+    virtual StoredCallable* MoveTo(void*) noexcept override
+    {
+        return this;
+    }
+
+    virtual void Destroy() noexcept override
+    {
+        if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+private:
+    std::atomic<int> ref_count_;
+};
+
+template <typename _Proxy, size_t _Size, size_t _Align>
+struct IsInlineCallable
+    : public std::bool_constant<sizeof(StoredCallable<_Proxy, true>) <= _Size
+                                && alignof(StoredCallable<_Proxy, true>) <= _Align
+                                && std::is_nothrow_move_constructible<StoredCallable<_Proxy, true>>::value
+                                && std::is_copy_constructible<StoredCallable<_Proxy, true>>::value>
+{
+};
+
 }  // namespace details
 
 template <typename _Ty>
 class Function;
 
+/// \~chinese
+/// @brief 
+/// @details ԱհͲ Lambda ֱӴںڲڴ棻
+/// ϴĿɵö󴢴ڶϣʱͬһݶ
 template <typename _Ret, typename... _Args>
 class Function<_Ret(_Args...)>
 {
@@ -244,19 +294,19 @@ public:
     Function(const Function& rhs)
         : callable_(nullptr)
     {
-        SetCallable(rhs.callable_);
+        CopyFrom(rhs);
     }
 
     Function(Function&& rhs) noexcept
-        : callable_(rhs.callable_)
+        : callable_(nullptr)
     {
-        rhs.callable_ = nullptr;
+        MoveFrom(rhs);
     }
 
     Function(_Ret (*func)(_Args...))
         : callable_(nullptr)
     {
-        SetCallable(details::ProxyCallable<_Ret (*)(_Args...), _Ret, _Args...>::Make(std::move(func)));
+        Emplace<details::ProxyCallable<_Ret (*)(_Args...), _Ret, _Args...>>(std::move(func));
     }
 
     template <typename _Ty,
@@ -264,7 +314,7 @@ public:
     Function(_Ty val)
         : callable_(nullptr)
     {
-        SetCallable(details::ProxyCallable<_Ty, _Ret, _Args...>::Make(std::move(val)));
+        Emplace<details::ProxyCallable<_Ty, _Ret, _Args...>>(std::move(val));
     }
 
     template <typename _Ty, typename _Uty,
@@ -273,7 +323,7 @@ public:
     Function(_Uty* ptr, _Ret (_Ty::*func)(_Args...))
         : callable_(nullptr)
     {
-        SetCallable(details::ProxyMemCallable<_Ty, _Ret, _Args...>::Make(ptr, func));
+        Emplace<details::ProxyMemCallable<_Ty, _Ret, _Args...>>(static_cast<_Ty*>(ptr), func);
     }
 
     template <typename _Ty, typename _Uty,
@@ -282,12 +332,12 @@ public:
     Function(_Uty* ptr, _Ret (_Ty::*func)(_Args...) const)
         : callable_(nullptr)
     {
-        SetCallable(details::ProxyConstMemCallable<_Ty, _Ret, _Args...>::Make(ptr, func));
+        Emplace<details::ProxyConstMemCallable<_Ty, _Ret, _Args...>>(static_cast<_Ty*>(ptr), func);
     }
 
     ~Function()
     {
-        SetCallable(nullptr);
+        Reset();
     }
 
     inline _Ret operator()(_Args... args) const
@@ -304,21 +354,32 @@ public:
 
     inline Function& operator=(const Function& rhs)
     {
-        SetCallable(rhs.callable_);
+        if (this != &rhs)
+        {
+            Reset();
+            CopyFrom(rhs);
+        }
         return (*this);
     }
 
-    inline Function& operator=(Function&& rhs)
+    inline Function& operator=(Function&& rhs) noexcept
     {
-        SetCallable(nullptr);
-        callable_     = rhs.callable_;
-        rhs.callable_ = nullptr;
+        if (this != &rhs)
+        {
+            Reset();
+            MoveFrom(rhs);
+        }
         return (*this);
     }
 
-    inline void swap(const Function& rhs)
+    inline void swap(Function& rhs) noexcept
     {
-        std::swap(callable_, rhs.callable_);
+        if (this != &rhs)
+        {
+            Function tmp(std::move(rhs));
+            rhs   = std::move(*this);
+            *this = std::move(tmp);
+        }
     }
 
     const std::type_info& target_type() const noexcept
@@ -338,27 +399,71 @@ public:
         return reinterpret_cast<const _Fx*>(callable_->Target(typeid(_Fx)));
     }
 
+    /// \~chinese
+    /// @brief ɵöǷ񴢴ںڲ
+    inline bool IsStoredInline() const noexcept
+    {
+        return callable_ && static_cast<const void*>(callable_) == static_cast<const void*>(&storage_);
+    }
+
 private:
-    inline void SetCallable(details::Callable<_Ret, _Args...>* callable)
+    using CallableType = details::Callable<_Ret, _Args...>;
+
+    // fits a proxy (vtable pointer + object pointer + member function pointer of a class with multiple
+    // inheritance) or a lambda capturing up to three pointers, see tests/FunctionBenchmark.cpp
+    static const size_t STORAGE_SIZE  = sizeof(void*) * 4;
+    static const size_t STORAGE_ALIGN = alignof(double);
+
+    template <typename _Proxy, typename... _CtorArgs>
+    inline void Emplace(_CtorArgs&&... args)
+    {
+        if constexpr (details::IsInlineCallable<_Proxy, STORAGE_SIZE, STORAGE_ALIGN>::value)
+        {
+            using _StoredTy = details::StoredCallable<_Proxy, true>;
+            callable_       = ::new (&storage_) _StoredTy(std::in_place, std::forward<_CtorArgs>(args)...);
+        }
+        else
+        {
+            using _StoredTy = details::StoredCallable<_Proxy, false>;
+            callable_       = new (std::nothrow) _StoredTy(std::in_place, std::forward<_CtorArgs>(args)...);
+        }
+    }
+
+    inline void CopyFrom(const Function& rhs)
+    {
+        if (rhs.callable_)
+        {
+            callable_ = rhs.callable_->CopyTo(&storage_);
+        }
+    }
+
+    inline void MoveFrom(Function& rhs) noexcept
+    {
+        if (rhs.IsStoredInline())
+        {
+            callable_ = rhs.callable_->MoveTo(&storage_);
+            rhs.Reset();
+        }
+        else
+        {
+            callable_     = rhs.callable_;
+            rhs.callable_ = nullptr;
+        }
+    }
+
+    inline void Reset() noexcept
     {
-        if (callable_ != callable)
+        if (callable_)
         {
-            if (callable_)
-            {
-                callable_->Release();
-                callable_ = nullptr;
-            }
-
-            callable_ = callable;
-            if (callable_)
-            {
-                callable_->Retain();
-            }
+            callable_->Destroy();
+            callable_ = nullptr;
         }
     }
 
 private:
-    details::Callable<_Ret, _Args...>* callable_;
+    typename std::aligned_storage<STORAGE_SIZE, STORAGE_ALIGN>::type storage_;
+
+    CallableType* callable_;
 };
 
 template <
@@ -0,0 +1,450 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <kiwano/core/PoolAllocator.h>
+
+namespace kiwano
+{
+namespace memory
+{
+namespace
+{
+
+const uint32_t large_size_class = uint32_t(-1);
+
+const size_t size_class_table[] = { 16,  32,  48,  64,  80,  96,   112,  128,  160,  192,  224,  256,
+                                    320, 384, 448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048 };
+
+const size_t max_block_size = 2048;
+
+// all blocks are prefixed with a header, so the size class of a pointer
+// can be found in Free() without any lookup
+struct alignas(16) BlockHeader
+{
+    void*    owner;
+    uint32_t size_class;
+    uint32_t size;
+};
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+struct Chunk
+{
+    Chunk* next;
+};
+
+inline BlockHeader* HeaderOf(void* ptr)
+{
+    return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - sizeof(BlockHeader));
+}
+
+inline void* PayloadOf(BlockHeader* header)
+{
+    return reinterpret_cast<char*>(header) + sizeof(BlockHeader);
+}
+
+uint32_t SizeToClass(size_t size)
+{
+    // lookup table indexed by (size - 1) / 16
+    struct Table
+    {
+        uint8_t index[max_block_size / 16];
+
+        Table()
+        {
+            uint8_t cls = 0;
+            for (size_t i = 0; i < max_block_size / 16; ++i)
+            {
+                while (size_class_table[cls] < (i + 1) * 16)
+                    ++cls;
+                index[i] = cls;
+            }
+        }
+    };
+
+    static const Table table;
+
+    if (size == 0)
+        size = 1;
+    if (size > max_block_size)
+        return large_size_class;
+    return table.index[(size - 1) / 16];
+}
+
+uint64_t NextAllocatorId()
+{
+    static std::atomic<uint64_t> next_id(1);
+    return next_id++;
+}
+
+// ids of alive pool allocators, used by exiting threads to check whether
+// their caches can still be handed back
+std::mutex& GetAliveMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<uint64_t>& GetAliveAllocators()
+{
+    static std::vector<uint64_t> ids;
+    return ids;
+}
+
+}  // namespace
+
+struct PoolAllocator::ThreadCache
+{
+    PoolAllocator*          allocator;
+    ThreadCache*            next_cache;
+    bool                    orphaned;
+    FreeBlock*              free_list[SIZE_CLASS_NUM];
+    std::atomic<FreeBlock*> remote_list;
+
+    ThreadCache(PoolAllocator* allocator)
+        : allocator(allocator)
+        , next_cache(nullptr)
+        , orphaned(false)
+        , free_list()
+        , remote_list(nullptr)
+    {
+    }
+
+    inline void PushLocal(BlockHeader* header)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(PayloadOf(header));
+        block->next      = free_list[header->size_class];
+
+        free_list[header->size_class] = block;
+    }
+
+    // lock-free push from any thread
+    inline void PushRemote(BlockHeader* header)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(PayloadOf(header));
+        block->next      = remote_list.load(std::memory_order_relaxed);
+        while (!remote_list.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                                  std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // only the owner thread takes blocks out of the remote list, and it always takes all of them,
+    // so there is no ABA problem
+    inline void DrainRemote()
+    {
+        FreeBlock* block = remote_list.exchange(nullptr, std::memory_order_acquire);
+        while (block)
+        {
+            FreeBlock* next = block->next;
+            PushLocal(HeaderOf(block));
+            block = next;
+        }
+    }
+};
+
+struct ThreadCacheRegistry
+{
+    struct Slot
+    {
+        uint64_t                    id;
+        PoolAllocator*              allocator;
+        PoolAllocator::ThreadCache* cache;
+    };
+
+    // keep members trivially destructible, so that frees issued by other thread-local
+    // destructors after this one still see a valid (empty) registry
+    bool   alive;
+    size_t count;
+    Slot   slots[8];
+
+    ThreadCacheRegistry()
+        : alive(true)
+        , count(0)
+    {
+    }
+
+    ~ThreadCacheRegistry()
+    {
+        std::lock_guard<std::mutex> lock(GetAliveMutex());
+
+        auto& ids = GetAliveAllocators();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (std::find(ids.begin(), ids.end(), slots[i].id) != ids.end())
+            {
+                slots[i].allocator->ReleaseThreadCache(slots[i].cache);
+            }
+        }
+        count = 0;
+        alive = false;
+    }
+};
+
+namespace
+{
+
+thread_local ThreadCacheRegistry thread_cache_registry;
+
+}  // namespace
+
+PoolAllocator::PoolAllocator(size_t chunk_size)
+    : id_(NextAllocatorId())
+    , chunk_size_(std::max(chunk_size, max_block_size * 4))
+    , caches_(nullptr)
+    , chunks_(nullptr)
+    , counters_()
+    , large_counter_()
+{
+    std::lock_guard<std::mutex> lock(GetAliveMutex());
+    GetAliveAllocators().push_back(id_);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    {
+        std::lock_guard<std::mutex> lock(GetAliveMutex());
+
+        auto& alive = GetAliveAllocators();
+        alive.erase(std::remove(alive.begin(), alive.end(), id_), alive.end());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ThreadCache* cache = caches_;
+    while (cache)
+    {
+        ThreadCache* next = cache->next_cache;
+        delete cache;
+        cache = next;
+    }
+    caches_ = nullptr;
+
+    Chunk* chunk = static_cast<Chunk*>(chunks_);
+    while (chunk)
+    {
+        Chunk* next = chunk->next;
+        ::operator delete(chunk);
+        chunk = next;
+    }
+    chunks_ = nullptr;
+}
+
+void* PoolAllocator::Alloc(size_t size)
+{
+    uint32_t     size_class = SizeToClass(size);
+    ThreadCache* cache      = (size_class != large_size_class) ? GetThreadCache() : nullptr;
+    if (!cache)
+    {
+        BlockHeader* header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size));
+        header->owner       = nullptr;
+        header->size_class  = large_size_class;
+        header->size        = uint32_t(size);
+
+        OnAlloc(large_counter_, size);
+        return PayloadOf(header);
+    }
+
+    if (!cache->free_list[size_class])
+    {
+        cache->DrainRemote();
+        if (!cache->free_list[size_class])
+        {
+            Refill(cache, size_class);
+        }
+    }
+
+    FreeBlock* block = cache->free_list[size_class];
+    cache->free_list[size_class] = block->next;
+
+    OnAlloc(counters_[size_class], size_class_table[size_class]);
+    return block;
+}
+
+void PoolAllocator::Free(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    BlockHeader* header = HeaderOf(ptr);
+    if (header->size_class == large_size_class)
+    {
+        OnFree(large_counter_, header->size);
+        ::operator delete(header);
+        return;
+    }
+
+    OnFree(counters_[header->size_class], size_class_table[header->size_class]);
+
+    ThreadCache* owner = static_cast<ThreadCache*>(header->owner);
+    if (owner == GetThreadCache())
+    {
+        owner->PushLocal(header);
+    }
+    else
+    {
+        owner->PushRemote(header);
+    }
+}
+
+size_t PoolAllocator::GetSizeClassCount()
+{
+    return SIZE_CLASS_NUM;
+}
+
+size_t PoolAllocator::GetMaxBlockSize()
+{
+    return max_block_size;
+}
+
+PoolAllocator::Stats PoolAllocator::GetStats(size_t size_class) const
+{
+    KGE_ASSERT(size_class < SIZE_CLASS_NUM);
+    return MakeStats(counters_[size_class], size_class_table[size_class]);
+}
+
+PoolAllocator::Stats PoolAllocator::GetLargeBlockStats() const
+{
+    return MakeStats(large_counter_, 0);
+}
+
+void PoolAllocator::ResetPeakStats()
+{
+    for (auto& counter : counters_)
+    {
+        counter.peak  = counter.live.load();
+        counter.total = 0;
+    }
+    large_counter_.peak  = large_counter_.live.load();
+    large_counter_.total = 0;
+}
+
+PoolAllocator::ThreadCache* PoolAllocator::GetThreadCache()
+{
+    auto& registry = thread_cache_registry;
+    for (size_t i = 0; i < registry.count; ++i)
+    {
+        if (registry.slots[i].id == id_)
+            return registry.slots[i].cache;
+    }
+
+    // the thread is exiting or uses too many pools
+    if (!registry.alive || registry.count == std::size(registry.slots))
+        return nullptr;
+
+    ThreadCache* cache = AcquireThreadCache();
+
+    registry.slots[registry.count++] = ThreadCacheRegistry::Slot{ id_, this, cache };
+    return cache;
+}
+
+PoolAllocator::ThreadCache* PoolAllocator::AcquireThreadCache()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // adopt a cache left by an exited thread, blocks freed to it in the meantime
+    // are still in its remote list
+    for (ThreadCache* cache = caches_; cache; cache = cache->next_cache)
+    {
+        if (cache->orphaned)
+        {
+            cache->orphaned = false;
+            return cache;
+        }
+    }
+
+    ThreadCache* cache = new ThreadCache(this);
+    cache->next_cache  = caches_;
+    caches_            = cache;
+    return cache;
+}
+
+void PoolAllocator::ReleaseThreadCache(ThreadCache* cache)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache->orphaned = true;
+}
+
+void PoolAllocator::Refill(ThreadCache* cache, uint32_t size_class)
+{
+    const size_t block_size = sizeof(BlockHeader) + size_class_table[size_class];
+    const size_t header_size = sizeof(BlockHeader);  // keeps blocks 16-byte aligned
+
+    Chunk* chunk = static_cast<Chunk*>(::operator new(chunk_size_));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunk->next = static_cast<Chunk*>(chunks_);
+        chunks_     = chunk;
+    }
+
+    char*  begin = reinterpret_cast<char*>(chunk) + header_size;
+    size_t count = (chunk_size_ - header_size) / block_size;
+
+    // push in reverse order so that blocks are handed out by ascending address
+    for (size_t i = count; i > 0; --i)
+    {
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(begin + (i - 1) * block_size);
+        header->owner       = cache;
+        header->size_class  = size_class;
+        header->size        = uint32_t(size_class_table[size_class]);
+        cache->PushLocal(header);
+    }
+
+    counters_[size_class].reserved_bytes += chunk_size_;
+}
+
+void PoolAllocator::OnAlloc(Counter& counter, size_t bytes)
+{
+    size_t live = counter.live.fetch_add(1, std::memory_order_relaxed) + 1;
+    counter.total.fetch_add(1, std::memory_order_relaxed);
+    counter.live_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    size_t peak = counter.peak.load(std::memory_order_relaxed);
+    while (live > peak && !counter.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+void PoolAllocator::OnFree(Counter& counter, size_t bytes)
+{
+    counter.live.fetch_sub(1, std::memory_order_relaxed);
+    counter.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+PoolAllocator::Stats PoolAllocator::MakeStats(const Counter& counter, size_t block_size) const
+{
+    Stats stats;
+    stats.block_size     = block_size;
+    stats.live_count     = counter.live.load(std::memory_order_relaxed);
+    stats.peak_count     = counter.peak.load(std::memory_order_relaxed);
+    stats.total_count    = counter.total.load(std::memory_order_relaxed);
+    stats.live_bytes     = counter.live_bytes.load(std::memory_order_relaxed);
+    stats.reserved_bytes = counter.reserved_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace memory
+}  // namespace kiwano
@@ -0,0 +1,133 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <kiwano/core/Allocator.h>
+
+namespace kiwano
+{
+namespace memory
+{
+
+/// \~chinese
+/// @brief ڴط
+/// @details
+/// Сּڴ飬ÿ߳ӵжĿͬ߳ͷž
+/// ߳ͷŵڴͨ黹ֱּ̡߳ϵͳ롣
+/// Ҫڴκζ֮ǰͨ memory::SetAllocator װ֤ڳڴ棺
+/// @code
+///   static memory::PoolAllocator pool;
+///   memory::SetAllocator(&pool);
+/// @endcode
+class KGE_API PoolAllocator : public MemoryAllocator
+{
+public:
+    /// \~chinese
+    /// @brief СּͳϢ
+    struct Stats
+    {
+        size_t block_size;      ///< ڴС
+        size_t live_count;      ///< ʹõڴ
+        size_t peak_count;      ///< ʹõڴֵ
+        size_t total_count;     ///< ۼƷ
+        size_t live_bytes;      ///< ʹõڴֽ
+        size_t reserved_bytes;  ///< ϵͳڴֽ
+    };
+
+    /// \~chinese
+    /// @brief ڴط
+    /// @param chunk_size ÿϵͳڴС
+    PoolAllocator(size_t chunk_size = 64 * 1024);
+
+    virtual ~PoolAllocator();
+
+    /// \~chinese
+    /// @brief ڴ
+    void* Alloc(size_t size) override;
+
+    /// \~chinese
+    /// @brief ͷڴ
+    void Free(void* ptr) override;
+
+    /// \~chinese
+    /// @brief ȡСּ
+    static size_t GetSizeClassCount();
+
+    /// \~chinese
+    /// @brief ȡڴؿɹڴС
+    static size_t GetMaxBlockSize();
+
+    /// \~chinese
+    /// @brief ȡСּͳϢ
+    /// @param size_class СּΧ [0, GetSizeClassCount())
+    Stats GetStats(size_t size_class) const;
+
+    /// \~chinese
+    /// @brief ȡּڴͳϢ
+    Stats GetLargeBlockStats() const;
+
+    /// \~chinese
+    /// @brief зּķֵۼƷ
+    void ResetPeakStats();
+
+private:
+    static const size_t SIZE_CLASS_NUM = 24;
+
+    struct ThreadCache;
+
+    struct Counter
+    {
+        std::atomic<size_t> live;
+        std::atomic<size_t> peak;
+        std::atomic<size_t> total;
+        std::atomic<size_t> live_bytes;
+        std::atomic<size_t> reserved_bytes;
+    };
+
+    ThreadCache* GetThreadCache();
+
+    ThreadCache* AcquireThreadCache();
+
+    void ReleaseThreadCache(ThreadCache* cache);
+
+    void Refill(ThreadCache* cache, uint32_t size_class);
+
+    void OnAlloc(Counter& counter, size_t bytes);
+
+    void OnFree(Counter& counter, size_t bytes);
+
+    Stats MakeStats(const Counter& counter, size_t block_size) const;
+
+    friend struct ThreadCacheRegistry;
+
+private:
+    uint64_t     id_;
+    size_t       chunk_size_;
+    std::mutex   mutex_;
+    ThreadCache* caches_;
+    void*        chunks_;
+    Counter      counters_[SIZE_CLASS_NUM];
+    Counter      large_counter_;
+};
+
+}  // namespace memory
+}  // namespace kiwano
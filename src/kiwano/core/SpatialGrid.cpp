@@ -0,0 +1,122 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/core/SpatialGrid.h>
+#include <algorithm>
+#include <cmath>
+
+namespace kiwano
+{
+
+SpatialGrid::SpatialGrid(float cell_size)
+    : cell_size_(cell_size)
+    , inv_cell_size_(1.f / cell_size)
+{
+    KGE_ASSERT(cell_size > 0.f && "SpatialGrid cell size must be positive");
+}
+
+void SpatialGrid::Insert(uint32_t id, const Rect& bounds)
+{
+    const float left = bounds.GetLeft(), top = bounds.GetTop();
+    const float right = bounds.GetRight(), bottom = bounds.GetBottom();
+
+    // NaN, infinite and huge rectangles are kept out of the grid
+    const float max_extent = cell_size_ * MAX_CELLS_PER_ITEM;
+    if (!(right - left <= max_extent) || !(bottom - top <= max_extent) || !std::isfinite(left) || !std::isfinite(top))
+    {
+        large_items_.push_back(Item{ id, bounds });
+        return;
+    }
+
+    const int x0 = ToCell(left), x1 = ToCell(right);
+    const int y0 = ToCell(top), y1 = ToCell(bottom);
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > MAX_CELLS_PER_ITEM)
+    {
+        large_items_.push_back(Item{ id, bounds });
+        return;
+    }
+
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            cells_[MakeKey(x, y)].push_back(Item{ id, bounds });
+        }
+    }
+}
+
+void SpatialGrid::Query(const Point& point, Vector<uint32_t>& ids) const
+{
+    const size_t first = ids.size();
+
+    if (std::isfinite(point.x) && std::isfinite(point.y))
+    {
+        auto iter = cells_.find(MakeKey(ToCell(point.x), ToCell(point.y)));
+        if (iter != cells_.end())
+        {
+            for (const auto& item : iter->second)
+            {
+                if (item.bounds.ContainsPoint(point))
+                    ids.push_back(item.id);
+            }
+        }
+    }
+
+    const size_t middle = ids.size();
+    for (const auto& item : large_items_)
+    {
+        if (item.bounds.ContainsPoint(point))
+            ids.push_back(item.id);
+    }
+
+    if (middle != first && middle != ids.size())
+        std::inplace_merge(ids.begin() + first, ids.begin() + middle, ids.end());
+}
+
+void SpatialGrid::Clear()
+{
+    for (auto iter = cells_.begin(); iter != cells_.end();)
+    {
+        if (iter->second.empty())
+        {
+            iter = cells_.erase(iter);
+        }
+        else
+        {
+            iter->second.clear();
+            ++iter;
+        }
+    }
+    large_items_.clear();
+}
+
+int SpatialGrid::ToCell(float value) const
+{
+    // clamp to keep far away coordinates from overflowing
+    const float cell = std::floor(value * inv_cell_size_);
+    return static_cast<int>(std::min(std::max(cell, -1073741824.f), 1073741824.f));
+}
+
+uint64_t SpatialGrid::MakeKey(int x, int y)
+{
+    return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(y));
+}
+
+}  // namespace kiwano
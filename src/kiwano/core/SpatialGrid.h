@@ -0,0 +1,88 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/core/Common.h>
+#include <kiwano/math/Math.h>
+
+namespace kiwano
+{
+
+/**
+ * \~chinese
+ * @brief ȿռ
+ * @details ̶߳ƽ棬ڿٲѯĳľΡԪĴ洢ռ֮临ã
+ * ǵԪľβ񣬲ѯʱ
+ */
+class KGE_API SpatialGrid
+{
+public:
+    /// \~chinese
+    /// @brief ռ
+    /// @param cell_size Ԫ߳
+    SpatialGrid(float cell_size = 128.f);
+
+    /// \~chinese
+    /// @brief 
+    /// @param id αţӦ˳
+    /// @param bounds 
+    void Insert(uint32_t id, const Rect& bounds);
+
+    /// \~chinese
+    /// @brief ѯָо
+    /// @param point ѯ
+    /// @param[out] ids ׷Ӳѯ
+    void Query(const Point& point, Vector<uint32_t>& ids) const;
+
+    /// \~chinese
+    /// @brief 
+    /// @details ʹõĵԪĴ洢ռ䣬ͷһպδʹõĵԪ
+    void Clear();
+
+    /// \~chinese
+    /// @brief ȡԪ߳
+    float GetCellSize() const;
+
+private:
+    struct Item
+    {
+        uint32_t id;
+        Rect     bounds;
+    };
+
+    static const int MAX_CELLS_PER_ITEM = 16;
+
+    int ToCell(float value) const;
+
+    static uint64_t MakeKey(int x, int y);
+
+private:
+    float                                cell_size_;
+    float                                inv_cell_size_;
+    UnorderedMap<uint64_t, Vector<Item>> cells_;
+    Vector<Item>                         large_items_;
+};
+
+inline float SpatialGrid::GetCellSize() const
+{
+    return cell_size_;
+}
+
+}  // namespace kiwano
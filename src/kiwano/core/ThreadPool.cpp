@@ -0,0 +1,157 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/core/ThreadPool.h>
+#include <atomic>
+#include <memory>
+
+namespace kiwano
+{
+
+ThreadPool::ThreadPool(uint32_t thread_count)
+    : stopping_(false)
+    , running_jobs_(0)
+{
+    if (thread_count == 0)
+    {
+        // Leave one core for the main thread
+        const uint32_t cores = std::thread::hardware_concurrency();
+        thread_count         = (cores > 1) ? (cores - 1) : 1;
+    }
+
+    threads_.reserve(thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        threads_.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    job_cond_.notify_all();
+
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::Submit(Function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push(std::move(job));
+    }
+    job_cond_.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cond_.wait(lock, [this]() { return jobs_.empty() && running_jobs_ == 0; });
+}
+
+void ThreadPool::ParallelFor(size_t count, const Function<void(size_t)>& job)
+{
+    if (count == 0)
+        return;
+
+    struct Batch
+    {
+        const Function<void(size_t)>* job;
+        size_t                        count;
+        std::atomic<size_t>           next;
+        std::atomic<size_t>           finished;
+        std::mutex                    mutex;
+        std::condition_variable       done_cond;
+
+        void Run()
+        {
+            // the job is only touched while an index is claimed, and the caller
+            // waits for every claimed index, so late helpers never see a dangling job
+            size_t index = 0;
+            while ((index = next.fetch_add(1)) < count)
+            {
+                (*job)(index);
+
+                if (finished.fetch_add(1) + 1 == count)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done_cond.notify_all();
+                }
+            }
+        }
+    };
+
+    auto batch      = std::make_shared<Batch>();
+    batch->job      = &job;
+    batch->count    = count;
+    batch->next     = 0;
+    batch->finished = 0;
+
+    const size_t helpers = std::min(count - 1, threads_.size());
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        Submit([batch]() { batch->Run(); });
+    }
+
+    batch->Run();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done_cond.wait(lock, [&]() { return batch->finished.load() == count; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        Function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_cond_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+
+            // Drain the queue before quitting
+            if (jobs_.empty())
+                break;
+
+            job = std::move(jobs_.front());
+            jobs_.pop();
+            ++running_jobs_;
+        }
+
+        if (job)
+        {
+            job();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --running_jobs_;
+            if (jobs_.empty() && running_jobs_ == 0)
+                idle_cond_.notify_all();
+        }
+    }
+}
+
+}  // namespace kiwano
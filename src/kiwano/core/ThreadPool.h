@@ -0,0 +1,82 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <kiwano/core/Common.h>
+
+namespace kiwano
+{
+
+/// \~chinese
+/// @brief ̳߳
+/// @details ɹ̶Ĺ̰߳ύ˳ִʱȴύִ
+class KGE_API ThreadPool : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief ̳߳
+    /// @param thread_count ߳Ϊ 0 ʱ CPU 
+    ThreadPool(uint32_t thread_count = 0);
+
+    ~ThreadPool();
+
+    /// \~chinese
+    /// @brief ύ
+    /// @param job ڹִ߳е
+    void Submit(Function<void()> job);
+
+    /// \~chinese
+    /// @brief ȴύִ
+    void WaitIdle();
+
+    /// \~chinese
+    /// @brief ִһ񣬷ʱִ
+    /// @param count 
+    /// @param job 񣬲Ϊ
+    /// @details ߳ҲִУе̴߳ӹļȡһ񣬺ʱҲ̡ܷ̯߳
+    /// Ҫ̳߳صĹ߳еøú
+    void ParallelFor(size_t count, const Function<void(size_t)>& job);
+
+    /// \~chinese
+    /// @brief ȡ߳
+    uint32_t GetThreadCount() const;
+
+private:
+    void WorkerLoop();
+
+private:
+    bool                    stopping_;
+    uint32_t                running_jobs_;
+    Vector<std::thread>     threads_;
+    Queue<Function<void()>> jobs_;
+    std::mutex              mutex_;
+    std::condition_variable job_cond_;
+    std::condition_variable idle_cond_;
+};
+
+inline uint32_t ThreadPool::GetThreadCount() const
+{
+    return uint32_t(threads_.size());
+}
+
+}  // namespace kiwano
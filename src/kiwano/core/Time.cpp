@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <chrono>  // std::chrono
+#include <time.h>  // clock_gettime
 #include <kiwano/core/Time.h>
 
 namespace kiwano
@@ -39,56 +40,66 @@ Time::Time(int64_t dur)
 
 const Time Time::operator+(const Duration& dur) const
 {
-    return Time{ dur_ + dur.GetMilliseconds() };
+    return Time{ dur_ + dur.GetNanoseconds() };
 }
 
 const Time Time::operator-(const Duration& dur) const
 {
-    return Time{ dur_ - dur.GetMilliseconds() };
+    return Time{ dur_ - dur.GetNanoseconds() };
 }
 
 Time& Time::operator+=(const Duration& other)
 {
-    dur_ += other.GetMilliseconds();
+    dur_ += other.GetNanoseconds();
     return (*this);
 }
 
 Time& Time::operator-=(const Duration& other)
 {
-    dur_ -= other.GetMilliseconds();
+    dur_ -= other.GetNanoseconds();
     return (*this);
 }
 
 const Duration Time::operator-(const Time& other) const
 {
-    return Duration(dur_ - other.dur_);
+    return Duration::FromNanoseconds(dur_ - other.dur_);
 }
 
 Time Time::Now() noexcept
 {
 #if defined(KGE_PLATFORM_WINDOWS)
 
-    static double millisecs_per_count = {};
-    if (millisecs_per_count == 0)
+    static int64_t counts_per_sec = 0;
+    if (counts_per_sec == 0)
     {
         LARGE_INTEGER freq = {};
         // the Function will always succceed on systems that run Windows XP or later
         QueryPerformanceFrequency(&freq);
-        millisecs_per_count = 1000.0 / static_cast<double>(freq.QuadPart);
+        counts_per_sec = static_cast<int64_t>(freq.QuadPart);
     }
 
     LARGE_INTEGER count;
     QueryPerformanceCounter(&count);
-    return Time{ static_cast<int64_t>(count.QuadPart * millisecs_per_count) };
+
+    // Split into seconds and remainder so that the conversion does not overflow
+    const int64_t sec = count.QuadPart / counts_per_sec;
+    const int64_t rem = count.QuadPart % counts_per_sec;
+    return Time{ sec * 1000000000LL + rem * 1000000000LL / counts_per_sec };
+
+#elif defined(KGE_PLATFORM_LINUX) || defined(KGE_PLATFORM_ANDROID)
+
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return Time{ static_cast<int64_t>(ts.tv_sec) * 1000000000LL + static_cast<int64_t>(ts.tv_nsec) };
 
 #else
 
     using std::chrono::duration_cast;
-    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
     using std::chrono::steady_clock;
 
     const auto now   = steady_clock::now();
-    const auto count = duration_cast<milliseconds>(now.time_since_epoch()).count();
+    const auto count = duration_cast<nanoseconds>(now.time_since_epoch()).count();
     return Time{ static_cast<int64_t>(count) };
 
 #endif
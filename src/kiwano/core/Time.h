@@ -36,7 +36,7 @@ namespace kiwano
  *   Time t2 = Time::Now();
  *   int ms = (t2 - t1).GetMilliseconds();  // ȡʱĺ
  * @endcode
- * @note ʱϵͳʱ޹أ˲ܽʱתΪʱ
+ * @note ʱԵĸ߾ʱӣΪ룬ϵͳʱ޹أ˲ܽʱתΪʱ
  */
 struct KGE_API Time
 {
@@ -60,10 +60,10 @@ struct KGE_API Time
     Time& operator-=(const Duration&);
 
 private:
-    Time(int64_t ms);
+    Time(int64_t ns);
 
 private:
-    int64_t dur_;
+    int64_t dur_;  // nanoseconds
 };
 
 /**
@@ -80,9 +80,14 @@ template <typename _Ty>
 struct IsSameEventType
 {
     inline bool operator()(const Event* evt) const
+    {
+        return (*this)(evt->GetType());
+    }
+
+    inline bool operator()(const EventType& type) const
     {
         static_assert(std::is_base_of<Event, _Ty>::value, "_Ty is not an event type.");
-        return evt->GetType() == KGE_EVENT(_Ty);
+        return type == KGE_EVENT(_Ty);
     }
 };
 
@@ -20,29 +20,83 @@
 
 #include <kiwano/event/EventDispatcher.h>
 #include <kiwano/utils/Logger.h>
+#include <algorithm>
 
 namespace kiwano
 {
+EventDispatcher::EventDispatcher()
+    : untyped_live_count_(0)
+    , next_listener_order_(0)
+    , dispatching_depth_(0)
+    , removing_(false)
+{
+}
+
+EventDispatcher::~EventDispatcher()
+{
+    // listeners may outlive the dispatcher
+    for (auto& listener : listeners_)
+    {
+        listener->dispatcher_ = nullptr;
+    }
+}
+
 bool EventDispatcher::DispatchEvent(Event* evt)
 {
     if (listeners_.IsEmpty())
         return true;
 
-    RefPtr<EventListener> next;
-    for (auto listener = listeners_.GetFirst(); listener; listener = next)
+    const ListenerBucket* typed = nullptr;
+
+    auto iter = typed_listeners_.find(evt->GetType());
+    if (iter != typed_listeners_.end())
+        typed = &iter->second;
+
+    // Listeners may be added while dispatching, so the sizes are read in every loop.
+    // Removeable listeners are kept until the outermost dispatch ends.
+    ++dispatching_depth_;
+
+    bool   swallowed     = false;
+    size_t typed_index   = 0;
+    size_t untyped_index = 0;
+    while (true)
     {
-        next = listener->GetNext();
+        const bool has_typed   = typed && typed_index < typed->size();
+        const bool has_untyped = untyped_index < untyped_listeners_.size();
+        if (!has_typed && !has_untyped)
+            break;
+
+        // merge two buckets in the order of addition
+        EventListener* listener = nullptr;
+        if (has_typed && (!has_untyped || (*typed)[typed_index].first < untyped_listeners_[untyped_index].first))
+            listener = (*typed)[typed_index++].second;
+        else
+            listener = untyped_listeners_[untyped_index++].second;
+
+        if (listener->IsRemoveable())
+        {
+            removing_ = true;
+            continue;
+        }
 
         if (listener->IsRunning())
             listener->Handle(evt);
 
         if (listener->IsRemoveable())
-            listeners_.Remove(listener);
+            removing_ = true;
 
         if (listener->IsSwallowEnabled())
-            return false;
+        {
+            swallowed = true;
+            break;
+        }
     }
-    return true;
+
+    --dispatching_depth_;
+
+    if (removing_ && dispatching_depth_ == 0)
+        RemoveRemoveableListeners();
+    return !swallowed;
 }
 
 EventListener* EventDispatcher::AddListener(RefPtr<EventListener> listener)
@@ -51,7 +105,29 @@ EventListener* EventDispatcher::AddListener(RefPtr<EventListener> listener)
 
     if (listener)
     {
+        KGE_ASSERT(!listener->dispatcher_ && "AddListener failed, the listener has been added to a dispatcher");
+
         listeners_.PushBack(listener);
+        listener->dispatcher_ = this;
+
+        const auto& type = listener->GetEventType();
+        if (type.IsNull())
+            untyped_listeners_.emplace_back(next_listener_order_++, listener.Get());
+        else
+            typed_listeners_[type].emplace_back(next_listener_order_++, listener.Get());
+
+        if (listener->IsRemoveable())
+        {
+            removing_ = true;
+        }
+        else if (type.IsNull())
+        {
+            ++untyped_live_count_;
+        }
+        else
+        {
+            ++typed_live_counts_[type];
+        }
     }
     return listener.Get();
 }
@@ -99,6 +175,9 @@ void EventDispatcher::RemoveListeners(StringView name)
             listener->Remove();
         }
     }
+
+    if (removing_ && dispatching_depth_ == 0)
+        RemoveRemoveableListeners();
 }
 
 void EventDispatcher::StartAllListeners()
@@ -123,6 +202,9 @@ void EventDispatcher::RemoveAllListeners()
     {
         listener->Remove();
     }
+
+    if (removing_ && dispatching_depth_ == 0)
+        RemoveRemoveableListeners();
 }
 
 const ListenerList& EventDispatcher::GetAllListeners() const
@@ -130,4 +212,56 @@ const ListenerList& EventDispatcher::GetAllListeners() const
     return listeners_;
 }
 
+void EventDispatcher::RemoveRemoveableListeners()
+{
+    removing_ = false;
+
+    auto is_removeable = [](const ListenerBucket::value_type& pair) { return pair.second->IsRemoveable(); };
+
+    untyped_listeners_.erase(std::remove_if(untyped_listeners_.begin(), untyped_listeners_.end(), is_removeable),
+                             untyped_listeners_.end());
+
+    for (auto iter = typed_listeners_.begin(); iter != typed_listeners_.end();)
+    {
+        auto& bucket = iter->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(), is_removeable), bucket.end());
+
+        if (bucket.empty())
+            iter = typed_listeners_.erase(iter);
+        else
+            ++iter;
+    }
+
+    // release the listeners after they are removed from buckets
+    RefPtr<EventListener> next;
+    for (auto listener = listeners_.GetFirst(); listener; listener = next)
+    {
+        next = listener->GetNext();
+
+        if (listener->IsRemoveable())
+        {
+            listener->dispatcher_ = nullptr;
+            listeners_.Remove(listener);
+        }
+    }
+}
+
+void EventDispatcher::OnListenerRemoved(EventListener* listener)
+{
+    // the listener is released when no dispatching is in progress, but it stops counting at once
+    removing_ = true;
+
+    const auto& type = listener->GetEventType();
+    if (type.IsNull())
+    {
+        --untyped_live_count_;
+    }
+    else
+    {
+        auto iter = typed_live_counts_.find(type);
+        if (iter != typed_live_counts_.end() && --iter->second == 0)
+            typed_live_counts_.erase(iter);
+    }
+}
+
 }  // namespace kiwano
@@ -34,9 +34,14 @@ typedef IntrusiveList<RefPtr<EventListener>> ListenerList;
  */
 class KGE_API EventDispatcher : protected IntrusiveListValue<EventDispatcher*>
 {
+    friend class EventListener;
     friend IntrusiveList<EventDispatcher*>;
 
 public:
+    EventDispatcher();
+
+    virtual ~EventDispatcher();
+
     /// \~chinese
     /// @brief Ӽ
     EventListener* AddListener(RefPtr<EventListener> listener);
@@ -108,6 +113,45 @@ public:
     /// @brief ȡм
     const ListenerList& GetAllListeners() const;
 
+    /// \~chinese
+    /// @brief Ƿڿܴĳ¼ļ
+    /// @tparam _EventTy ¼ͣ MouseEventKeyEvent ¼
+    template <typename _EventTy>
+    bool HasListener() const
+    {
+        return GetListenerMask<_EventTy>() != 0;
+    }
+
+    /// \~chinese
+    /// @brief һαжǷڿܴ¼ļ
+    /// @tparam _EventTy ¼ͣ MouseEventKeyEvent ¼
+    /// @return λ룬 i λʾǷڿܴ i ģӦ¼ļ
+    template <typename... _EventTy>
+    uint32_t GetListenerMask() const
+    {
+        static_assert(sizeof...(_EventTy) > 0 && sizeof...(_EventTy) < 32, "Invalid count of event types.");
+
+        const uint32_t all = (1u << sizeof...(_EventTy)) - 1;
+        if (untyped_live_count_ > 0)
+            return all;
+
+        // removed listeners are not counted, though they are released later
+        uint32_t mask = 0;
+        for (const auto& pair : typed_live_counts_)
+        {
+            const bool matched[] = { IsSameEventType<_EventTy>()(pair.first)... };
+            for (uint32_t i = 0; i < sizeof...(_EventTy); ++i)
+            {
+                if (matched[i])
+                    mask |= 1u << i;
+            }
+
+            if (mask == all)
+                break;
+        }
+        return mask;
+    }
+
     /// \~chinese
     /// @brief ַ¼
     /// @param evt ¼
@@ -115,6 +159,25 @@ public:
     virtual bool DispatchEvent(Event* evt);
 
 private:
-    ListenerList listeners_;
+    /// \~chinese
+    /// @brief ƳбΪƳļ
+    void RemoveRemoveableListeners();
+
+    /// \~chinese
+    /// @brief ΪƳʱ
+    void OnListenerRemoved(EventListener* listener);
+
+    /// \~chinese
+    /// @brief ˳еļ
+    typedef Vector<Pair<uint64_t, EventListener*>> ListenerBucket;
+
+    ListenerList                            listeners_;
+    ListenerBucket                          untyped_listeners_;
+    UnorderedMap<EventType, ListenerBucket> typed_listeners_;
+    UnorderedMap<EventType, uint32_t>       typed_live_counts_;
+    uint32_t                                untyped_live_count_;
+    uint64_t                                next_listener_order_;
+    int                                     dispatching_depth_;
+    bool                                    removing_;
 };
 }  // namespace kiwano
@@ -0,0 +1,80 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/event/EventPool.h>
+
+namespace kiwano
+{
+
+namespace
+{
+
+Vector<EventPoolBase*>& GetEventPools()
+{
+    static Vector<EventPoolBase*> pools;
+    return pools;
+}
+
+}  // namespace
+
+EventPoolBase::EventPoolBase()
+{
+    GetEventPools().push_back(this);
+}
+
+EventPoolBase::~EventPoolBase()
+{
+    auto& pools = GetEventPools();
+    auto  iter  = std::find(pools.begin(), pools.end(), this);
+    if (iter != pools.end())
+    {
+        pools.erase(iter);
+    }
+}
+
+EventPoolStats EventPoolBase::GetTotalFrameStats()
+{
+    EventPoolStats total;
+    for (auto pool : GetEventPools())
+    {
+        total.allocated_count += pool->frame_stats_.allocated_count;
+        total.reused_count += pool->frame_stats_.reused_count;
+    }
+    return total;
+}
+
+void EventPoolBase::NextFrame()
+{
+    for (auto pool : GetEventPools())
+    {
+        pool->frame_stats_   = pool->current_stats_;
+        pool->current_stats_ = EventPoolStats();
+    }
+}
+
+void EventPoolBase::ClearAll()
+{
+    for (auto pool : GetEventPools())
+    {
+        pool->Clear();
+    }
+}
+
+}  // namespace kiwano
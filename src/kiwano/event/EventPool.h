@@ -0,0 +1,242 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <mutex>
+#include <kiwano/event/Event.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Event
+ * @{
+ */
+
+/// \~chinese
+/// @brief ¼طͳ
+struct EventPoolStats
+{
+    uint32_t allocated_count;  ///< ·¼
+    uint32_t reused_count;     ///< õ¼
+
+    EventPoolStats();
+};
+
+/// \~chinese
+/// @brief ¼ػ
+/// @details ¼ÿ֡¼иʱ¼ػڹ߳ʹãͳֻ߳жȡ
+class KGE_API EventPoolBase : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief ȡһ֡ķͳ
+    const EventPoolStats& GetFrameStats() const;
+
+    /// \~chinese
+    /// @brief ȡ¼һ֡ķͳ֮
+    static EventPoolStats GetTotalFrameStats();
+
+    /// \~chinese
+    /// @brief һ֡沢¼صķͳ
+    static void NextFrame();
+
+    /// \~chinese
+    /// @brief ¼
+    static void ClearAll();
+
+    /// \~chinese
+    /// @brief ¼
+    virtual void Clear() = 0;
+
+protected:
+    EventPoolBase();
+
+    virtual ~EventPoolBase();
+
+    void OnAllocated();
+
+    void OnReused();
+
+private:
+    EventPoolStats current_stats_;
+    EventPoolStats frame_stats_;
+};
+
+/// \~chinese
+/// @brief ¼
+/// @details б¼ã¼ٱⲿʱüΪ1ɱ¹첢
+template <typename _Ty>
+class EventPool : public EventPoolBase
+{
+    static_assert(std::is_base_of<Event, _Ty>::value, "_Ty is not an event type.");
+
+public:
+    /// \~chinese
+    /// @brief ȡ¼͵¼
+    static EventPool& GetInstance();
+
+    /// \~chinese
+    /// @brief ¼лȡ¼
+    /// @param args ¼
+    template <typename... _Args>
+    static RefPtr<_Ty> Acquire(_Args&&... args);
+
+    /// \~chinese
+    /// @brief ¼
+    /// @details ¼ռﵽʱ·¼ٷ
+    void SetCapacity(size_t capacity);
+
+    /// \~chinese
+    /// @brief ȡ¼
+    size_t GetCapacity() const;
+
+    /// \~chinese
+    /// @brief ȡ¼
+    size_t GetSize() const;
+
+    void Clear() override;
+
+private:
+    EventPool();
+
+    template <typename... _Args>
+    RefPtr<_Ty> AcquireEvent(_Args&&... args);
+
+private:
+    size_t              capacity_;
+    size_t              cursor_;
+    Vector<RefPtr<_Ty>> events_;
+    std::mutex          mutex_;
+};
+
+/** @} */
+
+inline EventPoolStats::EventPoolStats()
+    : allocated_count(0)
+    , reused_count(0)
+{
+}
+
+inline const EventPoolStats& EventPoolBase::GetFrameStats() const
+{
+    return frame_stats_;
+}
+
+inline void EventPoolBase::OnAllocated()
+{
+    ++current_stats_.allocated_count;
+}
+
+inline void EventPoolBase::OnReused()
+{
+    ++current_stats_.reused_count;
+}
+
+template <typename _Ty>
+inline EventPool<_Ty>::EventPool()
+    : capacity_(32)
+    , cursor_(0)
+{
+}
+
+template <typename _Ty>
+inline EventPool<_Ty>& EventPool<_Ty>::GetInstance()
+{
+    static EventPool<_Ty> instance;
+    return instance;
+}
+
+template <typename _Ty>
+template <typename... _Args>
+inline RefPtr<_Ty> EventPool<_Ty>::Acquire(_Args&&... args)
+{
+    return GetInstance().AcquireEvent(std::forward<_Args>(args)...);
+}
+
+template <typename _Ty>
+template <typename... _Args>
+RefPtr<_Ty> EventPool<_Ty>::AcquireEvent(_Args&&... args)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const size_t size = events_.size();
+    for (size_t i = 0; i < size; ++i)
+    {
+        RefPtr<_Ty>& evt = events_[cursor_];
+        cursor_          = (cursor_ + 1) % size;
+
+        if (evt->GetRefCount() == 1)
+        {
+            // Only the pool holds this event, rebuild it in place
+            _Ty* ptr = evt.Get();
+            ptr->~_Ty();
+            new (ptr) _Ty(std::forward<_Args>(args)...);
+            ptr->Retain();
+
+            OnReused();
+            return evt;
+        }
+    }
+
+    RefPtr<_Ty> evt = new _Ty(std::forward<_Args>(args)...);
+    if (size < capacity_)
+    {
+        events_.push_back(evt);
+    }
+    OnAllocated();
+    return evt;
+}
+
+template <typename _Ty>
+inline void EventPool<_Ty>::SetCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    capacity_ = capacity;
+    if (events_.size() > capacity_)
+    {
+        events_.resize(capacity_);
+        cursor_ = 0;
+    }
+}
+
+template <typename _Ty>
+inline size_t EventPool<_Ty>::GetCapacity() const
+{
+    return capacity_;
+}
+
+template <typename _Ty>
+inline size_t EventPool<_Ty>::GetSize() const
+{
+    return events_.size();
+}
+
+template <typename _Ty>
+inline void EventPool<_Ty>::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    events_.clear();
+    cursor_ = 0;
+}
+
+}  // namespace kiwano
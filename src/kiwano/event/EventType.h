@@ -111,3 +111,15 @@ inline bool EventType::operator>=(const EventType& rhs) const
 }
 
 }  // namespace kiwano
+
+namespace std
+{
+template <>
+struct hash<::kiwano::EventType>
+{
+    inline size_t operator()(const ::kiwano::EventType& type) const
+    {
+        return hash<type_index>()(type.GetType());
+    }
+};
+}  // namespace std
@@ -83,8 +83,13 @@ struct IsSameEventType<KeyEvent>
 {
     inline bool operator()(const Event* evt) const
     {
-        return evt->GetType() == KGE_EVENT(KeyDownEvent) || evt->GetType() == KGE_EVENT(KeyUpEvent)
-               || evt->GetType() == KGE_EVENT(KeyCharEvent) || evt->GetType() == KGE_EVENT(IMEInputEvent);
+        return (*this)(evt->GetType());
+    }
+
+    inline bool operator()(const EventType& type) const
+    {
+        return type == KGE_EVENT(KeyDownEvent) || type == KGE_EVENT(KeyUpEvent) || type == KGE_EVENT(KeyCharEvent)
+               || type == KGE_EVENT(IMEInputEvent);
     }
 };
 
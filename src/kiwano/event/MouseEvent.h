@@ -110,10 +110,14 @@ struct IsSameEventType<MouseEvent>
 {
     inline bool operator()(const Event* evt) const
     {
-        return evt->GetType() == KGE_EVENT(MouseMoveEvent) || evt->GetType() == KGE_EVENT(MouseDownEvent)
-               || evt->GetType() == KGE_EVENT(MouseUpEvent) || evt->GetType() == KGE_EVENT(MouseClickEvent)
-               || evt->GetType() == KGE_EVENT(MouseHoverEvent) || evt->GetType() == KGE_EVENT(MouseOutEvent)
-               || evt->GetType() == KGE_EVENT(MouseWheelEvent);
+        return (*this)(evt->GetType());
+    }
+
+    inline bool operator()(const EventType& type) const
+    {
+        return type == KGE_EVENT(MouseMoveEvent) || type == KGE_EVENT(MouseDownEvent) || type == KGE_EVENT(MouseUpEvent)
+               || type == KGE_EVENT(MouseClickEvent) || type == KGE_EVENT(MouseHoverEvent)
+               || type == KGE_EVENT(MouseOutEvent) || type == KGE_EVENT(MouseWheelEvent);
     }
 };
 
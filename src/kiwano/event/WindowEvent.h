@@ -96,10 +96,14 @@ struct IsSameEventType<WindowEvent>
 {
     inline bool operator()(const Event* evt) const
     {
-        return evt->GetType() == KGE_EVENT(WindowMovedEvent) || evt->GetType() == KGE_EVENT(WindowResizedEvent)
-               || evt->GetType() == KGE_EVENT(WindowFocusChangedEvent)
-               || evt->GetType() == KGE_EVENT(WindowTitleChangedEvent)
-               || evt->GetType() == KGE_EVENT(WindowClosedEvent);
+        return (*this)(evt->GetType());
+    }
+
+    inline bool operator()(const EventType& type) const
+    {
+        return type == KGE_EVENT(WindowMovedEvent) || type == KGE_EVENT(WindowResizedEvent)
+               || type == KGE_EVENT(WindowFocusChangedEvent) || type == KGE_EVENT(WindowTitleChangedEvent)
+               || type == KGE_EVENT(WindowClosedEvent);
     }
 };
 
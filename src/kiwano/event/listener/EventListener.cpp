@@ -20,6 +20,7 @@
 
 #pragma once
 #include <kiwano/event/listener/EventListener.h>
+#include <kiwano/event/EventDispatcher.h>
 
 namespace kiwano
 {
@@ -28,23 +29,45 @@ EventListener::EventListener()
     : running_(true)
     , removeable_(false)
     , swallow_(false)
+    , dispatcher_(nullptr)
+{
+}
+
+EventListener::EventListener(const EventType& type)
+    : running_(true)
+    , removeable_(false)
+    , swallow_(false)
+    , type_(type)
+    , dispatcher_(nullptr)
 {
 }
 
 EventListener::~EventListener() {}
 
+void EventListener::Remove()
+{
+    if (!removeable_)
+    {
+        removeable_ = true;
+
+        if (dispatcher_)
+            dispatcher_->OnListenerRemoved(this);
+    }
+}
+
 class CallbackEventListener : public EventListener
 {
 public:
     CallbackEventListener(EventType type, const Callback& cb)
-        : type_(type)
+        : EventListener(type)
         , cb_(cb)
     {
     }
 
     void Handle(Event* evt) override
     {
-        if (type_.IsNull() || type_ == evt->GetType())
+        const auto& type = GetEventType();
+        if (type.IsNull() || type == evt->GetType())
         {
             if (cb_)
             {
@@ -54,8 +77,7 @@ public:
     }
 
 private:
-    EventType type_;
-    Callback  cb_;
+    Callback cb_;
 };
 
 RefPtr<EventListener> EventListener::Create(const Callback& callback)
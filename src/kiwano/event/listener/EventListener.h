@@ -56,6 +56,11 @@ public:
 
     EventListener();
 
+    /// \~chinese
+    /// @brief 
+    /// @param type ¼
+    EventListener(const EventType& type);
+
     virtual ~EventListener();
 
     /// \~chinese
@@ -92,6 +97,7 @@ public:
 
     /// \~chinese
     /// @brief Ƴ
+    /// @details ַֹͣ HasListener жϣڷַʱͷ
     void Remove();
 
     /// \~chinese
@@ -106,6 +112,11 @@ public:
     /// @brief ǷϢû
     bool IsSwallowEnabled() const;
 
+    /// \~chinese
+    /// @brief ȡ¼
+    /// @details ͱʾܴ͵¼
+    const EventType& GetEventType() const;
+
     /// \~chinese
     /// @brief Ϣû
     /// @param enabled Ƿ
@@ -116,9 +127,11 @@ public:
     virtual void Handle(Event* evt) = 0;
 
 private:
-    bool running_;
-    bool removeable_;
-    bool swallow_;
+    bool             running_;
+    bool             removeable_;
+    bool             swallow_;
+    EventType        type_;
+    EventDispatcher* dispatcher_;
 };
 
 /** @} */
@@ -133,11 +146,6 @@ inline void EventListener::Stop()
     running_ = false;
 }
 
-inline void EventListener::Remove()
-{
-    removeable_ = true;
-}
-
 inline bool EventListener::IsRunning() const
 {
     return running_;
@@ -158,4 +166,9 @@ inline void EventListener::SetSwallowEnabled(bool enabled)
     swallow_ = enabled;
 }
 
+inline const EventType& EventListener::GetEventType() const
+{
+    return type_;
+}
+
 }  // namespace kiwano
@@ -49,6 +49,9 @@
 #include <kiwano/core/Resource.h>
 #include <kiwano/core/RefBasePtr.hpp>
 #include <kiwano/core/Time.h>
+#include <kiwano/core/PoolAllocator.h>
+#include <kiwano/core/SpatialGrid.h>
+#include <kiwano/core/ThreadPool.h>
 
 //
 // event
@@ -62,6 +65,7 @@
 #include <kiwano/event/listener/MouseEventListener.h>
 #include <kiwano/event/listener/KeyEventListener.h>
 #include <kiwano/event/EventDispatcher.h>
+#include <kiwano/event/EventPool.h>
 
 //
 // base
@@ -85,11 +89,14 @@
 #include <kiwano/render/Shape.h>
 #include <kiwano/render/ShapeMaker.h>
 #include <kiwano/render/Texture.h>
+#include <kiwano/render/ImageDecoder.h>
 #include <kiwano/render/GifImage.h>
 #include <kiwano/render/Layer.h>
 #include <kiwano/render/TextLayout.h>
 #include <kiwano/render/TextureCache.h>
+#include <kiwano/render/SpriteBatch.h>
 #include <kiwano/render/Renderer.h>
+#include <kiwano/render/NullRenderer.h>
 
 //
 // 2d
@@ -100,11 +107,16 @@
 #include <kiwano/2d/DebugActor.h>
 #include <kiwano/2d/GifSprite.h>
 #include <kiwano/2d/LayerActor.h>
+#include <kiwano/2d/ParallelUpdater.h>
 #include <kiwano/2d/ShapeActor.h>
 #include <kiwano/2d/SpriteFrame.h>
 #include <kiwano/2d/Sprite.h>
+#include <kiwano/2d/SpriteBatchActor.h>
+#include <kiwano/2d/TextureAtlas.h>
+#include <kiwano/2d/TransformStore.h>
 #include <kiwano/2d/Stage.h>
 #include <kiwano/2d/TextActor.h>
+#include <kiwano/2d/SceneArchive.h>
 
 //
 // transition
@@ -136,8 +148,11 @@
 
 #include <kiwano/platform/Window.h>
 #include <kiwano/platform/Runner.h>
+#include <kiwano/platform/HeadlessRunner.h>
 #include <kiwano/platform/Application.h>
 #include <kiwano/platform/FileSystem.h>
+#include <kiwano/platform/FileArchive.h>
+#include <kiwano/platform/MappedFile.h>
 #include <kiwano/platform/Input.h>
 
 //
@@ -145,6 +160,7 @@
 //
 
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 #include <kiwano/utils/ResourceCache.h>
 #include <kiwano/utils/ResourceLoader.h>
 #include <kiwano/utils/UserData.h>
@@ -128,6 +128,17 @@ struct Matrix3x2T
         return operator=((*this) * other);
     }
 
+    inline bool operator==(const Matrix3x2T& other) const
+    {
+        return _11 == other._11 && _12 == other._12 && _21 == other._21 && _22 == other._22 && _31 == other._31
+               && _32 == other._32;
+    }
+
+    inline bool operator!=(const Matrix3x2T& other) const
+    {
+        return !operator==(other);
+    }
+
     inline void Identity()
     {
         _11 = 1.f;
@@ -149,6 +149,12 @@ public:
                  || right_bottom.y < rect.left_top.y || rect.right_bottom.y < left_top.y);
     }
 
+    inline RectT Merge(const RectT& rect) const
+    {
+        return RectT{ (std::min)(left_top.x, rect.left_top.x), (std::min)(left_top.y, rect.left_top.y),
+                      (std::max)(right_bottom.x, rect.right_bottom.x), (std::max)(right_bottom.y, rect.right_bottom.y) };
+    }
+
     static inline RectT Infinite()
     {
         return RectT{ -math::FLOAT_MAX, -math::FLOAT_MAX, math::FLOAT_MAX, math::FLOAT_MAX };
@@ -21,8 +21,10 @@
 #include <kiwano/platform/Application.h>
 #include <kiwano/core/Defer.h>
 #include <kiwano/base/Director.h>
+#include <kiwano/event/EventPool.h>
 #include <kiwano/render/Renderer.h>
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 
 namespace kiwano
 {
@@ -136,6 +138,9 @@ void Application::UpdateFrame(Duration dt)
 {
     this->Render();
     this->Update(dt);
+
+    EventPoolBase::NextFrame();
+    Profiler::GetInstance().NextFrame();
 }
 
 void Application::Destroy()
@@ -153,6 +158,9 @@ void Application::Destroy()
     }
     modules_.clear();
 
+    // Release pooled events
+    EventPoolBase::ClearAll();
+
     // Clear device resources
     Renderer::GetInstance().Destroy();
 }
@@ -193,6 +201,8 @@ void Application::Update(Duration dt)
     if (!running_ || is_paused_)
         return;
 
+    KGE_PROFILE_ZONE("Application::Update");
+
     auto ctx = UpdateModuleContext(modules_, dt);
     ctx.Next();
 
@@ -220,6 +230,8 @@ void Application::Render()
     if (!running_ /* Render even if application is paused */)
         return;
 
+    KGE_PROFILE_ZONE("Application::Render");
+
     Renderer& renderer = Renderer::GetInstance();
     renderer.Clear();
 
@@ -0,0 +1,284 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <kiwano/platform/ArchiveFormat.h>
+
+namespace kiwano
+{
+namespace archive
+{
+namespace
+{
+// A byte-oriented LZ77 block codec. Each sequence is a token byte (literal length in the high nibble,
+// match length minus 4 in the low nibble), extra length bytes of 255 when a nibble is saturated, the
+// literals and a 16-bit match offset. The last sequence carries literals only.
+
+const size_t kMinMatch     = 4;
+const size_t kMaxOffset    = 0xFFFF;
+const size_t kHashBits     = 12;
+const size_t kLastLiterals = 5;
+
+inline uint32_t ReadU32(const uint8_t* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t HashU32(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteLength(std::vector<uint8_t>& out, size_t len)
+{
+    while (len >= 255)
+    {
+        out.push_back(255);
+        len -= 255;
+    }
+    out.push_back(uint8_t(len));
+}
+
+void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literal_len, size_t offset,
+                   size_t match_len)
+{
+    size_t  match_code = match_len ? match_len - kMinMatch : 0;
+    uint8_t token      = uint8_t((std::min<size_t>(literal_len, 15) << 4) | std::min<size_t>(match_code, 15));
+    out.push_back(token);
+    if (literal_len >= 15)
+        WriteLength(out, literal_len - 15);
+    out.insert(out.end(), literals, literals + literal_len);
+
+    if (match_len)
+    {
+        out.push_back(uint8_t(offset & 0xFF));
+        out.push_back(uint8_t(offset >> 8));
+        if (match_code >= 15)
+            WriteLength(out, match_code - 15);
+    }
+}
+
+bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& len)
+{
+    uint8_t b;
+    do
+    {
+        if (ip >= end)
+            return false;
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+}  // namespace
+
+const char Magic[4] = { 'K', 'P', 'A', 'K' };
+
+std::string NormalizeFileName(const char* name, size_t length)
+{
+    std::string result(name, length);
+    for (auto& ch : result)
+    {
+        if (ch == '\\')
+            ch = '/';
+    }
+    while (result.size() > 2 && result[0] == '.' && result[1] == '/')
+    {
+        result.erase(0, 2);
+    }
+    return result;
+}
+
+std::vector<uint8_t> Compress(const uint8_t* src, size_t size)
+{
+    std::vector<uint8_t> out;
+    out.reserve(size / 2 + 16);
+
+    uint32_t table[1 << kHashBits] = {};
+
+    size_t anchor = 0;
+    size_t pos    = 0;
+    while (size > kLastLiterals + kMinMatch && pos < size - kLastLiterals - kMinMatch)
+    {
+        uint32_t seq  = ReadU32(src + pos);
+        uint32_t hash = HashU32(seq);
+        size_t   ref  = table[hash];
+        table[hash]   = uint32_t(pos + 1);  // 0 means empty
+
+        if (ref == 0 || pos - (ref - 1) > kMaxOffset || ReadU32(src + ref - 1) != seq)
+        {
+            ++pos;
+            continue;
+        }
+        ref -= 1;
+
+        size_t match_len = kMinMatch;
+        size_t limit     = size - kLastLiterals;
+        while (pos + match_len < limit && src[ref + match_len] == src[pos + match_len])
+        {
+            ++match_len;
+        }
+
+        WriteSequence(out, src + anchor, pos - anchor, pos - ref, match_len);
+        pos += match_len;
+        anchor = pos;
+    }
+
+    WriteSequence(out, src + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+uint64_t MaxDecompressedSize(uint64_t stored_size)
+{
+    // Literals copy one byte per input byte and every extra length byte adds at most 255, while the
+    // token and offset bytes cover the nibble and the minimum match, so no input byte yields more than 255
+    return stored_size * 255;
+}
+
+bool Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size)
+{
+    const uint8_t* ip   = src;
+    const uint8_t* iend = src + src_size;
+    uint8_t*       op   = dst;
+    uint8_t*       oend = dst + dst_size;
+
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+
+        size_t literal_len = token >> 4;
+        if (literal_len == 15 && !ReadLength(ip, iend, literal_len))
+            return false;
+        if (size_t(iend - ip) < literal_len || size_t(oend - op) < literal_len)
+            return false;
+        if (literal_len)
+            std::memcpy(op, ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+
+        if (ip == iend)
+            break;  // last sequence
+
+        if (iend - ip < 2)
+            return false;
+        size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+        ip += 2;
+
+        size_t match_len = token & 0x0F;
+        if (match_len == 15 && !ReadLength(ip, iend, match_len))
+            return false;
+        match_len += kMinMatch;
+
+        if (offset == 0 || size_t(op - dst) < offset || size_t(oend - op) < match_len)
+            return false;
+
+        // overlapping copies repeat the pattern, so copy byte by byte
+        const uint8_t* match = op - offset;
+        for (size_t i = 0; i < match_len; ++i)
+        {
+            op[i] = match[i];
+        }
+        op += match_len;
+    }
+    return op == oend;
+}
+
+PackedFile PackFile(std::string name, const uint8_t* data, size_t size, bool compress)
+{
+    PackedFile file;
+    file.name          = NormalizeFileName(name.data(), name.size());
+    file.original_size = uint32_t(size);
+    file.flags         = 0;
+
+    if (compress && size)
+    {
+        std::vector<uint8_t> packed = Compress(data, size);
+        if (packed.size() < size)
+        {
+            file.data  = std::move(packed);
+            file.flags = EntryCompressed;
+        }
+    }
+
+    if (!(file.flags & EntryCompressed) && size)
+    {
+        file.data.assign(data, data + size);
+    }
+    return file;
+}
+
+std::vector<uint8_t> Build(const std::vector<PackedFile>& files)
+{
+    Header header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version      = Version;
+    header.entry_count  = uint32_t(files.size());
+    header.names_offset = sizeof(Header) + files.size() * sizeof(Entry);
+
+    std::string names;
+    for (const auto& f : files)
+    {
+        names += f.name;
+    }
+    header.names_size = uint32_t(names.size());
+
+    auto align = [](uint64_t offset) { return (offset + DataAlignment - 1) & ~uint64_t(DataAlignment - 1); };
+
+    std::vector<Entry> records;
+    records.reserve(files.size());
+
+    uint64_t name_offset = 0;
+    uint64_t data_offset = align(header.names_offset + header.names_size);
+    for (const auto& f : files)
+    {
+        Entry record         = {};
+        record.name_offset   = uint32_t(name_offset);
+        record.name_length   = uint32_t(f.name.size());
+        record.data_offset   = data_offset;
+        record.stored_size   = uint32_t(f.data.size());
+        record.original_size = f.original_size;
+        record.flags         = f.flags;
+        records.push_back(record);
+
+        name_offset += f.name.size();
+        data_offset = align(data_offset + f.data.size());
+    }
+
+    std::vector<uint8_t> out(size_t(data_offset), 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!records.empty())
+        std::memcpy(out.data() + sizeof(header), records.data(), records.size() * sizeof(Entry));
+    if (!names.empty())
+        std::memcpy(out.data() + header.names_offset, names.data(), names.size());
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        if (!files[i].data.empty())
+            std::memcpy(out.data() + records[i].data_offset, files[i].data.data(), files[i].data.size());
+    }
+    return out;
+}
+
+}  // namespace archive
+}  // namespace kiwano
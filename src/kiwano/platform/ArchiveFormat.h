@@ -0,0 +1,114 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ļĴ̸ʽѹ㷨ֻ׼⣬ kiwano-pack ߹
+
+namespace kiwano
+{
+namespace archive
+{
+
+/// \~chinese
+/// @brief ǰʽ汾
+const uint32_t Version = 1;
+
+/// \~chinese
+/// @brief ļݶֽ
+const uint32_t DataAlignment = 16;
+
+/// \~chinese
+/// @brief ļѹ־
+const uint32_t EntryCompressed = 1;
+
+/// \~chinese
+/// @brief ļͷʶ
+extern const char Magic[4];
+
+// On-disk layout, little endian:
+//   Header | Entry[entry_count] | file names | padding | blobs (each 16-byte aligned)
+
+struct Header
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t names_size;
+    uint64_t names_offset;
+    uint64_t reserved;
+};
+
+struct Entry
+{
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint64_t data_offset;
+    uint32_t stored_size;
+    uint32_t original_size;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 32, "unexpected archive header size");
+static_assert(sizeof(Entry) == 32, "unexpected archive entry size");
+
+/// \~chinese
+/// @brief дļ
+struct PackedFile
+{
+    std::string          name;
+    std::vector<uint8_t> data;
+    uint32_t             original_size;
+    uint32_t             flags;
+};
+
+/// \~chinese
+/// @brief 淶ļ\ תΪ / ȥͷ ./
+std::string NormalizeFileName(const char* name, size_t length);
+
+/// \~chinese
+/// @brief ѹ
+std::vector<uint8_t> Compress(const uint8_t* src, size_t size);
+
+/// \~chinese
+/// @brief ȡѹݽѹֽܵڷڴǰУеԭʼС
+uint64_t MaxDecompressedSize(uint64_t stored_size);
+
+/// \~chinese
+/// @brief ѹ
+/// @return 𻵻ѹС dst_size ʱ false
+bool Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size);
+
+/// \~chinese
+/// @brief ׼дļ
+/// @param compress ǷѹѹûмСʱԭ
+PackedFile PackFile(std::string name, const uint8_t* data, size_t size, bool compress);
+
+/// \~chinese
+/// @brief ɴļ
+std::vector<uint8_t> Build(const std::vector<PackedFile>& files);
+
+}  // namespace archive
+}  // namespace kiwano
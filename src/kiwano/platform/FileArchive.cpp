@@ -0,0 +1,206 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <kiwano/platform/ArchiveFormat.h>
+#include <kiwano/platform/FileArchive.h>
+#include <kiwano/utils/Logger.h>
+
+namespace kiwano
+{
+FileArchive::FileArchive() {}
+
+FileArchive::~FileArchive()
+{
+    Close();
+}
+
+bool FileArchive::Open(StringView file_path)
+{
+    Close();
+
+    if (!file_.Open(file_path))
+    {
+        KGE_ERRORF("FileArchive: failed to open archive '%s'", String(file_path.data(), file_path.size()).c_str());
+        return false;
+    }
+
+    const uint8_t* data = file_.GetData();
+    const size_t   size = file_.GetSize();
+
+    archive::Header header;
+    if (size < sizeof(header))
+    {
+        KGE_ERRORF("FileArchive: '%s' is truncated", String(file_path.data(), file_path.size()).c_str());
+        Close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, archive::Magic, sizeof(archive::Magic)) != 0 || header.version != Version)
+    {
+        KGE_ERRORF("FileArchive: '%s' is not a supported archive", String(file_path.data(), file_path.size()).c_str());
+        Close();
+        return false;
+    }
+
+    const uint64_t entries_end = sizeof(header) + uint64_t(header.entry_count) * sizeof(archive::Entry);
+    if (entries_end > size || header.names_offset < entries_end || header.names_offset > size
+        || header.names_size > size - header.names_offset)
+    {
+        KGE_ERRORF("FileArchive: '%s' has a corrupted index", String(file_path.data(), file_path.size()).c_str());
+        Close();
+        return false;
+    }
+
+    const char* names = reinterpret_cast<const char*>(data + header.names_offset);
+
+    entries_.reserve(header.entry_count);
+    for (uint32_t i = 0; i < header.entry_count; ++i)
+    {
+        archive::Entry entry;
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(archive::Entry), sizeof(entry));
+
+        bool valid = uint64_t(entry.name_offset) + entry.name_length <= header.names_size
+                     && entry.data_offset <= size && entry.stored_size <= size - entry.data_offset;
+
+        // Bound compressed entries by what their stored bytes can expand to, so a corrupted index
+        // can't request an arbitrary allocation on first read
+        if (entry.flags & archive::EntryCompressed)
+            valid = valid && entry.original_size <= archive::MaxDecompressedSize(entry.stored_size);
+        else
+            valid = valid && entry.stored_size == entry.original_size;
+
+        if (!valid)
+        {
+            KGE_ERRORF("FileArchive: '%s' has a corrupted entry", String(file_path.data(), file_path.size()).c_str());
+            Close();
+            return false;
+        }
+
+        Entry& e        = entries_[String(names + entry.name_offset, entry.name_length)];
+        e.data          = data + entry.data_offset;
+        e.stored_size   = entry.stored_size;
+        e.original_size = entry.original_size;
+        e.flags         = entry.flags;
+    }
+    return true;
+}
+
+void FileArchive::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    decompressed_.clear();
+    entries_.clear();
+    file_.Close();
+}
+
+bool FileArchive::HasFile(StringView file_name) const
+{
+    return entries_.find(archive::NormalizeFileName(file_name.data(), file_name.size())) != entries_.end();
+}
+
+BinaryData FileArchive::GetFileData(StringView file_name) const
+{
+    String name = archive::NormalizeFileName(file_name.data(), file_name.size());
+
+    auto iter = entries_.find(name);
+    if (iter == entries_.end())
+        return BinaryData();
+
+    const Entry& entry = iter->second;
+    if (!(entry.flags & archive::EntryCompressed))
+    {
+        // Zero-copy view into the mapping
+        return BinaryData(const_cast<uint8_t*>(entry.data), entry.stored_size);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto cache_iter = decompressed_.find(name);
+    if (cache_iter != decompressed_.end())
+        return BinaryData(cache_iter->second.get(), entry.original_size);
+
+    std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[entry.original_size]);
+    if (!buffer)
+    {
+        KGE_ERRORF("FileArchive: out of memory decompressing '%s'", name.c_str());
+        return BinaryData();
+    }
+
+    if (!archive::Decompress(entry.data, entry.stored_size, buffer.get(), entry.original_size))
+    {
+        KGE_ERRORF("FileArchive: failed to decompress '%s'", name.c_str());
+        return BinaryData();
+    }
+
+    BinaryData result(buffer.get(), entry.original_size);
+    decompressed_.emplace(name, std::move(buffer));
+    return result;
+}
+
+Vector<String> FileArchive::GetFileNames() const
+{
+    Vector<String> names;
+    names.reserve(entries_.size());
+    for (const auto& pair : entries_)
+    {
+        names.push_back(pair.first);
+    }
+    return names;
+}
+
+void FileArchiveWriter::AddFile(StringView file_name, const BinaryData& data, bool compress)
+{
+    archive::PackedFile file = archive::PackFile(String(file_name.data(), file_name.size()),
+                                                 static_cast<const uint8_t*>(data.buffer), data.size, compress);
+    for (auto& f : files_)
+    {
+        if (f.name == file.name)
+        {
+            f = std::move(file);
+            return;
+        }
+    }
+    files_.push_back(std::move(file));
+}
+
+Vector<uint8_t> FileArchiveWriter::Save() const
+{
+    return archive::Build(files_);
+}
+
+bool FileArchiveWriter::SaveToFile(StringView file_path) const
+{
+    Vector<uint8_t> data = Save();
+
+    std::ofstream ofs(String(file_path.data(), file_path.size()).c_str(), std::ios::binary);
+    if (!ofs.is_open())
+    {
+        KGE_ERRORF("FileArchiveWriter: failed to create '%s'", String(file_path.data(), file_path.size()).c_str());
+        return false;
+    }
+    ofs.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+    return ofs.good();
+}
+
+}  // namespace kiwano
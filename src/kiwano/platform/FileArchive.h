@@ -0,0 +1,136 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <mutex>
+#include <kiwano/core/Common.h>
+#include <kiwano/core/BinaryData.h>
+#include <kiwano/base/ObjectBase.h>
+#include <kiwano/platform/MappedFile.h>
+#include <kiwano/platform/ArchiveFormat.h>
+
+namespace kiwano
+{
+
+/**
+ * \~chinese
+ * @brief ļ
+ * @details ļļͷļŵļɣʱļӳ䵽ڴ档
+ * δѹļֱӷӳڴϵͼݣѹļ״ζȡʱѹ档
+ * ͨ GetFileData ȡڴļǰһֱЧ
+ */
+class KGE_API FileArchive : public ObjectBase
+{
+public:
+    /// \~chinese
+    /// @brief ǰʽ汾
+    static const uint32_t Version = archive::Version;
+
+    FileArchive();
+
+    virtual ~FileArchive();
+
+    /// \~chinese
+    /// @brief 򿪴ļ
+    /// @param file_path ļ·
+    /// @return ǷɹʽļΪʧ
+    bool Open(StringView file_path);
+
+    /// \~chinese
+    /// @brief رմļ
+    /// @warning ֮ǰȡļȫʧЧ
+    void Close();
+
+    /// \~chinese
+    /// @brief ǷѴ
+    bool IsOpened() const;
+
+    /// \~chinese
+    /// @brief Ƿļ
+    /// @param file_name ļʹ / ָ·
+    bool HasFile(StringView file_name) const;
+
+    /// \~chinese
+    /// @brief ȡļ
+    /// @param file_name ļʹ / ָ·
+    /// @return ļݣļڻѹʧʱЧ
+    BinaryData GetFileData(StringView file_name) const;
+
+    /// \~chinese
+    /// @brief ȡļ
+    Vector<String> GetFileNames() const;
+
+private:
+    struct Entry
+    {
+        const uint8_t* data;
+        uint32_t       stored_size;
+        uint32_t       original_size;
+        uint32_t       flags;
+    };
+
+    MappedFile                                               file_;
+    UnorderedMap<String, Entry>                              entries_;
+    mutable std::mutex                                       mutex_;
+    mutable UnorderedMap<String, std::unique_ptr<uint8_t[]>> decompressed_;
+};
+
+/**
+ * \~chinese
+ * @brief ļ
+ */
+class KGE_API FileArchiveWriter : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief ļ
+    /// @param file_name ļ\ ᱻתΪ /
+    /// @param data ļ
+    /// @param compress ǷѹѹûмСʱԭ
+    void AddFile(StringView file_name, const BinaryData& data, bool compress = true);
+
+    /// \~chinese
+    /// @brief ȡӵļ
+    size_t GetFileCount() const;
+
+    /// \~chinese
+    /// @brief ɴļ
+    Vector<uint8_t> Save() const;
+
+    /// \~chinese
+    /// @brief ɴļ
+    /// @param file_path ļ·
+    bool SaveToFile(StringView file_path) const;
+
+private:
+    Vector<archive::PackedFile> files_;
+};
+
+inline bool FileArchive::IsOpened() const
+{
+    return file_.IsOpened();
+}
+
+inline size_t FileArchiveWriter::GetFileCount() const
+{
+    return files_.size();
+}
+
+}  // namespace kiwano
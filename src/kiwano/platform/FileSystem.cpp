@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <cctype>
+#include <algorithm>
 #include <kiwano/platform/FileSystem.h>
 
 namespace kiwano
@@ -165,6 +166,11 @@ void FileSystem::SetFileLookupDictionary(const UnorderedMap<String, String>& dic
 
 bool FileSystem::IsFileExists(StringView file_path) const
 {
+    if (GetArchivedFileData(file_path).IsValid())
+    {
+        return true;
+    }
+
     if (IsAbsolutePath(file_path))
     {
         return kiwano::IsFileExists(file_path);
@@ -214,4 +220,74 @@ bool FileSystem::ExtractResourceToFile(const Resource& res, StringView dest_file
     return false;
 }
 
+bool FileSystem::MountArchive(StringView archive_path)
+{
+    RefPtr<FileArchive> archive = MakePtr<FileArchive>();
+    if (!archive->Open(archive_path))
+        return false;
+
+    MountArchive(archive);
+    return true;
+}
+
+void FileSystem::MountArchive(RefPtr<FileArchive> archive)
+{
+    if (archive && archive->IsOpened())
+    {
+        archives_.push_back(archive);
+    }
+}
+
+void FileSystem::UnmountArchive(RefPtr<FileArchive> archive)
+{
+    auto iter = std::find(archives_.begin(), archives_.end(), archive);
+    if (iter != archives_.end())
+    {
+        archives_.erase(iter);
+    }
+}
+
+void FileSystem::UnmountAllArchives()
+{
+    archives_.clear();
+}
+
+BinaryData FileSystem::GetArchivedFileData(StringView file) const
+{
+    RefPtr<FileArchive> archive;
+    return GetArchivedFileData(file, archive);
+}
+
+BinaryData FileSystem::GetArchivedFileData(StringView file, RefPtr<FileArchive>& archive) const
+{
+    if (archives_.empty() || file.empty())
+    {
+        return BinaryData();
+    }
+
+    String name;
+
+    auto iter = file_lookup_dict_.find(file);
+    if (iter != file_lookup_dict_.end())
+    {
+        name = iter->second;
+    }
+    else
+    {
+        name = ConvertPathFormat(file);
+    }
+
+    // Later mounts override earlier ones
+    for (auto iter = archives_.rbegin(); iter != archives_.rend(); ++iter)
+    {
+        BinaryData data = (*iter)->GetFileData(name);
+        if (data.IsValid())
+        {
+            archive = *iter;
+            return data;
+        }
+    }
+    return BinaryData();
+}
+
 }  // namespace kiwano
@@ -20,6 +20,7 @@
 
 #pragma once
 #include <kiwano/core/Resource.h>
+#include <kiwano/platform/FileArchive.h>
 
 namespace kiwano
 {
@@ -110,6 +111,57 @@ public:
      */
     bool ExtractResourceToFile(const Resource& res, StringView dest_file_name) const;
 
+    /**
+     * \~chinese
+     * @brief شļ
+     * @details ȡļʱȰ˳ӺǰڴļвңҲʱٲҴϵļ
+     * غжӦ߳нУҲ߳еļȡͬʱ
+     * @param archive_path ļ·
+     * @return Ƿɹ
+     */
+    bool MountArchive(StringView archive_path);
+
+    /**
+     * \~chinese
+     * @brief شļ
+     * @param archive Ѵ򿪵Ĵļ
+     */
+    void MountArchive(RefPtr<FileArchive> archive);
+
+    /**
+     * \~chinese
+     * @brief жشļ
+     * @param archive ļ
+     * @details ֻͷļϵͳԴļãԱеĴļر
+     * @warning жغδдļõĶȡʧЧ
+     */
+    void UnmountArchive(RefPtr<FileArchive> archive);
+
+    /**
+     * \~chinese
+     * @brief ждļ
+     */
+    void UnmountAllArchives();
+
+    /**
+     * \~chinese
+     * @brief ѹصĴļжȡļ
+     * @details ļ·ȾֵתڴļжǰһֱЧ
+     * @param file ļ·
+     * @return ļݣκδļʱЧ
+     */
+    BinaryData GetArchivedFileData(StringView file) const;
+
+    /**
+     * \~chinese
+     * @brief ѹصĴļжȡļ
+     * @details ڴļǰһֱЧҪжغʹʱӦĴļ
+     * @param file ļ·
+     * @param archive ڵĴļ
+     * @return ļݣκδļʱЧ
+     */
+    BinaryData GetArchivedFileData(StringView file, RefPtr<FileArchive>& archive) const;
+
     ~FileSystem();
 
 private:
@@ -119,5 +171,6 @@ private:
     Vector<String>                       search_paths_;
     UnorderedMap<String, String>         file_lookup_dict_;
     mutable UnorderedMap<String, String> file_lookup_cache_;
+    Vector<RefPtr<FileArchive>>          archives_;
 };
 }  // namespace kiwano
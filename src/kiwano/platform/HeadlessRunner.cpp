@@ -0,0 +1,77 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/platform/HeadlessRunner.h>
+#include <kiwano/platform/Application.h>
+#include <kiwano/render/NullRenderer.h>
+#include <kiwano/base/Director.h>
+
+namespace kiwano
+{
+
+HeadlessRunner::HeadlessRunner(Duration time_step, uint64_t max_frames)
+    : max_frames_(max_frames)
+    , frame_count_(0)
+    , time_step_(time_step)
+{
+}
+
+HeadlessRunner::HeadlessRunner(const Settings& settings, Duration time_step, uint64_t max_frames)
+    : Runner(settings)
+    , max_frames_(max_frames)
+    , frame_count_(0)
+    , time_step_(time_step)
+{
+}
+
+void HeadlessRunner::InitSettings()
+{
+    Settings settings = GetSettings();
+
+    // Replace the platform renderer, no window or graphics device is created
+    NullRenderer& renderer = NullRenderer::GetInstance();
+    Renderer::SetInstance(&renderer);
+    renderer.Resize(settings.window.width, settings.window.height);
+    renderer.SetClearColor(settings.bg_color);
+
+    // Use default modules
+    Application::GetInstance().Use(renderer);
+    Application::GetInstance().Use(Director::GetInstance());
+
+    if (settings.debug_mode)
+    {
+        renderer.GetContext().SetCollectingStatus(true);
+    }
+}
+
+bool HeadlessRunner::MainLoop(Duration dt)
+{
+    if (max_frames_ && frame_count_ >= max_frames_)
+        return false;
+
+    Application::GetInstance().UpdateFrame(time_step_);
+
+    ++frame_count_;
+    simulated_time_ += time_step_;
+    real_time_ += dt;
+    return true;
+}
+
+}  // namespace kiwano
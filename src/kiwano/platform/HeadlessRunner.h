@@ -0,0 +1,125 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/platform/Runner.h>
+
+namespace kiwano
+{
+
+/**
+ * \~chinese
+ * @brief ޴ڳ
+ * @details ںͼ豸ʹÿȾݡʱģ飬
+ * ÿ֡Թ̶ʱ䲽²Ҳȴʵʱ䣬ڷ˻ط֤ܲ
+ */
+class KGE_API HeadlessRunner : public Runner
+{
+public:
+    /// \~chinese
+    /// @brief ޴ڳ
+    /// @param time_step ÿ֡Ĺ̶ʱ䲽
+    /// @param max_frames е֡Ϊ 0 ʱһֱֱ Application::Quit
+    HeadlessRunner(Duration time_step = time::Second / 60, uint64_t max_frames = 0);
+
+    /// \~chinese
+    /// @brief ޴ڳ
+    /// @param settings ϷãڴСΪȾС
+    /// @param time_step ÿ֡Ĺ̶ʱ䲽
+    /// @param max_frames е֡Ϊ 0 ʱһֱֱ Application::Quit
+    HeadlessRunner(const Settings& settings, Duration time_step = time::Second / 60, uint64_t max_frames = 0);
+
+    /// \~chinese
+    /// @brief ÿ֡Ĺ̶ʱ䲽
+    void SetTimeStep(Duration time_step);
+
+    /// \~chinese
+    /// @brief ȡÿ֡Ĺ̶ʱ䲽
+    Duration GetTimeStep() const;
+
+    /// \~chinese
+    /// @brief е֡
+    void SetMaxFrames(uint64_t max_frames);
+
+    /// \~chinese
+    /// @brief ȡе֡
+    uint64_t GetMaxFrames() const;
+
+    /// \~chinese
+    /// @brief ȡе֡
+    uint64_t GetFrameCount() const;
+
+    /// \~chinese
+    /// @brief ȡģϷʱ
+    Duration GetSimulatedTime() const;
+
+    /// \~chinese
+    /// @brief ȡõʵʱ
+    Duration GetRealTime() const;
+
+    bool MainLoop(Duration dt) override;
+
+protected:
+    void InitSettings() override;
+
+private:
+    uint64_t max_frames_;
+    uint64_t frame_count_;
+    Duration time_step_;
+    Duration simulated_time_;
+    Duration real_time_;
+};
+
+inline void HeadlessRunner::SetTimeStep(Duration time_step)
+{
+    time_step_ = time_step;
+}
+
+inline Duration HeadlessRunner::GetTimeStep() const
+{
+    return time_step_;
+}
+
+inline void HeadlessRunner::SetMaxFrames(uint64_t max_frames)
+{
+    max_frames_ = max_frames;
+}
+
+inline uint64_t HeadlessRunner::GetMaxFrames() const
+{
+    return max_frames_;
+}
+
+inline uint64_t HeadlessRunner::GetFrameCount() const
+{
+    return frame_count_;
+}
+
+inline Duration HeadlessRunner::GetSimulatedTime() const
+{
+    return simulated_time_;
+}
+
+inline Duration HeadlessRunner::GetRealTime() const
+{
+    return real_time_;
+}
+
+}  // namespace kiwano
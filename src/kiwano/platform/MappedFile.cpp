@@ -0,0 +1,156 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/platform/MappedFile.h>
+#include <kiwano/platform/FileSystem.h>
+
+#if !defined(KGE_PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kiwano
+{
+
+#if defined(KGE_PLATFORM_WINDOWS)
+
+MappedFile::MappedFile()
+    : data_(nullptr)
+    , size_(0)
+    , file_(INVALID_HANDLE_VALUE)
+    , mapping_(nullptr)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(StringView file_path)
+{
+    Close();
+
+    String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
+
+    file_ = ::CreateFileA(full_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size = {};
+    if (!::GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_)
+    {
+        data_ = static_cast<const uint8_t*>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    }
+
+    if (!data_)
+    {
+        Close();
+        return false;
+    }
+
+    size_ = size_t(file_size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_)
+    {
+        ::UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+
+    if (mapping_)
+    {
+        ::CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+
+    if (file_ != INVALID_HANDLE_VALUE)
+    {
+        ::CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+    size_ = 0;
+}
+
+#else
+
+MappedFile::MappedFile()
+    : data_(nullptr)
+    , size_(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(StringView file_path)
+{
+    Close();
+
+    String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
+
+    int fd = ::open(full_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* data = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            data_ = static_cast<const uint8_t*>(data);
+            size_ = size_t(st.st_size);
+        }
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return data_ != nullptr;
+}
+
+void MappedFile::Close()
+{
+    if (data_)
+    {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+}
+
+#endif
+
+}  // namespace kiwano
@@ -0,0 +1,97 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/core/Common.h>
+#include <kiwano/core/BinaryData.h>
+
+namespace kiwano
+{
+
+/**
+ * \~chinese
+ * @brief ڴӳļ
+ * @details ֻʽļӳ䵽ڴ棬ȡʱҪݡӳڶٻ Close ʱ
+ * ֮ͨ GetData ȡָȫʧЧ
+ */
+class KGE_API MappedFile : Noncopyable
+{
+public:
+    MappedFile();
+
+    ~MappedFile();
+
+    /// \~chinese
+    /// @brief ӳļ
+    /// @param file_path ļ·
+    /// @return ӳǷɹļΪʧ
+    bool Open(StringView file_path);
+
+    /// \~chinese
+    /// @brief ӳ䲢رļ
+    void Close();
+
+    /// \~chinese
+    /// @brief Ƿӳļ
+    bool IsOpened() const;
+
+    /// \~chinese
+    /// @brief ȡļ
+    const uint8_t* GetData() const;
+
+    /// \~chinese
+    /// @brief ȡļС
+    size_t GetSize() const;
+
+    /// \~chinese
+    /// @brief ȡļ
+    BinaryData GetBinaryData() const;
+
+private:
+    const uint8_t* data_;
+    size_t         size_;
+
+#if defined(KGE_PLATFORM_WINDOWS)
+    HANDLE file_;
+    HANDLE mapping_;
+#endif
+};
+
+inline bool MappedFile::IsOpened() const
+{
+    return data_ != nullptr;
+}
+
+inline const uint8_t* MappedFile::GetData() const
+{
+    return data_;
+}
+
+inline size_t MappedFile::GetSize() const
+{
+    return size_;
+}
+
+inline BinaryData MappedFile::GetBinaryData() const
+{
+    return BinaryData(const_cast<uint8_t*>(data_), uint32_t(size_));
+}
+
+}  // namespace kiwano
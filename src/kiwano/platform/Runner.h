@@ -89,7 +89,7 @@ public:
     /// @param dt ʱ
     /// @details ظúԿƳѭ
     /// @return false˳ѭѭ
-    bool MainLoop(Duration dt);
+    virtual bool MainLoop(Duration dt);
 
     /// \~chinese
     /// @brief ȡ
@@ -116,11 +116,14 @@ protected:
     /// @brief ô
     void SetWindow(RefPtr<Window> window);
 
+    /// \~chinese
+    /// @brief óʼڡȾĬģ
+    /// @details ظúԶӦóĳʼ
+    virtual void InitSettings();
+
 private:
     friend class Application;
 
-    void InitSettings();
-
 private:
     Settings       settings_;
     RefPtr<Window> main_window_;
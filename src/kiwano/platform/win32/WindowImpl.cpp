@@ -527,7 +527,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
         KeyCode key = this->key_map_[size_t(wparam)];
         if (key != KeyCode::Unknown)
         {
-            RefPtr<KeyDownEvent> evt = new KeyDownEvent;
+            RefPtr<KeyDownEvent> evt = EventPool<KeyDownEvent>::Acquire();
             evt->code                = key;
             this->PushEvent(evt);
         }
@@ -540,7 +540,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
         KeyCode key = this->key_map_[size_t(wparam)];
         if (key != KeyCode::Unknown)
         {
-            RefPtr<KeyUpEvent> evt = new KeyUpEvent;
+            RefPtr<KeyUpEvent> evt = EventPool<KeyUpEvent>::Acquire();
             evt->code              = key;
             this->PushEvent(evt);
         }
@@ -549,7 +549,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
 
     case WM_CHAR:
     {
-        RefPtr<KeyCharEvent> evt = new KeyCharEvent;
+        RefPtr<KeyCharEvent> evt = EventPool<KeyCharEvent>::Acquire();
         evt->value               = char(wparam);
         this->PushEvent(evt);
     }
@@ -579,7 +579,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
                 ::ImmGetCompositionStringA(hIMC, GCS_RESULTSTR, const_cast<char*>(buf.data()), dwSize);
                 ::ImmReleaseContext(hwnd, hIMC);
 
-                RefPtr<IMEInputEvent> evt = new IMEInputEvent;
+                RefPtr<IMEInputEvent> evt = EventPool<IMEInputEvent>::Acquire();
                 evt->value                = std::move(buf);
                 this->PushEvent(evt);
                 return TRUE;
@@ -594,7 +594,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     case WM_MBUTTONDOWN:
     case WM_MBUTTONDBLCLK:
     {
-        RefPtr<MouseDownEvent> evt = new MouseDownEvent;
+        RefPtr<MouseDownEvent> evt = EventPool<MouseDownEvent>::Acquire();
         evt->pos                   = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
 
         if (msg == WM_LBUTTONDOWN || msg == WM_LBUTTONDBLCLK)
@@ -622,7 +622,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     case WM_MBUTTONUP:
     case WM_RBUTTONUP:
     {
-        RefPtr<MouseUpEvent> evt = new MouseUpEvent;
+        RefPtr<MouseUpEvent> evt = EventPool<MouseUpEvent>::Acquire();
         evt->pos                 = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
 
         if (msg == WM_LBUTTONUP)
@@ -648,7 +648,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
 
     case WM_MOUSEMOVE:
     {
-        RefPtr<MouseMoveEvent> evt = new MouseMoveEvent;
+        RefPtr<MouseMoveEvent> evt = EventPool<MouseMoveEvent>::Acquire();
         evt->pos                   = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
         this->PushEvent(evt);
     }
@@ -656,7 +656,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
 
     case WM_MOUSEWHEEL:
     {
-        RefPtr<MouseWheelEvent> evt = new MouseWheelEvent;
+        RefPtr<MouseWheelEvent> evt = EventPool<MouseWheelEvent>::Acquire();
         evt->pos                    = Point((float)GET_X_LPARAM(lparam), (float)GET_Y_LPARAM(lparam));
         evt->wheel                  = GET_WHEEL_DELTA_WPARAM(wparam) / (float)WHEEL_DELTA;
         this->PushEvent(evt);
@@ -712,7 +712,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->width_  = ((uint32_t)(short)LOWORD(lparam));
             this->height_ = ((uint32_t)(short)HIWORD(lparam));
 
-            RefPtr<WindowResizedEvent> evt = new WindowResizedEvent;
+            RefPtr<WindowResizedEvent> evt = EventPool<WindowResizedEvent>::Acquire();
             evt->window                    = this;
             evt->width                     = this->GetWidth();
             evt->height                    = this->GetHeight();
@@ -748,7 +748,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->width_  = client_width;
             this->height_ = client_height;
 
-            RefPtr<WindowResizedEvent> evt = new WindowResizedEvent;
+            RefPtr<WindowResizedEvent> evt = EventPool<WindowResizedEvent>::Acquire();
             evt->window                    = this;
             evt->width                     = client_width;
             evt->height                    = client_height;
@@ -767,7 +767,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->pos_x_ = window_x;
             this->pos_y_ = window_y;
 
-            RefPtr<WindowMovedEvent> evt = new WindowMovedEvent;
+            RefPtr<WindowMovedEvent> evt = EventPool<WindowMovedEvent>::Acquire();
             evt->window                  = this;
             evt->x                       = window_x;
             evt->y                       = window_y;
@@ -806,7 +806,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
             this->pos_x_ = window_x;
             this->pos_y_ = window_y;
 
-            RefPtr<WindowMovedEvent> evt = new WindowMovedEvent;
+            RefPtr<WindowMovedEvent> evt = EventPool<WindowMovedEvent>::Acquire();
             evt->window                  = this;
             evt->x                       = window_x;
             evt->y                       = window_y;
@@ -826,7 +826,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     {
         bool active = (LOWORD(wparam) != WA_INACTIVE);
 
-        RefPtr<WindowFocusChangedEvent> evt = new WindowFocusChangedEvent;
+        RefPtr<WindowFocusChangedEvent> evt = EventPool<WindowFocusChangedEvent>::Acquire();
         evt->window                         = this;
         evt->focus                          = active;
         this->PushEvent(evt);
@@ -857,7 +857,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
 
         this->title_ = strings::WideToNarrow(reinterpret_cast<LPCWSTR>(lparam));
 
-        RefPtr<WindowTitleChangedEvent> evt = new WindowTitleChangedEvent;
+        RefPtr<WindowTitleChangedEvent> evt = EventPool<WindowTitleChangedEvent>::Acquire();
         evt->window                         = this;
         evt->title                          = this->title_;
         this->PushEvent(evt);
@@ -886,7 +886,7 @@ LRESULT WindowWin32Impl::MessageProc(HWND hwnd, UINT32 msg, WPARAM wparam, LPARA
     {
         KGE_DEBUG_LOGF("Window is closing");
 
-        RefPtr<WindowClosedEvent> evt = new WindowClosedEvent;
+        RefPtr<WindowClosedEvent> evt = EventPool<WindowClosedEvent>::Acquire();
         evt->window                   = this;
         this->PushEvent(evt);
         this->SetShouldClose(true);
@@ -89,13 +89,15 @@ Brush::Brush(const RadialGradientStyle& style)
 
 Brush::Brush()
     : type_(Type::None)
+    , color_(Color::Transparent)
 {
 }
 
 void Brush::SetColor(const Color& color)
 {
     Renderer::GetInstance().CreateBrush(*this, color);
-    type_ = Brush::Type::SolidColor;
+    type_  = Brush::Type::SolidColor;
+    color_ = color;
 }
 
 void Brush::SetStyle(const LinearGradientStyle& style)
@@ -148,8 +148,13 @@ public:
     /// @brief ȡˢ
     Type GetType() const;
 
+    /// \~chinese
+    /// @brief ȡɫˢɫԴɫˢЧ
+    const Color& GetColor() const;
+
 private:
-    Type type_;
+    Type  type_;
+    Color color_;
 };
 
 /** @} */
@@ -159,4 +164,9 @@ inline Brush::Type Brush::GetType() const
     return type_;
 }
 
+inline const Color& Brush::GetColor() const
+{
+    return color_;
+}
+
 }  // namespace kiwano
@@ -43,6 +43,11 @@ HRESULT RenderContextImpl::CreateDeviceResources(ComPtr<ID2D1Factory> factory, C
     render_ctx_ = ctx;
     text_renderer_.Reset();
     current_brush_.Reset();
+    sprite_ctx_.Reset();
+    sprite_batch_.Reset();
+
+    // ID2D1SpriteBatch requires Windows 10, fall back to DrawBitmap when it is unavailable
+    ctx->QueryInterface(IID_PPV_ARGS(&sprite_ctx_));
 
     HRESULT hr = ITextRenderer::Create(&text_renderer_, render_ctx_.Get());
 
@@ -71,6 +76,8 @@ void RenderContextImpl::DiscardDeviceResources()
 {
     text_renderer_.Reset();
     render_ctx_.Reset();
+    sprite_ctx_.Reset();
+    sprite_batch_.Reset();
     current_brush_.Reset();
 
     ComPolicy::Set(this, nullptr);
@@ -153,6 +160,96 @@ void RenderContextImpl::DrawTexture(const Texture& texture, const Rect* src_rect
     }
 }
 
+void RenderContextImpl::DrawSpriteBatch(const Texture& texture, const SpriteBatchItem* items, size_t count)
+{
+    KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
+
+    if (!texture.IsValid() || !items || count == 0)
+        return;
+
+    if (!sprite_ctx_)
+    {
+        RenderContext::DrawSpriteBatch(texture, items, count);
+        return;
+    }
+
+    if (!sprite_batch_)
+    {
+        HRESULT hr = sprite_ctx_->CreateSpriteBatch(&sprite_batch_);
+        if (FAILED(hr))
+        {
+            sprite_ctx_.Reset();
+            RenderContext::DrawSpriteBatch(texture, items, count);
+            return;
+        }
+    }
+
+    // Source rectangles of sprite batches are in whole pixels, round the edges to the nearest pixel
+    // instead of truncating them, so that a crop at 0.99 does not lose a row
+    auto to_pixel = [](float value) { return uint32_t(std::max(math::Floor(value + 0.5f), 0.f)); };
+
+    sprite_src_rects_.resize(count);
+    sprite_transforms_.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Rect& src = items[i].src_rect;
+
+        sprite_src_rects_[i] = D2D1::RectU(to_pixel(src.GetLeft()), to_pixel(src.GetTop()), to_pixel(src.GetRight()),
+                                           to_pixel(src.GetBottom()));
+
+        if (fast_global_transform_)
+        {
+            sprite_transforms_[i] = DX::ConvertToMatrix3x2F(items[i].transform);
+        }
+        else
+        {
+            Matrix3x2 result      = items[i].transform * global_transform_;
+            sprite_transforms_[i] = DX::ConvertToMatrix3x2F(result);
+        }
+    }
+
+    // Rect has the same layout as D2D1_RECT_F, so destination rectangles are read in place
+    const D2D1_COLOR_F color = D2D1::ColorF(1.0f, 1.0f, 1.0f, brush_opacity_);
+
+    sprite_batch_->Clear();
+    HRESULT hr = sprite_batch_->AddSprites(UINT32(count), DX::ConvertToRectF(&items[0].dest_rect),
+                                           sprite_src_rects_.data(), &color, sprite_transforms_.data(),
+                                           sizeof(SpriteBatchItem), sizeof(D2D1_RECT_U), 0, sizeof(D2D1_MATRIX_3X2_F));
+
+    if (SUCCEEDED(hr))
+    {
+        D2D1_BITMAP_INTERPOLATION_MODE mode;
+        if (texture.GetBitmapInterpolationMode() == InterpolationMode::Linear)
+        {
+            mode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
+        }
+        else
+        {
+            mode = D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR;
+        }
+
+        // Sprite batches can only be drawn with aliased antialiasing, and the sprite
+        // transforms already contain the global transform
+        D2D1_MATRIX_3X2_F saved_transform;
+        render_ctx_->GetTransform(&saved_transform);
+        render_ctx_->SetTransform(D2D1::Matrix3x2F::Identity());
+        render_ctx_->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+
+        auto bitmap = ComPolicy::Get<ID2D1Bitmap>(texture);
+        sprite_ctx_->DrawSpriteBatch(sprite_batch_.Get(), 0, UINT32(count), bitmap.Get(), mode,
+                                     D2D1_SPRITE_OPTIONS_NONE);
+
+        render_ctx_->SetAntialiasMode(antialias_ ? D2D1_ANTIALIAS_MODE_PER_PRIMITIVE : D2D1_ANTIALIAS_MODE_ALIASED);
+        render_ctx_->SetTransform(saved_transform);
+
+        IncreasePrimitivesCount();
+    }
+    else
+    {
+        RenderContext::DrawSpriteBatch(texture, items, count);
+    }
+}
+
 void RenderContextImpl::DrawTextLayout(const TextLayout& layout, const Point& offset,
                                        RefPtr<Brush> current_outline_brush)
 {
@@ -428,6 +525,7 @@ void RenderContextImpl::SetBlendMode(BlendMode blend)
 {
     KGE_ASSERT(render_ctx_ && "Render target has not been initialized!");
     render_ctx_->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND(blend));
+    blend_mode_ = blend;
 }
 
 void RenderContextImpl::SetAntialiasMode(bool enabled)
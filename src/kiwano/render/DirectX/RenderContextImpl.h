@@ -21,6 +21,7 @@
 #pragma once
 #include <kiwano/render/RenderContext.h>
 #include <kiwano/render/DirectX/TextRenderer.h>
+#include <d2d1_3.h>
 
 namespace kiwano
 {
@@ -48,6 +49,8 @@ public:
 
     void DrawTextLayout(const TextLayout& layout, const Point& offset, RefPtr<Brush> outline_brush) override;
 
+    void DrawSpriteBatch(const Texture& texture, const SpriteBatchItem* items, size_t count) override;
+
     void DrawShape(const Shape& shape) override;
 
     void DrawLine(const Point& point1, const Point& point2) override;
@@ -110,7 +113,11 @@ private:
 private:
     ComPtr<ITextRenderer>          text_renderer_;
     ComPtr<ID2D1DeviceContext>     render_ctx_;
+    ComPtr<ID2D1DeviceContext3>    sprite_ctx_;
+    ComPtr<ID2D1SpriteBatch>       sprite_batch_;
     ComPtr<ID2D1DrawingStateBlock> drawing_state_;
+    Vector<D2D1_RECT_U>            sprite_src_rects_;
+    Vector<D2D1_MATRIX_3X2_F>      sprite_transforms_;
 };
 
 }  // namespace directx
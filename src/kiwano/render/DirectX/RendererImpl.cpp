@@ -42,9 +42,11 @@ inline DXGI_FORMAT ConvertPixelFormat(PixelFormat format, UINT32& pitch)
     switch (format)
     {
     case PixelFormat::Bpp32RGBA:
+    case PixelFormat::Bpp32PRGBA:
         pitch = 4;
         return DXGI_FORMAT_R8G8B8A8_UNORM;
     case PixelFormat::Bpp32BGRA:
+    case PixelFormat::Bpp32PBGRA:
         pitch = 4;
         return DXGI_FORMAT_B8G8R8A8_UNORM;
     default:
@@ -62,6 +64,12 @@ inline const GUID& ConvertPixelFormat2WIC(PixelFormat format, UINT& stride)
     case PixelFormat::Bpp32BGRA:
         stride = 4;
         return GUID_WICPixelFormat32bppBGRA;
+    case PixelFormat::Bpp32PRGBA:
+        stride = 4;
+        return GUID_WICPixelFormat32bppPRGBA;
+    case PixelFormat::Bpp32PBGRA:
+        stride = 4;
+        return GUID_WICPixelFormat32bppPBGRA;
     default:
         return GUID_WICPixelFormatDontCare;
     }
@@ -69,6 +77,8 @@ inline const GUID& ConvertPixelFormat2WIC(PixelFormat format, UINT& stride)
 
 Renderer& Renderer::GetInstance()
 {
+    if (instance_)
+        return *instance_;
     return RendererImpl::GetInstance();
 }
 
@@ -228,6 +238,13 @@ void RendererImpl::Present()
 
 void RendererImpl::CreateTexture(Texture& texture, StringView file_path)
 {
+    BinaryData archived = FileSystem::GetInstance().GetArchivedFileData(file_path);
+    if (archived.IsValid())
+    {
+        CreateTexture(texture, archived);
+        return;
+    }
+
     HRESULT hr = S_OK;
     if (!d2d_res_)
     {
@@ -341,9 +358,30 @@ void RendererImpl::CreateTexture(Texture& texture, const PixelSize& size, const
 
     if (SUCCEEDED(hr))
     {
-        hr = data.IsValid() ? S_OK : E_FAIL;
+        hr = (data.IsValid() && data.size >= uint64_t(size.x) * size.y * 4) ? S_OK : E_FAIL;
 
-        if (SUCCEEDED(hr))
+        if (SUCCEEDED(hr) && format == PixelFormat::Bpp32PBGRA)
+        {
+            // Already in the native format, copy the pixels straight into a bitmap
+            float dpi_x = 0.f, dpi_y = 0.f;
+            d2d_res_->GetDeviceContext()->GetDpi(&dpi_x, &dpi_y);
+
+            ComPtr<ID2D1Bitmap> bitmap;
+            hr = d2d_res_->GetDeviceContext()->CreateBitmap(
+                D2D1::SizeU(size.x, size.y), data.buffer, size.x * 4,
+                D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED),
+                                       dpi_x, dpi_y),
+                &bitmap);
+
+            if (SUCCEEDED(hr))
+            {
+                ComPolicy::Set(texture, bitmap);
+
+                texture.SetSize({ bitmap->GetSize().width, bitmap->GetSize().height });
+                texture.SetSizeInPixels({ bitmap->GetPixelSize().width, bitmap->GetPixelSize().height });
+            }
+        }
+        else if (SUCCEEDED(hr))
         {
             UINT        stride    = 0;
             const auto& wicFormat = ConvertPixelFormat2WIC(format, stride);
@@ -20,6 +20,7 @@
 
 #include <kiwano/render/Font.h>
 #include <kiwano/render/Renderer.h>
+#include <kiwano/platform/FileSystem.h>
 #include <functional>  // std::hash
 #include <cctype>      // std::tolower
 
@@ -31,7 +32,29 @@ RefPtr<FontCollection> FontCollection::Preload(const Vector<String>& files)
     RefPtr<FontCollection> ptr = MakePtr<FontCollection>();
     if (ptr)
     {
-        Renderer::GetInstance().CreateFontCollection(*ptr, ptr->family_names_, files);
+        // DirectWrite keeps reading the font data, so the collection holds the archives it came from
+        Vector<BinaryData>          archived;
+        Vector<RefPtr<FileArchive>> archives;
+        for (const auto& file : files)
+        {
+            RefPtr<FileArchive> archive;
+            BinaryData          data = FileSystem::GetInstance().GetArchivedFileData(file, archive);
+            if (!data.IsValid())
+                break;
+            archived.push_back(data);
+            archives.push_back(archive);
+        }
+
+        if (!files.empty() && archived.size() == files.size())
+        {
+            Renderer::GetInstance().CreateFontCollection(*ptr, ptr->family_names_, archived);
+            ptr->archives_ = std::move(archives);
+        }
+        else
+        {
+            Renderer::GetInstance().CreateFontCollection(*ptr, ptr->family_names_, files);
+        }
+
         if (ptr->IsValid())
         {
             FontCache::GetInstance().AddFontCollection(ptr);
@@ -21,6 +21,7 @@
 #pragma once
 #include <kiwano/core/Resource.h>
 #include <kiwano/platform/NativeObject.hpp>
+#include <kiwano/platform/FileArchive.h>
 
 namespace kiwano
 {
@@ -90,6 +91,7 @@ class KGE_API FontCollection : public NativeObject
 public:
     /// \~chinese
     /// @brief Ԥ弯
+    /// @details ļѹصĴļʱӴļȡ弯ϳЩļ
     /// @param files ļб
     static RefPtr<FontCollection> Preload(const Vector<String>& files);
 
@@ -101,7 +103,8 @@ public:
     const Vector<String>& GetFamilyNames() const;
 
 protected:
-    Vector<String> family_names_;
+    Vector<String>              family_names_;
+    Vector<RefPtr<FileArchive>> archives_;
 };
 
 /**
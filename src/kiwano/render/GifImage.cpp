@@ -21,11 +21,59 @@
 #include <kiwano/utils/Logger.h>
 #include <kiwano/render/GifImage.h>
 #include <kiwano/render/Renderer.h>
+#include <kiwano/render/RenderContext.h>
+#include <kiwano/platform/FileSystem.h>
 #include <functional>  // std::hash
 
 namespace kiwano
 {
 
+struct GifImage::FrameCache
+{
+    struct Entry
+    {
+        Duration        delay;
+        RefPtr<Texture> texture;
+        uint64_t        last_used = 0;
+    };
+
+    // The canvas state before composing a frame, so that replays need not start from the first frame
+    struct Keyframe
+    {
+        RefPtr<Texture> canvas;
+        RefPtr<Texture> saved;
+        Frame           last;
+    };
+
+    Vector<Entry>    entries;
+    Vector<Keyframe> keyframes;  // keyframes[i] is taken before frame (i + 1) * keyframe_interval
+    uint32_t         keyframe_interval = 0;
+    size_t           frame_bytes       = 0;
+    size_t           used_bytes        = 0;
+    uint64_t         clock             = 0;
+
+    // Frames are composed on top of each other in order, like GifSprite does
+    RefPtr<Texture>       canvas;
+    RefPtr<RenderContext> canvas_ctx;
+    RefPtr<Texture>       saved;
+    Frame                 last;
+    uint32_t              next_index = 0;
+};
+
+namespace
+{
+// Frames between two keyframes at least
+const uint32_t min_keyframe_interval = 8;
+
+RefPtr<Texture> CopyTexture(RenderContext& ctx, RefPtr<Texture> source)
+{
+    RefPtr<Texture> texture = MakePtr<Texture>();
+    ctx.CreateTexture(*texture, source->GetSizeInPixels());
+    texture->CopyFrom(source);
+    return texture;
+}
+}  // namespace
+
 GifImage::GifImage(StringView file_path)
     : GifImage()
 {
@@ -40,17 +88,38 @@ GifImage::GifImage(const Resource& res)
 
 GifImage::GifImage()
     : frames_count_(0)
+    , frame_cache_budget_(64 * 1024 * 1024)
 {
 }
 
+GifImage::~GifImage() {}
+
 bool GifImage::Load(StringView file_path)
 {
-    Renderer::GetInstance().CreateGifImage(*this, file_path);
+    const bool cached = IsFrameCacheEnabled();
+    frame_cache_.reset();
+
+    archive_ = nullptr;
+
+    RefPtr<FileArchive> archive;
+    BinaryData          archived = FileSystem::GetInstance().GetArchivedFileData(file_path, archive);
+    if (archived.IsValid())
+    {
+        Renderer::GetInstance().CreateGifImage(*this, archived);
+        archive_ = archive;
+    }
+    else
+    {
+        Renderer::GetInstance().CreateGifImage(*this, file_path);
+    }
 
     if (IsValid())
     {
         if (GetGlobalMetadata())
+        {
+            SetFrameCacheEnabled(cached);
             return true;
+        }
 
         // Clear data
         ResetNative();
@@ -61,12 +130,20 @@ bool GifImage::Load(StringView file_path)
 
 bool GifImage::Load(const Resource& res)
 {
+    const bool cached = IsFrameCacheEnabled();
+    frame_cache_.reset();
+
+    archive_ = nullptr;
+
     Renderer::GetInstance().CreateGifImage(*this, res.GetData());
 
     if (IsValid())
     {
         if (GetGlobalMetadata())
+        {
+            SetFrameCacheEnabled(cached);
             return true;
+        }
 
         // Clear data
         ResetNative();
@@ -82,6 +159,208 @@ GifImage::Frame GifImage::GetFrame(uint32_t index)
     return frame;
 }
 
+void GifImage::SetFrameCacheEnabled(bool enabled)
+{
+    if (enabled == IsFrameCacheEnabled())
+        return;
+
+    if (!enabled)
+    {
+        frame_cache_.reset();
+        return;
+    }
+
+    if (!IsValid() || frames_count_ == 0)
+        return;
+
+    std::unique_ptr<FrameCache> cache(new FrameCache);
+    cache->canvas     = MakePtr<Texture>();
+    cache->canvas_ctx = RenderContext::Create(cache->canvas, size_in_pixels_);
+    if (!cache->canvas_ctx)
+    {
+        Fail("GifImage::SetFrameCacheEnabled failed: RenderContext::Create returns null");
+        return;
+    }
+
+    cache->entries.resize(frames_count_);
+    cache->frame_bytes = size_t(size_in_pixels_.x) * size_in_pixels_.y * 4;
+
+    // Keyframes are never evicted, they take a quarter of the budget at most
+    const size_t max_keyframes = frame_cache_budget_ / 4 / std::max<size_t>(cache->frame_bytes * 2, 1);
+    if (max_keyframes > 0)
+    {
+        const size_t interval    = (frames_count_ + max_keyframes - 1) / max_keyframes;
+        cache->keyframe_interval = std::max(min_keyframe_interval, uint32_t(interval));
+    }
+    frame_cache_ = std::move(cache);
+
+    // Compose every frame once, so that the delays of all frames are known
+    FrameCache& c = *frame_cache_;
+    for (uint32_t i = 0; i < frames_count_; ++i)
+    {
+        if (i > 0 && c.keyframe_interval && i % c.keyframe_interval == 0)
+        {
+            FrameCache::Keyframe keyframe;
+            keyframe.canvas = CopyTexture(*c.canvas_ctx, c.canvas);
+            if (c.last.disposal_type == DisposalType::Previous && c.saved)
+                keyframe.saved = CopyTexture(*c.canvas_ctx, c.saved);
+            keyframe.last = c.last;
+
+            c.used_bytes += c.frame_bytes * (keyframe.saved ? 2 : 1);
+            c.keyframes.push_back(keyframe);
+        }
+        ComposeCachedFrame(true);
+    }
+}
+
+void GifImage::SetFrameCacheBudget(size_t bytes)
+{
+    frame_cache_budget_ = bytes;
+    if (frame_cache_)
+        TrimFrameCache();
+}
+
+GifImage::ComposedFrame GifImage::GetComposedFrame(uint32_t index)
+{
+    ComposedFrame composed;
+    if (!frame_cache_ || index >= frames_count_)
+        return composed;
+
+    FrameCache& cache = *frame_cache_;
+    if (!cache.entries[index].texture)
+    {
+        // An evicted frame depends on the frames before it. Replay them from the nearest keyframe,
+        // unless the canvas is already between that keyframe and the frame
+        const uint32_t keyframe = cache.keyframe_interval ? index / cache.keyframe_interval : 0;
+        const uint32_t start    = keyframe * cache.keyframe_interval;
+        if (cache.next_index < start || cache.next_index > index)
+        {
+            if (keyframe == 0)
+            {
+                cache.next_index = 0;
+            }
+            else
+            {
+                const FrameCache::Keyframe& saved = cache.keyframes[keyframe - 1];
+                cache.canvas->CopyFrom(saved.canvas);
+                if (saved.saved)
+                {
+                    if (!cache.saved)
+                        cache.saved = CopyTexture(*cache.canvas_ctx, saved.saved);
+                    else
+                        cache.saved->CopyFrom(saved.saved);
+                }
+                cache.last       = saved.last;
+                cache.next_index = start;
+            }
+        }
+
+        // Frames passed on the way are not cached, they would only evict frames that are in use
+        while (cache.next_index != index)
+            ComposeCachedFrame(false);
+        ComposeCachedFrame(true);
+    }
+
+    auto& entry      = cache.entries[index];
+    entry.last_used  = ++cache.clock;
+    composed.delay   = entry.delay;
+    composed.texture = entry.texture;
+    return composed;
+}
+
+void GifImage::ComposeCachedFrame(bool store)
+{
+    FrameCache&    cache = *frame_cache_;
+    RenderContext& ctx   = *cache.canvas_ctx;
+
+    const uint32_t index = cache.next_index;
+    if (index == 0)
+    {
+        cache.last = Frame();
+    }
+
+    // Dispose the previous frame
+    switch (cache.last.disposal_type)
+    {
+    case DisposalType::Background:
+        ctx.BeginDraw();
+        ctx.PushClipRect(cache.last.rect);
+        ctx.Clear();
+        ctx.PopClipRect();
+        ctx.EndDraw();
+        break;
+
+    case DisposalType::Previous:
+        if (cache.saved)
+            cache.canvas->CopyFrom(cache.saved);
+        break;
+
+    default:
+        break;
+    }
+
+    Frame frame = GetFrame(index);
+    if (frame.disposal_type == DisposalType::Previous)
+    {
+        if (!cache.saved)
+        {
+            cache.saved = MakePtr<Texture>();
+            ctx.CreateTexture(*cache.saved, size_in_pixels_);
+        }
+        cache.saved->CopyFrom(cache.canvas);
+    }
+
+    ctx.BeginDraw();
+    if (index == 0)
+    {
+        ctx.Clear();
+    }
+    if (frame.texture)
+    {
+        ctx.DrawTexture(*frame.texture, nullptr, &frame.rect);
+    }
+    ctx.EndDraw();
+
+    auto& entry = cache.entries[index];
+    entry.delay = frame.delay;
+    if (store && !entry.texture)
+    {
+        entry.texture   = CopyTexture(ctx, cache.canvas);
+        entry.last_used = ++cache.clock;
+        cache.used_bytes += cache.frame_bytes;
+        TrimFrameCache();
+    }
+
+    // Only the disposal of the decoded frame is needed from now on
+    frame.texture    = nullptr;
+    cache.last       = frame;
+    cache.next_index = (index + 1) % frames_count_;
+}
+
+void GifImage::TrimFrameCache()
+{
+    FrameCache& cache = *frame_cache_;
+    while (cache.used_bytes > frame_cache_budget_)
+    {
+        // The most recently used frame is always kept, and so are frames still shown by a sprite,
+        // evicting them would free nothing
+        FrameCache::Entry* victim = nullptr;
+        for (auto& entry : cache.entries)
+        {
+            if (!entry.texture || entry.last_used == cache.clock || entry.texture->GetRefCount() > 1)
+                continue;
+            if (!victim || entry.last_used < victim->last_used)
+                victim = &entry;
+        }
+
+        if (!victim)
+            break;
+
+        victim->texture = nullptr;
+        cache.used_bytes -= cache.frame_bytes;
+    }
+}
+
 }  // namespace kiwano
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
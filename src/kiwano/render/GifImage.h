@@ -20,6 +20,7 @@
 
 #pragma once
 #include <kiwano/core/Time.h>
+#include <kiwano/platform/FileArchive.h>
 #include <kiwano/render/Texture.h>
 
 namespace kiwano
@@ -39,6 +40,8 @@ class KGE_API GifImage : public NativeObject
 public:
     GifImage();
 
+    virtual ~GifImage();
+
     /// \~chinese
     /// @brief GIFͼƬ
     GifImage(StringView file_path);
@@ -49,6 +52,7 @@ public:
 
     /// \~chinese
     /// @brief رGIFͼƬ
+    /// @details ȴѹصĴļжȡͼƬڵĴļжغԿɽ
     bool Load(StringView file_path);
 
     /// \~chinese
@@ -99,12 +103,56 @@ public:
     /// @param index ֡±
     Frame GetFrame(uint32_t index);
 
+    /// \~chinese
+    /// @brief ϳɺGIF֡
+    struct ComposedFrame
+    {
+        Duration        delay;    ///< ֡ӳ
+        RefPtr<Texture> texture;  ///< ֡ͼ
+    };
+
+    /// \~chinese
+    /// @brief û֡
+    /// @details ʱ벢ϳ֡ʹøͼGIF鹲ϳɽٸԺϳ
+    /// @note GIFظͼǰ
+    void SetFrameCacheEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿ֡
+    bool IsFrameCacheEnabled() const;
+
+    /// \~chinese
+    /// @brief ֡ڴޣֽڣ
+    /// @details ʱ̭δʹûоʾ̭֡֡ҪʱĹؼ֡ºϳɡ
+    /// ؼ֡ռ޵ķ֮һ֡ʱȷ
+    void SetFrameCacheBudget(size_t bytes);
+
+    /// \~chinese
+    /// @brief ȡ֡ڴޣֽڣ
+    size_t GetFrameCacheBudget() const;
+
+    /// \~chinese
+    /// @brief ȡϳɺ֡֡
+    /// @param index ֡±
+    ComposedFrame GetComposedFrame(uint32_t index);
+
 private:
     bool GetGlobalMetadata();
 
+    void ComposeCachedFrame(bool store);
+
+    void TrimFrameCache();
+
 private:
     uint32_t  frames_count_;
     PixelSize size_in_pixels_;
+    size_t    frame_cache_budget_;
+
+    // Frames are decoded lazily from the archive mapping
+    RefPtr<FileArchive> archive_;
+
+    struct FrameCache;
+    std::unique_ptr<FrameCache> frame_cache_;
 };
 
 /** @} */
@@ -134,4 +182,14 @@ inline uint32_t GifImage::GetFramesCount() const
     return frames_count_;
 }
 
+inline bool GifImage::IsFrameCacheEnabled() const
+{
+    return frame_cache_ != nullptr;
+}
+
+inline size_t GifImage::GetFrameCacheBudget() const
+{
+    return frame_cache_budget_;
+}
+
 }  // namespace kiwano
@@ -0,0 +1,1757 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <algorithm>
+#include <cstdlib>  // std::abs
+#include <cstring>  // std::memcpy
+#include <memory>
+#include <new>
+#include <kiwano/render/ImageCodec.h>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define KGE_IMAGE_CODEC_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace kiwano
+{
+namespace image
+{
+namespace
+{
+
+inline uint32_t ReadBE16(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 8) | p[1];
+}
+
+inline uint32_t ReadBE32(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+inline uint32_t ReadLE16(const uint8_t* p)
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8);
+}
+
+inline uint32_t ReadLE32(const uint8_t* p)
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline uint8_t ClampByte(int v)
+{
+    return uint8_t(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Larger images are rejected before anything is allocated for them
+inline bool IsValidSize(uint32_t width, uint32_t height)
+{
+    return width > 0 && height > 0 && width <= MaxDimension && height <= MaxDimension
+           && uint64_t(width) * height <= MaxPixels;
+}
+
+bool AllocatePixels(Image& image, uint32_t width, uint32_t height)
+{
+    if (!IsValidSize(width, height))
+        return false;
+
+    image.width  = width;
+    image.height = height;
+    image.pixels.resize(size_t(width) * height * 4);
+    return true;
+}
+
+//-------------------------------------------------------
+// Inflate (RFC 1950/1951)
+//-------------------------------------------------------
+
+class DeflateBits
+{
+public:
+    DeflateBits(const uint8_t* data, size_t size)
+        : ptr_(data)
+        , end_(data + size)
+        , bits_(0)
+        , count_(0)
+        , padded_(0)
+    {
+    }
+
+    inline void Ensure(uint32_t n)
+    {
+        if (count_ >= n)
+            return;
+
+        while (count_ <= 56)
+        {
+            uint64_t b = 0;
+            if (ptr_ < end_)
+                b = *ptr_++;
+            else
+                ++padded_;
+            bits_ |= b << count_;
+            count_ += 8;
+        }
+    }
+
+    inline uint32_t Peek(uint32_t n) const
+    {
+        return uint32_t(bits_ & ((uint64_t(1) << n) - 1));
+    }
+
+    inline void Consume(uint32_t n)
+    {
+        bits_ >>= n;
+        count_ -= n;
+    }
+
+    inline uint32_t Read(uint32_t n)
+    {
+        Ensure(n);
+        uint32_t v = Peek(n);
+        Consume(n);
+        return v;
+    }
+
+    inline void AlignToByte()
+    {
+        Consume(count_ % 8);
+    }
+
+    // Bits past the end of the input are read as zeros, this reports whether any of them were consumed
+    inline bool Overrun() const
+    {
+        return padded_ * 8 > count_;
+    }
+
+private:
+    const uint8_t* ptr_;
+    const uint8_t* end_;
+    uint64_t       bits_;
+    uint32_t       count_;
+    uint32_t       padded_;
+};
+
+const uint32_t kDeflateFastBits = 9;
+
+struct DeflateHuffman
+{
+    uint16_t fast[1 << kDeflateFastBits];  // (length << 9) | symbol, 0 for longer codes
+    uint16_t count[16];
+    uint16_t symbol[288];
+};
+
+bool BuildDeflateHuffman(DeflateHuffman& h, const uint8_t* lengths, uint32_t n)
+{
+    std::memset(h.count, 0, sizeof(h.count));
+    for (uint32_t i = 0; i < n; ++i)
+        ++h.count[lengths[i]];
+    h.count[0] = 0;
+
+    int left = 1;
+    for (int len = 1; len < 16; ++len)
+    {
+        left = (left << 1) - h.count[len];
+        if (left < 0)
+            return false;  // over-subscribed
+    }
+
+    uint16_t offset[16] = {};
+    uint16_t next_code[16] = {};
+    for (int len = 1; len < 15; ++len)
+        offset[len + 1] = offset[len] + h.count[len];
+    for (int len = 1, code = 0; len < 16; ++len)
+    {
+        code           = (code + h.count[len - 1]) << 1;
+        next_code[len] = uint16_t(code);
+    }
+
+    std::memset(h.fast, 0, sizeof(h.fast));
+    for (uint32_t sym = 0; sym < n; ++sym)
+    {
+        uint32_t len = lengths[sym];
+        if (len == 0)
+            continue;
+
+        h.symbol[offset[len]++] = uint16_t(sym);
+
+        uint32_t code = next_code[len]++;
+        if (len <= kDeflateFastBits)
+        {
+            // Codes are packed starting from the most significant bit
+            uint32_t reversed = 0;
+            for (uint32_t i = 0; i < len; ++i)
+                reversed |= ((code >> i) & 1) << (len - 1 - i);
+
+            for (uint32_t i = reversed; i < (1u << kDeflateFastBits); i += (1u << len))
+                h.fast[i] = uint16_t((len << 9) | sym);
+        }
+    }
+    return true;
+}
+
+int DecodeDeflateSymbol(DeflateBits& bits, const DeflateHuffman& h)
+{
+    bits.Ensure(16);
+
+    uint16_t entry = h.fast[bits.Peek(kDeflateFastBits)];
+    if (entry)
+    {
+        bits.Consume(entry >> 9);
+        return entry & 511;
+    }
+
+    // Canonical decoding one bit at a time for long codes
+    int code = 0, first = 0, index = 0;
+    for (int len = 1; len < 16; ++len)
+    {
+        code |= int(bits.Read(1));
+        int count = h.count[len];
+        if (code - count < first)
+            return h.symbol[index + (code - first)];
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+const uint16_t kLengthBase[29]  = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t  kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                   2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t kDistBase[30]    = { 1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                 33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const uint8_t  kDistExtra[30]   = { 0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+const uint8_t kCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+bool InflateBlock(DeflateBits& bits, const DeflateHuffman& lit, const DeflateHuffman& dist, uint8_t* out,
+                  size_t out_size, size_t& pos)
+{
+    for (;;)
+    {
+        int sym = DecodeDeflateSymbol(bits, lit);
+        if (sym < 256)
+        {
+            if (sym < 0 || pos >= out_size)
+                return false;
+            out[pos++] = uint8_t(sym);
+        }
+        else if (sym == 256)
+        {
+            return !bits.Overrun();
+        }
+        else
+        {
+            sym -= 257;
+            if (sym >= 29)
+                return false;
+            size_t len = kLengthBase[sym] + bits.Read(kLengthExtra[sym]);
+
+            int dsym = DecodeDeflateSymbol(bits, dist);
+            if (dsym < 0 || dsym >= 30)
+                return false;
+            size_t distance = kDistBase[dsym] + bits.Read(kDistExtra[dsym]);
+
+            if (distance > pos || len > out_size - pos || bits.Overrun())
+                return false;
+
+            const uint8_t* src = out + pos - distance;
+            uint8_t*       dst = out + pos;
+            if (distance >= len)
+            {
+                std::memcpy(dst, src, len);
+            }
+            else
+            {
+                // Overlapping copies repeat the last `distance` bytes
+                for (size_t i = 0; i < len; ++i)
+                    dst[i] = src[i];
+            }
+            pos += len;
+        }
+    }
+}
+
+// Inflates a zlib stream whose decompressed size is known in advance
+bool Inflate(const uint8_t* data, size_t size, uint8_t* out, size_t out_size)
+{
+    if (size < 2 || (data[0] & 0x0F) != 8 || ReadBE16(data) % 31 != 0 || (data[1] & 0x20))
+        return false;
+
+    DeflateBits    bits(data + 2, size - 2);
+    DeflateHuffman lit, dist;
+    size_t         pos = 0;
+
+    bool final = false;
+    while (!final)
+    {
+        final         = bits.Read(1) != 0;
+        uint32_t type = bits.Read(2);
+
+        if (type == 0)
+        {
+            bits.AlignToByte();
+            uint32_t len  = bits.Read(16);
+            uint32_t nlen = bits.Read(16);
+            if (len != (~nlen & 0xFFFF) || len > out_size - pos)
+                return false;
+            for (uint32_t i = 0; i < len; ++i)
+                out[pos++] = uint8_t(bits.Read(8));
+            if (bits.Overrun())
+                return false;
+        }
+        else if (type == 1)
+        {
+            uint8_t lengths[288 + 30];
+            std::memset(lengths, 8, 144);
+            std::memset(lengths + 144, 9, 112);
+            std::memset(lengths + 256, 7, 24);
+            std::memset(lengths + 280, 8, 8);
+            std::memset(lengths + 288, 5, 30);
+            BuildDeflateHuffman(lit, lengths, 288);
+            BuildDeflateHuffman(dist, lengths + 288, 30);
+
+            if (!InflateBlock(bits, lit, dist, out, out_size, pos))
+                return false;
+        }
+        else if (type == 2)
+        {
+            uint32_t nlit  = bits.Read(5) + 257;
+            uint32_t ndist = bits.Read(5) + 1;
+            uint32_t ncode = bits.Read(4) + 4;
+            if (nlit > 286 || ndist > 30)
+                return false;
+
+            uint8_t code_lengths[19] = {};
+            for (uint32_t i = 0; i < ncode; ++i)
+                code_lengths[kCodeLengthOrder[i]] = uint8_t(bits.Read(3));
+
+            DeflateHuffman code;
+            if (!BuildDeflateHuffman(code, code_lengths, 19))
+                return false;
+
+            uint8_t  lengths[286 + 30] = {};
+            uint32_t n                 = 0;
+            while (n < nlit + ndist)
+            {
+                int sym = DecodeDeflateSymbol(bits, code);
+                if (sym < 0)
+                    return false;
+
+                if (sym < 16)
+                {
+                    lengths[n++] = uint8_t(sym);
+                    continue;
+                }
+
+                uint8_t  value  = 0;
+                uint32_t repeat = 0;
+                if (sym == 16)
+                {
+                    if (n == 0)
+                        return false;
+                    value  = lengths[n - 1];
+                    repeat = 3 + bits.Read(2);
+                }
+                else if (sym == 17)
+                {
+                    repeat = 3 + bits.Read(3);
+                }
+                else
+                {
+                    repeat = 11 + bits.Read(7);
+                }
+
+                if (n + repeat > nlit + ndist)
+                    return false;
+                while (repeat--)
+                    lengths[n++] = value;
+            }
+
+            if (lengths[256] == 0 || bits.Overrun())
+                return false;
+            if (!BuildDeflateHuffman(lit, lengths, nlit) || !BuildDeflateHuffman(dist, lengths + nlit, ndist))
+                return false;
+
+            if (!InflateBlock(bits, lit, dist, out, out_size, pos))
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return pos == out_size;
+}
+
+//-------------------------------------------------------
+// PNG
+//-------------------------------------------------------
+
+struct PngHeader
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+    uint32_t color_type;
+    uint32_t channels;
+    bool     interlaced;
+
+    uint8_t  palette[256][4];
+    bool     has_trns;
+    uint16_t trns_key[3];
+
+    size_t RowBytes(uint32_t w) const
+    {
+        return (size_t(w) * channels * depth + 7) / 8;
+    }
+};
+
+// Branch-free form of the PNG Paeth predictor, the distances are |b - c|, |a - c| and |a + b - 2c|
+inline uint8_t PaethPredictor(int a, int b, int c)
+{
+    int pa = std::abs(b - c);
+    int pb = std::abs(a - c);
+    int pc = std::abs(a + b - c - c);
+    int bc = pb <= pc ? b : c;
+    return uint8_t((pa <= pb && pa <= pc) ? a : bc);
+}
+
+bool UnfilterPngRow(uint8_t* row, const uint8_t* prev, size_t len, size_t bpp, uint8_t filter)
+{
+    switch (filter)
+    {
+    case 0:
+        break;
+    case 1:
+        for (size_t i = bpp; i < len; ++i)
+            row[i] += row[i - bpp];
+        break;
+    case 2:
+        for (size_t i = 0; i < len; ++i)
+            row[i] += prev[i];
+        break;
+    case 3:
+        for (size_t i = 0; i < bpp; ++i)
+            row[i] += prev[i] >> 1;
+        for (size_t i = bpp; i < len; ++i)
+            row[i] += uint8_t((row[i - bpp] + prev[i]) >> 1);
+        break;
+    case 4:
+        for (size_t i = 0; i < bpp; ++i)
+            row[i] += prev[i];
+        for (size_t i = bpp; i < len; ++i)
+            row[i] += PaethPredictor(row[i - bpp], prev[i], prev[i - bpp]);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+inline uint32_t ReadPngSample(const uint8_t* row, uint32_t index, uint32_t depth)
+{
+    switch (depth)
+    {
+    case 16:
+        return ReadBE16(row + index * 2);
+    case 8:
+        return row[index];
+    default:
+    {
+        uint32_t bit = index * depth;
+        return (row[bit >> 3] >> (8 - depth - (bit & 7))) & ((1u << depth) - 1);
+    }
+    }
+}
+
+// Expands one unfiltered row into straight RGBA, writing a pixel every `step` bytes
+void ExpandPngRow(const PngHeader& h, const uint8_t* row, uint32_t count, uint8_t* dst, size_t step)
+{
+    if (h.depth == 8 && !h.has_trns)
+    {
+        switch (h.color_type)
+        {
+        case 6:
+            if (step == 4)
+            {
+                std::memcpy(dst, row, size_t(count) * 4);
+                return;
+            }
+            for (uint32_t i = 0; i < count; ++i, row += 4, dst += step)
+                std::memcpy(dst, row, 4);
+            return;
+        case 2:
+            for (uint32_t i = 0; i < count; ++i, row += 3, dst += step)
+            {
+                dst[0] = row[0];
+                dst[1] = row[1];
+                dst[2] = row[2];
+                dst[3] = 255;
+            }
+            return;
+        default:
+            break;
+        }
+    }
+
+    if (h.color_type == 3)
+    {
+        for (uint32_t i = 0; i < count; ++i, dst += step)
+            std::memcpy(dst, h.palette[ReadPngSample(row, i, h.depth)], 4);
+        return;
+    }
+
+    const uint32_t max   = (1u << h.depth) - 1;
+    const uint32_t shift = h.depth == 16 ? 8 : 0;
+    const uint32_t scale = h.depth < 8 ? 255 / max : 1;  // exact for depths 1, 2 and 4
+
+    for (uint32_t i = 0; i < count; ++i, dst += step)
+    {
+        uint32_t s[4] = {};
+        for (uint32_t c = 0; c < h.channels; ++c)
+            s[c] = ReadPngSample(row, i * h.channels + c, h.depth);
+
+        switch (h.color_type)
+        {
+        case 0:
+            dst[0] = dst[1] = dst[2] = uint8_t((s[0] >> shift) * scale);
+            dst[3]                   = (h.has_trns && s[0] == h.trns_key[0]) ? 0 : 255;
+            break;
+        case 2:
+            dst[0] = uint8_t(s[0] >> shift);
+            dst[1] = uint8_t(s[1] >> shift);
+            dst[2] = uint8_t(s[2] >> shift);
+            dst[3] = (h.has_trns && s[0] == h.trns_key[0] && s[1] == h.trns_key[1] && s[2] == h.trns_key[2]) ? 0 : 255;
+            break;
+        case 4:
+            dst[0] = dst[1] = dst[2] = uint8_t(s[0] >> shift);
+            dst[3]                   = uint8_t(s[1] >> shift);
+            break;
+        default:  // 6
+            dst[0] = uint8_t(s[0] >> shift);
+            dst[1] = uint8_t(s[1] >> shift);
+            dst[2] = uint8_t(s[2] >> shift);
+            dst[3] = uint8_t(s[3] >> shift);
+            break;
+        }
+    }
+}
+
+bool DecodePng(const uint8_t* data, size_t size, Image& image, bool& has_alpha)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (size < 8 || std::memcmp(data, signature, 8) != 0)
+        return false;
+
+    PngHeader h = {};
+    bool      has_header = false;
+
+    // A single IDAT chunk is inflated in place, several are joined first
+    const uint8_t*       idat      = nullptr;
+    size_t               idat_size = 0;
+    std::vector<uint8_t> joined;
+
+    size_t pos = 8;
+    while (pos + 12 <= size)
+    {
+        uint32_t       len   = ReadBE32(data + pos);
+        const uint8_t* type  = data + pos + 4;
+        const uint8_t* chunk = data + pos + 8;
+        if (len > size - pos - 12)
+            return false;
+        pos += size_t(len) + 12;
+
+        if (std::memcmp(type, "IHDR", 4) == 0)
+        {
+            if (len != 13 || has_header)
+                return false;
+            h.width      = ReadBE32(chunk);
+            h.height     = ReadBE32(chunk + 4);
+            h.depth      = chunk[8];
+            h.color_type = chunk[9];
+            h.interlaced = chunk[12] == 1;
+            if (chunk[10] != 0 || chunk[11] != 0 || chunk[12] > 1 || !IsValidSize(h.width, h.height))
+                return false;
+
+            static const uint32_t channels[7] = { 1, 0, 3, 1, 2, 0, 4 };
+            if (h.color_type > 6 || channels[h.color_type] == 0)
+                return false;
+            h.channels = channels[h.color_type];
+
+            bool low_depth   = h.depth == 1 || h.depth == 2 || h.depth == 4;
+            bool valid_depth = (h.depth == 8) || (h.depth == 16 && h.color_type != 3)
+                               || (low_depth && (h.color_type == 0 || h.color_type == 3));
+            if (!valid_depth)
+                return false;
+
+            for (auto& entry : h.palette)
+            {
+                entry[0] = entry[1] = entry[2] = 0;
+                entry[3]                       = 255;
+            }
+            has_header = true;
+        }
+        else if (!has_header)
+        {
+            return false;
+        }
+        else if (std::memcmp(type, "PLTE", 4) == 0)
+        {
+            if (len % 3 != 0 || len > 256 * 3)
+                return false;
+            for (uint32_t i = 0; i < len / 3; ++i)
+            {
+                h.palette[i][0] = chunk[i * 3];
+                h.palette[i][1] = chunk[i * 3 + 1];
+                h.palette[i][2] = chunk[i * 3 + 2];
+            }
+        }
+        else if (std::memcmp(type, "tRNS", 4) == 0)
+        {
+            if (h.color_type == 3)
+            {
+                if (len > 256)
+                    return false;
+                for (uint32_t i = 0; i < len; ++i)
+                    h.palette[i][3] = chunk[i];
+            }
+            else if (h.color_type == 0 || h.color_type == 2)
+            {
+                if (len != h.channels * 2)
+                    return false;
+                for (uint32_t c = 0; c < h.channels; ++c)
+                    h.trns_key[c] = uint16_t(ReadBE16(chunk + c * 2));
+            }
+            h.has_trns = true;
+        }
+        else if (std::memcmp(type, "IDAT", 4) == 0)
+        {
+            if (!idat)
+            {
+                idat      = chunk;
+                idat_size = len;
+            }
+            else
+            {
+                if (joined.empty())
+                    joined.assign(idat, idat + idat_size);
+                joined.insert(joined.end(), chunk, chunk + len);
+            }
+        }
+        else if (std::memcmp(type, "IEND", 4) == 0)
+        {
+            break;
+        }
+    }
+
+    if (!has_header || !idat)
+        return false;
+    if (!joined.empty())
+    {
+        idat      = joined.data();
+        idat_size = joined.size();
+    }
+
+    static const uint32_t adam7[7][4] = {
+        { 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 }, { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 },
+    };
+    static const uint32_t progressive[1][4] = { { 0, 0, 1, 1 } };
+
+    const uint32_t(*passes)[4] = h.interlaced ? adam7 : progressive;
+    const uint32_t pass_count  = h.interlaced ? 7 : 1;
+
+    size_t raw_size = 0;
+    for (uint32_t p = 0; p < pass_count; ++p)
+    {
+        uint32_t w = h.width > passes[p][0] ? (h.width - passes[p][0] + passes[p][2] - 1) / passes[p][2] : 0;
+        uint32_t r = h.height > passes[p][1] ? (h.height - passes[p][1] + passes[p][3] - 1) / passes[p][3] : 0;
+        if (w && r)
+            raw_size += size_t(r) * (h.RowBytes(w) + 1);
+    }
+
+    // Deflate can't expand a byte into more than 1032 bytes, so a short stream can't describe a
+    // large image. Check before allocating anything for it
+    if (raw_size / 1032 > idat_size)
+        return false;
+
+    std::vector<uint8_t> raw(raw_size);
+    if (!Inflate(idat, idat_size, raw.data(), raw.size()))
+        return false;
+
+    if (!AllocatePixels(image, h.width, h.height))
+        return false;
+
+    const size_t         bpp = std::max<size_t>(1, h.channels * h.depth / 8);
+    std::vector<uint8_t> zeros(h.RowBytes(h.width), 0);
+
+    uint8_t* cursor = raw.data();
+    for (uint32_t p = 0; p < pass_count; ++p)
+    {
+        const uint32_t x0 = passes[p][0], y0 = passes[p][1], dx = passes[p][2], dy = passes[p][3];
+
+        uint32_t w = h.width > x0 ? (h.width - x0 + dx - 1) / dx : 0;
+        uint32_t r = h.height > y0 ? (h.height - y0 + dy - 1) / dy : 0;
+        if (!w || !r)
+            continue;
+
+        const size_t   row_bytes = h.RowBytes(w);
+        const uint8_t* prev      = zeros.data();
+        for (uint32_t y = 0; y < r; ++y)
+        {
+            uint8_t filter = cursor[0];
+            uint8_t* row   = cursor + 1;
+            if (!UnfilterPngRow(row, prev, row_bytes, bpp, filter))
+                return false;
+
+            uint8_t* dst = &image.pixels[(size_t(y0 + y * dy) * h.width + x0) * 4];
+            ExpandPngRow(h, row, w, dst, size_t(dx) * 4);
+
+            prev = row;
+            cursor += row_bytes + 1;
+        }
+    }
+
+    has_alpha = h.color_type == 4 || h.color_type == 6 || h.has_trns;
+    return true;
+}
+
+//-------------------------------------------------------
+// JPEG (baseline and extended sequential, Huffman coded)
+//-------------------------------------------------------
+
+const uint8_t kZigzag[64 + 16] = {
+    0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  12, 19, 26, 33, 40, 48,
+    41, 34, 27, 20, 13, 6,  7,  14, 21, 28, 35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23,
+    30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+    // corrupted run lengths land here instead of running past the block
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+};
+
+const uint32_t kJpegFastBits = 9;
+
+struct JpegHuffman
+{
+    uint8_t fast_length[1 << kJpegFastBits];  // 0 for longer codes
+    uint8_t fast_value[1 << kJpegFastBits];
+    int32_t max_code[18];
+    int32_t value_offset[17];
+    uint8_t values[256];
+    bool    defined;
+};
+
+bool BuildJpegHuffman(JpegHuffman& h, const uint8_t* counts, const uint8_t* values, uint32_t total)
+{
+    std::memcpy(h.values, values, total);
+    std::memset(h.fast_length, 0, sizeof(h.fast_length));
+
+    int32_t  code  = 0;
+    uint32_t index = 0;
+    for (uint32_t len = 1; len <= 16; ++len)
+    {
+        h.value_offset[len] = int32_t(index) - code;
+        for (uint32_t i = 0; i < counts[len - 1]; ++i, ++index, ++code)
+        {
+            if (len <= kJpegFastBits)
+            {
+                uint32_t first = uint32_t(code) << (kJpegFastBits - len);
+                for (uint32_t j = 0; j < (1u << (kJpegFastBits - len)); ++j)
+                {
+                    h.fast_length[first + j] = uint8_t(len);
+                    h.fast_value[first + j]  = values[index];
+                }
+            }
+        }
+        h.max_code[len] = counts[len - 1] ? code - 1 : -1;
+        if (code > (1 << len))
+            return false;
+        code <<= 1;
+    }
+    h.max_code[17] = 0x7FFFFFFF;
+    h.defined      = true;
+    return true;
+}
+
+class JpegBits
+{
+public:
+    JpegBits(const uint8_t* data, const uint8_t* end)
+        : ptr_(data)
+        , end_(end)
+        , bits_(0)
+        , count_(0)
+        , marker_(false)
+    {
+    }
+
+    // Entropy-coded data ends at a marker, everything after it is read as zeros
+    inline void Fill()
+    {
+        while (count_ <= 24)
+        {
+            uint32_t b = 0;
+            if (!marker_ && ptr_ < end_)
+            {
+                b = *ptr_;
+                if (b == 0xFF)
+                {
+                    if (ptr_ + 1 < end_ && ptr_[1] == 0)
+                    {
+                        ptr_ += 2;
+                    }
+                    else
+                    {
+                        marker_ = true;
+                        b       = 0;
+                    }
+                }
+                else
+                {
+                    ++ptr_;
+                }
+            }
+            bits_ |= b << (24 - count_);
+            count_ += 8;
+        }
+    }
+
+    inline uint32_t Read(uint32_t n)
+    {
+        if (n == 0)
+            return 0;
+        Fill();
+        uint32_t v = bits_ >> (32 - n);
+        bits_ <<= n;
+        count_ -= n;
+        return v;
+    }
+
+    inline int ReceiveExtend(uint32_t n)
+    {
+        if (n == 0)
+            return 0;
+        int v = int(Read(n));
+        return v < (1 << (n - 1)) ? v - (1 << n) + 1 : v;
+    }
+
+    int Decode(const JpegHuffman& h)
+    {
+        Fill();
+
+        uint32_t look = bits_ >> (32 - kJpegFastBits);
+        uint32_t len  = h.fast_length[look];
+        if (len)
+        {
+            bits_ <<= len;
+            count_ -= len;
+            return h.fast_value[look];
+        }
+
+        for (len = kJpegFastBits + 1; len <= 16; ++len)
+        {
+            int32_t code = int32_t(bits_ >> (32 - len));
+            if (code <= h.max_code[len])
+            {
+                bits_ <<= len;
+                count_ -= len;
+                return h.values[(h.value_offset[len] + code) & 0xFF];
+            }
+        }
+        return -1;
+    }
+
+    // Skips to the restart marker expected after a restart interval
+    bool Restart()
+    {
+        bits_   = 0;
+        count_  = 0;
+        marker_ = false;
+        while (ptr_ + 1 < end_ && !(ptr_[0] == 0xFF && ptr_[1] >= 0xD0 && ptr_[1] <= 0xD7))
+            ++ptr_;
+        if (ptr_ + 1 >= end_)
+            return false;
+        ptr_ += 2;
+        return true;
+    }
+
+    const uint8_t* GetPosition() const
+    {
+        return ptr_;
+    }
+
+private:
+    const uint8_t* ptr_;
+    const uint8_t* end_;
+    uint32_t       bits_;
+    uint32_t       count_;
+    bool           marker_;
+};
+
+// Integer IDCT with 12 bits of fixed-point precision, after the IJG islow algorithm
+#define KGE_JPEG_F2F(x) int((x)*4096 + 0.5)
+
+struct IdctTerms
+{
+    int t0, t1, t2, t3, x0, x1, x2, x3;
+
+    IdctTerms(int s0, int s1, int s2, int s3, int s4, int s5, int s6, int s7)
+    {
+        int p1, p2, p3, p4, p5;
+
+        p2 = s2;
+        p3 = s6;
+        p1 = (p2 + p3) * KGE_JPEG_F2F(0.5411961f);
+        t2 = p1 + p3 * KGE_JPEG_F2F(-1.847759065f);
+        t3 = p1 + p2 * KGE_JPEG_F2F(0.765366865f);
+        t0 = (s0 + s4) * 4096;
+        t1 = (s0 - s4) * 4096;
+        x0 = t0 + t3;
+        x3 = t0 - t3;
+        x1 = t1 + t2;
+        x2 = t1 - t2;
+
+        t0 = s7;
+        t1 = s5;
+        t2 = s3;
+        t3 = s1;
+        p3 = t0 + t2;
+        p4 = t1 + t3;
+        p1 = t0 + t3;
+        p2 = t1 + t2;
+        p5 = (p3 + p4) * KGE_JPEG_F2F(1.175875602f);
+        t0 = t0 * KGE_JPEG_F2F(0.298631336f);
+        t1 = t1 * KGE_JPEG_F2F(2.053119869f);
+        t2 = t2 * KGE_JPEG_F2F(3.072711026f);
+        t3 = t3 * KGE_JPEG_F2F(1.501321110f);
+        p1 = p5 + p1 * KGE_JPEG_F2F(-0.899976223f);
+        p2 = p5 + p2 * KGE_JPEG_F2F(-2.562915447f);
+        p3 = p3 * KGE_JPEG_F2F(-1.961570560f);
+        p4 = p4 * KGE_JPEG_F2F(-0.390180644f);
+        t3 += p1 + p4;
+        t2 += p2 + p3;
+        t1 += p2 + p4;
+        t0 += p1 + p3;
+    }
+};
+
+#undef KGE_JPEG_F2F
+
+// Dequantized coefficients of valid images fit in 16 bits. Corrupted ones are clamped, which keeps the
+// first IDCT pass within 31 bits
+inline int ClampCoefficient(int v)
+{
+    return v < -32768 ? -32768 : (v > 32767 ? 32767 : v);
+}
+
+// The first pass of valid images stays within 16 bits as well. Clamping corrupted results keeps the
+// second pass, which multiplies them by up to 2^15, from overflowing
+inline int ClampIdctPass(int v)
+{
+    return v < -65536 ? -65536 : (v > 65536 ? 65536 : v);
+}
+
+void IdctBlock(const int* coef, uint8_t* out, size_t stride)
+{
+    int temp[64];
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const int* c = coef + i;
+        int*       v = temp + i;
+        if (c[8] == 0 && c[16] == 0 && c[24] == 0 && c[32] == 0 && c[40] == 0 && c[48] == 0 && c[56] == 0)
+        {
+            int dc = ClampIdctPass(c[0] * 4);
+            v[0] = v[8] = v[16] = v[24] = v[32] = v[40] = v[48] = v[56] = dc;
+            continue;
+        }
+
+        IdctTerms t(c[0], c[8], c[16], c[24], c[32], c[40], c[48], c[56]);
+        // Keep two extra bits of precision for the second pass
+        t.x0 += 512;
+        t.x1 += 512;
+        t.x2 += 512;
+        t.x3 += 512;
+        v[0]  = ClampIdctPass((t.x0 + t.t3) >> 10);
+        v[56] = ClampIdctPass((t.x0 - t.t3) >> 10);
+        v[8]  = ClampIdctPass((t.x1 + t.t2) >> 10);
+        v[48] = ClampIdctPass((t.x1 - t.t2) >> 10);
+        v[16] = ClampIdctPass((t.x2 + t.t1) >> 10);
+        v[40] = ClampIdctPass((t.x2 - t.t1) >> 10);
+        v[24] = ClampIdctPass((t.x3 + t.t0) >> 10);
+        v[32] = ClampIdctPass((t.x3 - t.t0) >> 10);
+    }
+
+    for (int i = 0; i < 8; ++i, out += stride)
+    {
+        const int* v = temp + i * 8;
+        IdctTerms  t(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+        // Remove the 1 << 17 scale with rounding and level-shift by 128
+        const int bias = 65536 + (128 << 17);
+        t.x0 += bias;
+        t.x1 += bias;
+        t.x2 += bias;
+        t.x3 += bias;
+        out[0] = ClampByte((t.x0 + t.t3) >> 17);
+        out[7] = ClampByte((t.x0 - t.t3) >> 17);
+        out[1] = ClampByte((t.x1 + t.t2) >> 17);
+        out[6] = ClampByte((t.x1 - t.t2) >> 17);
+        out[2] = ClampByte((t.x2 + t.t1) >> 17);
+        out[5] = ClampByte((t.x2 - t.t1) >> 17);
+        out[3] = ClampByte((t.x3 + t.t0) >> 17);
+        out[4] = ClampByte((t.x3 - t.t0) >> 17);
+    }
+}
+
+struct JpegComponent
+{
+    uint32_t             id;
+    uint32_t             h, v;
+    uint32_t             quant;
+    uint32_t             dc_table, ac_table;
+    uint32_t             blocks_x, blocks_y;  // blocks covering the image in non-interleaved scans
+    size_t               stride;
+    std::vector<uint8_t> plane;
+    int                  dc_pred;
+};
+
+struct JpegDecoder
+{
+    uint32_t      width  = 0;
+    uint32_t      height = 0;
+    uint32_t      h_max  = 1;
+    uint32_t      v_max  = 1;
+    uint32_t      mcus_x = 0;
+    uint32_t      mcus_y = 0;
+    uint32_t      restart_interval = 0;
+    uint32_t      component_count  = 0;
+    JpegComponent components[3];
+    uint16_t      quant[4][64];
+    JpegHuffman   dc[4];
+    JpegHuffman   ac[4];
+    int           adobe_transform = -1;
+    bool          has_frame       = false;
+    bool          has_scan        = false;
+
+    bool ParseFrame(const uint8_t* p, uint32_t len, size_t data_size)
+    {
+        if (has_frame || len < 6 || p[0] != 8)
+            return false;
+
+        height          = ReadBE16(p + 1);
+        width           = ReadBE16(p + 3);
+        component_count = p[5];
+        if (width == 0 || height == 0 || (component_count != 1 && component_count != 3)
+            || len < 6 + component_count * 3)
+            return false;
+
+        for (uint32_t i = 0; i < component_count; ++i)
+        {
+            JpegComponent& c = components[i];
+            c.id             = p[6 + i * 3];
+            c.h              = p[7 + i * 3] >> 4;
+            c.v              = p[7 + i * 3] & 15;
+            c.quant          = p[8 + i * 3];
+            if (c.h == 0 || c.h > 4 || c.v == 0 || c.v > 4 || c.quant > 3)
+                return false;
+            h_max = std::max(h_max, c.h);
+            v_max = std::max(v_max, c.v);
+        }
+
+        if (!IsValidSize(width, height))
+            return false;
+
+        mcus_x = (width + 8 * h_max - 1) / (8 * h_max);
+        mcus_y = (height + 8 * v_max - 1) / (8 * v_max);
+
+        // Every coded block takes at least two bits (a DC code and an end of block code), so a file
+        // can't describe more than four blocks per byte. Check before allocating the planes
+        uint64_t blocks = 0;
+        for (uint32_t i = 0; i < component_count; ++i)
+        {
+            JpegComponent& c = components[i];
+            c.blocks_x       = ((width * c.h + h_max - 1) / h_max + 7) / 8;
+            c.blocks_y       = ((height * c.v + v_max - 1) / v_max + 7) / 8;
+            blocks += uint64_t(c.blocks_x) * c.blocks_y;
+        }
+        if (blocks > uint64_t(data_size) * 4)
+            return false;
+
+        for (uint32_t i = 0; i < component_count; ++i)
+        {
+            JpegComponent& c = components[i];
+            c.stride         = size_t(mcus_x) * c.h * 8;
+            c.plane.assign(c.stride * mcus_y * c.v * 8, 0);
+        }
+        has_frame = true;
+        return true;
+    }
+
+    bool ParseQuantTables(const uint8_t* p, uint32_t len)
+    {
+        while (len > 0)
+        {
+            uint32_t precision = p[0] >> 4;
+            uint32_t id        = p[0] & 15;
+            uint32_t size      = precision ? 129 : 65;
+            if (id > 3 || precision > 1 || len < size)
+                return false;
+            for (uint32_t i = 0; i < 64; ++i)
+                quant[id][i] = uint16_t(precision ? ReadBE16(p + 1 + i * 2) : p[1 + i]);
+            p += size;
+            len -= size;
+        }
+        return true;
+    }
+
+    bool ParseHuffmanTables(const uint8_t* p, uint32_t len)
+    {
+        while (len > 0)
+        {
+            if (len < 17)
+                return false;
+            uint32_t table_class = p[0] >> 4;
+            uint32_t id          = p[0] & 15;
+            uint32_t total       = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+                total += p[1 + i];
+            if (table_class > 1 || id > 3 || total > 256 || len < 17 + total)
+                return false;
+
+            JpegHuffman& h = table_class ? ac[id] : dc[id];
+            if (!BuildJpegHuffman(h, p + 1, p + 17, total))
+                return false;
+            p += 17 + total;
+            len -= 17 + total;
+        }
+        return true;
+    }
+
+    bool DecodeBlock(JpegBits& bits, JpegComponent& c, uint8_t* out)
+    {
+        int coef[64] = {};
+
+        int t = bits.Decode(dc[c.dc_table]);
+        if (t < 0 || t > 15)
+            return false;
+        // The predictor of a corrupted stream would grow with every block
+        c.dc_pred = ClampCoefficient(c.dc_pred + bits.ReceiveExtend(uint32_t(t)));
+        coef[0]   = ClampCoefficient(c.dc_pred * quant[c.quant][0]);
+
+        for (uint32_t k = 1; k < 64;)
+        {
+            int rs = bits.Decode(ac[c.ac_table]);
+            if (rs < 0)
+                return false;
+
+            uint32_t run = uint32_t(rs) >> 4;
+            uint32_t s   = uint32_t(rs) & 15;
+            if (s == 0)
+            {
+                if (run != 15)
+                    break;  // end of block
+                k += 16;
+                continue;
+            }
+
+            k += run;
+            if (k > 63)
+                return false;
+            coef[kZigzag[k]] = ClampCoefficient(bits.ReceiveExtend(s) * quant[c.quant][k]);
+            ++k;
+        }
+
+        IdctBlock(coef, out, c.stride);
+        return true;
+    }
+
+    // Returns the position right after the entropy-coded data
+    const uint8_t* DecodeScan(const uint8_t* p, uint32_t len, const uint8_t* end)
+    {
+        if (!has_frame || len < 1)
+            return nullptr;
+
+        uint32_t count = p[0];
+        if (count == 0 || count > component_count || len < 4 + count * 2)
+            return nullptr;
+
+        JpegComponent* scan[3] = {};
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t id     = p[1 + i * 2];
+            uint32_t tables = p[2 + i * 2];
+            for (uint32_t j = 0; j < component_count; ++j)
+            {
+                if (components[j].id == id)
+                    scan[i] = &components[j];
+            }
+            if (!scan[i])
+                return nullptr;
+            scan[i]->dc_table = tables >> 4;
+            scan[i]->ac_table = tables & 15;
+            if (scan[i]->dc_table > 3 || scan[i]->ac_table > 3 || !dc[scan[i]->dc_table].defined
+                || !ac[scan[i]->ac_table].defined)
+                return nullptr;
+            scan[i]->dc_pred = 0;
+        }
+
+        // Spectral selection and successive approximation only apply to progressive images
+        const uint8_t* q = p + 1 + count * 2;
+        if (q[0] != 0 || q[1] != 63 || q[2] != 0)
+            return nullptr;
+
+        JpegBits bits(p + len, end);
+
+        const uint32_t units_x = count == 1 ? scan[0]->blocks_x : mcus_x;
+        const uint32_t units_y = count == 1 ? scan[0]->blocks_y : mcus_y;
+        uint32_t       todo    = restart_interval ? restart_interval : 0xFFFFFFFF;
+
+        for (uint32_t my = 0; my < units_y; ++my)
+        {
+            for (uint32_t mx = 0; mx < units_x; ++mx)
+            {
+                if (count == 1)
+                {
+                    JpegComponent& c = *scan[0];
+                    if (!DecodeBlock(bits, c, &c.plane[size_t(my) * 8 * c.stride + size_t(mx) * 8]))
+                        return nullptr;
+                }
+                else
+                {
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        JpegComponent& c = *scan[i];
+                        for (uint32_t by = 0; by < c.v; ++by)
+                        {
+                            for (uint32_t bx = 0; bx < c.h; ++bx)
+                            {
+                                size_t row = (size_t(my) * c.v + by) * 8;
+                                size_t col = (size_t(mx) * c.h + bx) * 8;
+                                if (!DecodeBlock(bits, c, &c.plane[row * c.stride + col]))
+                                    return nullptr;
+                            }
+                        }
+                    }
+                }
+
+                if (--todo == 0)
+                {
+                    todo = restart_interval;
+                    bool last = (my == units_y - 1) && (mx == units_x - 1);
+                    if (!last)
+                    {
+                        if (!bits.Restart())
+                            return nullptr;
+                        for (uint32_t i = 0; i < count; ++i)
+                            scan[i]->dc_pred = 0;
+                    }
+                }
+            }
+        }
+
+        has_scan = true;
+        return bits.GetPosition();
+    }
+
+    bool Decode(const uint8_t* data, size_t size)
+    {
+        size_t pos = 2;
+        while (pos + 1 < size)
+        {
+            if (data[pos] != 0xFF)
+            {
+                ++pos;  // tolerate garbage between segments
+                continue;
+            }
+
+            uint8_t marker = data[pos + 1];
+            pos += 2;
+
+            if (marker == 0xFF)
+            {
+                --pos;  // fill byte
+                continue;
+            }
+            if (marker == 0xD9)
+                break;
+            if (marker == 0x01 || marker == 0x00 || (marker >= 0xD0 && marker <= 0xD7))
+                continue;
+
+            if (pos + 2 > size)
+                return false;
+            uint32_t len = ReadBE16(data + pos);
+            if (len < 2 || pos + len > size)
+                return false;
+
+            const uint8_t* p = data + pos + 2;
+            len -= 2;
+            pos += len + 2;
+
+            switch (marker)
+            {
+            case 0xC0:  // baseline
+            case 0xC1:  // extended sequential
+                if (!ParseFrame(p, len, size))
+                    return false;
+                break;
+            case 0xC4:
+                if (!ParseHuffmanTables(p, len))
+                    return false;
+                break;
+            case 0xDB:
+                if (!ParseQuantTables(p, len))
+                    return false;
+                break;
+            case 0xDD:
+                if (len < 2)
+                    return false;
+                restart_interval = ReadBE16(p);
+                break;
+            case 0xDA:
+            {
+                const uint8_t* next = DecodeScan(p, len, data + size);
+                if (!next)
+                    return false;
+                pos = size_t(next - data);
+                break;
+            }
+            case 0xEE:
+                if (len >= 12 && std::memcmp(p, "Adobe", 5) == 0)
+                    adobe_transform = p[11];
+                break;
+            default:
+                // progressive, lossless and arithmetic coded frames are not supported
+                if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+                    return false;
+                break;
+            }
+        }
+        return has_frame && has_scan;
+    }
+
+    void Output(Image& image) const
+    {
+        const uint32_t w = width;
+
+        // Sample positions of each component for every output column (nearest-neighbour upsampling)
+        std::vector<uint32_t> columns[3];
+        for (uint32_t i = 0; i < component_count; ++i)
+        {
+            columns[i].resize(w);
+            for (uint32_t x = 0; x < w; ++x)
+                columns[i][x] = x * components[i].h / h_max;
+        }
+
+        const bool rgb_ids = components[0].id == 'R' && components[1].id == 'G' && components[2].id == 'B';
+        const bool rgb     = component_count == 3 && (adobe_transform == 0 || rgb_ids);
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            uint8_t* dst = &image.pixels[size_t(y) * w * 4];
+            if (component_count == 1)
+            {
+                const JpegComponent& c   = components[0];
+                const uint8_t*       src = &c.plane[size_t(y) * c.v / v_max * c.stride];
+                for (uint32_t x = 0; x < w; ++x, dst += 4)
+                {
+                    dst[0] = dst[1] = dst[2] = src[columns[0][x]];
+                    dst[3]                   = 255;
+                }
+                continue;
+            }
+
+            const uint8_t* src[3];
+            for (uint32_t i = 0; i < 3; ++i)
+                src[i] = &components[i].plane[size_t(y) * components[i].v / v_max * components[i].stride];
+
+            for (uint32_t x = 0; x < w; ++x, dst += 4)
+            {
+                int c0 = src[0][columns[0][x]];
+                int c1 = src[1][columns[1][x]];
+                int c2 = src[2][columns[2][x]];
+                if (rgb)
+                {
+                    dst[0] = uint8_t(c0);
+                    dst[1] = uint8_t(c1);
+                    dst[2] = uint8_t(c2);
+                }
+                else
+                {
+                    // JFIF YCbCr to RGB with 16 bits of fixed-point precision
+                    int luma = (c0 << 16) + 32768;
+                    int cb   = c1 - 128;
+                    int cr   = c2 - 128;
+                    dst[0]   = ClampByte((luma + 91881 * cr) >> 16);
+                    dst[1]   = ClampByte((luma - 22554 * cb - 46802 * cr) >> 16);
+                    dst[2]   = ClampByte((luma + 116130 * cb) >> 16);
+                }
+                dst[3] = 255;
+            }
+        }
+    }
+};
+
+bool DecodeJpeg(const uint8_t* data, size_t size, Image& image, bool& has_alpha)
+{
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8)
+        return false;
+
+    std::unique_ptr<JpegDecoder> decoder(new JpegDecoder);
+    std::memset(decoder->dc, 0, sizeof(decoder->dc));
+    std::memset(decoder->ac, 0, sizeof(decoder->ac));
+    std::memset(decoder->quant, 0, sizeof(decoder->quant));
+
+    if (!decoder->Decode(data, size))
+        return false;
+    if (!AllocatePixels(image, decoder->width, decoder->height))
+        return false;
+
+    decoder->Output(image);
+    has_alpha = false;
+    return true;
+}
+
+//-------------------------------------------------------
+// BMP
+//-------------------------------------------------------
+
+struct BitfieldChannel
+{
+    uint32_t mask;
+    uint32_t shift;
+    uint32_t max;
+
+    explicit BitfieldChannel(uint32_t m)
+        : mask(m)
+        , shift(0)
+        , max(0)
+    {
+        if (mask)
+        {
+            while (((mask >> shift) & 1) == 0)
+                ++shift;
+            max = mask >> shift;
+        }
+    }
+
+    inline uint8_t Extract(uint32_t pixel, uint8_t fallback) const
+    {
+        if (!mask)
+            return fallback;
+        uint32_t v = (pixel & mask) >> shift;
+        return uint8_t((uint64_t(v) * 255 + max / 2) / max);
+    }
+};
+
+bool DecodeBmp(const uint8_t* data, size_t size, Image& image, bool& has_alpha)
+{
+    if (size < 26 || data[0] != 'B' || data[1] != 'M')
+        return false;
+
+    const uint32_t offset      = ReadLE32(data + 10);
+    const uint32_t header_size = ReadLE32(data + 14);
+
+    int32_t  width = 0, height = 0;
+    uint32_t bpp = 0, compression = 0, colors_used = 0;
+    uint32_t masks[4]      = {};
+    size_t   palette_pos   = 14 + size_t(header_size);
+    size_t   palette_entry = 4;
+
+    if (header_size == 12)
+    {
+        width         = int32_t(ReadLE16(data + 18));
+        height        = int32_t(ReadLE16(data + 20));
+        bpp           = ReadLE16(data + 24);
+        palette_entry = 3;
+    }
+    else if (header_size >= 40 && size >= 14 + size_t(header_size))
+    {
+        width       = int32_t(ReadLE32(data + 18));
+        height      = int32_t(ReadLE32(data + 22));
+        bpp         = ReadLE16(data + 28);
+        compression = ReadLE32(data + 30);
+        colors_used = ReadLE32(data + 46);
+
+        if (compression == 3 || compression == 6)
+        {
+            uint32_t mask_count = compression == 6 ? 4 : 3;
+            size_t   mask_pos   = 54;
+            if (header_size == 40)
+            {
+                // masks follow the header
+                if (size < 54 + mask_count * 4)
+                    return false;
+                palette_pos += mask_count * 4;
+            }
+            else if (header_size >= 56)
+            {
+                mask_count = 4;
+            }
+            for (uint32_t i = 0; i < mask_count; ++i)
+                masks[i] = ReadLE32(data + mask_pos + i * 4);
+        }
+        else if (compression != 0)
+        {
+            return false;  // RLE and embedded JPEG/PNG
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    const bool     top_down = height < 0;
+    const uint32_t w        = uint32_t(width);
+    const uint32_t h        = top_down ? uint32_t(-int64_t(height)) : uint32_t(height);
+    if (width <= 0 || h == 0)
+        return false;
+
+    if (compression == 0 && bpp == 16)
+    {
+        masks[0] = 0x7C00;
+        masks[1] = 0x03E0;
+        masks[2] = 0x001F;
+    }
+
+    bool supported = bpp == 1 || bpp == 4 || bpp == 8 || bpp == 24 || ((bpp == 16 || bpp == 32));
+    if (!supported || (compression != 0 && bpp != 16 && bpp != 32))
+        return false;
+
+    const size_t stride = ((size_t(w) * bpp + 31) / 32) * 4;
+    if (offset > size || stride * h > size - offset)
+        return false;
+
+    uint8_t palette[256][4] = {};
+    if (bpp <= 8)
+    {
+        uint32_t entries = colors_used ? std::min<uint32_t>(colors_used, 256) : (1u << bpp);
+        if (palette_pos + size_t(entries) * palette_entry > offset)
+            return false;
+        for (uint32_t i = 0; i < entries; ++i)
+        {
+            const uint8_t* e = data + palette_pos + i * palette_entry;
+            palette[i][0]    = e[2];
+            palette[i][1]    = e[1];
+            palette[i][2]    = e[0];
+            palette[i][3]    = 255;
+        }
+        for (uint32_t i = entries; i < 256; ++i)
+            palette[i][3] = 255;
+    }
+
+    if (!AllocatePixels(image, w, h))
+        return false;
+
+    const BitfieldChannel red(masks[0]), green(masks[1]), blue(masks[2]), alpha(masks[3]);
+
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        const uint8_t* src = data + offset + stride * (top_down ? y : h - 1 - y);
+        uint8_t*       dst = &image.pixels[size_t(y) * w * 4];
+
+        switch (bpp)
+        {
+        case 24:
+            for (uint32_t x = 0; x < w; ++x, src += 3, dst += 4)
+            {
+                dst[0] = src[2];
+                dst[1] = src[1];
+                dst[2] = src[0];
+                dst[3] = 255;
+            }
+            break;
+        case 32:
+            if (compression == 0)
+            {
+                // The fourth byte is unused in BI_RGB bitmaps
+                for (uint32_t x = 0; x < w; ++x, src += 4, dst += 4)
+                {
+                    dst[0] = src[2];
+                    dst[1] = src[1];
+                    dst[2] = src[0];
+                    dst[3] = 255;
+                }
+                break;
+            }
+            for (uint32_t x = 0; x < w; ++x, src += 4, dst += 4)
+            {
+                uint32_t pixel = ReadLE32(src);
+                dst[0]         = red.Extract(pixel, 0);
+                dst[1]         = green.Extract(pixel, 0);
+                dst[2]         = blue.Extract(pixel, 0);
+                dst[3]         = alpha.Extract(pixel, 255);
+            }
+            break;
+        case 16:
+            for (uint32_t x = 0; x < w; ++x, src += 2, dst += 4)
+            {
+                uint32_t pixel = ReadLE16(src);
+                dst[0]         = red.Extract(pixel, 0);
+                dst[1]         = green.Extract(pixel, 0);
+                dst[2]         = blue.Extract(pixel, 0);
+                dst[3]         = alpha.Extract(pixel, 255);
+            }
+            break;
+        default:
+            for (uint32_t x = 0; x < w; ++x, dst += 4)
+            {
+                uint32_t bit   = x * bpp;
+                uint32_t index = (src[bit >> 3] >> (8 - bpp - (bit & 7))) & ((1u << bpp) - 1);
+                std::memcpy(dst, palette[index], 4);
+            }
+            break;
+        }
+    }
+
+    has_alpha = masks[3] != 0;
+    return true;
+}
+
+//-------------------------------------------------------
+// Pixel conversion
+//-------------------------------------------------------
+
+// round(c * a / 255) without a division, exact for all 8-bit inputs
+inline uint8_t MultiplyAlpha(uint32_t c, uint32_t a)
+{
+    uint32_t t = c * a + 128;
+    return uint8_t((t + (t >> 8)) >> 8);
+}
+
+void ConvertPixelsScalar(uint8_t* p, size_t count, bool premultiply, bool swap_rb)
+{
+    for (size_t i = 0; i < count; ++i, p += 4)
+    {
+        if (premultiply)
+        {
+            uint32_t a = p[3];
+            p[0]       = MultiplyAlpha(p[0], a);
+            p[1]       = MultiplyAlpha(p[1], a);
+            p[2]       = MultiplyAlpha(p[2], a);
+        }
+        if (swap_rb)
+        {
+            std::swap(p[0], p[2]);
+        }
+    }
+}
+
+#ifdef KGE_IMAGE_CODEC_SSE2
+
+inline __m128i MultiplyAlpha8x16(__m128i c, __m128i a)
+{
+    const __m128i bias = _mm_set1_epi16(128);
+
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), bias);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+// Processes 4 pixels per iteration and leaves the remainder to the scalar path
+size_t ConvertPixelsSSE2(uint8_t* p, size_t count, bool premultiply, bool swap_rb)
+{
+    const __m128i zero       = _mm_setzero_si128();
+    const __m128i color_mask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alpha_one  = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4, p += 16)
+    {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+        if (premultiply)
+        {
+            __m128i lo = _mm_unpacklo_epi8(px, zero);
+            __m128i hi = _mm_unpackhi_epi8(px, zero);
+
+            // Broadcast each pixel's alpha to its color lanes and multiply alpha itself by 255
+            __m128i alo = _mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i ahi = _mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3));
+            alo         = _mm_shufflehi_epi16(alo, _MM_SHUFFLE(3, 3, 3, 3));
+            ahi         = _mm_shufflehi_epi16(ahi, _MM_SHUFFLE(3, 3, 3, 3));
+            alo         = _mm_or_si128(_mm_and_si128(alo, color_mask), alpha_one);
+            ahi         = _mm_or_si128(_mm_and_si128(ahi, color_mask), alpha_one);
+
+            px = _mm_packus_epi16(MultiplyAlpha8x16(lo, alo), MultiplyAlpha8x16(hi, ahi));
+        }
+
+        if (swap_rb)
+        {
+            const __m128i ga_mask = _mm_set1_epi32(int(0xFF00FF00));
+
+            __m128i ga = _mm_and_si128(px, ga_mask);
+            __m128i rb = _mm_andnot_si128(ga_mask, px);
+            rb         = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+            px         = _mm_or_si128(ga, rb);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), px);
+    }
+    return i;
+}
+
+#endif
+
+}  // namespace
+
+bool Decode(const uint8_t* data, size_t size, Image& image)
+{
+    image = Image();
+    if (!data || size == 0)
+        return false;
+
+    bool decoded = false;
+    try
+    {
+        if (size >= 8 && data[0] == 0x89 && data[1] == 'P')
+            decoded = DecodePng(data, size, image, image.has_alpha);
+        else if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+            decoded = DecodeJpeg(data, size, image, image.has_alpha);
+        else if (size >= 2 && data[0] == 'B' && data[1] == 'M')
+            decoded = DecodeBmp(data, size, image, image.has_alpha);
+    }
+    catch (std::bad_alloc&)
+    {
+        decoded = false;
+    }
+
+    if (!decoded)
+        image = Image();
+    return decoded;
+}
+
+void ConvertPixels(uint8_t* pixels, size_t count, bool premultiply, bool swap_rb)
+{
+    if (!premultiply && !swap_rb)
+        return;
+
+    size_t done = 0;
+#ifdef KGE_IMAGE_CODEC_SSE2
+    done = ConvertPixelsSSE2(pixels, count, premultiply, swap_rb);
+#endif
+    ConvertPixelsScalar(pixels + done * 4, count - done, premultiply, swap_rb);
+}
+
+}  // namespace image
+}  // namespace kiwano
@@ -0,0 +1,66 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ͼƬ㷨ֻ׼⣬ͲԹ
+
+namespace kiwano
+{
+namespace image
+{
+
+/// \~chinese
+/// @brief ͼƬ߳
+const uint32_t MaxDimension = 1 << 15;
+
+/// \~chinese
+/// @brief ͼƬռ 256MB ڴ
+const uint64_t MaxPixels = uint64_t(1) << 26;
+
+/// \~chinese
+/// @brief ͼδԤ˵ RGBA ذн
+struct Image
+{
+    uint32_t             width     = 0;
+    uint32_t             height    = 0;
+    bool                 has_alpha = false;
+    std::vector<uint8_t> pixels;
+};
+
+/// \~chinese
+/// @brief  PNGJPEGBMP ͼƬ
+/// @details ߴ糬ƵͼƬڷǰܾڴ治ʱͬ false
+/// @return 𻵡ʽֻ֧ڴ治ʱ false
+bool Decode(const uint8_t* data, size_t size, Image& image);
+
+/// \~chinese
+/// @brief δԤ˵ RGBA ԭת
+/// @param pixels 
+/// @param count 
+/// @param premultiply ǷԤ͸
+/// @param swap_rb Ƿ񽻻ɫɫͨ
+void ConvertPixels(uint8_t* pixels, size_t count, bool premultiply, bool swap_rb);
+
+}  // namespace image
+}  // namespace kiwano
@@ -0,0 +1,83 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/render/ImageDecoder.h>
+#include <kiwano/render/ImageCodec.h>
+#include <kiwano/platform/FileSystem.h>
+#include <kiwano/platform/MappedFile.h>
+#include <kiwano/utils/Logger.h>
+
+namespace kiwano
+{
+
+bool ImageDecoder::Decode(const BinaryData& data, ImageData& output, PixelFormat format)
+{
+    output = ImageData();
+    if (!data.IsValid())
+        return false;
+
+    image::Image decoded;
+    if (!image::Decode(static_cast<const uint8_t*>(data.buffer), data.size, decoded))
+        return false;
+
+    output.size = PixelSize(decoded.width, decoded.height);
+    output.pixels.swap(decoded.pixels);
+
+    // Premultiplying opaque pixels changes nothing
+    PixelFormat conversion = format;
+    if (!decoded.has_alpha)
+    {
+        if (format == PixelFormat::Bpp32PRGBA)
+            conversion = PixelFormat::Bpp32RGBA;
+        else if (format == PixelFormat::Bpp32PBGRA)
+            conversion = PixelFormat::Bpp32BGRA;
+    }
+
+    ConvertPixels(output.pixels.data(), size_t(output.size.x) * output.size.y, conversion);
+    output.format = format;
+    return true;
+}
+
+bool ImageDecoder::DecodeFile(StringView file_path, ImageData& output, PixelFormat format)
+{
+    BinaryData archived = FileSystem::GetInstance().GetArchivedFileData(file_path);
+    if (archived.IsValid())
+    {
+        return Decode(archived, output, format);
+    }
+
+    MappedFile file;
+    if (!file.Open(file_path))
+    {
+        KGE_WARNF("ImageDecoder: failed to open image file '%s'", String(file_path.data(), file_path.size()).c_str());
+        output = ImageData();
+        return false;
+    }
+    return Decode(file.GetBinaryData(), output, format);
+}
+
+void ImageDecoder::ConvertPixels(uint8_t* pixels, size_t count, PixelFormat format)
+{
+    const bool premultiply = format == PixelFormat::Bpp32PRGBA || format == PixelFormat::Bpp32PBGRA;
+    const bool swap_rb     = format == PixelFormat::Bpp32BGRA || format == PixelFormat::Bpp32PBGRA;
+    image::ConvertPixels(pixels, count, premultiply, swap_rb);
+}
+
+}  // namespace kiwano
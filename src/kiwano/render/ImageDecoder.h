@@ -0,0 +1,106 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/render/Texture.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Render
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ͼ
+ * @details ذнУÿ 4 ֽ
+ */
+struct KGE_API ImageData
+{
+    PixelSize       size;    ///< شС
+    PixelFormat     format;  ///< ظʽ
+    Vector<uint8_t> pixels;  ///< 
+
+    ImageData();
+
+    /// \~chinese
+    /// @brief ǷЧͼ
+    bool IsValid() const;
+
+    /// \~chinese
+    /// @brief ȡ
+    BinaryData GetData() const;
+};
+
+/**
+ * \~chinese
+ * @brief ͼƬ
+ * @details  CPU Ͻ PNGJPEGBMP ͼƬΪݣȾڹ߳еá
+ * ͨ Texture::Load(const ImageData&) ϴʽΪ Bpp32PBGRA ʱϴҪת
+ * ֵ֧ͼƬ罥ʽ JPEGGIFʧܣʱӦ Texture::Load ֱӼͼƬļ
+ */
+class KGE_API ImageDecoder
+{
+public:
+    /// \~chinese
+    /// @brief ڴеͼƬļ
+    /// @param data ͼƬļ
+    /// @param[out] output 
+    /// @param format ظʽ
+    /// @return Ƿɹ
+    static bool Decode(const BinaryData& data, ImageData& output, PixelFormat format = PixelFormat::Bpp32PBGRA);
+
+    /// \~chinese
+    /// @brief ͼƬļ
+    /// @details ͨ FileSystem ļ߳е·޸ͬʱ
+    /// @param file_path ͼƬļ·
+    /// @param[out] output 
+    /// @param format ظʽ
+    /// @return Ƿɹ
+    static bool DecodeFile(StringView file_path, ImageData& output, PixelFormat format = PixelFormat::Bpp32PBGRA);
+
+    /// \~chinese
+    /// @brief δԤ˵ RGBA ԭתΪָʽ
+    /// @param pixels 
+    /// @param count 
+    /// @param format Ŀظʽ
+    static void ConvertPixels(uint8_t* pixels, size_t count, PixelFormat format);
+};
+
+/** @} */
+
+inline ImageData::ImageData()
+    : format(PixelFormat::Bpp32RGBA)
+{
+}
+
+inline bool ImageData::IsValid() const
+{
+    return size.x > 0 && size.y > 0 && pixels.size() >= size_t(size.x) * size.y * 4;
+}
+
+inline BinaryData ImageData::GetData() const
+{
+    return BinaryData(const_cast<uint8_t*>(pixels.data()), uint32_t(pixels.size()));
+}
+
+}  // namespace kiwano
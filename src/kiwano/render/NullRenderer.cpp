@@ -0,0 +1,247 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/render/NullRenderer.h>
+
+namespace kiwano
+{
+
+NullRenderContext::NullRenderContext() {}
+
+void NullRenderContext::CreateTexture(Texture& texture, const PixelSize& size)
+{
+    // the pixel size stands in for a native bitmap, so that the texture counts as valid
+    texture.SetNative(size);
+    texture.SetSize(Size(float(size.x), float(size.y)));
+    texture.SetSizeInPixels(size);
+}
+
+void NullRenderContext::DrawTexture(const Texture& texture, const Rect* src_rect, const Rect* dest_rect)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::DrawSpriteBatch(const Texture& texture, const SpriteBatchItem* items, size_t count)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::DrawTextLayout(const TextLayout& layout, const Point& offset, RefPtr<Brush> outline_brush)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::DrawShape(const Shape& shape)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::DrawLine(const Point& point1, const Point& point2)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::DrawRectangle(const Rect& rect)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::DrawRoundedRectangle(const Rect& rect, const Vec2& radius)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::DrawEllipse(const Point& center, const Vec2& radius)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::FillShape(const Shape& shape)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::FillRectangle(const Rect& rect)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::FillRoundedRectangle(const Rect& rect, const Vec2& radius)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::FillEllipse(const Point& center, const Vec2& radius)
+{
+    IncreasePrimitivesCount();
+}
+
+void NullRenderContext::PushClipRect(const Rect& clip_rect) {}
+
+void NullRenderContext::PopClipRect() {}
+
+void NullRenderContext::PushLayer(Layer& layer) {}
+
+void NullRenderContext::PopLayer() {}
+
+void NullRenderContext::Clear() {}
+
+void NullRenderContext::Clear(const Color& clear_color) {}
+
+Size NullRenderContext::GetSize() const
+{
+    return visible_size_.GetSize();
+}
+
+void NullRenderContext::SetBlendMode(BlendMode blend)
+{
+    blend_mode_ = blend;
+}
+
+void NullRenderContext::SetAntialiasMode(bool enabled)
+{
+    antialias_ = enabled;
+}
+
+void NullRenderContext::SetTextAntialiasMode(TextAntialiasMode mode)
+{
+    text_antialias_ = mode;
+}
+
+bool NullRenderContext::CheckVisibility(const Rect& bounds, const Matrix3x2& transform)
+{
+    if (fast_global_transform_)
+    {
+        return visible_size_.Intersects(transform.Transform(bounds));
+    }
+    return visible_size_.Intersects(Matrix3x2(transform * global_transform_).Transform(bounds));
+}
+
+void NullRenderContext::Resize(const Size& size)
+{
+    visible_size_ = Rect(Point(), size);
+}
+
+Matrix3x2 NullRenderContext::GetTransform() const
+{
+    return transform_;
+}
+
+void NullRenderContext::SetTransform(const Matrix3x2& matrix)
+{
+    transform_ = matrix;
+}
+
+RefPtr<Texture> NullRenderContext::GetTarget() const
+{
+    return nullptr;
+}
+
+NullRenderer& NullRenderer::GetInstance()
+{
+    static NullRenderer instance;
+    return instance;
+}
+
+NullRenderer::NullRenderer()
+{
+    render_ctx_ = new NullRenderContext;
+}
+
+void NullRenderer::CreateTexture(Texture& texture, StringView file_path) {}
+
+void NullRenderer::CreateTexture(Texture& texture, const BinaryData& data) {}
+
+void NullRenderer::CreateTexture(Texture& texture, const PixelSize& size, const BinaryData& data, PixelFormat format)
+{
+    texture.SetNative(size);
+    texture.SetSize(Size(float(size.x), float(size.y)));
+    texture.SetSizeInPixels(size);
+}
+
+void NullRenderer::CreateGifImage(GifImage& gif, StringView file_path) {}
+
+void NullRenderer::CreateGifImage(GifImage& gif, const BinaryData& data) {}
+
+void NullRenderer::CreateGifImageFrame(GifImage::Frame& frame, const GifImage& gif, size_t frame_index) {}
+
+void NullRenderer::CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
+                                        const Vector<String>& file_paths)
+{
+}
+
+void NullRenderer::CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
+                                        const Vector<BinaryData>& datas)
+{
+}
+
+void NullRenderer::CreateTextLayout(TextLayout& layout, StringView content, const TextStyle& style) {}
+
+void NullRenderer::CreateLineShape(Shape& shape, const Point& begin_pos, const Point& end_pos) {}
+
+void NullRenderer::CreateRectShape(Shape& shape, const Rect& rect) {}
+
+void NullRenderer::CreateRoundedRectShape(Shape& shape, const Rect& rect, const Vec2& radius) {}
+
+void NullRenderer::CreateEllipseShape(Shape& shape, const Point& center, const Vec2& radius) {}
+
+void NullRenderer::CreateShapeSink(ShapeMaker& maker) {}
+
+void NullRenderer::CreateBrush(Brush& brush, const Color& color) {}
+
+void NullRenderer::CreateBrush(Brush& brush, const LinearGradientStyle& style) {}
+
+void NullRenderer::CreateBrush(Brush& brush, const RadialGradientStyle& style) {}
+
+void NullRenderer::CreateBrush(Brush& brush, RefPtr<Texture> texture) {}
+
+void NullRenderer::CreateStrokeStyle(StrokeStyle& stroke_style) {}
+
+RefPtr<RenderContext> NullRenderer::CreateTextureRenderContext(RefPtr<Texture> texture, const PixelSize& desired_size)
+{
+    RefPtr<RenderContext> ctx = new NullRenderContext;
+    if (texture)
+    {
+        ctx->CreateTexture(*texture, desired_size);
+    }
+    ctx->Resize(Size(float(desired_size.x), float(desired_size.y)));
+    return ctx;
+}
+
+void NullRenderer::Clear() {}
+
+void NullRenderer::Present() {}
+
+void NullRenderer::Resize(uint32_t width, uint32_t height)
+{
+    output_size_.x = static_cast<float>(width);
+    output_size_.y = static_cast<float>(height);
+    render_ctx_->Resize(output_size_);
+}
+
+void NullRenderer::MakeContextForWindow(RefPtr<Window> window)
+{
+    if (window)
+    {
+        Resize(window->GetWidth(), window->GetHeight());
+    }
+}
+
+}  // namespace kiwano
@@ -0,0 +1,165 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/render/Renderer.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Render
+ * @{
+ */
+
+/// \~chinese
+/// @brief Ⱦ
+/// @details κλ¼任С޴
+class KGE_API NullRenderContext : public RenderContext
+{
+public:
+    NullRenderContext();
+
+    void CreateTexture(Texture& texture, const PixelSize& size) override;
+
+    void DrawTexture(const Texture& texture, const Rect* src_rect, const Rect* dest_rect) override;
+
+    void DrawSpriteBatch(const Texture& texture, const SpriteBatchItem* items, size_t count) override;
+
+    void DrawTextLayout(const TextLayout& layout, const Point& offset, RefPtr<Brush> outline_brush) override;
+
+    void DrawShape(const Shape& shape) override;
+
+    void DrawLine(const Point& point1, const Point& point2) override;
+
+    void DrawRectangle(const Rect& rect) override;
+
+    void DrawRoundedRectangle(const Rect& rect, const Vec2& radius) override;
+
+    void DrawEllipse(const Point& center, const Vec2& radius) override;
+
+    void FillShape(const Shape& shape) override;
+
+    void FillRectangle(const Rect& rect) override;
+
+    void FillRoundedRectangle(const Rect& rect, const Vec2& radius) override;
+
+    void FillEllipse(const Point& center, const Vec2& radius) override;
+
+    void PushClipRect(const Rect& clip_rect) override;
+
+    void PopClipRect() override;
+
+    void PushLayer(Layer& layer) override;
+
+    void PopLayer() override;
+
+    void Clear() override;
+
+    void Clear(const Color& clear_color) override;
+
+    Size GetSize() const override;
+
+    void SetBlendMode(BlendMode blend) override;
+
+    void SetAntialiasMode(bool enabled) override;
+
+    void SetTextAntialiasMode(TextAntialiasMode mode) override;
+
+    bool CheckVisibility(const Rect& bounds, const Matrix3x2& transform) override;
+
+    void Resize(const Size& size) override;
+
+    Matrix3x2 GetTransform() const override;
+
+    void SetTransform(const Matrix3x2& matrix) override;
+
+    RefPtr<Texture> GetTarget() const override;
+
+private:
+    Matrix3x2 transform_;
+};
+
+/// \~chinese
+/// @brief Ⱦ
+/// @details ںͼ豸ͼԴΪЧԴƲκڷģܲ
+class KGE_API NullRenderer : public Renderer
+{
+public:
+    static NullRenderer& GetInstance();
+
+    void CreateTexture(Texture& texture, StringView file_path) override;
+
+    void CreateTexture(Texture& texture, const BinaryData& data) override;
+
+    void CreateTexture(Texture& texture, const PixelSize& size, const BinaryData& data, PixelFormat format) override;
+
+    void CreateGifImage(GifImage& gif, StringView file_path) override;
+
+    void CreateGifImage(GifImage& gif, const BinaryData& data) override;
+
+    void CreateGifImageFrame(GifImage::Frame& frame, const GifImage& gif, size_t frame_index) override;
+
+    void CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
+                              const Vector<String>& file_paths) override;
+
+    void CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
+                              const Vector<BinaryData>& datas) override;
+
+    void CreateTextLayout(TextLayout& layout, StringView content, const TextStyle& style) override;
+
+    void CreateLineShape(Shape& shape, const Point& begin_pos, const Point& end_pos) override;
+
+    void CreateRectShape(Shape& shape, const Rect& rect) override;
+
+    void CreateRoundedRectShape(Shape& shape, const Rect& rect, const Vec2& radius) override;
+
+    void CreateEllipseShape(Shape& shape, const Point& center, const Vec2& radius) override;
+
+    void CreateShapeSink(ShapeMaker& maker) override;
+
+    void CreateBrush(Brush& brush, const Color& color) override;
+
+    void CreateBrush(Brush& brush, const LinearGradientStyle& style) override;
+
+    void CreateBrush(Brush& brush, const RadialGradientStyle& style) override;
+
+    void CreateBrush(Brush& brush, RefPtr<Texture> texture) override;
+
+    void CreateStrokeStyle(StrokeStyle& stroke_style) override;
+
+    RefPtr<RenderContext> CreateTextureRenderContext(RefPtr<Texture> texture, const PixelSize& desired_size) override;
+
+public:
+    void Clear() override;
+
+    void Present() override;
+
+    void Resize(uint32_t width, uint32_t height) override;
+
+    void MakeContextForWindow(RefPtr<Window> window) override;
+
+protected:
+    NullRenderer();
+};
+
+/** @} */
+
+}  // namespace kiwano
@@ -33,6 +33,7 @@ RenderContext::RenderContext()
     : collecting_status_(false)
     , fast_global_transform_(true)
     , brush_opacity_(1.0f)
+    , blend_mode_(BlendMode::SourceOver)
     , antialias_(true)
     , text_antialias_(TextAntialiasMode::GrayScale)
 {
@@ -42,8 +43,10 @@ void RenderContext::BeginDraw()
 {
     if (collecting_status_)
     {
-        status_.start      = Time::Now();
-        status_.primitives = 0;
+        status_.start        = Time::Now();
+        status_.primitives   = 0;
+        status_.cache_hits   = 0;
+        status_.cache_misses = 0;
     }
 }
 
@@ -68,6 +71,17 @@ void RenderContext::IncreasePrimitivesCount(uint32_t increase) const
     }
 }
 
+void RenderContext::IncreaseBitmapCacheCount(bool hit) const
+{
+    if (collecting_status_)
+    {
+        if (hit)
+            ++status_.cache_hits;
+        else
+            ++status_.cache_misses;
+    }
+}
+
 float RenderContext::GetBrushOpacity() const
 {
     return brush_opacity_;
@@ -78,11 +92,22 @@ RefPtr<Brush> RenderContext::GetCurrentBrush() const
     return current_brush_;
 }
 
+BlendMode RenderContext::GetBlendMode() const
+{
+    return blend_mode_;
+}
+
 const Matrix3x2& RenderContext::GetGlobalTransform() const
 {
     return global_transform_;
 }
 
+void RenderContext::SetGlobalTransform(const Matrix3x2& matrix)
+{
+    global_transform_      = matrix;
+    fast_global_transform_ = matrix.IsIdentity();
+}
+
 void RenderContext::SetBrushOpacity(float opacity)
 {
     brush_opacity_ = opacity;
@@ -98,6 +123,24 @@ void RenderContext::SetCurrentStrokeStyle(RefPtr<StrokeStyle> stroke)
     current_stroke_ = stroke;
 }
 
+bool RenderContext::CheckWorldVisibility(const Rect& world_bounds) const
+{
+    if (fast_global_transform_)
+    {
+        return visible_size_.Intersects(world_bounds);
+    }
+    return visible_size_.Intersects(global_transform_.Transform(world_bounds));
+}
+
+void RenderContext::DrawSpriteBatch(const Texture& texture, const SpriteBatchItem* items, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        this->SetTransform(items[i].transform);
+        this->DrawTexture(texture, &items[i].src_rect, &items[i].dest_rect);
+    }
+}
+
 void RenderContext::DrawCircle(const Point& center, float radius)
 {
     this->DrawEllipse(center, Vec2(radius, radius));
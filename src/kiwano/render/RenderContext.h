@@ -55,6 +55,16 @@ enum class BlendMode
     Max        = 4,
 };
 
+/// \~chinese
+/// @brief еĵ
+/// @details ͬһеľ鹲ģʽ͸
+struct SpriteBatchItem
+{
+    Rect      src_rect;   ///< Դü
+    Rect      dest_rect;  ///< ƵĿ
+    Matrix3x2 transform;  ///< ά任
+};
+
 /// \~chinese
 /// @brief Ⱦ
 /// @details ȾĽɻͼԪĻƣƽضƽ
@@ -96,6 +106,14 @@ public:
     /// @param outline_brush ߻ˢ
     virtual void DrawTextLayout(const TextLayout& layout, const Point& offset, RefPtr<Brush> outline_brush) = 0;
 
+    /// \~chinese
+    /// @brief ƹͬһľ
+    /// @param texture 
+    /// @param items 
+    /// @param count 
+    /// @details Ĭʵƾ飬úǰά任δ
+    virtual void DrawSpriteBatch(const Texture& texture, const SpriteBatchItem* items, size_t count);
+
     /// \~chinese
     /// @brief ״
     /// @param shape ״
@@ -197,6 +215,10 @@ public:
     /// @brief ȡǰˢ
     virtual RefPtr<Brush> GetCurrentBrush() const;
 
+    /// \~chinese
+    /// @brief ȡģʽ
+    BlendMode GetBlendMode() const;
+
     /// \~chinese
     /// @brief ȡȫֶά任
     virtual const Matrix3x2& GetGlobalTransform() const;
@@ -213,6 +235,11 @@ public:
     /// @brief õǰʹõʽ
     virtual void SetCurrentStrokeStyle(RefPtr<StrokeStyle> stroke);
 
+    /// \~chinese
+    /// @brief ȫֶά任
+    /// @details ȫֶά任Ӧ֮õжά任֮Ҳʹñ任Ľ
+    void SetGlobalTransform(const Matrix3x2& matrix);
+
     /// \~chinese
     /// @brief ûģʽ
     virtual void SetBlendMode(BlendMode blend) = 0;
@@ -229,6 +256,10 @@ public:
     /// @brief ߽Ƿ
     virtual bool CheckVisibility(const Rect& bounds, const Matrix3x2& transform) = 0;
 
+    /// \~chinese
+    /// @brief ϵµı߽Ƿ
+    bool CheckWorldVisibility(const Rect& world_bounds) const;
+
     /// \~chinese
     /// @brief ȾĴС
     virtual void Resize(const Size& size) = 0;
@@ -250,9 +281,11 @@ public:
     /// @brief Ⱦ״̬
     struct Status
     {
-        uint32_t primitives;  ///< ȾͼԪ
-        Time     start;       ///< Ⱦʼʱ
-        Duration duration;    ///< Ⱦʱ
+        uint32_t primitives;    ///< ȾͼԪ
+        uint32_t cache_hits;    ///< λͼд
+        uint32_t cache_misses;  ///< λͼδд
+        Time     start;         ///< Ⱦʼʱ
+        Duration duration;      ///< Ⱦʱ
 
         Status();
     };
@@ -265,6 +298,11 @@ public:
     /// @brief ȡȾ״̬
     const Status& GetStatus() const;
 
+    /// \~chinese
+    /// @brief ¼һλͼʹ
+    /// @param hit Ƿ
+    void IncreaseBitmapCacheCount(bool hit) const;
+
 protected:
     RenderContext();
 
@@ -277,6 +315,7 @@ protected:
     bool                fast_global_transform_;
     mutable bool        collecting_status_;
     float               brush_opacity_;
+    BlendMode           blend_mode_;
     TextAntialiasMode   text_antialias_;
     RefPtr<Brush>       current_brush_;
     RefPtr<StrokeStyle> current_stroke_;
@@ -289,6 +328,8 @@ protected:
 
 inline RenderContext::Status::Status()
     : primitives(0)
+    , cache_hits(0)
+    , cache_misses(0)
 {
 }
 
@@ -24,6 +24,13 @@
 namespace kiwano
 {
 
+Renderer* Renderer::instance_ = nullptr;
+
+void Renderer::SetInstance(Renderer* renderer)
+{
+    instance_ = renderer;
+}
+
 Renderer::Renderer()
     : vsync_(true)
     , auto_reset_resolution_(true)
@@ -50,6 +50,11 @@ public:
     /// @brief ȡʵ
     static Renderer& GetInstance();
 
+    /// \~chinese
+    /// @brief 滻Ⱦʵ
+    /// @details ӦóʼǰãָʱָΪƽ̨ĬȾ
+    static void SetInstance(Renderer* renderer);
+
     /// \~chinese
     /// @brief ȡɫ
     virtual Color GetClearColor() const;
@@ -246,6 +251,9 @@ protected:
     Color                 clear_color_;
     Size                  output_size_;
     RefPtr<RenderContext> render_ctx_;
+
+private:
+    static Renderer* instance_;
 };
 
 /** @} */
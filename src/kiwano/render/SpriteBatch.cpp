@@ -0,0 +1,156 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/render/SpriteBatch.h>
+#include <algorithm>
+
+namespace kiwano
+{
+
+SpriteBatch::SpriteBatch()
+    : sorting_enabled_(false)
+    , groups_dirty_(false)
+    , submission_count_(0)
+    , submitted_sprite_count_(0)
+{
+}
+
+void SpriteBatch::Add(const Texture& texture, const Rect& src_rect, const Rect& dest_rect, const Matrix3x2& transform,
+                      float opacity, BlendMode blend)
+{
+    if (!texture.IsValid() || opacity <= 0.0f)
+        return;
+
+    Entry entry;
+    entry.texture        = &texture;
+    entry.blend          = blend;
+    entry.opacity        = opacity;
+    entry.item.src_rect  = src_rect;
+    entry.item.dest_rect = dest_rect;
+    entry.item.transform = transform;
+    entries_.push_back(entry);
+
+    groups_dirty_ = true;
+}
+
+const Vector<SpriteBatchGroup>& SpriteBatch::BuildGroups()
+{
+    if (!groups_dirty_)
+        return groups_;
+
+    groups_dirty_ = false;
+    groups_.clear();
+    items_.clear();
+
+    if (entries_.empty())
+        return groups_;
+
+    if (sorting_enabled_)
+    {
+        // order textures by their first appearance so the result does not depend on addresses,
+        // and bucket the entries by texture, which keeps their order within each texture
+        UnorderedMap<const Texture*, size_t> texture_order;
+
+        Vector<size_t> orders;
+        orders.reserve(entries_.size());
+        for (const auto& entry : entries_)
+        {
+            orders.push_back(texture_order.insert(std::make_pair(entry.texture, texture_order.size())).first->second);
+        }
+
+        Vector<size_t> offsets(texture_order.size() + 1, 0);
+        for (size_t order : orders)
+        {
+            ++offsets[order + 1];
+        }
+        for (size_t i = 1; i < offsets.size(); ++i)
+        {
+            offsets[i] += offsets[i - 1];
+        }
+
+        sorted_entries_.resize(entries_.size());
+        for (size_t i = 0; i < entries_.size(); ++i)
+        {
+            sorted_entries_[offsets[orders[i]]++] = entries_[i];
+        }
+        entries_.swap(sorted_entries_);
+    }
+
+    items_.reserve(entries_.size());
+    for (const auto& entry : entries_)
+    {
+        if (groups_.empty() || groups_.back().texture != entry.texture || groups_.back().blend != entry.blend
+            || groups_.back().opacity != entry.opacity)
+        {
+            SpriteBatchGroup group;
+            group.texture = entry.texture;
+            group.blend   = entry.blend;
+            group.opacity = entry.opacity;
+            group.first   = items_.size();
+            group.count   = 0;
+            groups_.push_back(group);
+        }
+
+        items_.push_back(entry.item);
+        ++groups_.back().count;
+    }
+    return groups_;
+}
+
+void SpriteBatch::Flush(RenderContext& ctx)
+{
+    if (entries_.empty())
+        return;
+
+    BuildGroups();
+
+    // The batch leaves the state of the context as it was
+    float     saved_opacity = ctx.GetBrushOpacity();
+    BlendMode saved_blend   = ctx.GetBlendMode();
+    for (const auto& group : groups_)
+    {
+        ctx.SetBrushOpacity(group.opacity);
+        ctx.SetBlendMode(group.blend);
+        ctx.DrawSpriteBatch(*group.texture, &items_[group.first], group.count);
+
+        ++submission_count_;
+        submitted_sprite_count_ += uint32_t(group.count);
+    }
+    ctx.SetBlendMode(saved_blend);
+    ctx.SetBrushOpacity(saved_opacity);
+
+    Clear();
+}
+
+void SpriteBatch::Clear()
+{
+    entries_.clear();
+    items_.clear();
+    groups_.clear();
+    groups_dirty_ = false;
+}
+
+void SpriteBatch::ResetStats()
+{
+    submission_count_       = 0;
+    submitted_sprite_count_ = 0;
+}
+
+}  // namespace kiwano
@@ -0,0 +1,173 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/render/RenderContext.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Render
+ * @{
+ */
+
+/// \~chinese
+/// @brief η
+/// @details ڵľţģʽ͸ȣһύȾ
+struct SpriteBatchGroup
+{
+    const Texture* texture;  ///< 
+    BlendMode      blend;    ///< ģʽ
+    float          opacity;  ///< ͸
+    size_t         first;    ///< һ
+    size_t         count;    ///< 
+};
+
+/**
+ * \~chinese
+ * @brief 
+ * @details ռһ֡ڵľ󣬽ģʽ͸ȶͬϲΪһύ
+ * ָֻ룬ύǰ÷Ҫ֤Ч
+ */
+class KGE_API SpriteBatch : Noncopyable
+{
+public:
+    SpriteBatch();
+
+    /// \~chinese
+    /// @brief ûð
+    /// @details úڷǰ״γֵ˳ȶʹòͬһصľ˳ܸı
+    void SetSortingEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿ˰
+    bool IsSortingEnabled() const;
+
+    /// \~chinese
+    /// @brief Ӿ
+    /// @param texture 
+    /// @param src_rect Դü
+    /// @param dest_rect ƵĿ
+    /// @param transform ά任
+    /// @param opacity ͸
+    /// @param blend ģʽ
+    void Add(const Texture& texture, const Rect& src_rect, const Rect& dest_rect, const Matrix3x2& transform,
+             float opacity = 1.0f, BlendMode blend = BlendMode::SourceOver);
+
+    /// \~chinese
+    /// @brief ȡȴύľ
+    size_t GetSpriteCount() const;
+
+    /// \~chinese
+    /// @brief Ƿûеȴύľ
+    bool IsEmpty() const;
+
+    /// \~chinese
+    /// @brief ɷ
+    /// @details  GetItems صľ飬һ Add  Clear ǰЧ
+    const Vector<SpriteBatchGroup>& BuildGroups();
+
+    /// \~chinese
+    /// @brief ȡľ
+    const Vector<SpriteBatchItem>& GetItems() const;
+
+    /// \~chinese
+    /// @brief 鲢ύо飬Ȼ
+    /// @details ύȾĵĻģʽָΪ BlendMode::SourceOverά任δ
+    void Flush(RenderContext& ctx);
+
+    /// \~chinese
+    /// @brief յȴύľ
+    void Clear();
+
+    /// \~chinese
+    /// @brief ȡύ
+    uint32_t GetSubmissionCount() const;
+
+    /// \~chinese
+    /// @brief ȡύľ
+    uint32_t GetSubmittedSpriteCount() const;
+
+    /// \~chinese
+    /// @brief ύͳ
+    void ResetStats();
+
+private:
+    struct Entry
+    {
+        const Texture*  texture;
+        BlendMode       blend;
+        float           opacity;
+        SpriteBatchItem item;
+    };
+
+    bool                     sorting_enabled_;
+    bool                     groups_dirty_;
+    uint32_t                 submission_count_;
+    uint32_t                 submitted_sprite_count_;
+    Vector<Entry>            entries_;
+    Vector<Entry>            sorted_entries_;
+    Vector<SpriteBatchItem>  items_;
+    Vector<SpriteBatchGroup> groups_;
+};
+
+/** @} */
+
+inline void SpriteBatch::SetSortingEnabled(bool enabled)
+{
+    if (sorting_enabled_ != enabled)
+    {
+        sorting_enabled_ = enabled;
+        groups_dirty_    = true;
+    }
+}
+
+inline bool SpriteBatch::IsSortingEnabled() const
+{
+    return sorting_enabled_;
+}
+
+inline size_t SpriteBatch::GetSpriteCount() const
+{
+    return entries_.size();
+}
+
+inline bool SpriteBatch::IsEmpty() const
+{
+    return entries_.empty();
+}
+
+inline const Vector<SpriteBatchItem>& SpriteBatch::GetItems() const
+{
+    return items_;
+}
+
+inline uint32_t SpriteBatch::GetSubmissionCount() const
+{
+    return submission_count_;
+}
+
+inline uint32_t SpriteBatch::GetSubmittedSpriteCount() const
+{
+    return submitted_sprite_count_;
+}
+
+}  // namespace kiwano
@@ -20,6 +20,7 @@
 
 #include <kiwano/render/Renderer.h>
 #include <kiwano/render/Texture.h>
+#include <kiwano/render/ImageDecoder.h>
 #include <functional>  // std::hash
 
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
@@ -58,15 +59,39 @@ Texture::~Texture() {}
 
 bool Texture::Load(StringView file_path)
 {
-    ResetNative();
-    Renderer::GetInstance().CreateTexture(*this, file_path);
+    // Images the decoder does not support are loaded by the renderer
+    ImageData image;
+    if (!ImageDecoder::DecodeFile(file_path, image) || !Load(image))
+    {
+        ResetNative();
+        ClearStatus();
+        Renderer::GetInstance().CreateTexture(*this, file_path);
+    }
+
+    // the path is the key of the texture in saved scenes
+    if (GetName().empty())
+        SetName(file_path);
     return IsValid();
 }
 
 bool Texture::Load(const Resource& res)
+{
+    BinaryData data = res.GetData();
+
+    ImageData image;
+    if (data.IsValid() && ImageDecoder::Decode(data, image) && Load(image))
+        return true;
+
+    ResetNative();
+    ClearStatus();
+    Renderer::GetInstance().CreateTexture(*this, data);
+    return IsValid();
+}
+
+bool Texture::Load(const BinaryData& data)
 {
     ResetNative();
-    Renderer::GetInstance().CreateTexture(*this, res.GetData());
+    Renderer::GetInstance().CreateTexture(*this, data);
     return IsValid();
 }
 
@@ -77,6 +102,16 @@ bool Texture::Load(const PixelSize& size, const BinaryData& data, PixelFormat fo
     return IsValid();
 }
 
+bool Texture::Load(const ImageData& image)
+{
+    if (!image.IsValid())
+    {
+        ResetNative();
+        return false;
+    }
+    return Load(image.size, image.GetData(), image.format);
+}
+
 void Texture::CopyFrom(RefPtr<Texture> copy_from)
 {
 #if KGE_RENDER_ENGINE == KGE_RENDER_ENGINE_DIRECTX
@@ -52,10 +52,14 @@ typedef math::Vec2T<uint32_t> PixelSize;
  */
 enum class PixelFormat
 {
-    Bpp32RGBA,
-    Bpp32BGRA,
+    Bpp32RGBA,   ///< δԤ alpha  RGBA
+    Bpp32BGRA,   ///< δԤ alpha  BGRA
+    Bpp32PRGBA,  ///< Ԥ alpha  RGBA
+    Bpp32PBGRA,  ///< Ԥ alpha  BGRAȾڲʽͬʱҪת
 };
 
+struct ImageData;
+
 /**
  * \~chinese
  * @brief 
@@ -81,16 +85,27 @@ public:
 
     /// \~chinese
     /// @brief رļ
+    /// @details ʹ ImageDecoder 룬ֵ֧ĸʽȾ
     bool Load(StringView file_path);
 
     /// \~chinese
     /// @brief Դ
+    /// @details ʹ ImageDecoder 룬ֵ֧ĸʽȾ
     bool Load(const Resource& res);
 
+    /// \~chinese
+    /// @brief ڴеͼƬļݼ
+    bool Load(const BinaryData& data);
+
     /// \~chinese
     /// @brief ڴλͼ
     bool Load(const PixelSize& size, const BinaryData& data, PixelFormat format);
 
+    /// \~chinese
+    /// @brief ѽͼ
+    /// @see ImageDecoder
+    bool Load(const ImageData& image);
+
     /// \~chinese
     /// @brief ȡ
     float GetWidth() const;
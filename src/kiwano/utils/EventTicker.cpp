@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <kiwano/utils/EventTicker.h>
+#include <kiwano/event/EventPool.h>
 
 namespace kiwano
 {
@@ -40,7 +41,7 @@ bool EventTicker::Tick(Duration dt)
 {
     if (Ticker::Tick(dt))
     {
-        RefPtr<TickEvent> evt = new TickEvent;
+        RefPtr<TickEvent> evt = EventPool<TickEvent>::Acquire();
         evt->delta_time_      = GetDeltaTime();
         evt->ticker_          = this;
         DispatchEvent(evt.Get());
@@ -22,6 +22,8 @@
 #include <ios>
 #include <fstream>
 #include <iostream>
+#include <cstdarg>  // va_copy
+#include <chrono>   // std::chrono::steady_clock
 #include <kiwano/utils/Logger.h>
 
 namespace kiwano
@@ -136,6 +138,7 @@ public:
 //
 LogProvider::LogProvider()
     : level_(LogLevel::Debug)
+    , auto_flush_(true)
 {
 }
 
@@ -158,6 +161,11 @@ void LogProvider::SetLevel(LogLevel level)
     level_ = level;
 }
 
+void LogProvider::SetAutoFlush(bool auto_flush)
+{
+    auto_flush_ = auto_flush;
+}
+
 #if defined(KGE_PLATFORM_WINDOWS)
 void SetWindowConsoleColor(std::ostream& os, int foreground, int background)
 {
@@ -269,9 +277,16 @@ void ConsoleLogProvider::Init() {}
 void ConsoleLogProvider::WriteMessage(LogLevel level, const char* msg)
 {
     if (level != LogLevel::Error)
-        std::cout << GetColor(level) << msg << std::flush << ConsoleColorBrush<-1>;
+    {
+        std::cout << GetColor(level) << msg;
+        if (auto_flush_)
+            std::cout << std::flush;
+        std::cout << ConsoleColorBrush<-1>;
+    }
     else
+    {
         std::cerr << GetColor(level) << msg << ConsoleColorBrush<-1>;
+    }
 
 #if defined(KGE_PLATFORM_WINDOWS)
     ::OutputDebugStringA(msg);
@@ -316,7 +331,9 @@ void FileLogProvider::WriteMessage(LogLevel level, const char* msg)
 {
     if (ofs_)
     {
-        ofs_ << msg << std::flush;
+        ofs_ << msg;
+        if (auto_flush_)
+            ofs_ << std::flush;
     }
 }
 
@@ -542,6 +559,200 @@ LogBuffer::pos_type LogBuffer::seekoff(off_type offset, std::ios_base::seekdir w
     return pos_type(offset);
 }
 
+//
+// LogRing
+//
+
+/// \~chinese
+/// @brief ̵߳첽־λ
+/// @details ߵߣ¼Ϊ¼ͷ '\0' βϢģ¼ͷС롣
+/// ĩβŲһ¼ʱд¼
+class LogRing : Noncopyable
+{
+public:
+    struct Header
+    {
+        uint32_t  size;  // ļ¼С
+        uint32_t  level;
+        ClockTime time;
+        int64_t   ticks;  // ʱӵļڲ֮ͬ߳򣬲ϵͳʱӰ
+    };
+
+    static const uint32_t PaddingLevel = uint32_t(-1);
+
+    LogRing(size_t capacity)
+        : buffer_(capacity)
+        , head_(0)
+        , tail_(0)
+        , dropped_(0)
+        , released_(false)
+    {
+    }
+
+    static int64_t GetTicks()
+    {
+        return int64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    size_t GetMaxMessageSize() const
+    {
+        return buffer_.size() / 2 - sizeof(Header) - 1;
+    }
+
+    bool TryPush(LogLevel level, ClockTime time, int64_t ticks, const char* msg, size_t size)
+    {
+        const size_t   record_size = AlignSize(sizeof(Header) + size + 1);
+        const uint64_t write       = head_.load(std::memory_order_relaxed);
+        const uint64_t read        = tail_.load(std::memory_order_acquire);
+        const size_t   offset      = size_t(write % buffer_.size());
+        const size_t   contiguous  = buffer_.size() - offset;
+        const size_t   padding     = (contiguous < record_size) ? contiguous : 0;
+        if (buffer_.size() - size_t(write - read) < record_size + padding)
+            return false;
+
+        if (padding)
+        {
+            const Header header = { uint32_t(padding), PaddingLevel, time, ticks };
+            std::memcpy(&buffer_[offset], &header, sizeof(header));
+        }
+
+        const Header header = { uint32_t(record_size), uint32_t(level), time, ticks };
+        char*        dest   = &buffer_[size_t((write + padding) % buffer_.size())];
+        std::memcpy(dest, &header, sizeof(header));
+        std::memcpy(dest + sizeof(header), msg, size);
+        dest[sizeof(header) + size] = '\0';
+
+        head_.store(write + padding + record_size, std::memory_order_release);
+        return true;
+    }
+
+    void Drain(Vector<char>& records, Vector<size_t>& offsets)
+    {
+        uint64_t       read  = tail_.load(std::memory_order_relaxed);
+        const uint64_t write = head_.load(std::memory_order_acquire);
+        while (read != write)
+        {
+            const char* src = &buffer_[size_t(read % buffer_.size())];
+
+            Header header;
+            std::memcpy(&header, src, sizeof(header));
+            if (header.level != PaddingLevel)
+            {
+                offsets.push_back(records.size());
+                records.insert(records.end(), src, src + header.size);
+            }
+            read += header.size;
+        }
+        tail_.store(read, std::memory_order_release);
+    }
+
+    void IncreaseDropCount()
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t TakeDropCount()
+    {
+        return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+    // ߳˳󲻻д
+    void Release()
+    {
+        released_.store(true, std::memory_order_release);
+    }
+
+    bool IsReleased() const
+    {
+        return released_.load(std::memory_order_acquire);
+    }
+
+    static size_t AlignSize(size_t size)
+    {
+        return (size + sizeof(Header) - 1) / sizeof(Header) * sizeof(Header);
+    }
+
+    static void AppendRecord(Vector<char>& records, Vector<size_t>& offsets, LogLevel level, ClockTime time,
+                             const String& msg)
+    {
+        const Header header = { uint32_t(AlignSize(sizeof(Header) + msg.size() + 1)), uint32_t(level), time,
+                                GetTicks() };
+        const size_t offset = records.size();
+        offsets.push_back(offset);
+        records.resize(offset + header.size);
+        std::memcpy(&records[offset], &header, sizeof(header));
+        std::memcpy(&records[offset + sizeof(header)], msg.c_str(), msg.size() + 1);
+    }
+
+private:
+    Vector<char> buffer_;
+
+    // ߺ߸дļڲͬĻ
+    std::atomic<uint64_t> head_;
+    char                  head_padding_[64 - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> tail_;
+    char                  tail_padding_[64 - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> dropped_;
+    std::atomic<bool>     released_;
+};
+
+namespace
+{
+
+struct AsyncLogStream
+{
+    LogBuffer    buffer;
+    std::ostream stream;
+
+    AsyncLogStream()
+        : buffer(1024)
+        , stream(&buffer)
+    {
+    }
+};
+
+// ߳˳ʱͷŻλ־߳дʣ־աͬл־¼߳ʱҲǰȫ
+struct ThreadRing
+{
+    std::shared_ptr<LogRing> ring;
+
+    ~ThreadRing()
+    {
+        if (ring)
+            ring->Release();
+    }
+};
+
+thread_local ThreadRing     thread_ring;
+thread_local AsyncLogStream async_stream;
+thread_local Vector<char>   async_text;
+thread_local bool           is_async_thread = false;
+
+// ʽϢģͬģʽһԿոͷ
+size_t FormatAsyncText(Vector<char>& text, const char* format, va_list args)
+{
+    if (text.size() < 256)
+        text.resize(256);
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    const int len = std::vsnprintf(&text[1], text.size() - 1, format, args_copy);
+    va_end(args_copy);
+
+    if (len < 0)
+        return 0;
+
+    if (size_t(len) + 2 > text.size())
+    {
+        text.resize(size_t(len) + 2);
+        std::vsnprintf(&text[1], text.size() - 1, format, args);
+    }
+    text[0] = ' ';
+    return size_t(len) + 1;
+}
+
+}  // namespace
+
 //
 // Logger
 //
@@ -550,6 +761,15 @@ Logger::Logger()
     , level_(LogLevel::Debug)
     , buffer_(1024)
     , stream_(&buffer_)
+    , async_(false)
+    , async_wake_(false)
+    , async_producers_(0)
+    , async_disabling_(false)
+    , overflow_policy_(LogOverflowPolicy::Block)
+    , ring_size_(64 * 1024)
+    , async_stopping_(false)
+    , flush_requested_(0)
+    , flush_done_(0)
 {
     RefPtr<LogFormater> formater = MakePtr<TextFormater>();
     SetFormater(formater);
@@ -558,7 +778,7 @@ Logger::Logger()
     AddProvider(provider);
 }
 
-std::iostream& Logger::GetFormatedStream(LogLevel level, LogBuffer* buffer)
+std::iostream& Logger::GetFormatedStream(LogLevel level, LogBuffer* buffer, ClockTime time)
 {
     // reset buffer
     buffer->Reset();
@@ -568,12 +788,15 @@ std::iostream& Logger::GetFormatedStream(LogLevel level, LogBuffer* buffer)
 
     if (formater_)
     {
-        formater_->FormatHeader(stream_, level, ClockTime::Now());
+        formater_->FormatHeader(stream_, level, time);
     }
     return stream_;
 }
 
-Logger::~Logger() {}
+Logger::~Logger()
+{
+    DisableAsync();
+}
 
 void Logger::Logf(LogLevel level, const char* format, ...)
 {
@@ -583,13 +806,25 @@ void Logger::Logf(LogLevel level, const char* format, ...)
     if (level < level_)
         return;
 
+    if (IsAsync())
+    {
+        va_list args = nullptr;
+        va_start(args, format);
+        const size_t size = FormatAsyncText(async_text, format, args);
+        va_end(args);
+
+        PushAsync(level, async_text.data(), size);
+        return;
+    }
+
+    WaitForAsyncDisabled();
     std::lock_guard<std::mutex> lock(mutex_);
 
     va_list args = nullptr;
     va_start(args, format);
 
     // build message
-    auto& stream = this->GetFormatedStream(level, &buffer_);
+    auto& stream = this->GetFormatedStream(level, &buffer_, ClockTime::Now());
     stream << ' ' << strings::FormatArgs(format, args);
 
     va_end(args);
@@ -603,6 +838,249 @@ void Logger::Flush()
     if (!enabled_)
         return;
 
+    if (IsAsync() && !is_async_thread)
+    {
+        std::unique_lock<std::mutex> lock(async_mutex_);
+
+        const uint64_t ticket = ++flush_requested_;
+        async_cv_.notify_one();
+        flush_cv_.wait(lock, [=]() { return flush_done_ >= ticket; });
+        return;
+    }
+
+    for (auto provider : providers_)
+    {
+        provider->Flush();
+    }
+}
+
+void Logger::EnableAsync(size_t ring_size, LogOverflowPolicy policy)
+{
+    std::lock_guard<std::mutex> switch_lock(async_switch_mutex_);
+    if (IsAsync())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+
+        ring_size_ = 1024;
+        while (ring_size_ < ring_size)
+            ring_size_ <<= 1;
+
+        overflow_policy_ = policy;
+        async_stopping_  = false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto provider : providers_)
+        {
+            provider->SetAutoFlush(false);
+        }
+    }
+
+    async_thread_ = std::thread(&Logger::AsyncLoop, this);
+    async_.store(true, std::memory_order_release);
+}
+
+void Logger::DisableAsync()
+{
+    std::lock_guard<std::mutex> switch_lock(async_switch_mutex_);
+    if (!IsAsync())
+        return;
+
+    // Ѿʼд̻߳첽ģʽرպд룬־߳ڴڼռ
+    // ֮дΪͬȴн־д
+    async_disabling_.store(true);
+    async_.store(false);
+    while (async_producers_.load() != 0)
+    {
+        async_wake_.store(true, std::memory_order_release);
+        async_cv_.notify_one();
+        std::this_thread::yield();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        async_stopping_ = true;
+    }
+    async_cv_.notify_one();
+    async_thread_.join();
+
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        CollectAsyncBatch();
+    }
+    WriteAsyncBatch(true);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto provider : providers_)
+        {
+            provider->SetAutoFlush(true);
+            provider->Flush();
+        }
+    }
+    async_disabling_.store(false);
+}
+
+void Logger::WaitForAsyncDisabled()
+{
+    if (async_disabling_.load())
+    {
+        std::lock_guard<std::mutex> wait(async_switch_mutex_);
+    }
+}
+
+std::ostream& Logger::GetAsyncStream()
+{
+    async_stream.buffer.Reset();
+    async_stream.stream.clear();
+    return async_stream.stream;
+}
+
+void Logger::CommitAsyncStream(LogLevel level)
+{
+    const char* msg = async_stream.buffer.GetRaw();
+    PushAsync(level, msg, std::strlen(msg));
+}
+
+LogRing* Logger::GetThreadRing()
+{
+    if (!thread_ring.ring)
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+
+        thread_ring.ring = std::make_shared<LogRing>(ring_size_);
+        rings_.push_back(thread_ring.ring);
+    }
+    return thread_ring.ring.get();
+}
+
+void Logger::PushAsync(LogLevel level, const char* msg, size_t size)
+{
+    //  DisableAsync ϣٴμģʽ֤ر첽ģʽǰд־ᱻռ
+    async_producers_.fetch_add(1);
+    if (!IsAsync())
+    {
+        async_producers_.fetch_sub(1);
+        WaitForAsyncDisabled();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto& stream = this->GetFormatedStream(level, &buffer_, ClockTime::Now());
+        stream.write(msg, std::streamsize(size));
+        WriteToProviders(level, &buffer_);
+        return;
+    }
+
+    LogRing*        ring  = GetThreadRing();
+    const ClockTime time  = ClockTime::Now();
+    const int64_t   ticks = LogRing::GetTicks();
+
+    size = std::min(size, ring->GetMaxMessageSize());
+    while (!ring->TryPush(level, time, ticks, msg, size))
+    {
+        if (overflow_policy_ == LogOverflowPolicy::Drop)
+            break;
+
+        // ־߳ܵȴԼڳռ
+        if (overflow_policy_ == LogOverflowPolicy::CountDrops || is_async_thread)
+        {
+            ring->IncreaseDropCount();
+            break;
+        }
+
+        async_wake_.store(true, std::memory_order_release);
+        async_cv_.notify_one();
+        std::this_thread::yield();
+    }
+    async_producers_.fetch_sub(1, std::memory_order_release);
+}
+
+void Logger::AsyncLoop()
+{
+    is_async_thread = true;
+
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    while (true)
+    {
+        async_cv_.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+            return async_stopping_ || flush_requested_ != flush_done_ || async_wake_.exchange(false);
+        });
+
+        const bool     stopping     = async_stopping_;
+        const uint64_t flush_ticket = flush_requested_;
+
+        CollectAsyncBatch();
+        lock.unlock();
+
+        WriteAsyncBatch(stopping || flush_ticket != flush_done_);
+
+        lock.lock();
+        flush_done_ = flush_ticket;
+        flush_cv_.notify_all();
+
+        if (stopping)
+            break;
+    }
+}
+
+void Logger::CollectAsyncBatch()
+{
+    batch_.clear();
+    batch_records_.clear();
+
+    uint64_t dropped = 0;
+    for (auto iter = rings_.begin(); iter != rings_.end();)
+    {
+        // ͷǰд־ͷű־֮ȡܹȫռ
+        LogRing*   ring     = iter->get();
+        const bool released = ring->IsReleased();
+
+        ring->Drain(batch_, batch_records_);
+        dropped += ring->TakeDropCount();
+
+        if (released)
+            iter = rings_.erase(iter);
+        else
+            ++iter;
+    }
+
+    if (dropped)
+    {
+        LogRing::AppendRecord(batch_, batch_records_, LogLevel::Warning, ClockTime::Now(),
+                              strings::Format(" %llu log messages were dropped", (unsigned long long)dropped));
+    }
+}
+
+void Logger::WriteAsyncBatch(bool flush)
+{
+    if (batch_records_.empty() && !flush)
+        return;
+
+    // ̵ͬ߳־ʱͬһ߳ڱύ˳
+    auto get_ticks = [this](size_t offset) {
+        LogRing::Header header;
+        std::memcpy(&header, &batch_[offset], sizeof(header));
+        return header.ticks;
+    };
+    std::stable_sort(batch_records_.begin(), batch_records_.end(),
+                     [&](size_t lhs, size_t rhs) { return get_ticks(lhs) < get_ticks(rhs); });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto offset : batch_records_)
+    {
+        LogRing::Header header;
+        std::memcpy(&header, &batch_[offset], sizeof(header));
+
+        const LogLevel level  = LogLevel(header.level);
+        auto&          stream = this->GetFormatedStream(level, &buffer_, header.time);
+        stream << &batch_[offset + sizeof(header)];
+
+        WriteToProviders(level, &buffer_);
+    }
+
     for (auto provider : providers_)
     {
         provider->Flush();
@@ -618,7 +1096,10 @@ void Logger::AddProvider(RefPtr<LogProvider> provider)
 {
     if (provider)
     {
+        std::lock_guard<std::mutex> lock(mutex_);
+
         provider->Init();
+        provider->SetAutoFlush(!IsAsync());
         providers_.push_back(provider);
     }
 }
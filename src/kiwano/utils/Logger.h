@@ -20,6 +20,9 @@
 
 #pragma once
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 #include <iomanip>
 #include <streambuf>
 #include <fstream>
@@ -129,6 +132,17 @@ enum class LogLevel
     Error,    ///< 
 };
 
+/**
+ * \~chinese
+ * @brief 첽־ʱĴ
+ */
+enum class LogOverflowPolicy
+{
+    Block,       ///< ȴ־߳ڳռ䣨Ĭϣ
+    Drop,        ///< ־
+    CountDrops,  ///< ־֮
+};
+
 /**
  * \~chinese
  * @brief ־ʽ
@@ -194,6 +208,10 @@ public:
 
     void SetLevel(LogLevel level);
 
+    /// \~chinese
+    /// @brief Ƿÿ־ˢ첽ģʽ־߳ÿ־ˢ
+    void SetAutoFlush(bool auto_flush);
+
 protected:
     LogProvider();
 
@@ -201,6 +219,7 @@ protected:
 
 protected:
     LogLevel level_;
+    bool     auto_flush_;
 };
 
 /**
@@ -249,6 +268,8 @@ private:
     std::ofstream ofs_;
 };
 
+class LogRing;
+
 /**
  * \~chinese
  * @brief ־¼
@@ -273,8 +294,25 @@ public:
 
     /// \~chinese
     /// @brief ˢ־
+    /// @details 첽ģʽ»ȴǰύ־ȫд־
     void Flush();
 
+    /// \~chinese
+    /// @brief 첽־
+    /// @details ¼־ֻ߳Ϣд뱾̵߳λɺ̸̨߳ʽд־ߡ
+    /// ߳˳价λʣ־дաлģʽʱ߳̿Լ¼־ͬһ̵߳־ּ¼˳
+    /// @param ring_size ÿ̻߳λֽȡΪ2ݣ֮״μ¼־߳Ч
+    /// @param policy ʱĴ
+    void EnableAsync(size_t ring_size = 64 * 1024, LogOverflowPolicy policy = LogOverflowPolicy::Block);
+
+    /// \~chinese
+    /// @brief дδ־ָֹ̨̲ͣ߳ͬ־
+    void DisableAsync();
+
+    /// \~chinese
+    /// @brief Ƿ첽־
+    bool IsAsync() const;
+
     /// \~chinese
     /// @brief ־
     void Enable();
@@ -316,10 +354,26 @@ public:
 private:
     Logger();
 
-    std::iostream& GetFormatedStream(LogLevel level, LogBuffer* buffer);
+    std::iostream& GetFormatedStream(LogLevel level, LogBuffer* buffer, ClockTime time);
 
     void WriteToProviders(LogLevel level, LogBuffer* buffer);
 
+    std::ostream& GetAsyncStream();
+
+    void CommitAsyncStream(LogLevel level);
+
+    void PushAsync(LogLevel level, const char* msg, size_t size);
+
+    void WaitForAsyncDisabled();
+
+    LogRing* GetThreadRing();
+
+    void AsyncLoop();
+
+    void CollectAsyncBatch();
+
+    void WriteAsyncBatch(bool flush);
+
 private:
     bool                        enabled_;
     LogLevel                    level_;
@@ -328,6 +382,24 @@ private:
     std::iostream               stream_;
     Vector<RefPtr<LogProvider>> providers_;
     std::mutex                  mutex_;
+
+    std::atomic<bool>                async_;
+    std::atomic<bool>                async_wake_;
+    std::atomic<uint32_t>            async_producers_;
+    std::atomic<bool>                async_disabling_;
+    LogOverflowPolicy                overflow_policy_;
+    size_t                           ring_size_;
+    bool                             async_stopping_;
+    uint64_t                         flush_requested_;
+    uint64_t                         flush_done_;
+    std::thread                      async_thread_;
+    std::mutex                       async_mutex_;
+    std::mutex                       async_switch_mutex_;
+    std::condition_variable          async_cv_;
+    std::condition_variable          flush_cv_;
+    Vector<std::shared_ptr<LogRing>> rings_;
+    Vector<char>                     batch_;
+    Vector<size_t>                   batch_records_;
 };
 
 inline void Logger::Enable()
@@ -345,6 +417,11 @@ inline void Logger::SetFormater(RefPtr<LogFormater> formater)
     formater_ = formater;
 }
 
+inline bool Logger::IsAsync() const
+{
+    return async_.load(std::memory_order_acquire);
+}
+
 template <typename... _Args>
 inline void Logger::Log(LogLevel level, _Args&&... args)
 {
@@ -354,10 +431,19 @@ inline void Logger::Log(LogLevel level, _Args&&... args)
     if (level < level_)
         return;
 
+    if (this->IsAsync())
+    {
+        auto& stream = this->GetAsyncStream();
+        (void)std::initializer_list<int>{ ((stream << ' ' << args), 0)... };
+        this->CommitAsyncStream(level);
+        return;
+    }
+
+    this->WaitForAsyncDisabled();
     std::lock_guard<std::mutex> lock(mutex_);
 
     // build message
-    auto& stream = this->GetFormatedStream(level, &this->buffer_);
+    auto& stream = this->GetFormatedStream(level, &this->buffer_, ClockTime::Now());
     (void)std::initializer_list<int>{ ((stream << ' ' << args), 0)... };
 
     // write message
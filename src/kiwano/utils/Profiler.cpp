@@ -0,0 +1,313 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/utils/Profiler.h>
+#include <fstream>  // std::ofstream
+#include <iomanip>  // std::setw, std::setfill
+
+namespace kiwano
+{
+
+/// \~chinese
+/// @brief ̵߳¼
+/// @details ֻ߳д¼д󸲸ļ¼ȡڶ¼дλã
+/// ȡڼܱǵļ¼
+class ProfileBuffer : Noncopyable
+{
+public:
+    ProfileBuffer(uint32_t thread_index, size_t capacity)
+        : thread_index(thread_index)
+        , written(0)
+        , frame_cursor(0)
+        , clear_cursor(0)
+        , records(capacity)
+    {
+    }
+
+    void Push(const ProfileZoneRecord& record)
+    {
+        const uint64_t index = written.load(std::memory_order_relaxed);
+
+        records[index % records.size()] = record;
+        written.store(index + 1, std::memory_order_release);
+    }
+
+    // Calls func for every record in [begin, end) that survived the read, returns end
+    template <typename _Func>
+    uint64_t Read(uint64_t begin, _Func&& func) const
+    {
+        const uint64_t end = written.load(std::memory_order_acquire);
+
+        begin = std::max(begin, GetOldestIndex(end));
+        Vector<ProfileZoneRecord> copied;
+        copied.reserve(size_t(end - begin));
+        for (uint64_t i = begin; i < end; ++i)
+            copied.push_back(records[i % records.size()]);
+
+        // records that the writer may have overwritten while they were copied are dropped
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t valid = GetOldestIndex(written.load(std::memory_order_relaxed));
+        for (uint64_t i = std::max(begin, valid); i < end; ++i)
+            func(copied[size_t(i - begin)]);
+        return end;
+    }
+
+    uint64_t GetOldestIndex(uint64_t end) const
+    {
+        return end > records.size() ? end - records.size() : 0;
+    }
+
+    uint32_t                  thread_index;
+    std::atomic<uint64_t>     written;
+    uint64_t                  frame_cursor;  // only touched by the reader
+    uint64_t                  clear_cursor;  // only touched by the reader
+    Vector<ProfileZoneRecord> records;
+};
+
+namespace
+{
+
+thread_local ProfileBuffer* thread_buffer = nullptr;
+
+// Innermost open zone of the thread
+thread_local ProfileZone* thread_zone = nullptr;
+
+// Weight of the latest frame in the rolling average
+const float ROLLING_FACTOR = 0.05f;
+
+void WriteJsonString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for (; *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+            os << '\\';
+        os << *str;
+    }
+    os << '"';
+}
+
+}  // namespace
+
+Profiler::Profiler()
+    : enabled_(false)
+    , capacity_(1 << 16)
+{
+    epoch_       = Time::Now();
+    frame_start_ = epoch_;
+}
+
+Profiler::~Profiler() {}
+
+void Profiler::SetEnabled(bool enabled)
+{
+    if (enabled && !IsEnabled())
+    {
+        frame_start_ = Time::Now();
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::SetBufferCapacity(size_t capacity)
+{
+    KGE_ASSERT(capacity > 0);
+    capacity_ = capacity;
+}
+
+ProfileBuffer* Profiler::GetThreadBuffer()
+{
+    if (!thread_buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+
+        uint32_t thread_index = static_cast<uint32_t>(buffers_.size());
+        buffers_.emplace_back(new ProfileBuffer(thread_index, capacity_));
+        thread_buffer = buffers_.back().get();
+    }
+    return thread_buffer;
+}
+
+void Profiler::Record(const char* name, const char* category, Time start, Time end)
+{
+    ProfileZoneRecord record;
+    record.name      = name;
+    record.category  = category;
+    record.start     = (start - epoch_).GetNanoseconds();
+    record.duration  = (end - start).GetNanoseconds();
+    record.exclusive = record.duration;
+    Record(record);
+}
+
+void Profiler::Record(const ProfileZoneRecord& record)
+{
+    GetThreadBuffer()->Push(record);
+}
+
+void Profiler::EnterZone(ProfileZone* zone)
+{
+    zone->parent_ = thread_zone;
+    zone->nested_ = 0;
+    thread_zone   = zone;
+}
+
+void Profiler::LeaveZone(ProfileZone* zone, Time end)
+{
+    KGE_ASSERT(thread_zone == zone && "Profile zones must be left in reverse order");
+
+    ProfileZoneRecord record;
+    record.name      = zone->name_;
+    record.category  = zone->category_;
+    record.start     = (zone->start_ - epoch_).GetNanoseconds();
+    record.duration  = (end - zone->start_).GetNanoseconds();
+    record.exclusive = record.duration - zone->nested_;
+
+    thread_zone = zone->parent_;
+    if (thread_zone)
+        thread_zone->nested_ += record.duration;
+
+    Record(record);
+}
+
+size_t Profiler::ZoneKeyHash::operator()(const std::pair<const char*, const char*>& key) const
+{
+    const size_t h1 = std::hash<const char*>()(key.first);
+    const size_t h2 = std::hash<const char*>()(key.second);
+    return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+}
+
+void Profiler::NextFrame()
+{
+    if (!IsEnabled())
+        return;
+
+    const Time now = Time::Now();
+    if (frame_time_.IsZero())
+        frame_time_ = now - frame_start_;
+    else
+        frame_time_ += ((now - frame_start_) - frame_time_) * ROLLING_FACTOR;
+    frame_start_ = now;
+
+    for (auto& summary : summaries_)
+    {
+        summary.calls          = 0;
+        summary.last           = 0;
+        summary.last_exclusive = 0;
+    }
+
+    auto accumulate = [this](const ProfileZoneRecord& record) {
+        auto key  = std::make_pair(record.name, record.category);
+        auto iter = summary_indices_.find(key);
+        if (iter == summary_indices_.end())
+        {
+            ProfileZoneSummary summary;
+            summary.name     = record.name;
+            summary.category = record.category;
+            summary.calls    = 0;
+            summaries_.push_back(summary);
+            iter = summary_indices_.insert(std::make_pair(key, summaries_.size() - 1)).first;
+        }
+
+        auto& summary = summaries_[iter->second];
+        ++summary.calls;
+        summary.last += Duration::FromNanoseconds(record.duration);
+        summary.last_exclusive += Duration::FromNanoseconds(record.exclusive);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (auto& buffer : buffers_)
+        {
+            buffer->frame_cursor = buffer->Read(std::max(buffer->frame_cursor, buffer->clear_cursor), accumulate);
+        }
+    }
+
+    for (auto& summary : summaries_)
+    {
+        if (summary.average.IsZero())
+            summary.average = summary.last;
+        else
+            summary.average += (summary.last - summary.average) * ROLLING_FACTOR;
+
+        if (summary.average_exclusive.IsZero())
+            summary.average_exclusive = summary.last_exclusive;
+        else
+            summary.average_exclusive += (summary.last_exclusive - summary.average_exclusive) * ROLLING_FACTOR;
+    }
+
+    std::stable_sort(summaries_.begin(), summaries_.end(),
+                     [](const ProfileZoneSummary& lhs, const ProfileZoneSummary& rhs) {
+                         return lhs.average_exclusive > rhs.average_exclusive;
+                     });
+
+    for (size_t i = 0; i < summaries_.size(); ++i)
+    {
+        summary_indices_[std::make_pair(summaries_[i].name, summaries_[i].category)] = i;
+    }
+}
+
+bool Profiler::ExportChromeTrace(StringView file_path)
+{
+    std::ofstream ofs(file_path);
+    if (!ofs.is_open())
+        return false;
+
+    ofs << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    for (auto& buffer : buffers_)
+    {
+        buffer->Read(buffer->clear_cursor, [&](const ProfileZoneRecord& record) {
+            ofs << (first ? "\n" : ",\n") << "{\"name\":";
+            WriteJsonString(ofs, record.name);
+            ofs << ",\"cat\":";
+            WriteJsonString(ofs, record.category);
+            ofs << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->thread_index;
+            ofs << ",\"ts\":" << record.start / 1000 << '.' << std::setw(3) << std::setfill('0') << record.start % 1000;
+            ofs << ",\"dur\":" << record.duration / 1000 << '.' << std::setw(3) << std::setfill('0')
+                << record.duration % 1000 << "}";
+            first = false;
+        });
+    }
+
+    ofs << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return ofs.good();
+}
+
+void Profiler::Clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (auto& buffer : buffers_)
+        {
+            // the writer keeps its position, earlier records are skipped instead
+            buffer->clear_cursor = buffer->written.load(std::memory_order_acquire);
+            buffer->frame_cursor = buffer->clear_cursor;
+        }
+    }
+
+    summaries_.clear();
+    summary_indices_.clear();
+    frame_time_  = 0;
+    frame_start_ = Time::Now();
+}
+
+}  // namespace kiwano
@@ -0,0 +1,223 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <kiwano/core/Common.h>
+#include <kiwano/core/Time.h>
+
+namespace kiwano
+{
+
+class ProfileBuffer;
+class ProfileZone;
+
+/// \~chinese
+/// @brief ܷ¼
+struct ProfileZoneRecord
+{
+    const char* name;      ///< 
+    const char* category;  ///< 
+    int64_t     start;      ///< ʼʱ䣨룬ڷʱ̣
+    int64_t     duration;   ///< ʱ룩
+    int64_t     exclusive;  ///< ȥǶʱ룩
+};
+
+/// \~chinese
+/// @brief ܷͳ
+struct ProfileZoneSummary
+{
+    const char* name;               ///< 
+    const char* category;           ///< 
+    uint32_t    calls;              ///< һ֡ĵô
+    Duration    last;               ///< һ֡ܺʱ
+    Duration    average;            ///< ֡ƽʱ
+    Duration    last_exclusive;     ///< һ֡ȥǶĺʱ
+    Duration    average_exclusive;  ///< ֡ȥǶƽʱ
+};
+
+/**
+ * \~chinese
+ * @brief ܷ
+ * @details ÿ߳̽¼дԵĵ߻λдʱÿ֡һθĺʱ
+ * ͬһ߳Ƕ׵Ķռʱп۳¼ɵΪ Chrome ٸʽ (chrome://tracing)
+ * δʱ¼һԭӶȡ
+ */
+class KGE_API Profiler : public Singleton<Profiler>
+{
+    friend Singleton<Profiler>;
+
+public:
+    /// \~chinese
+    /// @brief ûܷ
+    void SetEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief Ƿܷ
+    bool IsEnabled() const;
+
+    /// \~chinese
+    /// @brief ÿ̵߳Ļ
+    /// @details ֮󴴽ĻЧд󽫸ļ¼
+    void SetBufferCapacity(size_t capacity);
+
+    /// \~chinese
+    /// @brief ȡÿ̵߳Ļ
+    size_t GetBufferCapacity() const;
+
+    /// \~chinese
+    /// @brief ¼
+    /// @param name ƣڷʹڼһֱЧ
+    /// @param category ࣬ڷʹڼһֱЧ
+    /// @param start ʼʱ
+    /// @param end ʱ
+    void Record(const char* name, const char* category, Time start, Time end);
+
+    /// \~chinese
+    /// @brief һ֡һ֡ʱ
+    void NextFrame();
+
+    /// \~chinese
+    /// @brief ȡͳƣȥǶƽʱӸߵ
+    const Vector<ProfileZoneSummary>& GetZoneSummaries() const;
+
+    /// \~chinese
+    /// @brief ȡ֡ƽ֡ʱ
+    Duration GetAverageFrameTime() const;
+
+    /// \~chinese
+    /// @brief е¼Ϊ Chrome ٸʽ JSON ļ
+    /// @param file_path ļ·
+    bool ExportChromeTrace(StringView file_path);
+
+    /// \~chinese
+    /// @brief ¼ͳ
+    void Clear();
+
+private:
+    friend class ProfileZone;
+
+    Profiler();
+
+    ~Profiler();
+
+    ProfileBuffer* GetThreadBuffer();
+
+    void Record(const ProfileZoneRecord& record);
+
+    void EnterZone(ProfileZone* zone);
+
+    void LeaveZone(ProfileZone* zone, Time end);
+
+private:
+    struct ZoneKeyHash
+    {
+        size_t operator()(const std::pair<const char*, const char*>& key) const;
+    };
+
+    std::atomic<bool>                      enabled_;
+    size_t                                 capacity_;
+    Time                                   epoch_;
+    Time                                   frame_start_;
+    Duration                               frame_time_;
+    std::mutex                             buffers_mutex_;
+    Vector<std::unique_ptr<ProfileBuffer>> buffers_;
+    Vector<ProfileZoneSummary>             summaries_;
+
+    UnorderedMap<std::pair<const char*, const char*>, size_t, ZoneKeyHash> summary_indices_;
+};
+
+/// \~chinese
+/// @brief ܷ
+/// @details ڹ֮ʱʱ¼ܷУΪָʱ¼
+class ProfileZone : Noncopyable
+{
+    friend class Profiler;
+
+public:
+    ProfileZone(const char* name, const char* category = "");
+
+    ~ProfileZone();
+
+private:
+    const char*  name_;
+    const char*  category_;
+    Time         start_;
+    ProfileZone* parent_;
+    int64_t      nested_;
+};
+
+inline bool Profiler::IsEnabled() const
+{
+    return enabled_.load(std::memory_order_relaxed);
+}
+
+inline size_t Profiler::GetBufferCapacity() const
+{
+    return capacity_;
+}
+
+inline const Vector<ProfileZoneSummary>& Profiler::GetZoneSummaries() const
+{
+    return summaries_;
+}
+
+inline Duration Profiler::GetAverageFrameTime() const
+{
+    return frame_time_;
+}
+
+inline ProfileZone::ProfileZone(const char* name, const char* category)
+    : name_(nullptr)
+    , category_(category)
+    , parent_(nullptr)
+    , nested_(0)
+{
+    if (name && Profiler::GetInstance().IsEnabled())
+    {
+        name_ = name;
+        Profiler::GetInstance().EnterZone(this);
+        start_ = Time::Now();
+    }
+}
+
+inline ProfileZone::~ProfileZone()
+{
+    if (name_)
+    {
+        Profiler::GetInstance().LeaveZone(this, Time::Now());
+    }
+}
+
+}  // namespace kiwano
+
+#define KGE_PROFILE_ZONE_CONCAT_IMPL(A, B) A##B
+#define KGE_PROFILE_ZONE_CONCAT(A, B) KGE_PROFILE_ZONE_CONCAT_IMPL(A, B)
+
+#if defined(KGE_DISABLE_PROFILER)
+#define KGE_PROFILE_ZONE(NAME)
+#define KGE_PROFILE_ZONE_CATEGORY(NAME, CATEGORY)
+#else
+#define KGE_PROFILE_ZONE(NAME) \
+    ::kiwano::ProfileZone KGE_PROFILE_ZONE_CONCAT(__kge_profile_zone_, __LINE__)(NAME)
+#define KGE_PROFILE_ZONE_CATEGORY(NAME, CATEGORY) \
+    ::kiwano::ProfileZone KGE_PROFILE_ZONE_CONCAT(__kge_profile_zone_, __LINE__)(NAME, CATEGORY)
+#endif
@@ -45,8 +45,32 @@ bool ResourceCache::LoadFromXmlFile(StringView file_path)
     return IsValid();
 }
 
+void ResourceCache::LoadFromJsonFileAsync(RefPtr<ResourceCache> cache, StringView file_path,
+                                          const ResourceLoadingCallback& callback)
+{
+    ResourceLoader loader(cache, &GetLoadingThreadPool(), callback);
+    loader.LoadFromJsonFile(file_path);
+}
+
+void ResourceCache::LoadFromXmlFileAsync(RefPtr<ResourceCache> cache, StringView file_path,
+                                         const ResourceLoadingCallback& callback)
+{
+    ResourceLoader loader(cache, &GetLoadingThreadPool(), callback);
+    loader.LoadFromXmlFile(file_path);
+}
+
+ThreadPool& ResourceCache::GetLoadingThreadPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
 void ResourceCache::AddObject(StringView id, RefPtr<ObjectBase> obj)
 {
+    // unnamed objects are named after their id, so that they can be referred to when saving scenes
+    if (obj && obj->GetName().empty())
+        obj->SetName(id);
+
     object_cache_[id] = obj;
 }
 
@@ -21,6 +21,7 @@
 #pragma once
 #include <kiwano/core/Resource.h>
 #include <kiwano/base/ObjectBase.h>
+#include <kiwano/utils/ResourceLoader.h>
 
 namespace kiwano
 {
@@ -44,6 +45,24 @@ public:
     /// @param file_path XMLļ·
     bool LoadFromXmlFile(StringView file_path);
 
+    /// \~chinese
+    /// @brief  JSON ļ첽Դ
+    /// @details عϷԼУǰɼ
+    /// @param cache Դ
+    /// @param file_path JSONļ·
+    /// @param callback ÿһԴʱ߳еõĽȻص
+    static void LoadFromJsonFileAsync(RefPtr<ResourceCache> cache, StringView file_path,
+                                      const ResourceLoadingCallback& callback = nullptr);
+
+    /// \~chinese
+    /// @brief  XML ļ첽Դ
+    /// @details عϷԼУǰɼ
+    /// @param cache Դ
+    /// @param file_path XMLļ·
+    /// @param callback ÿһԴʱ߳еõĽȻص
+    static void LoadFromXmlFileAsync(RefPtr<ResourceCache> cache, StringView file_path,
+                                     const ResourceLoadingCallback& callback = nullptr);
+
     /// \~chinese
     /// @brief ȡԴ
     /// @param id ID
@@ -62,6 +81,7 @@ public:
 
     /// \~chinese
     /// @brief 뻺
+    /// @details δĶԶID
     /// @param id ID
     /// @param obj 
     void AddObject(StringView id, RefPtr<ObjectBase> obj);
@@ -75,6 +95,10 @@ public:
     /// @brief Դ
     void Clear();
 
+    /// \~chinese
+    /// @brief ȡ첽ʹõ̳߳
+    static ThreadPool& GetLoadingThreadPool();
+
 private:
     UnorderedMap<String, RefPtr<ObjectBase>> object_cache_;
 };
@@ -25,36 +25,100 @@
 #include <kiwano/utils/ResourceCache.h>
 #include <kiwano/render/Font.h>
 #include <kiwano/render/GifImage.h>
+#include <kiwano/render/ImageDecoder.h>
 #include <kiwano/2d/SpriteFrame.h>
 #include <kiwano/2d/animation/FrameSequence.h>
+#include <kiwano/platform/Application.h>
 
 namespace kiwano
 {
 namespace resource_cache_01
 {
 
-void LoadJsonData(ResourceCache* cache, const Json& json_data);
-void LoadXmlData(ResourceCache* cache, const XmlNode& elem);
+struct LoadItem
+{
+    enum class Type
+    {
+        Texture,
+        GifImage,
+        FrameSequence,
+        SlicedFrames,
+        FontCollection,
+        Custom,
+    };
+
+    Type           type;
+    String         id;
+    Vector<String> files;
+    int            rows      = 0;
+    int            cols      = 0;
+    int            max_num   = -1;
+    float          padding_x = 0;
+    float          padding_y = 0;
+
+    // File contents read by worker threads in asynchronous mode
+    Vector<Vector<char>> file_data;
+
+    // Memory of archived files, resolved on the main thread in asynchronous mode. The archives are held
+    // until the item is done, so unmounting them during loading doesn't invalidate the memory
+    Vector<BinaryData>          archived_data;
+    Vector<RefPtr<FileArchive>> archives;
+
+    // Pixels decoded by worker threads, only uploaded on the main thread
+    Vector<ImageData> images;
+
+    // Custom resources are decoded by a registered decoder, on worker threads in asynchronous mode
+    ResourceDecoder    decoder;
+    RefPtr<ObjectBase> object;
+};
+
+struct GlobalData
+{
+    String           path;
+    Vector<LoadItem> items;
+};
+
+void LoadJsonData(GlobalData* gdata, const Json& json_data);
+void LoadXmlData(GlobalData* gdata, const XmlNode& elem);
+void LoadItemsSync(ResourceCache* cache, Vector<LoadItem>& items, const ResourceLoadingCallback& callback);
+void LoadItemsAsync(RefPtr<ResourceCache> cache, Vector<LoadItem>& items, ThreadPool* pool,
+                    const ResourceLoadingCallback& callback);
 
 }  // namespace resource_cache_01
 
 namespace
 {
 
-Map<String, Function<void(ResourceCache*, const Json&)>> load_json_funcs = {
+Map<String, Function<void(resource_cache_01::GlobalData*, const Json&)>> load_json_funcs = {
     { "latest", resource_cache_01::LoadJsonData },
     { "0.1", resource_cache_01::LoadJsonData },
 };
 
-Map<String, Function<void(ResourceCache*, const XmlNode&)>> load_xml_funcs = {
+Map<String, Function<void(resource_cache_01::GlobalData*, const XmlNode&)>> load_xml_funcs = {
     { "latest", resource_cache_01::LoadXmlData },
     { "0.1", resource_cache_01::LoadXmlData },
 };
 
+// Decoders of custom resources, keyed by the section name in resource manifests
+Map<String, ResourceDecoder>& GetResourceDecoders()
+{
+    static Map<String, ResourceDecoder> decoders;
+    return decoders;
+}
+
 }  // namespace
 
 ResourceLoader::ResourceLoader(ResourceCache& cache)
     : cache_(cache)
+    , pool_(nullptr)
+{
+}
+
+ResourceLoader::ResourceLoader(RefPtr<ResourceCache> cache, ThreadPool* pool, const ResourceLoadingCallback& callback)
+    : cache_(*cache)
+    , async_cache_(cache)
+    , pool_(pool)
+    , callback_(callback)
 {
 }
 
@@ -68,6 +132,26 @@ void ResourceLoader::LoadFromJsonFile(StringView file_path)
 
     Json json_data;
 
+    BinaryData archived = FileSystem::GetInstance().GetArchivedFileData(file_path);
+    if (archived.IsValid())
+    {
+        try
+        {
+            const char* begin = static_cast<const char*>(archived.buffer);
+            json_data         = Json::parse(begin, begin + archived.size);
+        }
+        catch (Json::exception& e)
+        {
+            cache_.Fail(strings::Format(
+                "ResourceLoader::LoadFromJsonFile failed: Json file [%s] parsed with errors: %s", file_path.data(),
+                e.what()));
+            return;
+        }
+
+        LoadFromJson(json_data);
+        return;
+    }
+
     std::ifstream ifs;
     ifs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 
@@ -100,19 +184,24 @@ void ResourceLoader::LoadFromJson(const Json& json_data)
     {
         String version = json_data["version"];
 
+        resource_cache_01::GlobalData global_data;
+
         auto load = load_json_funcs.find(version);
         if (load != load_json_funcs.end())
         {
-            load->second(&cache_, json_data);
+            load->second(&global_data, json_data);
         }
         else if (version.empty())
         {
-            load_json_funcs["latest"](&cache_, json_data);
+            load_json_funcs["latest"](&global_data, json_data);
         }
         else
         {
             cache_.Fail("ResourceLoader::LoadFromJson failed: unknown resource data version");
+            return;
         }
+
+        LoadGlobalData(&global_data);
     }
     catch (Json::exception& e)
     {
@@ -128,11 +217,21 @@ void ResourceLoader::LoadFromXmlFile(StringView file_path)
         return;
     }
 
-    String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
-
     XmlDocument doc;
 
-    auto result = doc.load_file(full_path.c_str());
+    pugi::xml_parse_result result;
+
+    BinaryData archived = FileSystem::GetInstance().GetArchivedFileData(file_path);
+    if (archived.IsValid())
+    {
+        result = doc.load_buffer(archived.buffer, archived.size);
+    }
+    else
+    {
+        String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
+        result           = doc.load_file(full_path.c_str());
+    }
+
     if (result)
     {
         LoadFromXml(doc);
@@ -152,19 +251,24 @@ void ResourceLoader::LoadFromXml(const XmlDocument& doc)
         if (auto version_node = root.child("version"))
             version = version_node.child_value();
 
+        resource_cache_01::GlobalData global_data;
+
         auto load = load_xml_funcs.find(version);
         if (load != load_xml_funcs.end())
         {
-            load->second(&cache_, root);
+            load->second(&global_data, root);
         }
         else if (version.empty())
         {
-            load_xml_funcs["latest"](&cache_, root);
+            load_xml_funcs["latest"](&global_data, root);
         }
         else
         {
             cache_.Fail("ResourceLoader::LoadFromXml failed: unknown resource data version");
+            return;
         }
+
+        LoadGlobalData(&global_data);
     }
     else
     {
@@ -172,132 +276,404 @@ void ResourceLoader::LoadFromXml(const XmlDocument& doc)
     }
 }
 
+void ResourceLoader::RegisterDecoder(StringView section, const ResourceDecoder& decoder)
+{
+    if (decoder)
+        GetResourceDecoders()[String(section)] = decoder;
+    else
+        GetResourceDecoders().erase(String(section));
+}
+
+void ResourceLoader::LoadGlobalData(resource_cache_01::GlobalData* gdata)
+{
+    if (pool_)
+    {
+        resource_cache_01::LoadItemsAsync(async_cache_, gdata->items, pool_, callback_);
+    }
+    else
+    {
+        resource_cache_01::LoadItemsSync(&cache_, gdata->items, callback_);
+    }
+}
+
 }  // namespace kiwano
 
 namespace kiwano
 {
 namespace resource_cache_01
 {
-struct GlobalData
+void LoadTexturesFromData(GlobalData* gdata, StringView id, StringView type, StringView file)
 {
-    String path;
-};
+    LoadItem item;
+    item.type = (type == "gif") ? LoadItem::Type::GifImage : LoadItem::Type::Texture;
+    item.id   = id;
+    if (!file.empty())
+        item.files.push_back(gdata->path + file.data());
+    gdata->items.push_back(std::move(item));
+}
 
-void LoadTexturesFromData(ResourceCache* cache, GlobalData* gdata, StringView id, StringView type, StringView file)
+void LoadTexturesFromData(GlobalData* gdata, StringView id, const Vector<String>& files)
 {
-    if (type == "gif")
+    if (files.empty())
+        return;
+
+    // Frames
+    LoadItem item;
+    item.type = LoadItem::Type::FrameSequence;
+    item.id   = id;
+    item.files.reserve(files.size());
+    for (const auto& file : files)
     {
-        // GIF image
-        RefPtr<GifImage> gif = MakePtr<GifImage>();
-        if (gif && gif->Load(gdata->path + file.data()))
-        {
-            cache->AddObject(id, gif);
-            return;
-        }
+        item.files.push_back(gdata->path + file);
     }
-    else if (!file.empty())
+    gdata->items.push_back(std::move(item));
+}
+
+void LoadTexturesFromData(GlobalData* gdata, StringView id, StringView file, int rows, int cols,
+                          int max_num, float padding_x, float padding_y)
+{
+    // KeyFrame slices
+    LoadItem item;
+    item.type      = LoadItem::Type::SlicedFrames;
+    item.id        = id;
+    item.rows      = rows;
+    item.cols      = cols;
+    item.max_num   = max_num;
+    item.padding_x = padding_x;
+    item.padding_y = padding_y;
+    if (!file.empty())
+        item.files.push_back(gdata->path + file.data());
+    gdata->items.push_back(std::move(item));
+}
+
+void LoadFontsFromData(GlobalData* gdata, StringView id, const Vector<String>& files)
+{
+    LoadItem item;
+    item.type  = LoadItem::Type::FontCollection;
+    item.id    = id;
+    item.files = files;
+    gdata->items.push_back(std::move(item));
+}
+
+void LoadCustomFromData(GlobalData* gdata, StringView id, StringView file, const ResourceDecoder& decoder)
+{
+    LoadItem item;
+    item.type    = LoadItem::Type::Custom;
+    item.id      = id;
+    item.decoder = decoder;
+    if (!file.empty())
+        item.files.push_back(gdata->path + file.data());
+    gdata->items.push_back(std::move(item));
+}
+
+bool NeedsFileData(const LoadItem& item)
+{
+    // GIF images decode their frames lazily from the source, and fonts are
+    // registered by path, so only plain images are read ahead
+    if (item.type != LoadItem::Type::Texture && item.type != LoadItem::Type::FrameSequence
+        && item.type != LoadItem::Type::SlicedFrames)
     {
-        // Simple image
-        RefPtr<Texture> texture = MakePtr<Texture>();
-        if (texture && texture->Load(gdata->path + file.data()))
-        {
-            cache->AddObject(id, texture);
-            return;
-        }
+        return false;
     }
+    return true;
+}
 
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
+void ResolveFiles(LoadItem& item)
+{
+    // FileSystem caches lookups and is not thread-safe, so the paths are resolved on the main thread
+    auto& files = item.files;
+    item.archived_data.resize(files.size());
+    item.archives.resize(files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        item.archived_data[i] = FileSystem::GetInstance().GetArchivedFileData(files[i], item.archives[i]);
+        if (!item.archived_data[i].IsValid())
+            files[i] = FileSystem::GetInstance().GetFullPathForFile(files[i]);
+    }
 }
 
-void LoadTexturesFromData(ResourceCache* cache, GlobalData* gdata, StringView id, const Vector<String>& files)
+void DecodeCustom(LoadItem& item)
 {
-    if (files.empty())
+    if (item.files.empty() || !item.decoder)
         return;
 
-    // Frames
-    Vector<SpriteFrame> frames;
-    frames.reserve(files.size());
-    for (const auto& file : files)
+    BinaryData data = item.archived_data.empty() ? BinaryData() : item.archived_data[0];
+    item.object     = item.decoder(item.files[0], data);
+}
+
+uint64_t ReadFileData(LoadItem& item)
+{
+    uint64_t bytes = 0;
+
+    item.file_data.resize(item.files.size());
+    for (size_t i = 0; i < item.files.size(); ++i)
     {
-        SpriteFrame frame;
-        if (frame.Load(gdata->path + file))
-        {
-            frames.push_back(frame);
-        }
+        // Archived files are already mapped into memory
+        if (i < item.archived_data.size() && item.archived_data[i].IsValid())
+            continue;
+
+        std::ifstream ifs(item.files[i].c_str(), std::ios::binary | std::ios::ate);
+        if (!ifs)
+            continue;
+
+        const auto size = ifs.tellg();
+        if (size <= 0)
+            continue;
+
+        Vector<char>& data = item.file_data[i];
+        data.resize(size_t(size));
+
+        ifs.seekg(0);
+        if (ifs.read(data.data(), size))
+            bytes += uint64_t(size);
+        else
+            data.clear();
     }
+    return bytes;
+}
 
-    if (!frames.empty())
+void DecodeImages(LoadItem& item)
+{
+    item.images.resize(item.files.size());
+    for (size_t i = 0; i < item.files.size(); ++i)
     {
-        RefPtr<FrameSequence> frame_seq = MakePtr<FrameSequence>(frames);
-        if (frame_seq)
+        BinaryData data;
+        if (i < item.archived_data.size() && item.archived_data[i].IsValid())
         {
-            cache->AddObject(id, frame_seq);
-            return;
+            data = item.archived_data[i];
+        }
+        else if (!item.file_data[i].empty())
+        {
+            data = BinaryData(item.file_data[i].data(), uint32_t(item.file_data[i].size()));
+        }
+
+        // Unsupported formats keep their file data and are decoded by the renderer
+        if (data.IsValid() && ImageDecoder::Decode(data, item.images[i]))
+        {
+            Vector<char>().swap(item.file_data[i]);
         }
     }
+}
 
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
+RefPtr<Texture> LoadTextureFromItem(const LoadItem& item, size_t index)
+{
+    RefPtr<Texture> texture = MakePtr<Texture>();
+    if (index < item.images.size() && item.images[index].IsValid())
+    {
+        if (texture->Load(item.images[index]))
+            return texture;
+    }
+    else if (index < item.archived_data.size() && item.archived_data[index].IsValid())
+    {
+        if (texture->Load(item.archived_data[index]))
+            return texture;
+    }
+    else if (index < item.file_data.size())
+    {
+        const Vector<char>& data = item.file_data[index];
+        if (data.empty())
+            return nullptr;
+
+        // The renderer only reads from the buffer while creating the texture
+        BinaryData binary(const_cast<char*>(data.data()), uint32_t(data.size()));
+        if (texture->Load(binary))
+            return texture;
+    }
+    else
+    {
+        if (texture->Load(item.files[index]))
+            return texture;
+    }
+    return nullptr;
 }
 
-void LoadTexturesFromData(ResourceCache* cache, GlobalData* gdata, StringView id, StringView file, int rows, int cols,
-                          int max_num, float padding_x, float padding_y)
+void LoadItemToCache(ResourceCache* cache, const LoadItem& item)
 {
-    if (!file.empty())
+    switch (item.type)
     {
-        if (rows || cols)
+    case LoadItem::Type::Texture:
+    {
+        // Simple image
+        if (!item.files.empty())
         {
-            // KeyFrame slices
-            SpriteFrame frame;
-            if (frame.Load(gdata->path + file.data()))
+            RefPtr<Texture> texture = LoadTextureFromItem(item, 0);
+            if (texture)
             {
-                RefPtr<FrameSequence> frame_seq = MakePtr<FrameSequence>();
-                if (frame_seq)
-                {
-                    frame_seq->AddFrames(frame.Split(cols, rows, max_num, padding_x, padding_y));
-                    cache->AddObject(id, frame_seq);
-                    return;
-                }
+                cache->AddObject(item.id, texture);
+                return;
             }
         }
-        else
+        break;
+    }
+    case LoadItem::Type::GifImage:
+    {
+        // GIF image
+        RefPtr<GifImage> gif = MakePtr<GifImage>();
+        if (!item.files.empty() && gif->Load(item.files[0]))
+        {
+            cache->AddObject(item.id, gif);
+            return;
+        }
+        break;
+    }
+    case LoadItem::Type::FrameSequence:
+    {
+        // Frames
+        Vector<SpriteFrame> frames;
+        frames.reserve(item.files.size());
+        for (size_t i = 0; i < item.files.size(); ++i)
+        {
+            RefPtr<Texture> texture = LoadTextureFromItem(item, i);
+            if (texture)
+            {
+                frames.push_back(SpriteFrame(texture));
+            }
+        }
+
+        if (!frames.empty())
+        {
+            RefPtr<FrameSequence> frame_seq = MakePtr<FrameSequence>(frames);
+            cache->AddObject(item.id, frame_seq);
+            return;
+        }
+        break;
+    }
+    case LoadItem::Type::SlicedFrames:
+    {
+        // KeyFrame slices
+        if (!item.files.empty())
         {
-            // Simple image
-            RefPtr<Texture> texture = MakePtr<Texture>();
-            if (texture && texture->Load(gdata->path + file.data()))
+            RefPtr<Texture> texture = LoadTextureFromItem(item, 0);
+            if (texture)
             {
-                cache->AddObject(id, texture);
+                SpriteFrame frame(texture);
+
+                RefPtr<FrameSequence> frame_seq = MakePtr<FrameSequence>();
+                frame_seq->AddFrames(frame.Split(item.cols, item.rows, item.max_num, item.padding_x, item.padding_y));
+                cache->AddObject(item.id, frame_seq);
                 return;
             }
         }
+        break;
+    }
+    case LoadItem::Type::FontCollection:
+    {
+        RefPtr<FontCollection> collection = FontCollection::Preload(item.files);
+        if (collection)
+        {
+            cache->AddObject(item.id, collection);
+            return;
+        }
+        break;
+    }
+    case LoadItem::Type::Custom:
+    {
+        if (item.object)
+        {
+            cache->AddObject(item.id, item.object);
+            return;
+        }
+        break;
+    }
     }
 
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
+    cache->Fail(strings::Format("%s failed: cannot load resource [%s]", __FUNCTION__, item.id.c_str()));
 }
 
-void LoadFontsFromData(ResourceCache* cache, GlobalData* gdata, StringView id, const Vector<String>& files)
+void LoadItemsSync(ResourceCache* cache, Vector<LoadItem>& items, const ResourceLoadingCallback& callback)
 {
-    Vector<String> full_paths;
-    full_paths.reserve(files.size());
-    for (const auto& file : files)
+    ResourceLoadingProgress progress;
+    progress.total_count = uint32_t(items.size());
+
+    for (auto& item : items)
     {
-        full_paths.emplace_back(file);
+        if (item.type == LoadItem::Type::Custom)
+        {
+            ResolveFiles(item);
+            DecodeCustom(item);
+        }
+
+        LoadItemToCache(cache, item);
+
+        ++progress.loaded_count;
+        if (callback)
+            callback(progress);
     }
+}
+
+struct AsyncLoadingState
+{
+    RefPtr<ResourceCache>   cache;
+    ResourceLoadingCallback callback;
+    ResourceLoadingProgress progress;
+};
+
+// Runs on the main thread, the state is released with the last item
+void FinishAsyncItem(AsyncLoadingState* state, const LoadItem& item, uint64_t bytes)
+{
+    LoadItemToCache(state->cache.Get(), item);
+
+    ++state->progress.loaded_count;
+    state->progress.loaded_bytes += bytes;
+    if (state->callback)
+        state->callback(state->progress);
 
-    RefPtr<FontCollection> collection = FontCollection::Preload(full_paths);
-    if (collection)
+    if (state->progress.IsFinished())
+        delete state;
+}
+
+void LoadItemsAsync(RefPtr<ResourceCache> cache, Vector<LoadItem>& items, ThreadPool* pool,
+                    const ResourceLoadingCallback& callback)
+{
+    if (items.empty())
     {
-        cache->AddObject(id, collection);
+        if (callback)
+            callback(ResourceLoadingProgress());
         return;
     }
-    cache->Fail(strings::Format("%s failed", __FUNCTION__));
+
+    auto state                  = new AsyncLoadingState;
+    state->cache                = cache;
+    state->callback             = callback;
+    state->progress.total_count = uint32_t(items.size());
+
+    for (auto& item : items)
+    {
+        auto shared_item = std::make_shared<LoadItem>(std::move(item));
+        if (shared_item->type == LoadItem::Type::Custom)
+        {
+            ResolveFiles(*shared_item);
+
+            pool->Submit([=]() {
+                DecodeCustom(*shared_item);
+
+                Application::GetInstance().PerformInMainThread([=]() { FinishAsyncItem(state, *shared_item, 0); });
+            });
+        }
+        else if (NeedsFileData(*shared_item))
+        {
+            ResolveFiles(*shared_item);
+
+            pool->Submit([=]() {
+                uint64_t bytes = ReadFileData(*shared_item);
+                DecodeImages(*shared_item);
+
+                Application::GetInstance().PerformInMainThread(
+                    [=]() { FinishAsyncItem(state, *shared_item, bytes); });
+            });
+        }
+        else
+        {
+            Application::GetInstance().PerformInMainThread([=]() { FinishAsyncItem(state, *shared_item, 0); });
+        }
+    }
 }
 
-void LoadJsonData(ResourceCache* cache, const Json& json_data)
+void LoadJsonData(GlobalData* gdata, const Json& json_data)
 {
-    GlobalData global_data;
     if (json_data.count("path"))
     {
-        global_data.path = json_data["path"].get<String>();
+        gdata->path = json_data["path"].get<String>();
     }
 
     if (json_data.count("images"))
@@ -328,10 +704,9 @@ void LoadJsonData(ResourceCache* cache, const Json& json_data)
                 if (image.count("padding-y"))
                     padding_y = image["padding-y"].get<float>();
 
-                LoadTexturesFromData(cache, &global_data, id, file, rows, cols, max_num, padding_x, padding_y);
+                LoadTexturesFromData(gdata, id, file, rows, cols, max_num, padding_x, padding_y);
             }
-
-            if (image.count("files"))
+            else if (image.count("files"))
             {
                 Vector<String> files;
                 files.reserve(image["files"].size());
@@ -339,11 +714,11 @@ void LoadJsonData(ResourceCache* cache, const Json& json_data)
                 {
                     files.push_back(file.get<String>());
                 }
-                LoadTexturesFromData(cache, &global_data, id, files);
+                LoadTexturesFromData(gdata, id, files);
             }
             else
             {
-                LoadTexturesFromData(cache, &global_data, id, type, file);
+                LoadTexturesFromData(gdata, id, type, file);
             }
         }
     }
@@ -364,18 +739,34 @@ void LoadJsonData(ResourceCache* cache, const Json& json_data)
                 {
                     files.push_back(file.get<String>());
                 }
-                LoadFontsFromData(cache, &global_data, id, files);
+                LoadFontsFromData(gdata, id, files);
             }
         }
     }
+
+    for (const auto& pair : GetResourceDecoders())
+    {
+        if (!json_data.count(pair.first))
+            continue;
+
+        for (const auto& res : json_data[pair.first])
+        {
+            String id, file;
+            if (res.count("id"))
+                id = res["id"].get<String>();
+            if (res.count("file"))
+                file = res["file"].get<String>();
+
+            LoadCustomFromData(gdata, id, file, pair.second);
+        }
+    }
 }
 
-void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
+void LoadXmlData(GlobalData* gdata, const XmlNode& elem)
 {
-    GlobalData global_data;
     if (auto path = elem.child("path"))
     {
-        global_data.path = path.child_value();
+        gdata->path = path.child_value();
     }
 
     if (auto images = elem.child("images"))
@@ -406,10 +797,9 @@ void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
                 if (auto attr = image.attribute("padding-y"))
                     padding_y = attr.as_float(0.0f);
 
-                LoadTexturesFromData(cache, &global_data, id, file, rows, cols, max_num, padding_x, padding_y);
+                LoadTexturesFromData(gdata, id, file, rows, cols, max_num, padding_x, padding_y);
             }
-
-            if (file.empty() && !image.empty())
+            else if (file.empty() && !image.empty())
             {
                 Vector<String> files_arr;
                 for (auto file : image.children())
@@ -419,11 +809,11 @@ void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
                         files_arr.push_back(path.value());
                     }
                 }
-                LoadTexturesFromData(cache, &global_data, id, files_arr);
+                LoadTexturesFromData(gdata, id, files_arr);
             }
             else
             {
-                LoadTexturesFromData(cache, &global_data, id, type, file);
+                LoadTexturesFromData(gdata, id, type, file);
             }
         }
     }
@@ -443,7 +833,24 @@ void LoadXmlData(ResourceCache* cache, const XmlNode& elem)
                 {
                     files.push_back(file_node.value());
                 }
-                LoadFontsFromData(cache, &global_data, id, files);
+                LoadFontsFromData(gdata, id, files);
+            }
+        }
+    }
+
+    for (const auto& pair : GetResourceDecoders())
+    {
+        if (auto section = elem.child(pair.first.c_str()))
+        {
+            for (auto res : section.children())
+            {
+                String id, file;
+                if (auto attr = res.attribute("id"))
+                    id = attr.value();
+                if (auto attr = res.attribute("file"))
+                    file = attr.value();
+
+                LoadCustomFromData(gdata, id, file, pair.second);
             }
         }
     }
@@ -20,6 +20,9 @@
 
 #pragma once
 #include <kiwano/core/Common.h>
+#include <kiwano/core/BinaryData.h>
+#include <kiwano/core/ThreadPool.h>
+#include <kiwano/base/ObjectBase.h>
 #include <kiwano/utils/Json.h>
 #include <kiwano/utils/Xml.h>
 
@@ -28,13 +31,56 @@ namespace kiwano
 
 class ResourceCache;
 
+namespace resource_cache_01
+{
+struct GlobalData;
+}
+
+/// \~chinese
+/// @brief Դؽ
+struct ResourceLoadingProgress
+{
+    uint32_t loaded_count = 0;  ///< ѼصԴ
+    uint32_t total_count  = 0;  ///< Դ
+    uint64_t loaded_bytes = 0;  ///< ߳Ѷȡļֽ
+
+    /// \~chinese
+    /// @brief Ƿȫ
+    inline bool IsFinished() const
+    {
+        return loaded_count == total_count;
+    }
+};
+
+/// \~chinese
+/// @brief ԴؽȻص
+using ResourceLoadingCallback = Function<void(const ResourceLoadingProgress&)>;
+
+/// \~chinese
+/// @brief ԶԴ뺯
+/// @details 첽ʱڹ߳еãܷļϵͳȾ豸
+/// @param file_path ļ·
+/// @param data ļλԴʱΪݣΪ
+using ResourceDecoder = Function<RefPtr<ObjectBase>(StringView file_path, const BinaryData& data)>;
+
 /// \~chinese
 /// @brief Դ
 class KGE_API ResourceLoader final
 {
 public:
+    /// \~chinese
+    /// @brief ͬԴڵ߳μԴ
     ResourceLoader(ResourceCache& cache);
 
+    /// \~chinese
+    /// @brief Դ
+    /// @details ̳߳زΪʱ첽أԴ嵥ڵ߳нļȡ̳߳нУ
+    /// ҪȾ豸Ĳͨ Application::PerformInMainThread ִ߳
+    /// @param cache Դ棬첽ǰɼ
+    /// @param pool ̳߳أ첽ǰҪִ
+    /// @param callback ÿһԴʱõĽȻص첽ʱ߳е
+    ResourceLoader(RefPtr<ResourceCache> cache, ThreadPool* pool, const ResourceLoadingCallback& callback);
+
     /// \~chinese
     /// @brief  JSON ļԴϢ
     /// @param file_path JSONļ·
@@ -55,8 +101,22 @@ public:
     /// @param doc XMLĵ
     void LoadFromXml(const XmlDocument& doc);
 
+    /// \~chinese
+    /// @brief עԶԴ
+    /// @details Դ嵥бͬԴбͨ뺯أÿԴ id  file ԣ
+    /// 첽ʱ̳߳нСҪ߳е
+    /// @param section Դ嵥еб
+    /// @param decoder 뺯Ϊʱȡע
+    static void RegisterDecoder(StringView section, const ResourceDecoder& decoder);
+
+private:
+    void LoadGlobalData(resource_cache_01::GlobalData* gdata);
+
 private:
-    ResourceCache& cache_;
+    ResourceCache&          cache_;
+    RefPtr<ResourceCache>   async_cache_;
+    ThreadPool*             pool_;
+    ResourceLoadingCallback callback_;
 };
 
 }  // namespace kiwano
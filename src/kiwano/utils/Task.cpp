@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <kiwano/utils/Task.h>
+#include <kiwano/utils/TaskScheduler.h>
 
 namespace kiwano
 {
@@ -27,6 +28,9 @@ Task::Task(const Callback& cb, RefPtr<Ticker> ticker)
     , removeable_(false)
     , callback_(cb)
     , ticker_(ticker)
+    , scheduler_(nullptr)
+    , sequence_(0)
+    , generation_(0)
 {
 }
 
@@ -40,6 +44,9 @@ Task::Task(const Callback& cb, Duration interval, int times)
     : running_(true)
     , removeable_(false)
     , callback_(cb)
+    , scheduler_(nullptr)
+    , sequence_(0)
+    , generation_(0)
 {
     ticker_ = MakePtr<Ticker>(interval, times);
 }
@@ -54,6 +61,9 @@ Task::Task()
     : running_(true)
     , removeable_(false)
     , callback_()
+    , scheduler_(nullptr)
+    , sequence_(0)
+    , generation_(0)
 {
 }
 
@@ -64,6 +74,9 @@ void Task::Start()
         running_ = true;
         if (ticker_)
             ticker_->Resume();
+
+        if (scheduler_)
+            scheduler_->OnTaskStarted(this);
     }
 }
 
@@ -74,9 +87,38 @@ void Task::Stop()
         running_ = false;
         if (ticker_)
             ticker_->Pause();
+
+        if (scheduler_)
+            scheduler_->OnTaskStopped(this);
     }
 }
 
+void Task::Remove()
+{
+    if (!removeable_)
+    {
+        removeable_ = true;
+
+        if (scheduler_)
+            scheduler_->OnTaskRemoved(this);
+    }
+}
+
+void Task::SetTicker(RefPtr<Ticker> ticker)
+{
+    ticker_ = ticker;
+    if (ticker_)
+    {
+        if (running_)
+            ticker_->Resume();
+        else
+            ticker_->Pause();
+    }
+
+    if (scheduler_)
+        scheduler_->OnTaskTickerChanged(this);
+}
+
 void Task::Update(Duration dt)
 {
     if (!running_ || removeable_)
@@ -125,12 +125,14 @@ private:
     bool           removeable_;
     RefPtr<Ticker> ticker_;
     Callback       callback_;
-};
 
-inline void Task::Remove()
-{
-    removeable_ = true;
-}
+    // ³Աάڰʱ
+    TaskScheduler* scheduler_;
+    uint64_t       sequence_;
+    uint64_t       generation_;
+    Duration       since_;
+    Duration       stopped_elapsed_;
+};
 
 inline bool Task::IsRunning() const
 {
@@ -147,18 +149,6 @@ inline RefPtr<Ticker> Task::GetTicker() const
     return ticker_;
 }
 
-inline void Task::SetTicker(RefPtr<Ticker> ticker)
-{
-    ticker_ = ticker;
-    if (ticker_)
-    {
-        if (running_)
-            ticker_->Resume();
-        else
-            ticker_->Pause();
-    }
-}
-
 inline Task::Callback Task::GetCallback() const
 {
     return callback_;
@@ -20,15 +20,52 @@
 
 #include <kiwano/utils/Logger.h>
 #include <kiwano/utils/TaskScheduler.h>
+#include <kiwano/utils/Profiler.h>
+#include <algorithm>
 
 namespace kiwano
 {
 
+namespace
+{
+
+struct TaskEntryLater
+{
+    template <typename _Ty>
+    inline bool operator()(const _Ty& lhs, const _Ty& rhs) const
+    {
+        if (lhs.deadline != rhs.deadline)
+            return lhs.deadline > rhs.deadline;
+        return lhs.sequence > rhs.sequence;
+    }
+};
+
+}  // namespace
+
+TaskScheduler::TaskScheduler()
+    : mode_(TaskSchedulingMode::PerFrame)
+    , next_sequence_(0)
+{
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    RemoveAllTasks();
+}
+
 void TaskScheduler::Update(Duration dt)
 {
     if (tasks_.IsEmpty())
         return;
 
+    KGE_PROFILE_ZONE("TaskScheduler::Update");
+
+    if (mode_ == TaskSchedulingMode::Deadline)
+    {
+        UpdateDeadlineTasks(dt);
+        return;
+    }
+
     RefPtr<Task> next;
     for (auto task = tasks_.GetFirst(); task; task = next)
     {
@@ -37,7 +74,159 @@ void TaskScheduler::Update(Duration dt)
         task->Update(dt);
 
         if (task->IsRemoveable())
-            tasks_.Remove(task);
+            RemoveTaskFromList(task.Get());
+    }
+}
+
+void TaskScheduler::UpdateDeadlineTasks(Duration dt)
+{
+    now_ += dt;
+
+    for (const auto& task : removed_)
+    {
+        RemoveTaskFromList(task.Get());
+    }
+    removed_.clear();
+
+    while (!queue_.empty() && queue_.front().deadline <= now_)
+    {
+        std::pop_heap(queue_.begin(), queue_.end(), TaskEntryLater());
+        expired_.push_back(std::move(queue_.back()));
+        queue_.pop_back();
+    }
+
+    if (expired_.empty())
+        return;
+
+    // update expired tasks in the order they were added, just like the per-frame mode
+    std::sort(expired_.begin(), expired_.end(),
+              [](const TaskEntry& lhs, const TaskEntry& rhs) { return lhs.sequence < rhs.sequence; });
+
+    for (const auto& entry : expired_)
+    {
+        Task* task = entry.task.Get();
+        if (task->scheduler_ != this || task->generation_ != entry.generation)
+            continue;
+
+        // the ticker receives all the time elapsed since it was updated last time,
+        // so it reports with the same delta time and error time as the per-frame mode
+        const Duration elapsed = now_ - task->since_;
+        task->since_           = now_;
+        task->Update(elapsed);
+
+        if (task->IsRemoveable())
+            RemoveTaskFromList(task);
+        else if (task->IsRunning() && task->generation_ == entry.generation)
+            ScheduleTask(task);
+    }
+    expired_.clear();
+}
+
+void TaskScheduler::ScheduleTask(Task* task)
+{
+    const auto& ticker   = task->GetTicker();
+    const auto  deadline = task->since_ + (ticker ? ticker->GetRemainingTime() : Duration());
+
+    queue_.push_back(TaskEntry{ deadline, task->sequence_, ++task->generation_, task });
+    std::push_heap(queue_.begin(), queue_.end(), TaskEntryLater());
+}
+
+void TaskScheduler::RemoveTaskFromList(Task* task)
+{
+    if (task->scheduler_ != this)
+        return;
+
+    task->scheduler_ = nullptr;
+    ++task->generation_;
+
+    RefPtr<Task> ptr = task;
+    tasks_.Remove(ptr);
+}
+
+void TaskScheduler::OnTaskStarted(Task* task)
+{
+    if (mode_ != TaskSchedulingMode::Deadline || task->IsRemoveable())
+        return;
+
+    // time elapsed before the task stopped still counts
+    task->since_           = now_ - task->stopped_elapsed_;
+    task->stopped_elapsed_ = 0;
+    ScheduleTask(task);
+}
+
+void TaskScheduler::OnTaskStopped(Task* task)
+{
+    if (mode_ != TaskSchedulingMode::Deadline)
+        return;
+
+    task->stopped_elapsed_ = now_ - task->since_;
+    ++task->generation_;
+}
+
+void TaskScheduler::OnTaskRemoved(Task* task)
+{
+    if (mode_ != TaskSchedulingMode::Deadline)
+        return;
+
+    // tasks are removed from list in the next update, for the list may be traversing now
+    ++task->generation_;
+    removed_.push_back(task);
+}
+
+void TaskScheduler::OnTaskTickerChanged(Task* task)
+{
+    if (mode_ != TaskSchedulingMode::Deadline || task->IsRemoveable())
+        return;
+
+    task->since_           = now_;
+    task->stopped_elapsed_ = 0;
+
+    if (task->IsRunning())
+        ScheduleTask(task);
+}
+
+void TaskScheduler::SetSchedulingMode(TaskSchedulingMode mode)
+{
+    if (mode_ == mode)
+        return;
+
+    mode_ = mode;
+    if (mode_ == TaskSchedulingMode::Deadline)
+    {
+        for (auto& task : tasks_)
+        {
+            task->since_           = now_;
+            task->stopped_elapsed_ = 0;
+
+            if (task->IsRunning() && !task->IsRemoveable())
+                ScheduleTask(task.Get());
+        }
+    }
+    else
+    {
+        // hand the time accumulated by the scheduler over to tickers
+        for (auto& task : tasks_)
+        {
+            ++task->generation_;
+
+            auto ticker = task->GetTicker();
+            if (!ticker || task->IsRemoveable())
+                continue;
+
+            if (task->IsRunning())
+            {
+                ticker->Tick(now_ - task->since_);
+            }
+            else if (!task->stopped_elapsed_.IsZero())
+            {
+                ticker->Resume();
+                ticker->Tick(task->stopped_elapsed_);
+                ticker->Pause();
+            }
+        }
+
+        queue_.clear();
+        removed_.clear();
     }
 }
 
@@ -48,7 +237,14 @@ Task* TaskScheduler::AddTask(RefPtr<Task> task)
     if (task)
     {
         task->Reset();
+        task->scheduler_       = this;
+        task->sequence_        = next_sequence_++;
+        task->since_           = now_;
+        task->stopped_elapsed_ = 0;
         tasks_.PushBack(task);
+
+        if (mode_ == TaskSchedulingMode::Deadline && task->IsRunning() && !task->IsRemoveable())
+            ScheduleTask(task.Get());
     }
     return task.Get();
 }
@@ -143,7 +339,15 @@ void TaskScheduler::StartAllTasks()
 
 void TaskScheduler::RemoveAllTasks()
 {
+    for (auto& task : tasks_)
+    {
+        task->scheduler_ = nullptr;
+        ++task->generation_;
+    }
+
     tasks_.Clear();
+    queue_.clear();
+    removed_.clear();
 }
 
 const TaskList& TaskScheduler::GetAllTasks() const
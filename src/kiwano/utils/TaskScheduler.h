@@ -28,13 +28,27 @@ namespace kiwano
 /// @brief б
 typedef IntrusiveList<RefPtr<Task>> TaskList;
 
+/// \~chinese
+/// @brief ģʽ
+enum class TaskSchedulingMode
+{
+    PerFrame,  ///< ÿ֡
+    Deadline,  ///< ʱȣÿֻ֡µڵ
+};
+
 /**
  * \~chinese
  * @brief 
  */
 class KGE_API TaskScheduler : Noncopyable
 {
+    friend class Task;
+
 public:
+    TaskScheduler();
+
+    ~TaskScheduler();
+
     /// \~chinese
     /// @brief 
     Task* AddTask(RefPtr<Task> task);
@@ -95,12 +109,58 @@ public:
     /// @brief ȡ
     const TaskList& GetAllTasks() const;
 
+    /// \~chinese
+    /// @brief ȡģʽ
+    TaskSchedulingMode GetSchedulingMode() const;
+
+    /// \~chinese
+    /// @brief ģʽ
+    /// @details ʱʱʣʱСѣÿ֡Ŀֻ뵽ڵйأ
+    /// ʺϴ񡣴ģʽ±ʱֻʱۼʱ䣬ͣ޸ıʱӦͨ
+    /// Task::StopTask::Start  Task::SetTicker Уֱ޸ıʱ´εʱЧ
+    /// @param mode ģʽ
+    void SetSchedulingMode(TaskSchedulingMode mode);
+
     /// \~chinese
     /// @brief µ
     void Update(Duration dt);
 
 private:
-    TaskList tasks_;
+    void UpdateDeadlineTasks(Duration dt);
+
+    void ScheduleTask(Task* task);
+
+    void RemoveTaskFromList(Task* task);
+
+    void OnTaskStarted(Task* task);
+
+    void OnTaskStopped(Task* task);
+
+    void OnTaskRemoved(Task* task);
+
+    void OnTaskTickerChanged(Task* task);
+
+private:
+    struct TaskEntry
+    {
+        Duration     deadline;
+        uint64_t     sequence;
+        uint64_t     generation;
+        RefPtr<Task> task;
+    };
+
+    TaskSchedulingMode   mode_;
+    Duration             now_;
+    uint64_t             next_sequence_;
+    TaskList             tasks_;
+    Vector<TaskEntry>    queue_;
+    Vector<TaskEntry>    expired_;
+    Vector<RefPtr<Task>> removed_;
 };
 
+inline TaskSchedulingMode TaskScheduler::GetSchedulingMode() const
+{
+    return mode_;
+}
+
 }  // namespace kiwano
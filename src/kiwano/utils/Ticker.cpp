@@ -100,6 +100,15 @@ Duration Ticker::GetDeltaTime()
     return delta_time_;
 }
 
+Duration Ticker::GetRemainingTime() const
+{
+    if (interval_.IsZero())
+        return 0;
+
+    Duration remaining = interval_ - elapsed_time_ - error_time_;
+    return remaining < 0 ? 0 : remaining;
+}
+
 RefPtr<Timer> Ticker::GetTimer()
 {
     return timer_;
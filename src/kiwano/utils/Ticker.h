@@ -88,6 +88,11 @@ public:
     /// @brief ȡʱ
     Duration GetErrorTime() const;
 
+    /// \~chinese
+    /// @brief ȡ´αʱʱ
+    /// @details ´αʱǰۼƵʱѼʱ
+    Duration GetRemainingTime() const;
+
     /// \~chinese
     /// @brief ȡʱ
     RefPtr<Timer> GetTimer();
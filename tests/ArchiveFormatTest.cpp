@@ -0,0 +1,135 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Test.h"
+#include <kiwano/platform/ArchiveFormat.h>
+#include <cstring>
+#include <vector>
+
+using namespace kiwano;
+
+namespace
+{
+std::vector<uint8_t> MakeSample(size_t size)
+{
+    // Repeating text with some noise, so both literals and matches are produced
+    const char*          text = "kiwano archive format sample ";
+    std::vector<uint8_t> data(size);
+    uint32_t             seed = 12345;
+    for (size_t i = 0; i < size; ++i)
+    {
+        seed    = seed * 1103515245u + 12345u;
+        data[i] = (seed >> 24) % 7 == 0 ? uint8_t(seed >> 16) : uint8_t(text[i % 29]);
+    }
+    return data;
+}
+
+bool RoundTrip(const std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> packed = archive::Compress(data.data(), data.size());
+    if (data.size() > archive::MaxDecompressedSize(packed.size()))
+        return false;
+
+    std::vector<uint8_t> unpacked(data.size());
+    if (!archive::Decompress(packed.data(), packed.size(), unpacked.data(), unpacked.size()))
+        return false;
+    return unpacked == data;
+}
+}  // namespace
+
+KGE_TEST(ArchiveFormatRoundTrip)
+{
+    KGE_CHECK(RoundTrip(MakeSample(1)));
+    KGE_CHECK(RoundTrip(MakeSample(100)));
+    KGE_CHECK(RoundTrip(MakeSample(256 * 1024)));
+
+    // Long runs need the extra length bytes and expand the most
+    std::vector<uint8_t> zeros(1024 * 1024, 0);
+    KGE_CHECK(RoundTrip(zeros));
+}
+
+KGE_TEST(ArchiveFormatEmptyFile)
+{
+    std::vector<uint8_t> packed = archive::Compress(nullptr, 0);
+    KGE_CHECK(!packed.empty());
+
+    // The last sequence of an empty block has no literals to copy into the missing buffer
+    KGE_CHECK(archive::Decompress(packed.data(), packed.size(), nullptr, 0));
+}
+
+KGE_TEST(ArchiveFormatRejectsCorruptData)
+{
+    std::vector<uint8_t> data   = MakeSample(4096);
+    std::vector<uint8_t> packed = archive::Compress(data.data(), data.size());
+    std::vector<uint8_t> unpacked(data.size());
+
+    // Wrong sizes
+    KGE_CHECK(!archive::Decompress(packed.data(), packed.size(), unpacked.data(), unpacked.size() - 1));
+    KGE_CHECK(!archive::Decompress(packed.data(), packed.size() / 2, unpacked.data(), unpacked.size()));
+
+    // Every single-byte corruption either fails or stays inside the output buffer
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        std::vector<uint8_t> corrupted = packed;
+        corrupted[i] ^= 0xFF;
+        archive::Decompress(corrupted.data(), corrupted.size(), unpacked.data(), unpacked.size());
+    }
+
+    // A match pointing before the start of the output
+    const uint8_t bad_offset[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+    KGE_CHECK(!archive::Decompress(bad_offset, sizeof(bad_offset), unpacked.data(), 16));
+}
+
+KGE_TEST(ArchiveFormatBuildsIndex)
+{
+    std::vector<archive::PackedFile> files;
+    std::vector<uint8_t>             data = MakeSample(1000);
+    files.push_back(archive::PackFile("dir\\a.txt", data.data(), data.size(), true));
+    files.push_back(archive::PackFile("./b.bin", data.data(), data.size(), false));
+
+    std::vector<uint8_t> image = archive::Build(files);
+    KGE_CHECK(image.size() >= sizeof(archive::Header) + 2 * sizeof(archive::Entry));
+
+    archive::Header header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    KGE_CHECK(std::memcmp(header.magic, archive::Magic, sizeof(archive::Magic)) == 0);
+    KGE_CHECK(header.version == archive::Version);
+    KGE_CHECK(header.entry_count == 2);
+
+    for (uint32_t i = 0; i < header.entry_count; ++i)
+    {
+        archive::Entry entry;
+        std::memcpy(&entry, image.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        KGE_CHECK(entry.data_offset % archive::DataAlignment == 0);
+        KGE_CHECK(entry.original_size == data.size());
+
+        std::string name(reinterpret_cast<const char*>(image.data() + header.names_offset + entry.name_offset),
+                         entry.name_length);
+        KGE_CHECK(name == "dir/a.txt" || name == "b.bin");
+
+        std::vector<uint8_t> unpacked(entry.original_size);
+        const uint8_t*       stored = image.data() + entry.data_offset;
+        if (entry.flags & archive::EntryCompressed)
+            KGE_CHECK(archive::Decompress(stored, entry.stored_size, unpacked.data(), unpacked.size()));
+        else
+            std::memcpy(unpacked.data(), stored, entry.stored_size);
+        KGE_CHECK(unpacked == data);
+    }
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Test.h"
+#include <kiwano/core/Function.h>
+#include <array>
+#include <vector>
+
+using namespace kiwano;
+
+namespace
+{
+struct Base1
+{
+    virtual ~Base1() = default;
+};
+
+struct Base2
+{
+    virtual ~Base2() = default;
+};
+
+struct Handler
+    : public Base1
+    , public Base2
+{
+    void OnTask(void*, int dt)
+    {
+        sum += dt;
+    }
+
+    int sum = 0;
+};
+
+const int kIterations = 1000000;
+
+// constructs and copies kIterations functions, as a scheduler or dispatcher does when it stores a callback
+template <typename _Ty, typename _Factory>
+void Measure(const char* name, _Factory&& factory)
+{
+    std::vector<Function<_Ty>> stored;
+    stored.reserve(kIterations);
+
+    uint64_t        allocations = test::GetAllocationCount();
+    test::Stopwatch watch;
+    for (int i = 0; i < kIterations; ++i)
+    {
+        Function<_Ty> func = factory(i);
+        stored.push_back(func);
+    }
+    double elapsed = watch.GetMilliseconds();
+
+    double per_callback = double(test::GetAllocationCount() - allocations) / kIterations;
+    std::printf("  %-32s %s, %.2f allocations per callback, %.1f ns per callback\n", name,
+                stored.front().IsStoredInline() ? "inline" : "heap  ", per_callback, elapsed * 1e6 / kIterations);
+}
+}  // namespace
+
+// The baseline Function allocated one ref-counted proxy per callback, so every line below was 1.00 allocation
+// per callback and each copy bumped a shared reference count.
+KGE_BENCHMARK(FunctionAllocations)
+{
+    std::printf("  sizeof(Function) = %u bytes\n", unsigned(sizeof(Function<void()>)));
+
+    Handler handler;
+    Measure<void(void*, int)>("member closure (multiple bases)",
+                              [&](int) { return Closure(&handler, &Handler::OnTask); });
+
+    Measure<void(void*, int)>("lambda capturing this", [&](int) {
+        Handler* self = &handler;
+        return [self](void*, int dt) { self->sum += dt; };
+    });
+
+    Measure<void(void*, int)>("lambda capturing 3 values", [&](int i) {
+        Handler* self = &handler;
+        int      a = i, b = i + 1;
+        double   c = i * 0.5;
+        return [self, a, b, c](void*, int dt) { self->sum += dt + a + b + int(c); };
+    });
+
+    Measure<void(void*, int)>("lambda capturing 64 bytes", [&](int i) {
+        std::array<char, 64> payload = {};
+        payload[0]                   = char(i);
+        return [payload](void*, int) {};
+    });
+}
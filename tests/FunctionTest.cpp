@@ -0,0 +1,168 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Test.h"
+#include <kiwano/core/Function.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace kiwano;
+
+namespace
+{
+struct Base1
+{
+    virtual ~Base1() = default;
+
+    int value1 = 1;
+};
+
+struct Base2
+{
+    virtual ~Base2() = default;
+
+    int value2 = 2;
+};
+
+// member function pointers of classes with multiple inheritance are the largest common case
+struct Listener
+    : public Base1
+    , public Base2
+{
+    void OnEvent(int value)
+    {
+        sum += value;
+    }
+
+    int GetSum() const
+    {
+        return sum;
+    }
+
+    int sum = 0;
+};
+
+struct DestroyCounter
+{
+    explicit DestroyCounter(std::atomic<int>* counter)
+        : counter(counter)
+    {
+    }
+
+    DestroyCounter(const DestroyCounter& rhs)
+        : counter(rhs.counter)
+    {
+    }
+
+    ~DestroyCounter()
+    {
+        if (counter)
+            counter->fetch_add(1);
+    }
+
+    std::atomic<int>* counter;
+};
+}  // namespace
+
+KGE_TEST(FunctionIsSmall)
+{
+    KGE_CHECK(sizeof(Function<void()>) <= sizeof(void*) * 5);
+}
+
+KGE_TEST(FunctionStoresMemberClosuresInline)
+{
+    Listener listener;
+
+    uint64_t                allocations = test::GetAllocationCount();
+    Function<void(int)>     on_event    = Closure(&listener, &Listener::OnEvent);
+    Function<int()>         get_sum     = Closure(&listener, &Listener::GetSum);
+    Function<void(int)>     copy        = on_event;
+    KGE_CHECK(test::GetAllocationCount() == allocations);
+
+    KGE_CHECK(on_event.IsStoredInline());
+    KGE_CHECK(get_sum.IsStoredInline());
+    on_event(2);
+    copy(3);
+    KGE_CHECK(get_sum() == 5);
+}
+
+KGE_TEST(FunctionStoresSmallLambdasInline)
+{
+    int  a = 1, b = 2, c = 3;
+    int* pa = &a;
+    int* pb = &b;
+    int* pc = &c;
+
+    uint64_t        allocations = test::GetAllocationCount();
+    Function<int()> func        = [pa, pb, pc]() { return *pa + *pb + *pc; };
+    Function<int()> copy        = func;
+    Function<int()> moved       = std::move(copy);
+    KGE_CHECK(test::GetAllocationCount() == allocations);
+
+    KGE_CHECK(func.IsStoredInline());
+    KGE_CHECK(!copy);
+    KGE_CHECK(moved() == 6);
+}
+
+KGE_TEST(FunctionSharesLargeCallables)
+{
+    std::array<char, 64> payload = {};
+    payload[0]                   = 7;
+
+    Function<int()> func = [payload]() { return int(payload[0]); };
+    KGE_CHECK(!func.IsStoredInline());
+
+    uint64_t        allocations = test::GetAllocationCount();
+    Function<int()> copy        = func;
+    KGE_CHECK(test::GetAllocationCount() == allocations);
+    KGE_CHECK(copy() == 7);
+}
+
+KGE_TEST(FunctionDestroysSharedCallableOnce)
+{
+    std::atomic<int> destroyed(0);
+    {
+        std::array<char, 64> payload = {};
+
+        Function<void()> func = [payload, counter = DestroyCounter(&destroyed)]() {};
+        destroyed.store(0);  // the temporary counter
+
+        // copies of a heap callable may be made and dropped on any thread
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([func]() {
+                for (int n = 0; n < 100000; ++n)
+                {
+                    Function<void()> copy = func;
+                    copy();
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        KGE_CHECK(destroyed.load() == 0);
+    }
+    KGE_CHECK(destroyed.load() == 1);
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Test.h"
+#include "ImageEncoder.h"
+#include <kiwano/render/ImageCodec.h>
+#include <vector>
+
+using namespace kiwano;
+
+namespace
+{
+const uint32_t kSize       = 1024;
+const int      kIterations = 5;
+
+void Measure(const char* name, const std::vector<uint8_t>& data)
+{
+    image::Image img;
+    bool         decoded = true;
+
+    test::Stopwatch watch;
+    for (int i = 0; i < kIterations; ++i)
+        decoded = image::Decode(data.data(), data.size(), img) && decoded;
+    double elapsed = watch.GetMilliseconds() / kIterations;
+
+    double megapixels = double(kSize) * kSize / 1e6;
+    std::printf("  %-28s %8.2f ms, %7.1f MP/s, %8u KB%s\n", name, elapsed, megapixels * 1000 / elapsed,
+                unsigned(data.size() / 1024), decoded ? "" : ", FAILED");
+}
+}  // namespace
+
+// Decodes a 1024 x 1024 image in each supported layout
+KGE_BENCHMARK(ImageCodecDecode)
+{
+    image::Image rgba   = test::MakeTestImage(kSize, kSize, true);
+    image::Image opaque = test::MakeTestImage(kSize, kSize, false);
+
+    test::PngOptions png;
+    Measure("PNG RGBA", test::EncodePng(rgba, png));
+    png.interlaced = true;
+    Measure("PNG RGBA interlaced", test::EncodePng(rgba, png));
+    png            = test::PngOptions();
+    png.color_type = 2;
+    Measure("PNG RGB", test::EncodePng(opaque, png));
+
+    test::JpegOptions jpeg;
+    Measure("JPEG 4:4:4", test::EncodeJpeg(opaque, jpeg));
+    jpeg.subsample = true;
+    Measure("JPEG 4:2:0", test::EncodeJpeg(opaque, jpeg));
+
+    Measure("BMP 24-bit", test::EncodeBmp(opaque, 24));
+    Measure("BMP 32-bit", test::EncodeBmp(rgba, 32));
+}
+
+// Premultiplies and swizzles a 1024 x 1024 image, which Texture::Load does for every decoded image
+KGE_BENCHMARK(ImageCodecConvertPixels)
+{
+    image::Image img = test::MakeTestImage(kSize, kSize, true);
+
+    test::Stopwatch watch;
+    for (int i = 0; i < kIterations; ++i)
+        image::ConvertPixels(img.pixels.data(), size_t(kSize) * kSize, true, true);
+    double elapsed = watch.GetMilliseconds() / kIterations;
+
+    std::printf("  %-28s %8.2f ms, %7.1f MP/s\n", "premultiply + swap", elapsed, double(kSize) * kSize / 1e3 / elapsed);
+}
@@ -0,0 +1,345 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Test.h"
+#include "ImageEncoder.h"
+#include <kiwano/render/ImageCodec.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace kiwano;
+
+namespace
+{
+bool Decode(const std::vector<uint8_t>& data, image::Image& img)
+{
+    return image::Decode(data.data(), data.size(), img);
+}
+
+bool SamePixels(const image::Image& a, const image::Image& b)
+{
+    return a.width == b.width && a.height == b.height && a.pixels == b.pixels;
+}
+
+// Mean absolute difference of the color channels
+double MeanError(const image::Image& a, const image::Image& b)
+{
+    if (a.width != b.width || a.height != b.height || a.pixels.size() != b.pixels.size())
+        return 1e9;
+
+    double sum = 0;
+    for (size_t i = 0; i < a.pixels.size(); i += 4)
+    {
+        for (size_t c = 0; c < 3; ++c)
+            sum += std::abs(int(a.pixels[i + c]) - int(b.pixels[i + c]));
+    }
+    return sum / (double(a.width) * a.height * 3);
+}
+
+// The first few colors of the test image, so it fits a palette
+image::Image MakePaletteImage(uint32_t width, uint32_t height)
+{
+    image::Image img = test::MakeTestImage(width, height, true);
+    for (size_t i = 0; i < img.pixels.size(); i += 4)
+    {
+        img.pixels[i + 0] &= 0xC0;
+        img.pixels[i + 1] &= 0xC0;
+        img.pixels[i + 3] &= 0x80;
+    }
+    return img;
+}
+
+void WriteBE32(std::vector<uint8_t>& data, size_t pos, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i)
+        data[pos + i] = uint8_t(v >> (24 - i * 8));
+}
+}  // namespace
+
+KGE_TEST(ImageCodecDecodesBmp)
+{
+    image::Image source = test::MakeTestImage(37, 21, true);
+    image::Image opaque = test::MakeTestImage(37, 21, false);
+    image::Image img;
+
+    KGE_CHECK(Decode(test::EncodeBmp(opaque, 24), img) && SamePixels(img, opaque) && !img.has_alpha);
+    KGE_CHECK(Decode(test::EncodeBmp(opaque, 24, true), img) && SamePixels(img, opaque));
+    KGE_CHECK(Decode(test::EncodeBmp(source, 32), img) && SamePixels(img, source) && img.has_alpha);
+}
+
+KGE_TEST(ImageCodecDecodesPng)
+{
+    image::Image rgba = test::MakeTestImage(45, 29, true);
+    image::Image img;
+
+    test::PngOptions opt;
+    KGE_CHECK(Decode(test::EncodePng(rgba, opt), img) && SamePixels(img, rgba) && img.has_alpha);
+
+    opt.blocks = test::DeflateBlocks::Fixed;
+    KGE_CHECK(Decode(test::EncodePng(rgba, opt), img) && SamePixels(img, rgba));
+
+    opt.blocks = test::DeflateBlocks::Stored;
+    KGE_CHECK(Decode(test::EncodePng(rgba, opt), img) && SamePixels(img, rgba));
+
+    opt.blocks     = test::DeflateBlocks::Dynamic;
+    opt.idat_chunk = 50;
+    KGE_CHECK(Decode(test::EncodePng(rgba, opt), img) && SamePixels(img, rgba));
+
+    opt.idat_chunk = 0;
+    opt.interlaced = true;
+    KGE_CHECK(Decode(test::EncodePng(rgba, opt), img) && SamePixels(img, rgba));
+
+    opt.depth = 16;
+    KGE_CHECK(Decode(test::EncodePng(rgba, opt), img) && SamePixels(img, rgba));
+
+    for (int filter = 0; filter < 5; ++filter)
+    {
+        test::PngOptions single;
+        single.filter = filter;
+        KGE_CHECK(Decode(test::EncodePng(rgba, single), img) && SamePixels(img, rgba));
+    }
+
+    image::Image opaque = test::MakeTestImage(45, 29, false);
+    opt                 = test::PngOptions();
+    opt.color_type      = 2;
+    KGE_CHECK(Decode(test::EncodePng(opaque, opt), img) && SamePixels(img, opaque) && !img.has_alpha);
+
+    image::Image gray = opaque;
+    test::MakeGray(gray);
+    opt.color_type = 0;
+    KGE_CHECK(Decode(test::EncodePng(gray, opt), img) && SamePixels(img, gray));
+
+    image::Image gray_alpha = rgba;
+    test::MakeGray(gray_alpha);
+    opt.color_type = 4;
+    opt.depth      = 16;
+    KGE_CHECK(Decode(test::EncodePng(gray_alpha, opt), img) && SamePixels(img, gray_alpha));
+
+    image::Image indexed = MakePaletteImage(45, 29);
+    opt                  = test::PngOptions();
+    opt.color_type       = 3;
+    opt.interlaced       = true;
+    KGE_CHECK(Decode(test::EncodePng(indexed, opt), img) && SamePixels(img, indexed) && img.has_alpha);
+}
+
+KGE_TEST(ImageCodecDecodesJpeg)
+{
+    image::Image source = test::MakeTestImage(67, 45, false);
+    image::Image img;
+
+    test::JpegOptions opt;
+    KGE_CHECK(Decode(test::EncodeJpeg(source, opt), img) && MeanError(img, source) < 2.0 && !img.has_alpha);
+
+    opt.subsample = true;
+    KGE_CHECK(Decode(test::EncodeJpeg(source, opt), img) && MeanError(img, source) < 6.0);
+
+    opt.restart_interval = 3;
+    KGE_CHECK(Decode(test::EncodeJpeg(source, opt), img) && MeanError(img, source) < 6.0);
+
+    opt            = test::JpegOptions();
+    opt.wide_quant = true;
+    KGE_CHECK(Decode(test::EncodeJpeg(source, opt), img) && MeanError(img, source) < 2.0);
+
+    image::Image gray = source;
+    test::MakeGray(gray);
+    opt      = test::JpegOptions();
+    opt.gray = true;
+    KGE_CHECK(Decode(test::EncodeJpeg(gray, opt), img) && MeanError(img, gray) < 2.0);
+}
+
+KGE_TEST(ImageCodecRejectsOversizedImages)
+{
+    image::Image img;
+
+    // Each side is within MaxDimension but the pixel count is not, and the header comes with almost no data
+    std::vector<uint8_t> png = test::EncodePng(test::MakeTestImage(8, 8, true));
+    WriteBE32(png, 16, image::MaxDimension);
+    WriteBE32(png, 20, image::MaxDimension);
+    uint64_t allocated = test::GetAllocatedBytes();
+    KGE_CHECK(!Decode(png, img));
+    KGE_CHECK(test::GetAllocatedBytes() - allocated < 64 * 1024);
+
+    // Within the pixel limit, but more pixels than the stream can inflate to
+    WriteBE32(png, 16, 4096);
+    WriteBE32(png, 20, 4096);
+    allocated = test::GetAllocatedBytes();
+    KGE_CHECK(!Decode(png, img));
+    KGE_CHECK(test::GetAllocatedBytes() - allocated < 64 * 1024);
+
+    // A JPEG frame of 32768 x 2048 blocks described by a few hundred bytes
+    std::vector<uint8_t> jpeg = test::EncodeJpeg(test::MakeTestImage(16, 16, false));
+    for (size_t i = 0; i + 8 < jpeg.size(); ++i)
+    {
+        if (jpeg[i] == 0xFF && jpeg[i + 1] == 0xC0)
+        {
+            jpeg[i + 5] = 0x40;
+            jpeg[i + 6] = 0x00;
+            jpeg[i + 7] = 0x80;
+            jpeg[i + 8] = 0x00;
+            break;
+        }
+    }
+    allocated = test::GetAllocatedBytes();
+    KGE_CHECK(!Decode(jpeg, img));
+    KGE_CHECK(test::GetAllocatedBytes() - allocated < 64 * 1024);
+    KGE_CHECK(img.pixels.empty());
+}
+
+KGE_TEST(ImageCodecSurvivesCorruptJpegCoefficients)
+{
+    // Huge quantization values and random entropy-coded data drive the IDCT far outside the range of valid
+    // images. Built with -fsanitize=undefined this checks the fixed-point arithmetic doesn't overflow
+    test::JpegOptions opt;
+    opt.wide_quant            = true;
+    std::vector<uint8_t> jpeg = test::EncodeJpeg(test::MakeTestImage(64, 64, false), opt);
+
+    size_t dqt = 0, sos = 0;
+    for (size_t i = 0; i + 1 < jpeg.size(); ++i)
+    {
+        if (jpeg[i] == 0xFF && jpeg[i + 1] == 0xDB && !dqt)
+            dqt = i;
+        if (jpeg[i] == 0xFF && jpeg[i + 1] == 0xDA)
+            sos = i;
+    }
+    KGE_CHECK(dqt && sos);
+
+    for (size_t k = 0; k < 64; ++k)
+    {
+        jpeg[dqt + 5 + k * 2]     = 0xFF;
+        jpeg[dqt + 5 + k * 2 + 1] = 0xFF;
+    }
+
+    const size_t data_start = sos + 2 + 8 + 3 * 2;
+    uint32_t     seed       = 1;
+    for (int round = 0; round < 32; ++round)
+    {
+        for (size_t i = data_start; i + 2 < jpeg.size(); ++i)
+        {
+            seed    = seed * 1103515245u + 12345u;
+            jpeg[i] = uint8_t(seed >> 24);
+            if (jpeg[i] == 0xFF)
+                jpeg[i] = 0x7F;
+        }
+        image::Image img;
+        Decode(jpeg, img);
+    }
+}
+
+KGE_TEST(ImageCodecSurvivesMutations)
+{
+    // A small in-process fuzzer over one seed per decoder path. Decoding must fail cleanly or produce a
+    // complete image, which ASan and UBSan builds check in depth
+    image::Image      rgba = test::MakeTestImage(24, 17, true);
+    test::PngOptions  interlaced;
+    test::JpegOptions subsampled;
+    interlaced.interlaced      = true;
+    subsampled.subsample       = true;
+    subsampled.restart_interval = 2;
+
+    std::vector<std::vector<uint8_t>> seeds = {
+        test::EncodeBmp(rgba, 24),
+        test::EncodeBmp(rgba, 32),
+        test::EncodePng(rgba),
+        test::EncodePng(rgba, interlaced),
+        test::EncodeJpeg(rgba),
+        test::EncodeJpeg(rgba, subsampled),
+    };
+
+    uint32_t seed = 12345;
+    auto     next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    };
+
+    for (const auto& original : seeds)
+    {
+        for (int round = 0; round < 500; ++round)
+        {
+            std::vector<uint8_t> data = original;
+            switch (next() % 4)
+            {
+            case 0:
+                data.resize(next() % data.size());
+                break;
+            case 1:
+                data[next() % data.size()] ^= uint8_t(1 << (next() % 8));
+                break;
+            case 2:
+                for (int i = 0; i < 8; ++i)
+                    data[next() % data.size()] = uint8_t(next());
+                break;
+            default:
+                data.insert(data.begin() + next() % data.size(), uint8_t(next()));
+                break;
+            }
+
+            image::Image img;
+            if (Decode(data, img))
+            {
+                KGE_CHECK(img.width > 0 && img.height > 0);
+                KGE_CHECK(img.pixels.size() == size_t(img.width) * img.height * 4);
+            }
+            else
+            {
+                KGE_CHECK(img.pixels.empty());
+            }
+        }
+    }
+}
+
+KGE_TEST(ImageCodecConvertsPixels)
+{
+    // Every color and alpha pair, with a count that leaves a remainder for the scalar path
+    std::vector<uint8_t> pixels;
+    for (uint32_t a = 0; a < 256; ++a)
+    {
+        for (uint32_t c = 0; c < 256; ++c)
+        {
+            pixels.push_back(uint8_t(c));
+            pixels.push_back(uint8_t(255 - c));
+            pixels.push_back(uint8_t(c / 2));
+            pixels.push_back(uint8_t(a));
+        }
+    }
+    pixels.insert(pixels.end(), { 10, 20, 30, 128, 40, 50, 60, 64, 70, 80, 90, 0 });
+    const size_t count = pixels.size() / 4;
+
+    std::vector<uint8_t> converted = pixels;
+    image::ConvertPixels(converted.data(), count, true, true);
+
+    bool exact = true;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint8_t* src = &pixels[i * 4];
+        const uint8_t* dst = &converted[i * 4];
+        for (int c = 0; c < 3; ++c)
+        {
+            uint32_t expected = (uint32_t(src[2 - c]) * src[3] + 127) / 255;
+            exact             = exact && dst[c] == expected;
+        }
+        exact = exact && dst[3] == src[3];
+    }
+    KGE_CHECK(exact);
+
+    converted = pixels;
+    image::ConvertPixels(converted.data(), count, false, false);
+    KGE_CHECK(converted == pixels);
+}
@@ -0,0 +1,886 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/render/ImageCodec.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Small encoders that produce the inputs of the image codec tests, benchmarks and fuzz corpus. They favour
+// covering the decoder's paths over compression ratio.
+
+namespace kiwano
+{
+namespace test
+{
+
+// A gradient with hard edges and, optionally, varying alpha
+inline image::Image MakeTestImage(uint32_t width, uint32_t height, bool alpha)
+{
+    image::Image img;
+    img.width     = width;
+    img.height    = height;
+    img.has_alpha = alpha;
+    img.pixels.resize(size_t(width) * height * 4);
+
+    uint8_t* p = img.pixels.data();
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x, p += 4)
+        {
+            p[0] = uint8_t(x * 255 / (width > 1 ? width - 1 : 1));
+            p[1] = uint8_t(y * 255 / (height > 1 ? height - 1 : 1));
+            p[2] = ((x / 16 + y / 16) & 1) ? 200 : 40;
+            p[3] = alpha ? uint8_t((x + y) * 255 / (width + height)) : 255;
+        }
+    }
+    return img;
+}
+
+// Replaces every pixel with the gray value of its red channel
+inline void MakeGray(image::Image& img)
+{
+    for (size_t i = 0; i < img.pixels.size(); i += 4)
+        img.pixels[i + 1] = img.pixels[i + 2] = img.pixels[i];
+}
+
+//-------------------------------------------------------
+// BMP
+//-------------------------------------------------------
+
+inline void PutLE16(std::vector<uint8_t>& out, uint32_t v)
+{
+    out.push_back(uint8_t(v));
+    out.push_back(uint8_t(v >> 8));
+}
+
+inline void PutLE32(std::vector<uint8_t>& out, uint32_t v)
+{
+    PutLE16(out, v & 0xFFFF);
+    PutLE16(out, v >> 16);
+}
+
+// 24-bit BI_RGB, or 32-bit BI_BITFIELDS with an alpha mask
+inline std::vector<uint8_t> EncodeBmp(const image::Image& img, uint32_t bpp, bool top_down = false)
+{
+    const uint32_t header_size = bpp == 32 ? 108 : 40;
+    const uint32_t stride      = (img.width * bpp / 8 + 3) & ~3u;
+    const uint32_t offset      = 14 + header_size;
+
+    std::vector<uint8_t> out;
+    out.push_back('B');
+    out.push_back('M');
+    PutLE32(out, offset + stride * img.height);
+    PutLE32(out, 0);
+    PutLE32(out, offset);
+
+    PutLE32(out, header_size);
+    PutLE32(out, img.width);
+    PutLE32(out, top_down ? uint32_t(-int32_t(img.height)) : img.height);
+    PutLE16(out, 1);
+    PutLE16(out, bpp);
+    PutLE32(out, bpp == 32 ? 3 : 0);
+    PutLE32(out, stride * img.height);
+    PutLE32(out, 2835);
+    PutLE32(out, 2835);
+    PutLE32(out, 0);
+    PutLE32(out, 0);
+    if (bpp == 32)
+    {
+        PutLE32(out, 0x00FF0000);
+        PutLE32(out, 0x0000FF00);
+        PutLE32(out, 0x000000FF);
+        PutLE32(out, 0xFF000000);
+        out.resize(offset, 0);
+    }
+
+    for (uint32_t i = 0; i < img.height; ++i)
+    {
+        uint32_t       y   = top_down ? i : img.height - 1 - i;
+        const uint8_t* src = &img.pixels[size_t(y) * img.width * 4];
+        size_t         row = out.size();
+        for (uint32_t x = 0; x < img.width; ++x, src += 4)
+        {
+            out.push_back(src[2]);
+            out.push_back(src[1]);
+            out.push_back(src[0]);
+            if (bpp == 32)
+                out.push_back(src[3]);
+        }
+        out.resize(row + stride, 0);
+    }
+    return out;
+}
+
+//-------------------------------------------------------
+// PNG
+//-------------------------------------------------------
+
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<uint8_t>& out)
+        : out_(out)
+    {
+    }
+
+    // Writes the low `count` bits of `value`, least significant bit first
+    void Write(uint32_t value, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            bits_ |= ((value >> i) & 1) << filled_;
+            if (++filled_ == 8)
+                Flush();
+        }
+    }
+
+    // Huffman codes are stored most significant bit first
+    void WriteCode(uint32_t code, uint32_t length)
+    {
+        for (uint32_t i = length; i > 0; --i)
+            Write((code >> (i - 1)) & 1, 1);
+    }
+
+    void Flush()
+    {
+        if (filled_)
+        {
+            out_.push_back(uint8_t(bits_));
+            bits_   = 0;
+            filled_ = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint32_t              bits_   = 0;
+    uint32_t              filled_ = 0;
+};
+
+// Deflate block types
+enum class DeflateBlocks
+{
+    Stored,
+    Fixed,
+    Dynamic,
+};
+
+// Canonical Huffman codes from code lengths, as RFC 1951 section 3.2.2 assigns them
+inline void BuildDeflateCodes(const uint8_t* lengths, uint32_t count, uint16_t* codes)
+{
+    uint32_t length_count[16] = {}, next[16] = {};
+    for (uint32_t i = 0; i < count; ++i)
+        ++length_count[lengths[i]];
+    length_count[0] = 0;
+    for (uint32_t len = 1, code = 0; len < 16; ++len)
+    {
+        code      = (code + length_count[len - 1]) << 1;
+        next[len] = code;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (lengths[i])
+            codes[i] = uint16_t(next[lengths[i]]++);
+    }
+}
+
+// One Huffman block with greedy LZ77 matches, or stored blocks. Dynamic blocks use fixed but complete
+// code lengths sent in the block header, including runs coded with the repeat symbol
+inline std::vector<uint8_t> Deflate(const std::vector<uint8_t>& data, DeflateBlocks blocks)
+{
+    static const uint16_t length_base[29]  = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                              31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const uint8_t  length_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                              2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const uint16_t dist_base[30]    = { 1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                            33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                            1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const uint8_t  dist_extra[30]   = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                            6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    std::vector<uint8_t> out;
+    out.push_back(0x78);
+    out.push_back(0x01);
+
+    if (blocks == DeflateBlocks::Stored)
+    {
+        size_t pos = 0;
+        do
+        {
+            size_t len = std::min<size_t>(data.size() - pos, 65535);
+            out.push_back(pos + len == data.size() ? 1 : 0);
+            PutLE16(out, uint32_t(len));
+            PutLE16(out, uint32_t(~len & 0xFFFF));
+            out.insert(out.end(), data.begin() + pos, data.begin() + pos + len);
+            pos += len;
+        } while (pos < data.size());
+    }
+    else
+    {
+        // The fixed code, or the dynamic one: 8 bits for the first 226 symbols and 9 for the rest
+        uint8_t  lit_lengths[288], dist_lengths[30];
+        uint16_t lit_codes[288], dist_codes[30];
+        for (uint32_t i = 0; i < 288; ++i)
+        {
+            if (blocks == DeflateBlocks::Fixed)
+                lit_lengths[i] = i < 144 ? 8 : (i < 256 ? 9 : (i < 280 ? 7 : 8));
+            else
+                lit_lengths[i] = i < 226 ? 8 : 9;
+        }
+        for (uint32_t i = 0; i < 30; ++i)
+            dist_lengths[i] = blocks == DeflateBlocks::Fixed ? 5 : (i < 2 ? 4 : 5);
+        BuildDeflateCodes(lit_lengths, blocks == DeflateBlocks::Fixed ? 288 : 286, lit_codes);
+        BuildDeflateCodes(dist_lengths, 30, dist_codes);
+
+        BitWriter bits(out);
+        bits.Write(1, 1);
+        bits.Write(blocks == DeflateBlocks::Fixed ? 1 : 2, 2);
+
+        if (blocks == DeflateBlocks::Dynamic)
+        {
+            static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+            uint8_t  cl_lengths[19] = {};
+            uint16_t cl_codes[19]   = {};
+            cl_lengths[4] = cl_lengths[5] = cl_lengths[8] = cl_lengths[9] = cl_lengths[17] = cl_lengths[18] = 3;
+            cl_lengths[16] = 2;
+            BuildDeflateCodes(cl_lengths, 19, cl_codes);
+
+            bits.Write(286 - 257, 5);
+            bits.Write(30 - 1, 5);
+            bits.Write(19 - 4, 4);
+            for (uint32_t i = 0; i < 19; ++i)
+                bits.Write(cl_lengths[order[i]], 3);
+
+            std::vector<uint8_t> all(lit_lengths, lit_lengths + 286);
+            all.insert(all.end(), dist_lengths, dist_lengths + 30);
+            for (size_t i = 0; i < all.size();)
+            {
+                bits.WriteCode(cl_codes[all[i]], cl_lengths[all[i]]);
+                size_t run = 1;
+                while (i + run < all.size() && all[i + run] == all[i])
+                    ++run;
+                size_t repeat = run - 1;
+                while (repeat >= 3)
+                {
+                    size_t n = std::min<size_t>(repeat, 6);
+                    bits.WriteCode(cl_codes[16], cl_lengths[16]);
+                    bits.Write(uint32_t(n - 3), 2);
+                    repeat -= n;
+                }
+                i += run - repeat;
+            }
+        }
+
+        auto put_literal = [&](uint32_t symbol) { bits.WriteCode(lit_codes[symbol], lit_lengths[symbol]); };
+
+        std::vector<int32_t> head(1 << 15, -1);
+        size_t               pos = 0;
+        while (pos < data.size())
+        {
+            size_t best_len = 0, best_dist = 0;
+            if (pos + 3 <= data.size())
+            {
+                uint32_t hash = (uint32_t(data[pos]) << 10 ^ uint32_t(data[pos + 1]) << 5 ^ data[pos + 2]) & 0x7FFF;
+                int32_t  cand = head[hash];
+                head[hash]    = int32_t(pos);
+                if (cand >= 0 && pos - size_t(cand) <= 32768)
+                {
+                    size_t len = 0;
+                    while (len < 258 && pos + len < data.size() && data[cand + len] == data[pos + len])
+                        ++len;
+                    if (len >= 3)
+                    {
+                        best_len  = len;
+                        best_dist = pos - size_t(cand);
+                    }
+                }
+            }
+
+            if (!best_len)
+            {
+                put_literal(data[pos++]);
+                continue;
+            }
+
+            uint32_t lc = 28;
+            while (length_base[lc] > best_len)
+                --lc;
+            put_literal(257 + lc);
+            bits.Write(uint32_t(best_len - length_base[lc]), length_extra[lc]);
+
+            uint32_t dc = 29;
+            while (dist_base[dc] > best_dist)
+                --dc;
+            bits.WriteCode(dist_codes[dc], dist_lengths[dc]);
+            bits.Write(uint32_t(best_dist - dist_base[dc]), dist_extra[dc]);
+            pos += best_len;
+        }
+        put_literal(256);
+        bits.Flush();
+    }
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t v : data)
+    {
+        a = (a + v) % 65521;
+        b = (b + a) % 65521;
+    }
+    uint32_t adler = (b << 16) | a;
+    for (int i = 3; i >= 0; --i)
+        out.push_back(uint8_t(adler >> (i * 8)));
+    return out;
+}
+
+inline uint32_t Crc32(const uint8_t* data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+inline void PutPngChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+{
+    for (int i = 3; i >= 0; --i)
+        out.push_back(uint8_t(size >> (i * 8)));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (size)
+        out.insert(out.end(), data, data + size);
+    uint32_t crc = Crc32(&out[start], out.size() - start);
+    for (int i = 3; i >= 0; --i)
+        out.push_back(uint8_t(crc >> (i * 8)));
+}
+
+struct PngOptions
+{
+    uint32_t      color_type = 6;  // 0 gray, 2 RGB, 3 palette, 4 gray with alpha, 6 RGBA
+    uint32_t      depth      = 8;  // 8 or 16, palette images are always 8
+    bool          interlaced = false;
+    DeflateBlocks blocks     = DeflateBlocks::Dynamic;
+    int           filter     = -1;  // -1 cycles through all five filters row by row
+    size_t        idat_chunk = 0;   // splits the stream into IDAT chunks of this size, 0 for a single chunk
+};
+
+// Palette images need at most 256 distinct colors in the source
+inline std::vector<uint8_t> EncodePng(const image::Image& img, const PngOptions& opt = PngOptions())
+{
+    static const uint32_t channel_count[7] = { 1, 0, 3, 1, 2, 0, 4 };
+    static const uint32_t adam7[7][4]      = {
+        { 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 }, { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 },
+    };
+    static const uint32_t single[1][4] = { { 0, 0, 1, 1 } };
+
+    const uint32_t channels = channel_count[opt.color_type];
+    const uint32_t bytes    = opt.depth / 8;
+    const size_t   bpp      = channels * bytes;
+
+    std::vector<uint32_t> palette;
+    std::vector<uint8_t>  indices;
+    if (opt.color_type == 3)
+    {
+        for (size_t i = 0; i < img.pixels.size(); i += 4)
+        {
+            uint32_t color;
+            std::memcpy(&color, &img.pixels[i], 4);
+            size_t index = 0;
+            while (index < palette.size() && palette[index] != color)
+                ++index;
+            if (index == palette.size())
+                palette.push_back(color);
+            indices.push_back(uint8_t(index));
+        }
+    }
+
+    auto sample = [&](uint32_t x, uint32_t y, uint8_t* dst) {
+        const size_t   i = size_t(y) * img.width + x;
+        const uint8_t* p = &img.pixels[i * 4];
+        uint8_t        v[4];
+        uint32_t       n = 0;
+        switch (opt.color_type)
+        {
+        case 0:
+            v[n++] = p[0];
+            break;
+        case 2:
+            v[n++] = p[0], v[n++] = p[1], v[n++] = p[2];
+            break;
+        case 3:
+            v[n++] = indices[i];
+            break;
+        case 4:
+            v[n++] = p[0], v[n++] = p[3];
+            break;
+        default:
+            v[n++] = p[0], v[n++] = p[1], v[n++] = p[2], v[n++] = p[3];
+            break;
+        }
+        for (uint32_t c = 0; c < n; ++c)
+            for (uint32_t b = 0; b < bytes; ++b)
+                *dst++ = v[c];  // 16-bit samples repeat the byte, so the high byte is the 8-bit value
+    };
+
+    std::vector<uint8_t> raw;
+    uint32_t             row_index = 0;
+    const uint32_t(*passes)[4]     = opt.interlaced ? adam7 : single;
+    for (uint32_t p = 0; p < (opt.interlaced ? 7u : 1u); ++p)
+    {
+        const uint32_t x0 = passes[p][0], y0 = passes[p][1], dx = passes[p][2], dy = passes[p][3];
+        const uint32_t w = img.width > x0 ? (img.width - x0 + dx - 1) / dx : 0;
+        const uint32_t r = img.height > y0 ? (img.height - y0 + dy - 1) / dy : 0;
+        if (!w || !r)
+            continue;
+
+        std::vector<uint8_t> prev(w * bpp, 0), cur(w * bpp);
+        for (uint32_t y = 0; y < r; ++y, ++row_index)
+        {
+            for (uint32_t x = 0; x < w; ++x)
+                sample(x0 + x * dx, y0 + y * dy, &cur[x * bpp]);
+
+            const uint8_t filter = uint8_t(opt.filter < 0 ? row_index % 5 : opt.filter);
+            raw.push_back(filter);
+            for (size_t i = 0; i < cur.size(); ++i)
+            {
+                int a = i >= bpp ? cur[i - bpp] : 0;
+                int b = prev[i];
+                int c = i >= bpp ? prev[i - bpp] : 0;
+                int pred = 0;
+                switch (filter)
+                {
+                case 1:
+                    pred = a;
+                    break;
+                case 2:
+                    pred = b;
+                    break;
+                case 3:
+                    pred = (a + b) / 2;
+                    break;
+                case 4:
+                {
+                    int pa = std::abs(b - c), pb = std::abs(a - c), pc = std::abs(a + b - 2 * c);
+                    pred   = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+                    break;
+                }
+                default:
+                    break;
+                }
+                raw.push_back(uint8_t(cur[i] - pred));
+            }
+            prev.swap(cur);
+        }
+    }
+
+    std::vector<uint8_t> out = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    uint8_t ihdr[13] = {};
+    for (int i = 0; i < 4; ++i)
+    {
+        ihdr[i]     = uint8_t(img.width >> (24 - i * 8));
+        ihdr[4 + i] = uint8_t(img.height >> (24 - i * 8));
+    }
+    ihdr[8]  = uint8_t(opt.depth);
+    ihdr[9]  = uint8_t(opt.color_type);
+    ihdr[12] = opt.interlaced ? 1 : 0;
+    PutPngChunk(out, "IHDR", ihdr, sizeof(ihdr));
+
+    if (opt.color_type == 3)
+    {
+        std::vector<uint8_t> plte, trns;
+        for (uint32_t color : palette)
+        {
+            const uint8_t* c = reinterpret_cast<const uint8_t*>(&color);
+            plte.insert(plte.end(), c, c + 3);
+            trns.push_back(c[3]);
+        }
+        PutPngChunk(out, "PLTE", plte.data(), plte.size());
+        PutPngChunk(out, "tRNS", trns.data(), trns.size());
+    }
+
+    std::vector<uint8_t> stream = Deflate(raw, opt.blocks);
+    size_t               chunk  = opt.idat_chunk ? opt.idat_chunk : stream.size();
+    for (size_t pos = 0; pos < stream.size(); pos += chunk)
+        PutPngChunk(out, "IDAT", &stream[pos], std::min(chunk, stream.size() - pos));
+    PutPngChunk(out, "IEND", nullptr, 0);
+    return out;
+}
+
+//-------------------------------------------------------
+// JPEG
+//-------------------------------------------------------
+
+struct JpegOptions
+{
+    int      quality          = 90;
+    bool     gray             = false;
+    bool     subsample        = false;  // 4:2:0 chroma
+    bool     wide_quant       = false;  // 16-bit quantization tables
+    uint32_t restart_interval = 0;
+};
+
+// Canonical Huffman codes for JPEG symbols, built from a code length per symbol
+struct JpegCodes
+{
+    uint8_t  counts[16] = {};
+    uint8_t  values[256];
+    uint32_t total = 0;
+    uint16_t code[256];
+    uint8_t  length[256] = {};
+
+    void Add(uint8_t symbol, uint8_t len)
+    {
+        length[symbol] = len;
+    }
+
+    void Build()
+    {
+        total = 0;
+        for (uint32_t len = 1; len <= 16; ++len)
+        {
+            for (uint32_t s = 0; s < 256; ++s)
+            {
+                if (length[s] == len)
+                {
+                    values[total++] = uint8_t(s);
+                    ++counts[len - 1];
+                }
+            }
+        }
+
+        uint32_t next = 0, k = 0;
+        for (uint32_t len = 1; len <= 16; ++len, next <<= 1)
+        {
+            for (uint32_t i = 0; i < counts[len - 1]; ++i, ++k)
+                code[values[k]] = uint16_t(next++);
+        }
+    }
+};
+
+// Non-optimal tables with short, medium and long codes, so the decoder's slow path is used too
+inline void MakeJpegTables(JpegCodes& dc, JpegCodes& ac)
+{
+    for (uint8_t s = 0; s < 12; ++s)
+        dc.Add(s, s < 6 ? 3 : 5);
+    dc.Build();
+
+    ac.Add(0x00, 2);
+    ac.Add(0xF0, 9);
+    for (uint32_t run = 0; run < 16; ++run)
+    {
+        for (uint32_t size = 1; size <= 10; ++size)
+            ac.Add(uint8_t(run << 4 | size), size <= 5 ? 9 : 12);
+    }
+    ac.Build();
+}
+
+class JpegBitWriter
+{
+public:
+    explicit JpegBitWriter(std::vector<uint8_t>& out)
+        : out_(out)
+    {
+    }
+
+    void Write(uint32_t value, uint32_t count)
+    {
+        for (uint32_t i = count; i > 0; --i)
+        {
+            bits_ = (bits_ << 1) | ((value >> (i - 1)) & 1);
+            if (++filled_ == 8)
+                Emit();
+        }
+    }
+
+    // Pads with one bits as the standard requires
+    void Flush()
+    {
+        while (filled_)
+            Write(1, 1);
+    }
+
+private:
+    void Emit()
+    {
+        out_.push_back(uint8_t(bits_));
+        if (uint8_t(bits_) == 0xFF)
+            out_.push_back(0);
+        bits_   = 0;
+        filled_ = 0;
+    }
+
+    std::vector<uint8_t>& out_;
+    uint32_t              bits_   = 0;
+    uint32_t              filled_ = 0;
+};
+
+inline void PutBE16(std::vector<uint8_t>& out, uint32_t v)
+{
+    out.push_back(uint8_t(v >> 8));
+    out.push_back(uint8_t(v));
+}
+
+inline std::vector<uint8_t> EncodeJpeg(const image::Image& img, const JpegOptions& opt = JpegOptions())
+{
+    static const uint8_t zigzag[64] = { 0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,
+                                        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28,
+                                        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+                                        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63 };
+    static const uint8_t luma_quant[64] = { 16, 11, 10, 16, 24,  40,  51,  61,  12, 12, 14, 19, 26,  58,  60,  55,
+                                            14, 13, 16, 24, 40,  57,  69,  56,  14, 17, 22, 29, 51,  87,  80,  62,
+                                            18, 22, 37, 56, 68,  109, 103, 77,  24, 35, 55, 64, 81,  104, 113, 92,
+                                            49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99 };
+    static const uint8_t chroma_quant[64] = { 17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99,
+                                              24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99, 99, 99, 99, 99,
+                                              99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+                                              99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99 };
+
+    const uint32_t components = opt.gray ? 1 : 3;
+    const uint32_t luma_scale = opt.subsample && !opt.gray ? 2 : 1;
+    const int      scale      = opt.quality < 50 ? 5000 / opt.quality : 200 - opt.quality * 2;
+
+    uint16_t quant[2][64];  // natural order
+    for (int i = 0; i < 64; ++i)
+    {
+        quant[0][i] = uint16_t(std::max(1, std::min(255, (luma_quant[i] * scale + 50) / 100)));
+        quant[1][i] = uint16_t(std::max(1, std::min(255, (chroma_quant[i] * scale + 50) / 100)));
+    }
+
+    // Planes in YCbCr (JFIF), padded by repeating the edge pixels
+    const uint32_t mcu    = 8 * luma_scale;
+    const uint32_t mcus_x = (img.width + mcu - 1) / mcu;
+    const uint32_t mcus_y = (img.height + mcu - 1) / mcu;
+    const uint32_t pw = mcus_x * mcu, ph = mcus_y * mcu;
+
+    std::vector<float> planes[3];
+    for (auto& plane : planes)
+        plane.resize(size_t(pw) * ph);
+    for (uint32_t y = 0; y < ph; ++y)
+    {
+        for (uint32_t x = 0; x < pw; ++x)
+        {
+            const size_t   src = size_t(std::min(y, img.height - 1)) * img.width + std::min(x, img.width - 1);
+            const uint8_t* p   = &img.pixels[src * 4];
+            float          r = p[0], g = p[1], b = p[2];
+            size_t         i = size_t(y) * pw + x;
+            planes[0][i]     = 0.299f * r + 0.587f * g + 0.114f * b;
+            planes[1][i]     = -0.168736f * r - 0.331264f * g + 0.5f * b + 128;
+            planes[2][i]     = 0.5f * r - 0.418688f * g - 0.081312f * b + 128;
+        }
+    }
+
+    JpegCodes dc, ac;
+    MakeJpegTables(dc, ac);
+
+    std::vector<uint8_t> out = { 0xFF, 0xD8 };
+
+    const uint32_t tables = opt.gray ? 1 : 2;
+    for (uint32_t t = 0; t < tables; ++t)
+    {
+        out.push_back(0xFF);
+        out.push_back(0xDB);
+        PutBE16(out, 2 + 1 + 64 * (opt.wide_quant ? 2 : 1));
+        out.push_back(uint8_t((opt.wide_quant ? 0x10 : 0) | t));
+        for (int k = 0; k < 64; ++k)
+        {
+            if (opt.wide_quant)
+                PutBE16(out, quant[t][zigzag[k]]);
+            else
+                out.push_back(uint8_t(quant[t][zigzag[k]]));
+        }
+    }
+
+    out.push_back(0xFF);
+    out.push_back(opt.wide_quant ? 0xC1 : 0xC0);
+    PutBE16(out, 8 + components * 3);
+    out.push_back(8);
+    PutBE16(out, img.height);
+    PutBE16(out, img.width);
+    out.push_back(uint8_t(components));
+    for (uint32_t c = 0; c < components; ++c)
+    {
+        out.push_back(uint8_t(c + 1));
+        out.push_back(c == 0 ? uint8_t(luma_scale << 4 | luma_scale) : 0x11);
+        out.push_back(c == 0 ? 0 : 1);
+    }
+
+    for (uint32_t t = 0; t < 2; ++t)
+    {
+        const JpegCodes& h = t == 0 ? dc : ac;
+        out.push_back(0xFF);
+        out.push_back(0xC4);
+        PutBE16(out, 2 + 17 + h.total);
+        out.push_back(uint8_t(t << 4));
+        out.insert(out.end(), h.counts, h.counts + 16);
+        out.insert(out.end(), h.values, h.values + h.total);
+    }
+
+    if (opt.restart_interval)
+    {
+        out.push_back(0xFF);
+        out.push_back(0xDD);
+        PutBE16(out, 4);
+        PutBE16(out, opt.restart_interval);
+    }
+
+    out.push_back(0xFF);
+    out.push_back(0xDA);
+    PutBE16(out, 6 + components * 2);
+    out.push_back(uint8_t(components));
+    for (uint32_t c = 0; c < components; ++c)
+    {
+        out.push_back(uint8_t(c + 1));
+        out.push_back(0x00);
+    }
+    out.push_back(0);
+    out.push_back(63);
+    out.push_back(0);
+
+    JpegBitWriter bits(out);
+    int           dc_pred[3] = {};
+
+    // cosines[x][u] = c(u) / 2 * cos((2x + 1) u pi / 16), the orthonormal DCT basis
+    float cosines[8][8];
+    for (uint32_t x = 0; x < 8; ++x)
+    {
+        for (uint32_t u = 0; u < 8; ++u)
+            cosines[x][u] = (u ? 0.5f : 0.35355339f) * std::cos((2 * x + 1) * u * 3.14159265f / 16);
+    }
+
+    auto encode_block = [&](uint32_t c, uint32_t bx, uint32_t by, uint32_t step) {
+        // Samples of the block, averaged over step x step pixels for subsampled chroma
+        float block[64];
+        for (uint32_t y = 0; y < 8; ++y)
+        {
+            for (uint32_t x = 0; x < 8; ++x)
+            {
+                float sum = 0;
+                for (uint32_t sy = 0; sy < step; ++sy)
+                    for (uint32_t sx = 0; sx < step; ++sx)
+                        sum += planes[c][size_t((by + y) * step + sy) * pw + (bx + x) * step + sx];
+                block[y * 8 + x] = sum / float(step * step) - 128;
+            }
+        }
+
+        // Separable forward DCT, rows then columns
+        float rows[64];
+        for (uint32_t y = 0; y < 8; ++y)
+        {
+            for (uint32_t u = 0; u < 8; ++u)
+            {
+                float sum = 0;
+                for (uint32_t x = 0; x < 8; ++x)
+                    sum += block[y * 8 + x] * cosines[x][u];
+                rows[y * 8 + u] = sum;
+            }
+        }
+
+        int coef[64];
+        for (uint32_t v = 0; v < 8; ++v)
+        {
+            for (uint32_t u = 0; u < 8; ++u)
+            {
+                float sum = 0;
+                for (uint32_t y = 0; y < 8; ++y)
+                    sum += rows[y * 8 + u] * cosines[y][v];
+                coef[v * 8 + u] = int(std::lround(sum / quant[c ? 1 : 0][v * 8 + u]));
+            }
+        }
+
+        auto put_value = [&](int value, uint32_t size) {
+            bits.Write(uint32_t(value < 0 ? value - 1 : value) & ((1u << size) - 1), size);
+        };
+        auto size_of = [](int value) {
+            uint32_t size = 0;
+            for (uint32_t m = uint32_t(std::abs(value)); m; m >>= 1)
+                ++size;
+            return size;
+        };
+
+        int      diff = coef[0] - dc_pred[c];
+        uint32_t size = size_of(diff);
+        dc_pred[c]    = coef[0];
+        bits.Write(dc.code[size], dc.length[size]);
+        put_value(diff, size);
+
+        uint32_t run = 0;
+        for (uint32_t k = 1; k < 64; ++k)
+        {
+            int v = coef[zigzag[k]];
+            if (v == 0)
+            {
+                ++run;
+                continue;
+            }
+            while (run >= 16)
+            {
+                bits.Write(ac.code[0xF0], ac.length[0xF0]);
+                run -= 16;
+            }
+            size           = size_of(v);
+            uint8_t symbol = uint8_t(run << 4 | size);
+            bits.Write(ac.code[symbol], ac.length[symbol]);
+            put_value(v, size);
+            run = 0;
+        }
+        if (run)
+            bits.Write(ac.code[0x00], ac.length[0x00]);
+    };
+
+    uint32_t todo = opt.restart_interval, marker = 0;
+    for (uint32_t my = 0; my < mcus_y; ++my)
+    {
+        for (uint32_t mx = 0; mx < mcus_x; ++mx)
+        {
+            for (uint32_t by = 0; by < luma_scale; ++by)
+                for (uint32_t bx = 0; bx < luma_scale; ++bx)
+                    encode_block(0, mx * mcu + bx * 8, my * mcu + by * 8, 1);
+            for (uint32_t c = 1; c < components; ++c)
+                encode_block(c, mx * 8, my * 8, luma_scale);
+
+            bool last = my == mcus_y - 1 && mx == mcus_x - 1;
+            if (opt.restart_interval && --todo == 0 && !last)
+            {
+                bits.Flush();
+                out.push_back(0xFF);
+                out.push_back(uint8_t(0xD0 + (marker++ & 7)));
+                todo       = opt.restart_interval;
+                dc_pred[0] = dc_pred[1] = dc_pred[2] = 0;
+            }
+        }
+    }
+    bits.Flush();
+
+    out.push_back(0xFF);
+    out.push_back(0xD9);
+    return out;
+}
+
+}  // namespace test
+}  // namespace kiwano
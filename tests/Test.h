@@ -0,0 +1,81 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace kiwano
+{
+namespace test
+{
+
+typedef void (*TestFunc)();
+
+// registers a test or a benchmark before main runs
+struct Registrar
+{
+    Registrar(const char* name, TestFunc func, bool is_benchmark);
+};
+
+void ReportFailure(const char* file, int line, const char* expr);
+
+// number of global operator new calls made by this process so far
+uint64_t GetAllocationCount();
+
+// bytes requested from global operator new by this process so far, including failed requests
+uint64_t GetAllocatedBytes();
+
+class Stopwatch
+{
+public:
+    Stopwatch()
+        : start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    double GetMilliseconds() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace test
+}  // namespace kiwano
+
+#define KGE_TEST_REGISTER(NAME, IS_BENCHMARK)                                      \
+    static void                      NAME();                                       \
+    static ::kiwano::test::Registrar NAME##_registrar(#NAME, &NAME, IS_BENCHMARK); \
+    static void                      NAME()
+
+// tests run on every invocation, benchmarks only with --bench
+#define KGE_TEST(NAME) KGE_TEST_REGISTER(NAME, false)
+#define KGE_BENCHMARK(NAME) KGE_TEST_REGISTER(NAME, true)
+
+#define KGE_CHECK(EXPR)                                               \
+    do                                                                \
+    {                                                                 \
+        if (!(EXPR))                                                  \
+            ::kiwano::test::ReportFailure(__FILE__, __LINE__, #EXPR); \
+    } while (0)
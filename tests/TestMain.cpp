@@ -0,0 +1,138 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Test.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace
+{
+struct TestCase
+{
+    const char*            name;
+    kiwano::test::TestFunc func;
+    bool                   is_benchmark;
+};
+
+std::vector<TestCase>& GetTestCases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+std::atomic<uint64_t> allocation_count{ 0 };
+std::atomic<uint64_t> allocated_bytes{ 0 };
+int                   failure_count = 0;
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+namespace kiwano
+{
+namespace test
+{
+
+Registrar::Registrar(const char* name, TestFunc func, bool is_benchmark)
+{
+    GetTestCases().push_back(TestCase{ name, func, is_benchmark });
+}
+
+void ReportFailure(const char* file, int line, const char* expr)
+{
+    ++failure_count;
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+}
+
+uint64_t GetAllocationCount()
+{
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+uint64_t GetAllocatedBytes()
+{
+    return allocated_bytes.load(std::memory_order_relaxed);
+}
+
+}  // namespace test
+}  // namespace kiwano
+
+// usage: <program> [--bench] [name-filter]
+int main(int argc, char** argv)
+{
+    bool        benchmarks = false;
+    const char* filter     = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0)
+            benchmarks = true;
+        else
+            filter = argv[i];
+    }
+
+    int run_count = 0;
+    for (const auto& test : GetTestCases())
+    {
+        if (test.is_benchmark != benchmarks)
+            continue;
+        if (filter && !std::strstr(test.name, filter))
+            continue;
+
+        int failures_before = failure_count;
+        std::printf("[ RUN  ] %s\n", test.name);
+        test.func();
+        std::printf("[ %s ] %s\n", failure_count == failures_before ? " OK " : "FAIL", test.name);
+        ++run_count;
+    }
+
+    std::printf("%d run, %d check(s) failed\n", run_count, failure_count);
+    return failure_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/2d/Stage.h>
+#include <kiwano/render/NullRenderer.h>
+
+using namespace kiwano;
+
+namespace
+{
+class TestStage : public Stage
+{
+public:
+    using Stage::Render;
+};
+
+class Fixture
+{
+public:
+    Fixture()
+        : ctx(UseNullRenderer())
+        , stage(MakePtr<TestStage>())
+        , panel(MakePtr<Actor>())
+        , child(MakePtr<Actor>())
+    {
+        ctx.SetCollectingStatus(true);
+
+        panel->SetCacheAsBitmapEnabled(true);
+        panel->SetSize(Size(100, 100));
+        child->SetSize(Size(50, 50));
+        panel->AddChild(child);
+        stage->AddChild(panel);
+    }
+
+    const RenderContext::Status& Draw()
+    {
+        ctx.BeginDraw();
+        stage->Render(ctx);
+        ctx.EndDraw();
+        return ctx.GetStatus();
+    }
+
+    RenderContext&    ctx;
+    RefPtr<TestStage> stage;
+    RefPtr<Actor>     panel;
+    RefPtr<Actor>     child;
+
+private:
+    static RenderContext& UseNullRenderer()
+    {
+        NullRenderer& renderer = NullRenderer::GetInstance();
+        Renderer::SetInstance(&renderer);
+        renderer.Resize(640, 480);
+        return renderer.GetContext();
+    }
+};
+}  // namespace
+
+KGE_TEST(BitmapCacheKeepsTextureWhenOpacityChanges)
+{
+    Fixture f;
+    KGE_CHECK(f.Draw().cache_misses == 1);
+    KGE_CHECK(f.Draw().cache_hits == 1);
+
+    // the own opacity is applied when compositing
+    f.panel->SetOpacity(0.5f);
+    KGE_CHECK(f.Draw().cache_hits == 1);
+    KGE_CHECK(f.child->GetDisplayedOpacity() == 0.5f);
+
+    // a child is rendered relative to the cache, its own opacity changes the content
+    f.child->SetOpacity(0.5f);
+    KGE_CHECK(f.Draw().cache_misses == 1);
+    KGE_CHECK(f.child->GetDisplayedOpacity() == 0.25f);
+    KGE_CHECK(f.panel->GetDisplayedOpacity() == 0.5f);
+}
+
+KGE_TEST(BitmapCacheRebuildsWhenContentChanges)
+{
+    Fixture f;
+    f.Draw();
+
+    // the content is rebuilt when the bounds shrink and grow again
+    f.panel->SetSize(Size(10, 10));
+    f.child->SetSize(Size(10, 10));
+    KGE_CHECK(f.Draw().cache_misses == 1);
+    f.panel->SetSize(Size(100, 100));
+    KGE_CHECK(f.Draw().cache_misses == 1);
+    KGE_CHECK(f.Draw().cache_hits == 1);
+
+    f.child->SetPosition(Point(200, 200));
+    KGE_CHECK(f.Draw().cache_misses == 1);
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/event/EventDispatcher.h>
+#include <kiwano/event/MouseEvent.h>
+#include <kiwano/utils/TaskScheduler.h>
+
+using namespace kiwano;
+
+namespace
+{
+const int kCallbacks = 100000;
+
+class Handler : public ObjectBase
+{
+public:
+    void OnTask(Task*, Duration dt)
+    {
+        elapsed += dt;
+    }
+
+    void OnMouseMove(Event*)
+    {
+        ++moves;
+    }
+
+    Duration elapsed;
+    int      moves = 0;
+};
+
+void Report(const char* name, uint64_t allocations, double elapsed)
+{
+    std::printf("  %-36s %.2f allocations per call, %.1f ns per call\n", name, double(allocations) / kCallbacks,
+                elapsed * 1e6 / kCallbacks);
+}
+}  // namespace
+
+// Every call allocates the Task or EventListener itself. Before inline storage in Function, the callback added one
+// more allocation per call, so the totals below were one higher.
+KGE_BENCHMARK(CallbackAllocations)
+{
+    RefPtr<Handler> handler = MakePtr<Handler>();
+
+    {
+        TaskScheduler   scheduler;
+        uint64_t        allocations = test::GetAllocationCount();
+        test::Stopwatch watch;
+        for (int i = 0; i < kCallbacks; ++i)
+        {
+            scheduler.AddTask(Closure(handler.Get(), &Handler::OnTask), time::Millisecond * 100);
+        }
+        Report("TaskScheduler::AddTask(Closure)", test::GetAllocationCount() - allocations, watch.GetMilliseconds());
+    }
+
+    {
+        TaskScheduler   scheduler;
+        Handler*        self        = handler.Get();
+        uint64_t        allocations = test::GetAllocationCount();
+        test::Stopwatch watch;
+        for (int i = 0; i < kCallbacks; ++i)
+        {
+            scheduler.AddTask([self, i](Task*, Duration dt) { self->elapsed += dt * i; }, time::Millisecond * 100);
+        }
+        Report("TaskScheduler::AddTask(lambda)", test::GetAllocationCount() - allocations, watch.GetMilliseconds());
+    }
+
+    {
+        EventDispatcher dispatcher;
+        uint64_t        allocations = test::GetAllocationCount();
+        test::Stopwatch watch;
+        for (int i = 0; i < kCallbacks; ++i)
+        {
+            dispatcher.AddListener<MouseMoveEvent>(Closure(handler.Get(), &Handler::OnMouseMove));
+        }
+        Report("EventDispatcher::AddListener(Closure)", test::GetAllocationCount() - allocations,
+               watch.GetMilliseconds());
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/base/component/ComponentManager.h>
+
+using namespace kiwano;
+
+namespace
+{
+class Host : public ComponentManager
+{
+public:
+    Host()
+        : ComponentManager(nullptr)
+    {
+    }
+};
+
+class BaseComponent : public Component
+{
+    KGE_COMPONENT_TYPE(BaseComponent, Component)
+};
+
+class DerivedComponent : public BaseComponent
+{
+};
+
+class OtherComponent : public Component
+{
+};
+}  // namespace
+
+KGE_TEST(ComponentLookupByType)
+{
+    Host host;
+    KGE_CHECK(host.GetComponent<BaseComponent>() == nullptr);
+
+    RefPtr<OtherComponent> other = MakePtr<OtherComponent>();
+    other->SetName("other");
+    host.AddComponent(other);
+
+    RefPtr<DerivedComponent> derived = MakePtr<DerivedComponent>();
+    derived->SetName("derived");
+    host.AddComponent(derived);
+
+    // the derived component is found by its own type and by the declared base type
+    KGE_CHECK(host.GetComponent<OtherComponent>() == other.Get());
+    KGE_CHECK(host.GetComponent<DerivedComponent>() == derived.Get());
+    KGE_CHECK(host.GetComponent<BaseComponent>() == derived.Get());
+    KGE_CHECK(derived->GetTypeId() == GetComponentTypeId<DerivedComponent>());
+
+    host.RemoveComponent("derived");
+    KGE_CHECK(host.GetComponent<BaseComponent>() == nullptr);
+    KGE_CHECK(host.GetAllComponents().size() == 1);
+}
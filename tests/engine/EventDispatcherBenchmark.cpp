@@ -0,0 +1,147 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/event/EventDispatcher.h>
+#include <kiwano/event/KeyEvent.h>
+#include <kiwano/event/MouseEvent.h>
+#include <kiwano/event/WindowEvent.h>
+
+using namespace kiwano;
+
+namespace
+{
+const int kListeners = 100;
+const int kEvents    = 1000000;
+
+struct Counter
+{
+    int handled = 0;
+};
+
+// 100 listeners spread over mouse, key and window events, and a few untyped ones
+void AddListeners(EventDispatcher& dispatcher, Counter& counter)
+{
+    Counter* c = &counter;
+    for (int i = 0; i < kListeners; ++i)
+    {
+        auto callback = [c](Event*) { ++c->handled; };
+        switch (i % 5)
+        {
+        case 0:
+            dispatcher.AddListener<MouseMoveEvent>(callback);
+            break;
+        case 1:
+            dispatcher.AddListener<MouseDownEvent>(callback);
+            break;
+        case 2:
+            dispatcher.AddListener<KeyDownEvent>(callback);
+            break;
+        case 3:
+            dispatcher.AddListener<WindowResizedEvent>(callback);
+            break;
+        default:
+            dispatcher.AddListener(EventType(), callback);
+            break;
+        }
+    }
+}
+}  // namespace
+
+KGE_TEST(RemovedListenerIsNotCounted)
+{
+    EventDispatcher dispatcher;
+    EventListener*  key = dispatcher.AddListener<KeyDownEvent>([](Event*) {});
+    KGE_CHECK(dispatcher.HasListener<KeyEvent>());
+    KGE_CHECK(!dispatcher.HasListener<MouseEvent>());
+
+    // no event is dispatched between the removal and the query
+    key->Remove();
+    KGE_CHECK(!dispatcher.HasListener<KeyEvent>());
+
+    EventListener* any = dispatcher.AddListener(EventType(), [](Event*) {});
+    KGE_CHECK((dispatcher.GetListenerMask<KeyEvent, MouseEvent>() == 0x3));
+
+    any->Remove();
+    any->Remove();
+    KGE_CHECK((dispatcher.GetListenerMask<KeyEvent, MouseEvent>() == 0));
+
+    dispatcher.AddListener<MouseUpEvent>([](Event*) {});
+    dispatcher.RemoveAllListeners();
+    KGE_CHECK(!dispatcher.HasListener<MouseEvent>());
+    KGE_CHECK(dispatcher.GetAllListeners().IsEmpty());
+}
+
+KGE_TEST(ListenerRemovedWhileDispatching)
+{
+    EventDispatcher dispatcher;
+    int             handled = 0;
+    EventListener*  self    = nullptr;
+    self = dispatcher.AddListener<MouseMoveEvent>([&](Event*) {
+        ++handled;
+        self->Remove();
+    });
+
+    MouseMoveEvent evt;
+    dispatcher.DispatchEvent(&evt);
+    KGE_CHECK(!dispatcher.HasListener<MouseEvent>());
+    KGE_CHECK(dispatcher.GetAllListeners().IsEmpty());
+
+    dispatcher.DispatchEvent(&evt);
+    KGE_CHECK(handled == 1);
+}
+
+// 1M events of five types dispatched to 100 listeners, then again after half of the listeners are removed
+KGE_BENCHMARK(EventDispatcherMixedEvents)
+{
+    MouseMoveEvent     move;
+    MouseDownEvent     down;
+    KeyDownEvent       key;
+    WindowResizedEvent resized;
+    KeyUpEvent         unheard;
+    Event*             events[] = { &move, &down, &key, &resized, &unheard };
+
+    EventDispatcher dispatcher;
+    Counter         counter;
+    AddListeners(dispatcher, counter);
+
+    for (int round = 0; round < 2; ++round)
+    {
+        counter.handled = 0;
+
+        test::Stopwatch watch;
+        for (int i = 0; i < kEvents; ++i)
+        {
+            dispatcher.DispatchEvent(events[i % 5]);
+        }
+        const double elapsed = watch.GetMilliseconds();
+
+        std::printf("  %-20s %.1f ns per event, %.1f handlers per event\n", round ? "half removed:" : "all listeners:",
+                    elapsed * 1e6 / kEvents, double(counter.handled) / kEvents);
+
+        // remove every other listener, they must stop counting before the next dispatch
+        int index = 0;
+        for (auto& listener : dispatcher.GetAllListeners())
+        {
+            if (index++ % 2 == 0)
+                listener->Remove();
+        }
+    }
+}
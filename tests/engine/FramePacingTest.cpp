@@ -0,0 +1,112 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/utils/Ticker.h>
+
+using namespace kiwano;
+
+namespace
+{
+const int kFrames = 10000;
+
+// Deterministic frame times that jitter by up to 10% around the interval
+class FrameClock
+{
+public:
+    FrameClock(Duration interval)
+        : interval_(interval.GetNanoseconds())
+        , seed_(12345)
+    {
+    }
+
+    Duration NextFrame()
+    {
+        seed_ = seed_ * 1103515245u + 12345u;
+
+        const int64_t jitter = int64_t((seed_ >> 8) % 2001) - 1000;  // -1000 ~ 1000
+        return Duration::FromNanoseconds(interval_ + interval_ * jitter / 10000);
+    }
+
+private:
+    int64_t  interval_;
+    uint32_t seed_;
+};
+}  // namespace
+
+KGE_TEST(FrameIntervalKeepsSubMillisecondPrecision)
+{
+    KGE_CHECK((time::Second / 60).GetNanoseconds() == 16666666);
+    KGE_CHECK((time::Second / 144).GetNanoseconds() == 6944444);
+    KGE_CHECK((time::Second / 240).GetNanoseconds() == 4166666);
+
+    KGE_CHECK(Duration(16).GetMilliseconds() == 16);
+    KGE_CHECK(Duration::Parse("1.5ms").GetNanoseconds() == 1500000);
+    KGE_CHECK(Duration::Parse("250us").GetNanoseconds() == 250000);
+    KGE_CHECK((time::Second * 3 / 2).GetSeconds() == 1.5f);
+}
+
+KGE_TEST(TickerDoesNotDriftOver10kFrames)
+{
+    const int rates[] = { 60, 144, 240 };
+    for (int rate : rates)
+    {
+        const Duration interval = time::Second / rate;
+
+        RefPtr<Ticker> ticker = MakePtr<Ticker>(interval, -1);
+        FrameClock     clock(interval);
+
+        Duration elapsed;
+        int64_t  elapsed_ns = 0;
+        int      drifted    = 0;
+        for (int i = 0; i < kFrames; ++i)
+        {
+            const Duration dt = clock.NextFrame();
+            elapsed += dt;
+            elapsed_ns += dt.GetNanoseconds();
+
+            // right after a tick, the ticked intervals and the carried error add up to the simulated clock
+            if (ticker->Tick(dt) && interval * ticker->GetTickedCount() + ticker->GetErrorTime() != elapsed)
+                ++drifted;
+        }
+        KGE_CHECK(drifted == 0);
+
+        // durations accumulate without rounding
+        KGE_CHECK(elapsed.GetNanoseconds() == elapsed_ns);
+
+        // the ticker ticks once per frame at most, long frames are carried as error instead of being lost
+        const int64_t expected = elapsed_ns / interval.GetNanoseconds();
+        const int64_t carried  = ticker->GetErrorTime().GetNanoseconds() / interval.GetNanoseconds();
+        const int64_t ticked   = ticker->GetTickedCount() + carried;
+        KGE_CHECK(ticked >= expected - 1 && ticked <= expected);
+    }
+}
+
+KGE_TEST(TickerTicksOncePerExactFrame)
+{
+    const Duration interval = time::Second / 240;
+    RefPtr<Ticker> ticker   = MakePtr<Ticker>(interval, -1);
+    for (int i = 0; i < kFrames; ++i)
+    {
+        ticker->Tick(interval);
+    }
+    KGE_CHECK(ticker->GetTickedCount() == kFrames);
+    KGE_CHECK(ticker->GetErrorTime().IsZero());
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano-audio/Ogg/OggTranscoder.h>
+#include <3rd-party/vorbis/vorbisenc.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace kiwano;
+using namespace kiwano::audio;
+
+namespace
+{
+const long     kSampleRate   = 44100;
+const uint32_t kBytesPerTick = 4;  // 16-bit stereo
+
+void WritePage(Vector<char>& out, const ogg_page& page)
+{
+    out.insert(out.end(), page.header, page.header + page.header_len);
+    out.insert(out.end(), page.body, page.body + page.body_len);
+}
+
+// Encodes a 440Hz sine wave into an in-memory ogg vorbis stream
+Vector<char> EncodeSine(long seconds)
+{
+    Vector<char> out;
+
+    vorbis_info info;
+    vorbis_info_init(&info);
+    vorbis_encode_init_vbr(&info, 2, kSampleRate, 0.1f);
+
+    vorbis_comment comment;
+    vorbis_comment_init(&comment);
+
+    vorbis_dsp_state dsp;
+    vorbis_block     block;
+    vorbis_analysis_init(&dsp, &info);
+    vorbis_block_init(&dsp, &block);
+
+    ogg_stream_state stream;
+    ogg_stream_init(&stream, 1);
+
+    ogg_packet header, header_comment, header_code;
+    vorbis_analysis_headerout(&dsp, &comment, &header, &header_comment, &header_code);
+    ogg_stream_packetin(&stream, &header);
+    ogg_stream_packetin(&stream, &header_comment);
+    ogg_stream_packetin(&stream, &header_code);
+
+    ogg_page page;
+    while (ogg_stream_flush(&stream, &page))
+        WritePage(out, page);
+
+    const long total = kSampleRate * seconds;
+    long       done  = 0;
+    bool       eos   = false;
+    while (!eos)
+    {
+        const long count = std::min(total - done, 1024L);
+        if (count > 0)
+        {
+            float** buffer = vorbis_analysis_buffer(&dsp, int(count));
+            for (long i = 0; i < count; ++i)
+            {
+                const float v = 0.5f * std::sin(float(done + i) * 2.0f * 3.14159f * 440.0f / float(kSampleRate));
+                buffer[0][i]  = v;
+                buffer[1][i]  = v;
+            }
+            vorbis_analysis_wrote(&dsp, int(count));
+            done += count;
+        }
+        else
+        {
+            vorbis_analysis_wrote(&dsp, 0);
+        }
+
+        while (vorbis_analysis_blockout(&dsp, &block) == 1)
+        {
+            vorbis_analysis(&block, nullptr);
+            vorbis_bitrate_addblock(&block);
+
+            ogg_packet packet;
+            while (vorbis_bitrate_flushpacket(&dsp, &packet))
+            {
+                ogg_stream_packetin(&stream, &packet);
+                while (!eos && ogg_stream_pageout(&stream, &page))
+                {
+                    WritePage(out, page);
+                    eos = ogg_page_eos(&page) != 0;
+                }
+            }
+        }
+    }
+
+    ogg_stream_clear(&stream);
+    vorbis_block_clear(&block);
+    vorbis_dsp_clear(&dsp);
+    vorbis_comment_clear(&comment);
+    vorbis_info_clear(&info);
+    return out;
+}
+
+// Reads up to max_bytes from the stream and returns the number of bytes decoded
+uint32_t ReadAll(StreamAudioData* data, Vector<char>* pcm = nullptr, uint32_t max_bytes = UINT32_MAX)
+{
+    uint32_t total = 0;
+    while (total < max_bytes)
+    {
+        BinaryData chunk = data->ReadChunk();
+        if (!chunk.IsValid())
+            break;
+        if (pcm)
+            pcm->insert(pcm->end(), (const char*)chunk.buffer, (const char*)chunk.buffer + chunk.size);
+        total += chunk.size;
+    }
+    return total;
+}
+}  // namespace
+
+KGE_TEST(OggStreamDecodesWholeFile)
+{
+    Vector<char>  ogg = EncodeSine(5);
+    OggTranscoder transcoder;
+    transcoder.SetStreamingThreshold(Duration(1000));
+
+    RefPtr<AudioData> data = transcoder.Decode(BinaryData(ogg.data(), uint32_t(ogg.size())));
+    KGE_CHECK(data && data->IsStreaming());
+
+    auto     stream   = static_cast<StreamAudioData*>(data.Get());
+    uint32_t expected = uint32_t(kSampleRate * 5) * kBytesPerTick;
+    KGE_CHECK(stream->GetDuration().GetMilliseconds() >= 4990);
+    KGE_CHECK(ReadAll(stream) == expected);
+    KGE_CHECK(stream->IsEndOfStream());
+
+    // seeking back restarts the stream
+    KGE_CHECK(stream->Seek(Duration(0)));
+    KGE_CHECK(ReadAll(stream) == expected);
+}
+
+KGE_TEST(OggStreamCloneDecodesIndependently)
+{
+    Vector<char>  ogg = EncodeSine(5);
+    OggTranscoder transcoder;
+    transcoder.SetStreamingThreshold(Duration(1000));
+
+    RefPtr<AudioData> data   = transcoder.Decode(BinaryData(ogg.data(), uint32_t(ogg.size())));
+    auto              stream = static_cast<StreamAudioData*>(data.Get());
+
+    // advance the original decoder before cloning it
+    Vector<char> head;
+    ReadAll(stream, &head, StreamAudioData::CHUNK_SIZE * 2);
+
+    RefPtr<StreamAudioData> clone = stream->Clone();
+    KGE_CHECK(clone && clone != stream);
+
+    // the clone starts from the beginning regardless of the original position
+    Vector<char> from_clone;
+    ReadAll(clone.Get(), &from_clone, StreamAudioData::CHUNK_SIZE * 2);
+    KGE_CHECK(from_clone.size() == head.size());
+    KGE_CHECK(std::memcmp(from_clone.data(), head.data(), head.size()) == 0);
+
+    // and reading from the clone did not move the original
+    Vector<char> rest;
+    ReadAll(stream, &rest);
+    KGE_CHECK(head.size() + rest.size() == uint32_t(kSampleRate * 5) * kBytesPerTick);
+    KGE_CHECK(!clone->IsEndOfStream());
+}
+
+KGE_TEST(OggShortAudioIsDecodedAtOnce)
+{
+    Vector<char>  ogg = EncodeSine(1);
+    OggTranscoder transcoder;
+    transcoder.SetStreamingThreshold(Duration(10000));
+
+    RefPtr<AudioData> data = transcoder.Decode(BinaryData(ogg.data(), uint32_t(ogg.size())));
+    KGE_CHECK(data && !data->IsStreaming());
+    KGE_CHECK(data->GetData().size == uint32_t(kSampleRate) * kBytesPerTick);
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano-physics/World.h>
+#include <cmath>
+
+using namespace kiwano;
+
+namespace
+{
+const int kFrames = 60;
+
+// exposes the update entry that the director calls on stages
+class Root : public Actor
+{
+public:
+    using Actor::Update;
+};
+
+RefPtr<physics::Body> AddBody(physics::World* world, Actor* actor, b2BodyType type)
+{
+    b2BodyDef def;
+    def.type = type;
+
+    RefPtr<physics::Body> body = world->AddBody(&def);
+    actor->AddComponent(body);
+    return body;
+}
+
+bool IsAt(physics::Body* body, float x)
+{
+    return std::abs(body->GetB2Body()->GetPosition().x - physics::LocalToWorld(x)) < 1e-4f;
+}
+}  // namespace
+
+KGE_TEST(BodyRegisteredWhenEnteringWorld)
+{
+    RefPtr<Root>           root  = MakePtr<Root>();
+    RefPtr<physics::World> world = MakePtr<physics::World>(b2Vec2(0, 0));
+    root->AddComponent(world);
+
+    // the body is bound before its actor enters the world subtree
+    RefPtr<Actor> actor = MakePtr<Actor>();
+    actor->SetPosition(Point(100, 50));
+    RefPtr<physics::Body> body = AddBody(world.Get(), actor.Get(), b2_staticBody);
+
+    // not synced until the actor enters the world
+    actor->SetPosition(Point(200, 50));
+    root->Update(time::Millisecond * 16);
+    KGE_CHECK(IsAt(body.Get(), 100));
+
+    root->AddChild(actor);
+    root->Update(time::Millisecond * 16);
+    KGE_CHECK(IsAt(body.Get(), 200));
+
+    // the world actor itself is not a part of the physics transform
+    root->SetPosition(Point(10, 0));
+    root->Update(time::Millisecond * 16);
+    KGE_CHECK(IsAt(body.Get(), 200));
+
+    RefPtr<Actor> parent = MakePtr<Actor>();
+    parent->SetPosition(Point(20, 0));
+    root->AddChild(parent);
+    actor->RemoveFromParent();
+    parent->AddChild(actor);
+    root->Update(time::Millisecond * 16);
+    KGE_CHECK(IsAt(body.Get(), 220));
+
+    // moving the parent invalidates the cached parent transform
+    parent->SetPosition(Point(40, 0));
+    root->Update(time::Millisecond * 16);
+    KGE_CHECK(IsAt(body.Get(), 240));
+}
+
+// Frame time of a world with 1k, 10k and 50k bodies, 80% of them static
+KGE_BENCHMARK(PhysicsBodySync)
+{
+    const int counts[] = { 1000, 10000, 50000 };
+    for (int count : counts)
+    {
+        RefPtr<Root>           root  = MakePtr<Root>();
+        RefPtr<physics::World> world = MakePtr<physics::World>(b2Vec2(0, 10));
+        root->AddComponent(world);
+
+        for (int i = 0; i < count; ++i)
+        {
+            RefPtr<Actor> group = MakePtr<Actor>();
+            RefPtr<Actor> actor = MakePtr<Actor>();
+            actor->SetPosition(Point(float(i % 200) * 4, float(i / 200) * 4));
+            group->AddChild(actor);
+            root->AddChild(group);
+
+            AddBody(world.Get(), actor.Get(), (i % 5 == 0) ? b2_dynamicBody : b2_staticBody);
+        }
+
+        test::Stopwatch watch;
+        for (int frame = 0; frame < kFrames; ++frame)
+        {
+            root->Update(time::Millisecond * 16);
+        }
+        std::printf("  %6d bodies: %.3f ms per frame\n", count, watch.GetMilliseconds() / kFrames);
+    }
+}
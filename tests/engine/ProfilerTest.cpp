@@ -0,0 +1,154 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/utils/Profiler.h>
+#include <cstdio>
+#include <thread>
+
+using namespace kiwano;
+
+namespace
+{
+void Spin(Duration duration)
+{
+    const Time start = Time::Now();
+    while (Time::Now() - start < duration)
+    {
+    }
+}
+
+const ProfileZoneSummary* FindSummary(const char* name)
+{
+    for (const auto& summary : Profiler::GetInstance().GetZoneSummaries())
+    {
+        if (summary.name == name)
+            return &summary;
+    }
+    return nullptr;
+}
+}  // namespace
+
+KGE_TEST(ProfilerSubtractsNestedZones)
+{
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+
+    static const char outer_name[] = "Outer";
+    static const char inner_name[] = "Inner";
+
+    // creates the buffer of this thread, so that the allocation is not timed below
+    {
+        ProfileZone warm_up("WarmUp");
+    }
+    profiler.Clear();
+
+    {
+        ProfileZone outer(outer_name);
+        Spin(time::Millisecond * 2);
+        for (int i = 0; i < 2; ++i)
+        {
+            ProfileZone inner(inner_name);
+            Spin(time::Millisecond * 4);
+        }
+    }
+    profiler.NextFrame();
+    profiler.SetEnabled(false);
+
+    const ProfileZoneSummary* outer = FindSummary(outer_name);
+    const ProfileZoneSummary* inner = FindSummary(inner_name);
+    KGE_CHECK(outer && inner);
+    KGE_CHECK(outer->calls == 1 && inner->calls == 2);
+
+    // the outer zone keeps its inclusive time, but its exclusive time does not contain the inner zones
+    KGE_CHECK(outer->last >= time::Millisecond * 10);
+    KGE_CHECK(outer->last_exclusive >= time::Millisecond * 2);
+    KGE_CHECK(outer->last_exclusive < time::Millisecond * 4);
+    KGE_CHECK(outer->last_exclusive + inner->last == outer->last);
+    KGE_CHECK(inner->last_exclusive == inner->last);
+
+    // summaries are sorted by exclusive time
+    KGE_CHECK(profiler.GetZoneSummaries().front().name == inner_name);
+}
+
+KGE_TEST(ProfilerCollectsRecordsFromWriterThreads)
+{
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+
+    static const char zone_name[] = "Worker";
+
+    const int kThreads = 4;
+    const int kZones   = 10000;
+
+    Vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([]() {
+            for (int i = 0; i < kZones; ++i)
+            {
+                ProfileZone zone(zone_name);
+            }
+        });
+    }
+
+    // frames are summarized while the writers are running
+    uint32_t calls = 0;
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        profiler.NextFrame();
+        if (auto summary = FindSummary(zone_name))
+            calls += summary->calls;
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    profiler.NextFrame();
+    if (auto summary = FindSummary(zone_name))
+        calls += summary->calls;
+    profiler.SetEnabled(false);
+
+    // the buffers are large enough that no record is overwritten before it is read
+    KGE_CHECK(calls == uint32_t(kThreads * kZones));
+}
+
+KGE_BENCHMARK(ProfilerZoneOverhead)
+{
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+
+    static const char zone_name[] = "Benchmark";
+
+    const int       kZones = 1000000;
+    test::Stopwatch watch;
+    for (int i = 0; i < kZones; ++i)
+    {
+        ProfileZone zone(zone_name);
+        if (i % 1000 == 999)
+            profiler.NextFrame();
+    }
+    std::printf("  %d zones: %.2f ns per zone\n", kZones, watch.GetMilliseconds() * 1e6 / kZones);
+
+    profiler.SetEnabled(false);
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/2d/SceneArchive.h>
+#include <kiwano/2d/Sprite.h>
+#include <kiwano/render/NullRenderer.h>
+#include <kiwano/utils/ResourceCache.h>
+#include <algorithm>
+#include <cstdio>
+
+using namespace kiwano;
+
+namespace
+{
+RefPtr<Actor> MakeTree(int count)
+{
+    RefPtr<Actor> root = MakePtr<Actor>();
+    root->SetName("root");
+
+    Actor* parent = root.Get();
+    for (int i = 0; i < count; ++i)
+    {
+        RefPtr<Actor> actor = MakePtr<Actor>();
+        actor->SetName(i % 2 ? "odd" : "even");
+        actor->SetPosition(Point(float(i), float(-i)));
+        actor->SetZOrder(i % 7);
+        parent->AddChild(actor);
+
+        // a few levels deep, so the parent indices are exercised
+        if (i % 100 == 0)
+            parent = actor.Get();
+    }
+    return root;
+}
+
+size_t CountChildren(const Actor* actor)
+{
+    size_t count = 0;
+    for (const auto& child : actor->GetAllChildren())
+    {
+        KGE_NOT_USED(child);
+        ++count;
+    }
+    return count;
+}
+}  // namespace
+
+KGE_TEST(SceneArchiveRoundTrip)
+{
+    NullRenderer& renderer = NullRenderer::GetInstance();
+    Renderer::SetInstance(&renderer);
+
+    RefPtr<Texture> texture = MakePtr<Texture>();
+    renderer.CreateTexture(*texture, PixelSize(16, 16), BinaryData(), PixelFormat::Bpp32RGBA);
+    texture->SetName("sprites/hero");
+
+    RefPtr<ResourceCache> cache = MakePtr<ResourceCache>();
+    cache->AddObject("sprites/hero", texture);
+
+    RefPtr<Actor> root = MakeTree(10);
+    RefPtr<Sprite> sprite = MakePtr<Sprite>();
+    sprite->SetName("hero");
+    sprite->SetFrame(SpriteFrame(texture));
+    sprite->SetOpacity(0.5f);
+    root->AddChild(sprite);
+
+    Vector<uint8_t> data = SceneArchive::Save(root.Get());
+    KGE_CHECK(!data.empty());
+
+    RefPtr<Actor> loaded = SceneArchive::Load(data.data(), data.size(), cache.Get());
+    KGE_CHECK(loaded);
+    if (!loaded)
+        return;
+
+    KGE_CHECK(loaded->GetName() == "root");
+    KGE_CHECK(CountChildren(loaded.Get()) == CountChildren(root.Get()));
+
+    Actor* first = loaded->GetAllChildren().GetFirst().Get();
+    KGE_CHECK(first->GetName() == "even");
+    KGE_CHECK(first->GetPosition() == Point(0.f, 0.f));
+
+    RefPtr<Sprite> loaded_sprite = dynamic_cast<Sprite*>(loaded->GetChild("hero").Get());
+    KGE_CHECK(loaded_sprite);
+    if (loaded_sprite)
+    {
+        KGE_CHECK(loaded_sprite->GetTexture() == texture);
+        KGE_CHECK(loaded_sprite->GetOpacity() == 0.5f);
+    }
+
+    // a second round trip produces the same bytes
+    Vector<uint8_t> again = SceneArchive::Save(loaded.Get());
+    KGE_CHECK(again == data);
+}
+
+KGE_TEST(SceneArchiveRejectsUnterminatedStrings)
+{
+    RefPtr<Actor> root = MakeTree(1);
+
+    Vector<uint8_t> data = SceneArchive::Save(root.Get());
+    KGE_CHECK(SceneArchive::Load(data.data(), data.size()));
+
+    // overwrite the terminator of a pooled name
+    const char  name[] = "even";
+    const auto  iter   = std::search(data.begin(), data.end(), name, name + sizeof(name));
+    KGE_CHECK(iter != data.end());
+    if (iter == data.end())
+        return;
+
+    *(iter + sizeof(name) - 1) = 'x';
+    KGE_CHECK(!SceneArchive::Load(data.data(), data.size()));
+}
+
+KGE_BENCHMARK(SceneArchive50kActors)
+{
+    RefPtr<Actor> root = MakeTree(50000);
+
+    test::Stopwatch save_watch;
+    Vector<uint8_t> data = SceneArchive::Save(root.Get());
+    const double    save_ms = save_watch.GetMilliseconds();
+
+    test::Stopwatch load_watch;
+    RefPtr<Actor>   loaded  = SceneArchive::Load(data.data(), data.size());
+    const double    load_ms = load_watch.GetMilliseconds();
+    KGE_CHECK(loaded);
+
+    std::printf("  50k actors, %u bytes: save %.2f ms, load %.2f ms\n", uint32_t(data.size()), save_ms, load_ms);
+}
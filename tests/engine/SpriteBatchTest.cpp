@@ -0,0 +1,183 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/2d/Stage.h>
+#include <kiwano/2d/Sprite.h>
+#include <kiwano/2d/SpriteBatchActor.h>
+#include <kiwano/render/NullRenderer.h>
+#include <kiwano/render/SpriteBatch.h>
+#include <cstdio>
+
+using namespace kiwano;
+
+namespace
+{
+class TestStage : public Stage
+{
+public:
+    using Stage::Render;
+};
+
+RenderContext& UseNullRenderer()
+{
+    NullRenderer& renderer = NullRenderer::GetInstance();
+    Renderer::SetInstance(&renderer);
+    renderer.Resize(640, 480);
+    return renderer.GetContext();
+}
+
+RefPtr<Texture> MakeTexture()
+{
+    RefPtr<Texture> texture = MakePtr<Texture>();
+    NullRenderer::GetInstance().CreateTexture(*texture, PixelSize(32, 32), BinaryData(), PixelFormat::Bpp32RGBA);
+    return texture;
+}
+
+RefPtr<SpriteBatchActor> MakeLayer(TestStage* stage, const Vector<RefPtr<Texture>>& textures, int count)
+{
+    RefPtr<SpriteBatchActor> layer = MakePtr<SpriteBatchActor>();
+    stage->AddChild(layer);
+    for (int i = 0; i < count; ++i)
+    {
+        RefPtr<Sprite> sprite = MakePtr<Sprite>();
+        sprite->SetFrame(SpriteFrame(textures[i % textures.size()]));
+        sprite->SetPosition(Point(float(i % 100) * 6.f, float(i / 100) * 4.f));
+        layer->AddChild(sprite);
+    }
+    return layer;
+}
+
+void Draw(RenderContext& ctx, TestStage* stage)
+{
+    ctx.BeginDraw();
+    stage->Render(ctx);
+    ctx.EndDraw();
+}
+}  // namespace
+
+KGE_TEST(SpriteBatchGroupsConsecutiveSprites)
+{
+    UseNullRenderer();
+    RefPtr<Texture> a = MakeTexture();
+    RefPtr<Texture> b = MakeTexture();
+
+    const Rect      rect(0, 0, 32, 32);
+    const Matrix3x2 identity;
+
+    SpriteBatch batch;
+    batch.Add(*a, rect, rect, identity);
+    batch.Add(*a, rect, rect, identity);
+    batch.Add(*b, rect, rect, identity);
+    batch.Add(*a, rect, rect, identity);
+    batch.Add(*a, rect, rect, identity, 0.5f);
+    batch.Add(*a, rect, rect, identity, 0.0f);  // transparent sprites are dropped
+    KGE_CHECK(batch.GetSpriteCount() == 5);
+
+    const auto& groups = batch.BuildGroups();
+    KGE_CHECK(groups.size() == 4);
+    KGE_CHECK(groups[0].texture == a.Get() && groups[0].first == 0 && groups[0].count == 2);
+    KGE_CHECK(groups[1].texture == b.Get() && groups[1].count == 1);
+    KGE_CHECK(groups[3].opacity == 0.5f);
+
+    // sorting moves the sprite of b behind the other sprites of a
+    batch.SetSortingEnabled(true);
+    KGE_CHECK(batch.BuildGroups().size() == 3);
+    KGE_CHECK(batch.BuildGroups()[0].count == 3);
+}
+
+KGE_TEST(SpriteBatchFlushRestoresContextState)
+{
+    RenderContext&  ctx = UseNullRenderer();
+    RefPtr<Texture> a   = MakeTexture();
+    RefPtr<Texture> b   = MakeTexture();
+
+    const Rect rect(0, 0, 32, 32);
+
+    SpriteBatch batch;
+    batch.Add(*a, rect, rect, Matrix3x2(), 0.5f, BlendMode::Add);
+    batch.Add(*b, rect, rect, Matrix3x2());
+
+    ctx.BeginDraw();
+    ctx.SetBrushOpacity(0.25f);
+    batch.Flush(ctx);
+    KGE_CHECK(ctx.GetBrushOpacity() == 0.25f);
+    KGE_CHECK(ctx.GetBlendMode() == BlendMode::SourceOver);
+    ctx.EndDraw();
+
+    KGE_CHECK(batch.IsEmpty());
+    KGE_CHECK(batch.GetSubmissionCount() == 2);
+    KGE_CHECK(batch.GetSubmittedSpriteCount() == 2);
+}
+
+KGE_TEST(SpriteBatchActorKeepsSpecialSpritesOutOfTheBatch)
+{
+    RenderContext&  ctx   = UseNullRenderer();
+    RefPtr<Texture> a     = MakeTexture();
+    auto            stage = MakePtr<TestStage>();
+
+    RefPtr<SpriteBatchActor> layer = MakeLayer(stage.Get(), { a }, 10);
+    Draw(ctx, stage.Get());
+    KGE_CHECK(layer->GetSubmissionCount() == 1);
+    KGE_CHECK(layer->GetBatchedSpriteCount() == 10);
+
+    // a sprite culled as a subtree is rendered by Actor::Render, and splits the batch
+    Actor* middle = layer->GetAllChildren().GetFirst()->GetNext()->GetNext().Get();
+    middle->SetSubtreeCullingEnabled(true);
+    Draw(ctx, stage.Get());
+    KGE_CHECK(layer->GetSubmissionCount() == 2);
+    KGE_CHECK(layer->GetBatchedSpriteCount() == 9);
+    KGE_CHECK(stage->GetRenderedActorCount() >= 11);
+
+    // removing a sprite while rendering does not break the walk
+    middle->SetSubtreeCullingEnabled(false);
+    layer->RemoveChild(middle);
+    Draw(ctx, stage.Get());
+    KGE_CHECK(layer->GetBatchedSpriteCount() == 9);
+}
+
+KGE_BENCHMARK(SpriteBatchActor10kSprites)
+{
+    RenderContext&          ctx      = UseNullRenderer();
+    Vector<RefPtr<Texture>> textures = { MakeTexture(), MakeTexture() };
+
+    const int kSprites = 10000;
+    const int kFrames  = 100;
+
+    auto run = [&](const char* name, bool batching, bool sorting) {
+        auto                     stage = MakePtr<TestStage>();
+        RefPtr<SpriteBatchActor> layer = MakeLayer(stage.Get(), textures, kSprites);
+        layer->SetBatchingEnabled(batching);
+        layer->SetSortingEnabled(sorting);
+
+        Draw(ctx, stage.Get());
+
+        test::Stopwatch watch;
+        for (int i = 0; i < kFrames; ++i)
+            Draw(ctx, stage.Get());
+
+        std::printf("  %-12s %.3f ms per frame, %u submissions\n", name, watch.GetMilliseconds() / kFrames,
+                    batching ? layer->GetSubmissionCount() : uint32_t(kSprites));
+    };
+
+    run("unbatched", false, false);
+    run("alternating", true, false);
+    run("sorted", true, true);
+}
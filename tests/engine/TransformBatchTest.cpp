@@ -0,0 +1,67 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "../Test.h"
+#include <kiwano/2d/Stage.h>
+#include <kiwano/render/NullRenderer.h>
+
+using namespace kiwano;
+
+namespace
+{
+class TestStage : public Stage
+{
+public:
+    using Stage::Render;
+};
+}  // namespace
+
+KGE_TEST(TransformBatchComposesFromRecomputedParents)
+{
+    NullRenderer& renderer = NullRenderer::GetInstance();
+    Renderer::SetInstance(&renderer);
+    renderer.Resize(640, 480);
+    RenderContext& ctx = renderer.GetContext();
+
+    RefPtr<TestStage> stage  = MakePtr<TestStage>();
+    RefPtr<Actor>     root   = MakePtr<Actor>();
+    RefPtr<Actor>     parent = MakePtr<Actor>();
+    RefPtr<Actor>     child  = MakePtr<Actor>();
+    root->SetTransformBatchingEnabled(true);
+    stage->AddChild(root);
+    root->AddChild(parent);
+    parent->AddChild(child);
+
+    auto draw = [&]() {
+        ctx.BeginDraw();
+        stage->Render(ctx);
+        ctx.EndDraw();
+    };
+    draw();
+
+    // the parent is recomputed outside the batch, only the child changes its own transform
+    root->SetPositionX(100.f);
+    parent->GetTransformMatrix();
+    child->SetPositionX(5.f);
+    draw();
+
+    KGE_CHECK(child->GetTransformMatrix()[4] == 105.f);
+    KGE_CHECK(parent->GetTransformMatrix()[4] == 100.f);
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Fuzz target for the portable image decoders. Built with -fsanitize=fuzzer it runs under libFuzzer:
+//   kiwano-image-fuzzer -max_len=65536 tests/fuzz/corpus/image
+// Otherwise it is a replay driver that decodes each file (or each file of a directory) it is given,
+// which ctest runs over the seed corpus.
+
+#include <kiwano/render/ImageCodec.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    kiwano::image::Image img;
+    if (kiwano::image::Decode(data, size, img))
+    {
+        // Touch every pixel so a short buffer shows up under the sanitizers
+        kiwano::image::ConvertPixels(img.pixels.data(), size_t(img.width) * img.height, img.has_alpha, true);
+    }
+    return 0;
+}
+
+#ifndef KGE_LIBFUZZER
+
+namespace
+{
+int ReplayFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::fprintf(stderr, "cannot open %s\n", path.string().c_str());
+        return 1;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+    return 0;
+}
+}  // namespace
+
+// usage: <program> <file-or-directory>...
+int main(int argc, char** argv)
+{
+    int failures = 0, count = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::error_code ec;
+        if (std::filesystem::is_directory(argv[i], ec))
+        {
+            for (const auto& entry : std::filesystem::directory_iterator(argv[i]))
+            {
+                if (entry.is_regular_file())
+                {
+                    failures += ReplayFile(entry.path());
+                    ++count;
+                }
+            }
+        }
+        else
+        {
+            failures += ReplayFile(argv[i]);
+            ++count;
+        }
+    }
+
+    std::printf("%d input(s) replayed\n", count);
+    return failures == 0 && count > 0 ? 0 : 1;
+}
+
+#endif